@@ -0,0 +1,336 @@
+#ifndef CONCURRENTSKIPLIST_H
+#define CONCURRENTSKIPLIST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+/******************************************************************************
+* ConcurrentSkipList
+*
+* implementation: lock-free ordered set. Any number of threads may insert,
+*                 erase and look up at once; compile-time "generic" with
+*                 CONCURRENTSKIPLIST_TYPE, ordered by CONCURRENTSKIPLIST_LESS.
+*
+*                 A node becomes part of the set when a CAS links it in at
+*                 level 0. Its upper levels are then linked one at a time by
+*                 CAS, re-searching the predecessors whenever a CAS loses a
+*                 race. Upper levels are only shortcuts, so searches stay
+*                 correct while a tower is half built.
+*
+*                 Erase is logical: it CASes the node's deleted flag, and a
+*                 later insert of the same key CASes it back. Nodes are never
+*                 unlinked, which is what keeps this free of the
+*                 memory-reclamation problem (hazard pointers, epochs) a
+*                 physically deleting list needs. Memory therefore grows
+*                 with the number of distinct keys ever inserted. Rank and
+*                 position queries need exact widths, which can't be
+*                 maintained lock-free, so they are only in SkipList.
+*
+*                 Towers come from a shared arena: threads bump an atomic
+*                 offset into the newest chunk, and whoever finds it full
+*                 installs a new chunk with a CAS.
+*
+* structures
+*  - ConcurrentSkipListNode: key, height, deleted flag and atomic links
+*  - ConcurrentSkipListArenaChunk: one arena allocation
+*  - ConcurrentSkipList: head tower, element count, arena and height counter
+*
+******************************************************************************/
+
+#define CONCURRENTSKIPLIST_TYPE int
+#define CONCURRENTSKIPLIST_LESS(a, b) ((a) < (b))
+
+#define CONCURRENTSKIPLIST_MAX_LEVEL 16
+#define CONCURRENTSKIPLIST_ARENA_CHUNK_BYTES (64 * 1024)
+
+typedef struct ConcurrentSkipListNode {
+    CONCURRENTSKIPLIST_TYPE key;
+    unsigned int height;
+    atomic_bool deleted;
+    _Atomic(struct ConcurrentSkipListNode*) next[];
+} ConcurrentSkipListNode;
+
+typedef struct ConcurrentSkipListArenaChunk {
+    struct ConcurrentSkipListArenaChunk* next;
+    atomic_ulong used;                  // in units of max_align_t
+    max_align_t data[];
+} ConcurrentSkipListArenaChunk;
+
+#define CONCURRENTSKIPLIST_ARENA_CHUNK_UNITS \
+    ((CONCURRENTSKIPLIST_ARENA_CHUNK_BYTES - sizeof(ConcurrentSkipListArenaChunk)) / sizeof(max_align_t))
+
+typedef struct ConcurrentSkipList {
+    ConcurrentSkipListNode* head;
+    atomic_long size;
+    _Atomic(ConcurrentSkipListArenaChunk*) chunks;   // newest first
+    atomic_ulong heightCounter;
+} ConcurrentSkipList;
+
+/* Arena helpers **************************************************************/
+static ConcurrentSkipListNode* __concurrentSkipListAllocTower(ConcurrentSkipList* list, unsigned int height) {
+    size_t bytes = sizeof(ConcurrentSkipListNode) + height * sizeof(ConcurrentSkipListNode*);
+    unsigned long units = (bytes + sizeof(max_align_t) - 1) / sizeof(max_align_t);
+
+    while (true) {
+        ConcurrentSkipListArenaChunk* chunk = atomic_load_explicit(&list->chunks, memory_order_acquire);
+        if (chunk != NULL) {
+            unsigned long offset = atomic_fetch_add_explicit(&chunk->used, units, memory_order_relaxed);
+            if (offset + units <= CONCURRENTSKIPLIST_ARENA_CHUNK_UNITS) {
+                ConcurrentSkipListNode* node = (ConcurrentSkipListNode*)&chunk->data[offset];
+                node->height = height;
+                return node;
+            }
+        }
+
+        // chunk is full (or missing): try to install a fresh one
+        ConcurrentSkipListArenaChunk* fresh = malloc(CONCURRENTSKIPLIST_ARENA_CHUNK_BYTES);
+        if (fresh == NULL) {
+            fprintf(stderr, "ERROR: failed to allocate memory for ConcurrentSkipList arena chunk.\n");
+            return NULL;
+        }
+        fresh->next = chunk;
+        atomic_init(&fresh->used, 0);
+        if (!atomic_compare_exchange_strong_explicit(&list->chunks, &chunk, fresh,
+                                                     memory_order_acq_rel, memory_order_acquire)) {
+            free(fresh);    // another thread installed one first
+        }
+    }
+}
+
+// splitmix64 of a shared counter; two random bits per level gives p = 1/4
+static unsigned int __concurrentSkipListRandomHeight(ConcurrentSkipList* list) {
+    uint64_t bits = atomic_fetch_add_explicit(&list->heightCounter, 0x9E3779B97F4A7C15ULL, memory_order_relaxed);
+    bits = (bits ^ (bits >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    bits = (bits ^ (bits >> 27)) * 0x94D049BB133111EBULL;
+    bits ^= bits >> 31;
+
+    unsigned int height = 1;
+    while (height < CONCURRENTSKIPLIST_MAX_LEVEL && (bits & 3) == 0) {
+        height++;
+        bits >>= 2;
+    }
+    return height;
+}
+/* End arena helpers **********************************************************/
+
+/******************************************************************************
+* concurrentSkipListInit
+*
+* parameters: none
+*
+* returns: ConcurrentSkipList*
+*
+* description: initializes an empty set; not itself thread-safe
+*
+******************************************************************************/
+ConcurrentSkipList* concurrentSkipListInit() {
+    ConcurrentSkipList* list = malloc(sizeof(ConcurrentSkipList));
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for ConcurrentSkipList.\n");
+        return NULL;
+    }
+
+    atomic_init(&list->chunks, NULL);
+    atomic_init(&list->size, 0);
+    atomic_init(&list->heightCounter, 0);
+
+    list->head = __concurrentSkipListAllocTower(list, CONCURRENTSKIPLIST_MAX_LEVEL);
+    if (list->head == NULL) {
+        free(list);
+        return NULL;
+    }
+    atomic_init(&list->head->deleted, false);
+    for (unsigned int l = 0; l < CONCURRENTSKIPLIST_MAX_LEVEL; ++l) atomic_init(&list->head->next[l], NULL);
+
+    return list;
+}
+
+/******************************************************************************
+* concurrentSkipListDestroy
+*
+* parameters:
+*  - list : ConcurrentSkipList*
+*
+* returns: none
+*
+* description: frees the arena and the set; no thread may be using it
+*
+******************************************************************************/
+void concurrentSkipListDestroy(ConcurrentSkipList* list) {
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: attempted to destroy NULL ConcurrentSkipList.\n");
+        return;
+    }
+
+    ConcurrentSkipListArenaChunk* chunk = atomic_load(&list->chunks);
+    while (chunk != NULL) {
+        ConcurrentSkipListArenaChunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    free(list);
+}
+
+/******************************************************************************
+* concurrentSkipListFind
+*
+* parameters:
+*  - list : ConcurrentSkipList*
+*  - key : CONCURRENTSKIPLIST_TYPE
+*  - preds : ConcurrentSkipListNode** ; MAX_LEVEL entries, or NULL
+*  - succs : ConcurrentSkipListNode** ; MAX_LEVEL entries, or NULL
+*
+* returns: ConcurrentSkipListNode* ; the node holding key (deleted or not),
+*          NULL if there is none
+*
+* description: standard top-down search, recording at each level the last
+*              node before key and the first node not before it
+*
+******************************************************************************/
+ConcurrentSkipListNode* concurrentSkipListFind(ConcurrentSkipList* list, CONCURRENTSKIPLIST_TYPE key,
+                                               ConcurrentSkipListNode** preds, ConcurrentSkipListNode** succs) {
+    ConcurrentSkipListNode* x = list->head;
+    ConcurrentSkipListNode* next = NULL;
+
+    for (int l = CONCURRENTSKIPLIST_MAX_LEVEL - 1; l >= 0; --l) {
+        next = atomic_load_explicit(&x->next[l], memory_order_acquire);
+        while (next != NULL && CONCURRENTSKIPLIST_LESS(next->key, key)) {
+            x = next;
+            next = atomic_load_explicit(&x->next[l], memory_order_acquire);
+        }
+        if (preds != NULL) preds[l] = x;
+        if (succs != NULL) succs[l] = next;
+    }
+
+    if (next != NULL && !CONCURRENTSKIPLIST_LESS(key, next->key)) return next;
+    return NULL;
+}
+
+/******************************************************************************
+* concurrentSkipListInsert
+*
+* parameters:
+*  - list : ConcurrentSkipList*
+*  - key : CONCURRENTSKIPLIST_TYPE
+*
+* returns: bool ; false if key was already present (or out of memory)
+*
+* description: lock-free; see the header for the linking order
+*
+******************************************************************************/
+bool concurrentSkipListInsert(ConcurrentSkipList* list, CONCURRENTSKIPLIST_TYPE key) {
+    ConcurrentSkipListNode* preds[CONCURRENTSKIPLIST_MAX_LEVEL];
+    ConcurrentSkipListNode* succs[CONCURRENTSKIPLIST_MAX_LEVEL];
+    ConcurrentSkipListNode* node = NULL;
+    unsigned int height = 0;
+
+    while (true) {
+        ConcurrentSkipListNode* found = concurrentSkipListFind(list, key, preds, succs);
+        if (found != NULL) {
+            // key is linked already; revive it if it was erased.
+            // A tower allocated on an earlier pass is abandoned in the arena.
+            bool expected = true;
+            if (atomic_compare_exchange_strong(&found->deleted, &expected, false)) {
+                atomic_fetch_add_explicit(&list->size, 1, memory_order_relaxed);
+                return true;
+            }
+            return false;
+        }
+
+        if (node == NULL) {
+            height = __concurrentSkipListRandomHeight(list);
+            node = __concurrentSkipListAllocTower(list, height);
+            if (node == NULL) return false;
+            node->key = key;
+            atomic_init(&node->deleted, false);
+        }
+        for (unsigned int l = 0; l < height; ++l) {
+            atomic_store_explicit(&node->next[l], succs[l], memory_order_relaxed);
+        }
+
+        // linearization point: the node is in the set once level 0 links it
+        ConcurrentSkipListNode* expected = succs[0];
+        if (atomic_compare_exchange_strong_explicit(&preds[0]->next[0], &expected, node,
+                                                    memory_order_release, memory_order_relaxed)) {
+            break;
+        }
+    }
+    atomic_fetch_add_explicit(&list->size, 1, memory_order_relaxed);
+
+    for (unsigned int l = 1; l < height; ++l) {
+        while (true) {
+            ConcurrentSkipListNode* expected = succs[l];
+            if (atomic_compare_exchange_strong_explicit(&preds[l]->next[l], &expected, node,
+                                                        memory_order_release, memory_order_relaxed)) {
+                break;
+            }
+            // lost a race at this level: search again and retarget the link
+            concurrentSkipListFind(list, key, preds, succs);
+            atomic_store_explicit(&node->next[l], succs[l], memory_order_relaxed);
+        }
+    }
+    return true;
+}
+
+/******************************************************************************
+* concurrentSkipListErase
+*
+* parameters:
+*  - list : ConcurrentSkipList*
+*  - key : CONCURRENTSKIPLIST_TYPE
+*
+* returns: bool ; false if key was not present
+*
+* description: marks key's node deleted; the node stays linked
+*
+******************************************************************************/
+bool concurrentSkipListErase(ConcurrentSkipList* list, CONCURRENTSKIPLIST_TYPE key) {
+    ConcurrentSkipListNode* found = concurrentSkipListFind(list, key, NULL, NULL);
+    if (found == NULL) return false;
+
+    bool expected = false;
+    if (!atomic_compare_exchange_strong(&found->deleted, &expected, true)) return false;
+
+    atomic_fetch_sub_explicit(&list->size, 1, memory_order_relaxed);
+    return true;
+}
+
+/******************************************************************************
+* concurrentSkipListContains
+*
+* parameters:
+*  - list : ConcurrentSkipList*
+*  - key : CONCURRENTSKIPLIST_TYPE
+*
+* returns: bool
+*
+* description: whether key is present and not erased
+*
+******************************************************************************/
+bool concurrentSkipListContains(ConcurrentSkipList* list, CONCURRENTSKIPLIST_TYPE key) {
+    ConcurrentSkipListNode* found = concurrentSkipListFind(list, key, NULL, NULL);
+    return found != NULL && !atomic_load(&found->deleted);
+}
+
+/******************************************************************************
+* concurrentSkipListSize
+*
+* parameters:
+*  - list : ConcurrentSkipList*
+*
+* returns: unsigned long
+*
+* description: number of present keys; only a snapshot while other threads
+*              are running
+*
+******************************************************************************/
+unsigned long concurrentSkipListSize(ConcurrentSkipList* list) {
+    long size = atomic_load_explicit(&list->size, memory_order_relaxed);
+    return (size > 0) ? (unsigned long)size : 0;
+}
+
+#endif /* CONCURRENTSKIPLIST_H */
@@ -0,0 +1,472 @@
+#ifndef SKIPLIST_H
+#define SKIPLIST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+* SkipList
+*
+* implementation: indexable skip list; an ordered multiset with O(log n)
+*                 expected insert, erase, lookup, rank and access by
+*                 position. Compile-time "generic" with SKIPLIST_TYPE,
+*                 ordered by SKIPLIST_LESS.
+*
+*                 Every link also stores its width: how many level 0 steps it
+*                 skips. Summing widths along a search path gives an
+*                 element's position, and following widths finds the element
+*                 at a position. Links running off the end are treated as
+*                 pointing at a sentinel at position size + 1, so their
+*                 widths stay exact too.
+*
+*                 Towers (a node and its links) are variable sized and carved
+*                 from an arena of SKIPLIST_ARENA_CHUNK_BYTES chunks. Erased
+*                 towers go on a free list per height and are reused by the
+*                 next insert of that height; clear and destroy release whole
+*                 chunks.
+*
+* structures
+*  - SkipListLink: next node and width
+*  - SkipListNode: key, height and height links (flexible array member)
+*  - SkipListArenaChunk: one arena allocation
+*  - SkipList: head tower of SKIPLIST_MAX_LEVEL links, size, arena, free
+*              lists and random state
+*
+* see also: ConcurrentSkipList.h for the lock-free variant
+*
+******************************************************************************/
+
+#define SKIPLIST_TYPE int
+#define SKIPLIST_LESS(a, b) ((a) < (b))
+
+// p = 1/4 per level; 16 levels comfortably cover 4^16 elements
+#define SKIPLIST_MAX_LEVEL 16
+#define SKIPLIST_ARENA_CHUNK_BYTES (64 * 1024)
+
+typedef struct SkipListLink {
+    struct SkipListNode* next;
+    unsigned long width;
+} SkipListLink;
+
+typedef struct SkipListNode {
+    SKIPLIST_TYPE key;
+    unsigned int height;
+    SkipListLink links[];
+} SkipListNode;
+
+typedef struct SkipListArenaChunk {
+    struct SkipListArenaChunk* next;
+    unsigned long used;                 // in units of max_align_t
+    max_align_t data[];
+} SkipListArenaChunk;
+
+#define SKIPLIST_ARENA_CHUNK_UNITS \
+    ((SKIPLIST_ARENA_CHUNK_BYTES - sizeof(SkipListArenaChunk)) / sizeof(max_align_t))
+
+typedef struct SkipList {
+    SkipListNode* head;
+    unsigned long size;
+    SkipListArenaChunk* chunks;                      // newest first
+    SkipListNode* freeTowers[SKIPLIST_MAX_LEVEL + 1]; // by height, chained through links[0].next
+    uint64_t random;
+} SkipList;
+
+/* Arena helpers **************************************************************/
+static unsigned long __skipListTowerUnits(unsigned int height) {
+    size_t bytes = sizeof(SkipListNode) + height * sizeof(SkipListLink);
+    return (bytes + sizeof(max_align_t) - 1) / sizeof(max_align_t);
+}
+
+static SkipListNode* __skipListAllocTower(SkipList* list, unsigned int height) {
+    SkipListNode* node = list->freeTowers[height];
+    if (node != NULL) {
+        list->freeTowers[height] = node->links[0].next;
+        return node;
+    }
+
+    unsigned long units = __skipListTowerUnits(height);
+    if (list->chunks == NULL || list->chunks->used + units > SKIPLIST_ARENA_CHUNK_UNITS) {
+        SkipListArenaChunk* chunk = malloc(SKIPLIST_ARENA_CHUNK_BYTES);
+        if (chunk == NULL) {
+            fprintf(stderr, "ERROR: failed to allocate memory for SkipList arena chunk.\n");
+            return NULL;
+        }
+        chunk->next = list->chunks;
+        chunk->used = 0;
+        list->chunks = chunk;
+    }
+
+    node = (SkipListNode*)&list->chunks->data[list->chunks->used];
+    list->chunks->used += units;
+    node->height = height;
+    return node;
+}
+
+static void __skipListFreeTower(SkipList* list, SkipListNode* node) {
+    node->links[0].next = list->freeTowers[node->height];
+    list->freeTowers[node->height] = node;
+}
+
+static void __skipListReleaseArena(SkipList* list) {
+    SkipListArenaChunk* chunk = list->chunks;
+    while (chunk != NULL) {
+        SkipListArenaChunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    list->chunks = NULL;
+    for (unsigned int h = 0; h <= SKIPLIST_MAX_LEVEL; ++h) list->freeTowers[h] = NULL;
+}
+/* End arena helpers **********************************************************/
+
+// Allocates an empty head tower; every link points at the end sentinel
+static bool __skipListResetHead(SkipList* list) {
+    list->head = __skipListAllocTower(list, SKIPLIST_MAX_LEVEL);
+    if (list->head == NULL) return false;
+
+    for (unsigned int l = 0; l < SKIPLIST_MAX_LEVEL; ++l) {
+        list->head->links[l].next = NULL;
+        list->head->links[l].width = 1;
+    }
+    list->size = 0;
+    return true;
+}
+
+// xorshift64*; two random bits per level gives p = 1/4
+static unsigned int __skipListRandomHeight(SkipList* list) {
+    list->random ^= list->random >> 12;
+    list->random ^= list->random << 25;
+    list->random ^= list->random >> 27;
+    uint64_t bits = list->random * 0x2545F4914F6CDD1DULL;
+
+    unsigned int height = 1;
+    while (height < SKIPLIST_MAX_LEVEL && (bits & 3) == 0) {
+        height++;
+        bits >>= 2;
+    }
+    return height;
+}
+
+/******************************************************************************
+* skipListInit
+*
+* parameters:
+*  - seed : uint64_t ; seeds the tower heights, 0 for a fixed default
+*
+* returns: SkipList*
+*
+* description: initializes an empty skip list
+*
+******************************************************************************/
+SkipList* skipListInit(uint64_t seed) {
+    SkipList* list = malloc(sizeof(SkipList));
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for SkipList.\n");
+        return NULL;
+    }
+
+    list->chunks = NULL;
+    for (unsigned int h = 0; h <= SKIPLIST_MAX_LEVEL; ++h) list->freeTowers[h] = NULL;
+    list->random = (seed != 0) ? seed : 0x9E3779B97F4A7C15ULL;
+
+    if (!__skipListResetHead(list)) {
+        free(list);
+        return NULL;
+    }
+    return list;
+}
+
+/******************************************************************************
+* skipListDestroy
+*
+* parameters:
+*  - list : SkipList*
+*
+* returns: none
+*
+* description: frees the arena and the list
+*
+******************************************************************************/
+void skipListDestroy(SkipList* list) {
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: attempted to destroy NULL SkipList.\n");
+        return;
+    }
+
+    __skipListReleaseArena(list);
+    free(list);
+}
+
+/******************************************************************************
+* skipListClear
+*
+* parameters:
+*  - list : SkipList*
+*
+* returns: none
+*
+* description: removes every element by releasing the arena
+*
+******************************************************************************/
+void skipListClear(SkipList* list) {
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: attempted to clear NULL SkipList*.\n");
+        return;
+    }
+
+    __skipListReleaseArena(list);
+    __skipListResetHead(list);
+}
+
+/******************************************************************************
+* skipListSize / skipListEmpty
+*
+* parameters:
+*  - list : SkipList*
+*
+* returns: unsigned long / bool
+*
+* description: number of elements / whether there are none
+*
+******************************************************************************/
+unsigned long skipListSize(SkipList* list) {
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: attempted to access size of NULL SkipList*.\n");
+        return 0;
+    }
+
+    return list->size;
+}
+
+bool skipListEmpty(SkipList* list) {
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: attempted to access size of NULL SkipList*.\n");
+        return false;
+    }
+
+    return list->size == 0;
+}
+
+/******************************************************************************
+* skipListInsert
+*
+* parameters:
+*  - list : SkipList*
+*  - key : SKIPLIST_TYPE
+*
+* returns: bool ; success status
+*
+* description: inserts key after any equal keys. On the way down, update[l]
+*              is the last node at level l before the new one and rank[l]
+*              its position; the new node's widths are split off from
+*              update[l]'s, and links passing over it grow by one.
+*
+******************************************************************************/
+bool skipListInsert(SkipList* list, SKIPLIST_TYPE key) {
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: attempted to add element to NULL SkipList*.\n");
+        return false;
+    }
+
+    SkipListNode* update[SKIPLIST_MAX_LEVEL];
+    unsigned long rank[SKIPLIST_MAX_LEVEL];
+    SkipListNode* x = list->head;
+    unsigned long position = 0;
+
+    for (int l = SKIPLIST_MAX_LEVEL - 1; l >= 0; --l) {
+        while (x->links[l].next != NULL && !SKIPLIST_LESS(key, x->links[l].next->key)) {
+            position += x->links[l].width;
+            x = x->links[l].next;
+        }
+        update[l] = x;
+        rank[l] = position;
+    }
+
+    unsigned int height = __skipListRandomHeight(list);
+    SkipListNode* node = __skipListAllocTower(list, height);
+    if (node == NULL) return false;
+    node->key = key;
+
+    for (unsigned int l = 0; l < SKIPLIST_MAX_LEVEL; ++l) {
+        if (l < height) {
+            node->links[l].next = update[l]->links[l].next;
+            node->links[l].width = update[l]->links[l].width - (position - rank[l]);
+            update[l]->links[l].next = node;
+            update[l]->links[l].width = position - rank[l] + 1;
+        }
+        else {
+            update[l]->links[l].width++;
+        }
+    }
+
+    list->size++;
+    return true;
+}
+
+/******************************************************************************
+* skipListErase
+*
+* parameters:
+*  - list : SkipList*
+*  - key : SKIPLIST_TYPE
+*
+* returns: bool ; false if key was not present
+*
+* description: removes the first element equal to key
+*
+******************************************************************************/
+bool skipListErase(SkipList* list, SKIPLIST_TYPE key) {
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: attempted to erase from NULL SkipList*.\n");
+        return false;
+    }
+
+    SkipListNode* update[SKIPLIST_MAX_LEVEL];
+    SkipListNode* x = list->head;
+
+    for (int l = SKIPLIST_MAX_LEVEL - 1; l >= 0; --l) {
+        while (x->links[l].next != NULL && SKIPLIST_LESS(x->links[l].next->key, key)) {
+            x = x->links[l].next;
+        }
+        update[l] = x;
+    }
+
+    SkipListNode* target = update[0]->links[0].next;
+    if (target == NULL || SKIPLIST_LESS(key, target->key)) return false;
+
+    for (unsigned int l = 0; l < SKIPLIST_MAX_LEVEL; ++l) {
+        if (update[l]->links[l].next == target) {
+            update[l]->links[l].width += target->links[l].width - 1;
+            update[l]->links[l].next = target->links[l].next;
+        }
+        else {
+            update[l]->links[l].width--;
+        }
+    }
+
+    __skipListFreeTower(list, target);
+    list->size--;
+    return true;
+}
+
+/******************************************************************************
+* skipListLowerBound
+*
+* parameters:
+*  - list : SkipList*
+*  - key : SKIPLIST_TYPE
+*
+* returns: SkipListNode* ; first node not less than key, NULL if none
+*
+* description: walk the level 0 links from the result for ordered iteration
+*
+******************************************************************************/
+SkipListNode* skipListLowerBound(SkipList* list, SKIPLIST_TYPE key) {
+    SkipListNode* x = list->head;
+    for (int l = SKIPLIST_MAX_LEVEL - 1; l >= 0; --l) {
+        while (x->links[l].next != NULL && SKIPLIST_LESS(x->links[l].next->key, key)) {
+            x = x->links[l].next;
+        }
+    }
+    return x->links[0].next;
+}
+
+/******************************************************************************
+* skipListContains
+*
+* parameters:
+*  - list : SkipList*
+*  - key : SKIPLIST_TYPE
+*
+* returns: bool
+*
+* description: whether an element equal to key is present
+*
+******************************************************************************/
+bool skipListContains(SkipList* list, SKIPLIST_TYPE key) {
+    SkipListNode* node = skipListLowerBound(list, key);
+    return node != NULL && !SKIPLIST_LESS(key, node->key);
+}
+
+/******************************************************************************
+* skipListRank
+*
+* parameters:
+*  - list : SkipList*
+*  - key : SKIPLIST_TYPE
+*
+* returns: unsigned long
+*
+* description: number of elements less than key, which is also the position
+*              key has or would be inserted at
+*
+******************************************************************************/
+unsigned long skipListRank(SkipList* list, SKIPLIST_TYPE key) {
+    SkipListNode* x = list->head;
+    unsigned long position = 0;
+
+    for (int l = SKIPLIST_MAX_LEVEL - 1; l >= 0; --l) {
+        while (x->links[l].next != NULL && SKIPLIST_LESS(x->links[l].next->key, key)) {
+            position += x->links[l].width;
+            x = x->links[l].next;
+        }
+    }
+    return position;
+}
+
+/******************************************************************************
+* skipListAt
+*
+* parameters:
+*  - list : SkipList*
+*  - index : unsigned long ; 0-based position in sorted order
+*
+* returns: SKIPLIST_TYPE* ; NULL if out of bounds
+*
+* description: follows links whose widths don't overshoot index + 1, so it
+*              takes O(log n) steps instead of LinkedList's O(n)
+*
+******************************************************************************/
+SKIPLIST_TYPE* skipListAt(SkipList* list, unsigned long index) {
+    if (index >= list->size) {
+        fprintf(stderr, "Error: index out of bounds\n");
+        return NULL;
+    }
+
+    unsigned long target = index + 1;
+    unsigned long position = 0;
+    SkipListNode* x = list->head;
+
+    for (int l = SKIPLIST_MAX_LEVEL - 1; l >= 0; --l) {
+        while (x->links[l].next != NULL && position + x->links[l].width <= target) {
+            position += x->links[l].width;
+            x = x->links[l].next;
+        }
+    }
+    return &x->key;
+}
+
+/******************************************************************************
+* skipListToString
+*
+* parameters:
+*  - list : SkipList*
+*
+* returns: none
+*
+* description: prints the elements in order
+*
+******************************************************************************/
+void skipListToString(SkipList* list) {
+    printf("[ ");
+    for (SkipListNode* node = list->head->links[0].next; node != NULL; node = node->links[0].next) {
+        printf("%d", node->key);
+        if (node->links[0].next != NULL) printf(", ");
+    }
+    printf(" ]\n");
+}
+
+#endif /* SKIPLIST_H */
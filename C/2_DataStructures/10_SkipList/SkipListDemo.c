@@ -0,0 +1,28 @@
+#include <stdio.h>
+
+#include "SkipList.h"
+#include "SkipListTest.h"
+
+int main() {
+    SkipList* list = skipListInit(0);
+    if (list == NULL) return 1;
+
+    int values[] = { 42, 7, 19, 3, 88, 19, 56 };
+    for (unsigned long i = 0; i < sizeof(values) / sizeof(values[0]); ++i) {
+        skipListInsert(list, values[i]);
+    }
+    skipListToString(list);
+
+    // Random access in O(log n) instead of linkedListAt's O(n)
+    printf("Element at index 3: %d\n", *skipListAt(list, 3));
+    printf("Elements less than 50: %lu\n", skipListRank(list, 50));
+    printf("Contains 19: %s\n", skipListContains(list, 19) ? "yes" : "no");
+
+    skipListErase(list, 19);
+    skipListErase(list, 88);
+    skipListToString(list);
+
+    skipListDestroy(list);
+
+    runSkipListTests();
+}
\ No newline at end of file
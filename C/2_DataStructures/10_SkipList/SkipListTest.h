@@ -0,0 +1,299 @@
+#ifndef SKIPLISTTEST_H
+#define SKIPLISTTEST_H
+
+#include <pthread.h>
+
+#include "SkipList.h"
+#include "ConcurrentSkipList.h"
+#include "TestsSummary.h"
+
+/* Testing functions **********************************************************/
+void testSkipListInsertOrder();
+void testSkipListRankAt();
+void testSkipListErase();
+void testSkipListTowerReuse();
+void testConcurrentSkipListInsert();
+void testConcurrentSkipListEraseRevive();
+/* End testing functions ******************************************************/
+
+/* Test setup/teardown functions **********************************************/
+SkipList* SetUp() {
+    return skipListInit(12345);
+}
+
+void TearDown(SkipList* list) {
+    skipListDestroy(list);
+}
+/* End test setup/teardown functions ******************************************/
+
+#define SKIPLIST_TEST_THREADS 4
+#define SKIPLIST_TEST_KEYS_PER_THREAD 20000
+
+// These tests assume SKIPLIST_TYPE and CONCURRENTSKIPLIST_TYPE are int
+void runSkipListTests() {
+    TestsSummaryPrintHeader("SkipList");
+
+    testSkipListInsertOrder();
+    testSkipListRankAt();
+    testSkipListErase();
+    testSkipListTowerReuse();
+    testConcurrentSkipListInsert();
+    testConcurrentSkipListEraseRevive();
+
+    TestsSummaryPrintFooter("SkipList");
+}
+
+// Level 0 is sorted, and skipListAt agrees with a plain level 0 walk at
+// every position (i.e. every width is right)
+bool __skipListIsConsistent(SkipList* list) {
+    unsigned long position = 0;
+    for (SkipListNode* node = list->head->links[0].next; node != NULL; node = node->links[0].next) {
+        if (node->links[0].next != NULL && SKIPLIST_LESS(node->links[0].next->key, node->key)) return false;
+        if (skipListAt(list, position) != &node->key) return false;
+        position++;
+    }
+    return position == list->size;
+}
+
+void testSkipListInsertOrder() {
+    SkipList* list = SetUp();
+    int successes = 0, failures = 0;
+
+    // a permutation of 0..999
+    for (int i = 0; i < 1000; ++i) skipListInsert(list, (i * 7919) % 1000);
+
+    if (skipListSize(list) != 1000 || !__skipListIsConsistent(list) || *skipListAt(list, 0) != 0) {
+        printf("FAILED: testSkipListInsertOrder: elements out of order\n");
+        failures++;
+    }
+    else successes++;
+
+    if (!skipListContains(list, 500) || skipListContains(list, 1000) || skipListContains(list, -1)) {
+        printf("FAILED: testSkipListInsertOrder: wrong membership\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("SkipListInsertOrder", successes, failures);
+    TearDown(list);
+}
+
+void testSkipListRankAt() {
+    SkipList* list = SetUp();
+    int successes = 0, failures = 0;
+
+    // even numbers 0..1998, with 3 copies of 1000
+    for (int i = 0; i < 1000; ++i) skipListInsert(list, i * 2);
+    skipListInsert(list, 1000);
+    skipListInsert(list, 1000);
+
+    bool ranksMatch = true;
+    for (int i = 0; i < 500; ++i) {
+        if (skipListRank(list, i * 2) != (unsigned long)i || skipListRank(list, i * 2 + 1) != (unsigned long)i + 1) {
+            ranksMatch = false;
+        }
+    }
+    if (!ranksMatch || skipListRank(list, 1001) != 503 || skipListRank(list, 5000) != skipListSize(list)) {
+        printf("FAILED: testSkipListRankAt: wrong rank\n");
+        failures++;
+    }
+    else successes++;
+
+    if (*skipListAt(list, 500) != 1000 || *skipListAt(list, 502) != 1000 || *skipListAt(list, 503) != 1002
+        || skipListAt(list, skipListSize(list)) != NULL) {
+        printf("FAILED: testSkipListRankAt: wrong element at position\n");
+        failures++;
+    }
+    else successes++;
+
+    if (!__skipListIsConsistent(list)) {
+        printf("FAILED: testSkipListRankAt: widths inconsistent\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("SkipListRankAt", successes, failures);
+    TearDown(list);
+}
+
+void testSkipListErase() {
+    SkipList* list = SetUp();
+    int successes = 0, failures = 0;
+
+    for (int i = 0; i < 2000; ++i) skipListInsert(list, i);
+    for (int i = 0; i < 2000; i += 3) skipListErase(list, i);
+
+    bool erasedCorrectly = true;
+    for (int i = 0; i < 2000; ++i) {
+        if (skipListContains(list, i) != (i % 3 != 0)) erasedCorrectly = false;
+    }
+    if (!erasedCorrectly || skipListSize(list) != 1333 || !__skipListIsConsistent(list)) {
+        printf("FAILED: testSkipListErase: wrong contents after erase\n");
+        failures++;
+    }
+    else successes++;
+
+    if (skipListErase(list, 3) || skipListErase(list, 5000)) {
+        printf("FAILED: testSkipListErase: erased a missing key\n");
+        failures++;
+    }
+    else successes++;
+
+    skipListClear(list);
+    skipListInsert(list, 9);
+    if (skipListSize(list) != 1 || *skipListAt(list, 0) != 9) {
+        printf("FAILED: testSkipListErase: list unusable after clear\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("SkipListErase", successes, failures);
+    TearDown(list);
+}
+
+void testSkipListTowerReuse() {
+    SkipList* list = SetUp();
+    int successes = 0, failures = 0;
+
+    for (int i = 0; i < 1000; ++i) skipListInsert(list, i);
+    SkipListArenaChunk* chunksBefore = list->chunks;
+    unsigned long usedBefore = list->chunks->used;
+
+    // erase and reinsert: towers come back off the free lists. Heights are
+    // random, so a round can draw more towers of some height than were freed;
+    // allow a little arena growth for those, far short of 10 more rounds' worth.
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 1000; ++i) skipListErase(list, i);
+        for (int i = 0; i < 1000; ++i) skipListInsert(list, i);
+    }
+
+    if (list->chunks != chunksBefore || list->chunks->used > usedBefore + usedBefore / 4) {
+        printf("FAILED: testSkipListTowerReuse: arena kept growing under churn\n");
+        failures++;
+    }
+    else successes++;
+
+    if (!__skipListIsConsistent(list) || skipListSize(list) != 1000) {
+        printf("FAILED: testSkipListTowerReuse: wrong contents after churn\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("SkipListTowerReuse", successes, failures);
+    TearDown(list);
+}
+
+typedef struct {
+    ConcurrentSkipList* list;
+    int thread;
+} __SkipListTestWorker;
+
+// thread t inserts t, t + THREADS, t + 2 * THREADS, ... so neighbors interleave
+static void* __skipListTestInserter(void* arg) {
+    __SkipListTestWorker* worker = arg;
+    for (int i = 0; i < SKIPLIST_TEST_KEYS_PER_THREAD; ++i) {
+        concurrentSkipListInsert(worker->list, i * SKIPLIST_TEST_THREADS + worker->thread);
+    }
+    return NULL;
+}
+
+void testConcurrentSkipListInsert() {
+    ConcurrentSkipList* list = concurrentSkipListInit();
+    int successes = 0, failures = 0;
+
+    pthread_t threads[SKIPLIST_TEST_THREADS];
+    __SkipListTestWorker workers[SKIPLIST_TEST_THREADS];
+    for (int t = 0; t < SKIPLIST_TEST_THREADS; ++t) {
+        workers[t] = (__SkipListTestWorker){ list, t };
+        pthread_create(&threads[t], NULL, __skipListTestInserter, &workers[t]);
+    }
+    for (int t = 0; t < SKIPLIST_TEST_THREADS; ++t) pthread_join(threads[t], NULL);
+
+    const int total = SKIPLIST_TEST_THREADS * SKIPLIST_TEST_KEYS_PER_THREAD;
+    int expected = 0;
+    bool inOrder = true;
+    for (ConcurrentSkipListNode* node = atomic_load(&list->head->next[0]); node != NULL;
+         node = atomic_load(&node->next[0])) {
+        if (node->key != expected++) inOrder = false;
+    }
+    if (!inOrder || expected != total || concurrentSkipListSize(list) != (unsigned long)total) {
+        printf("FAILED: testConcurrentSkipListInsert: level 0 is not 0..%d in order\n", total - 1);
+        failures++;
+    }
+    else successes++;
+
+    // every upper level is a sorted subsequence of level 0
+    bool levelsSorted = true;
+    for (int l = 1; l < CONCURRENTSKIPLIST_MAX_LEVEL; ++l) {
+        ConcurrentSkipListNode* node = atomic_load(&list->head->next[l]);
+        while (node != NULL) {
+            ConcurrentSkipListNode* next = atomic_load(&node->next[l]);
+            if (next != NULL && !CONCURRENTSKIPLIST_LESS(node->key, next->key)) levelsSorted = false;
+            node = next;
+        }
+    }
+    if (!levelsSorted || concurrentSkipListInsert(list, 42)) {
+        printf("FAILED: testConcurrentSkipListInsert: upper levels unsorted or duplicate accepted\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("ConcurrentSkipListInsert", successes, failures);
+    concurrentSkipListDestroy(list);
+}
+
+// even threads erase their keys while odd threads insert new ones
+static void* __skipListTestMixed(void* arg) {
+    __SkipListTestWorker* worker = arg;
+    for (int i = 0; i < SKIPLIST_TEST_KEYS_PER_THREAD; ++i) {
+        int key = i * SKIPLIST_TEST_THREADS + worker->thread;
+        if (worker->thread % 2 == 0) concurrentSkipListErase(worker->list, key);
+        else concurrentSkipListInsert(worker->list, key);
+    }
+    return NULL;
+}
+
+void testConcurrentSkipListEraseRevive() {
+    ConcurrentSkipList* list = concurrentSkipListInit();
+    int successes = 0, failures = 0;
+
+    // keys owned by even threads start present
+    for (int i = 0; i < SKIPLIST_TEST_KEYS_PER_THREAD; ++i) {
+        for (int t = 0; t < SKIPLIST_TEST_THREADS; t += 2) {
+            concurrentSkipListInsert(list, i * SKIPLIST_TEST_THREADS + t);
+        }
+    }
+
+    pthread_t threads[SKIPLIST_TEST_THREADS];
+    __SkipListTestWorker workers[SKIPLIST_TEST_THREADS];
+    for (int t = 0; t < SKIPLIST_TEST_THREADS; ++t) {
+        workers[t] = (__SkipListTestWorker){ list, t };
+        pthread_create(&threads[t], NULL, __skipListTestMixed, &workers[t]);
+    }
+    for (int t = 0; t < SKIPLIST_TEST_THREADS; ++t) pthread_join(threads[t], NULL);
+
+    bool correct = true;
+    const int total = SKIPLIST_TEST_THREADS * SKIPLIST_TEST_KEYS_PER_THREAD;
+    for (int key = 0; key < total; ++key) {
+        bool odd = (key % SKIPLIST_TEST_THREADS) % 2 == 1;
+        if (concurrentSkipListContains(list, key) != odd) correct = false;
+    }
+    if (!correct || concurrentSkipListSize(list) != (unsigned long)total / 2) {
+        printf("FAILED: testConcurrentSkipListEraseRevive: wrong membership after mixed run\n");
+        failures++;
+    }
+    else successes++;
+
+    // an erased key can be inserted again
+    if (!concurrentSkipListInsert(list, 0) || !concurrentSkipListContains(list, 0)
+        || concurrentSkipListErase(list, 1 + total * 2)) {
+        printf("FAILED: testConcurrentSkipListEraseRevive: revive or missing erase misbehaved\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("ConcurrentSkipListEraseRevive", successes, failures);
+    concurrentSkipListDestroy(list);
+}
+
+#endif /* SKIPLISTTEST_H */
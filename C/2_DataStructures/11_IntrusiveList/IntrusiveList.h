@@ -0,0 +1,264 @@
+#ifndef INTRUSIVELIST_H
+#define INTRUSIVELIST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/******************************************************************************
+* IntrusiveList
+*
+* implementation: circular doubly-linked list whose links live inside the
+*                 user's own structs. Nothing is allocated: a struct embeds
+*                 one IntrusiveLink per list it can be on, and container_of
+*                 gets from a link back to the struct. One object can sit on
+*                 several lists at once (say, per-server and per-severity)
+*                 with a single allocation and no extra hop to the payload.
+*
+*                 The list head is a sentinel link, so insert and remove
+*                 never special-case the ends. An unlinked link has NULL
+*                 prev/next, which is how intrusiveLinkIsLinked tells.
+*
+* usage:
+*     typedef struct {
+*         EventLog log;
+*         IntrusiveLink byServer;
+*         IntrusiveLink bySeverity;
+*     } TrackedEvent;
+*
+*     intrusiveListPushBack(&serverList, &event->byServer);
+*     INTRUSIVE_LIST_FOR_EACH_ENTRY(&serverList, event, TrackedEvent, byServer) { ... }
+*
+* structures
+*  - IntrusiveLink: prev/next, embedded in the user's struct
+*  - IntrusiveList: sentinel link and size
+*
+******************************************************************************/
+
+typedef struct IntrusiveLink {
+    struct IntrusiveLink* prev;
+    struct IntrusiveLink* next;
+} IntrusiveLink;
+
+typedef struct IntrusiveList {
+    IntrusiveLink head;
+    unsigned long size;
+} IntrusiveList;
+
+// Pointer to the struct of the given type whose member ptr points at.
+// Goes through void* so -Wcast-align=strict accepts the cast back.
+#ifndef container_of
+#define container_of(ptr, type, member) \
+    ((type*)(void*)((char*)(ptr) - offsetof(type, member)))
+#endif
+
+// Struct holding link, or NULL if link is NULL
+#define INTRUSIVE_LIST_ENTRY(link, type, member) \
+    ((link) != NULL ? container_of(link, type, member) : NULL)
+
+// Iterate links; the current link must not be removed inside the loop
+#define INTRUSIVE_LIST_FOR_EACH(list, link) \
+    for (IntrusiveLink* link = (list)->head.next; link != &(list)->head; link = link->next)
+
+// Iterate links; the current link may be removed inside the loop
+#define INTRUSIVE_LIST_FOR_EACH_SAFE(list, link, nextLink)                     \
+    for (IntrusiveLink* link = (list)->head.next, *nextLink = link->next;      \
+         link != &(list)->head; link = nextLink, nextLink = link->next)
+
+// Iterate the structs on the list; entry is declared as type*
+#define INTRUSIVE_LIST_FOR_EACH_ENTRY(list, entry, type, member)               \
+    for (type* entry = container_of((list)->head.next, type, member);          \
+         &entry->member != &(list)->head;                                      \
+         entry = container_of(entry->member.next, type, member))
+
+/******************************************************************************
+* intrusiveListInit
+*
+* parameters:
+*  - list : IntrusiveList* ; usually embedded or on the stack
+*
+* returns: none
+*
+* description: makes list empty: the sentinel points at itself
+*
+******************************************************************************/
+void intrusiveListInit(IntrusiveList* list) {
+    list->head.prev = &list->head;
+    list->head.next = &list->head;
+    list->size = 0;
+}
+
+/******************************************************************************
+* intrusiveLinkInit / intrusiveLinkIsLinked
+*
+* parameters:
+*  - link : IntrusiveLink*
+*
+* returns: none / bool
+*
+* description: marks a link as on no list / whether it is on one
+*
+******************************************************************************/
+void intrusiveLinkInit(IntrusiveLink* link) {
+    link->prev = NULL;
+    link->next = NULL;
+}
+
+bool intrusiveLinkIsLinked(const IntrusiveLink* link) {
+    return link->next != NULL;
+}
+
+/******************************************************************************
+* intrusiveListSize / intrusiveListEmpty
+*
+* parameters:
+*  - list : IntrusiveList*
+*
+* returns: unsigned long / bool
+*
+* description: number of links on the list / whether there are none
+*
+******************************************************************************/
+unsigned long intrusiveListSize(IntrusiveList* list) {
+    return list->size;
+}
+
+bool intrusiveListEmpty(IntrusiveList* list) {
+    return list->head.next == &list->head;
+}
+
+/******************************************************************************
+* intrusiveListInsertBefore
+*
+* parameters:
+*  - list : IntrusiveList*
+*  - pos : IntrusiveLink* ; a link on list, or &list->head for the back
+*  - link : IntrusiveLink* ; not on any list through this member
+*
+* returns: bool ; false if link is already linked
+*
+* description: links link in front of pos, O(1)
+*
+******************************************************************************/
+bool intrusiveListInsertBefore(IntrusiveList* list, IntrusiveLink* pos, IntrusiveLink* link) {
+    if (intrusiveLinkIsLinked(link)) {
+        fprintf(stderr, "ERROR: attempted to insert a link that is already on a list.\n");
+        return false;
+    }
+
+    link->prev = pos->prev;
+    link->next = pos;
+    pos->prev->next = link;
+    pos->prev = link;
+    list->size++;
+    return true;
+}
+
+/******************************************************************************
+* intrusiveListPushBack / intrusiveListPushFront
+*
+* parameters:
+*  - list : IntrusiveList*
+*  - link : IntrusiveLink*
+*
+* returns: bool ; false if link is already linked
+*
+* description: links link at the back / front
+*
+******************************************************************************/
+bool intrusiveListPushBack(IntrusiveList* list, IntrusiveLink* link) {
+    return intrusiveListInsertBefore(list, &list->head, link);
+}
+
+bool intrusiveListPushFront(IntrusiveList* list, IntrusiveLink* link) {
+    return intrusiveListInsertBefore(list, list->head.next, link);
+}
+
+/******************************************************************************
+* intrusiveListRemove
+*
+* parameters:
+*  - list : IntrusiveList* ; the list link is on
+*  - link : IntrusiveLink*
+*
+* returns: none
+*
+* description: unlinks link in O(1) without searching; the object itself is
+*              untouched and stays on any other lists
+*
+******************************************************************************/
+void intrusiveListRemove(IntrusiveList* list, IntrusiveLink* link) {
+    if (!intrusiveLinkIsLinked(link)) {
+        fprintf(stderr, "ERROR: attempted to remove a link that is not on a list.\n");
+        return;
+    }
+
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    intrusiveLinkInit(link);
+    list->size--;
+}
+
+/******************************************************************************
+* intrusiveListFront / intrusiveListBack
+*
+* parameters:
+*  - list : IntrusiveList*
+*
+* returns: IntrusiveLink* ; NULL if empty
+*
+* description: first / last link; pair with INTRUSIVE_LIST_ENTRY
+*
+******************************************************************************/
+IntrusiveLink* intrusiveListFront(IntrusiveList* list) {
+    return intrusiveListEmpty(list) ? NULL : list->head.next;
+}
+
+IntrusiveLink* intrusiveListBack(IntrusiveList* list) {
+    return intrusiveListEmpty(list) ? NULL : list->head.prev;
+}
+
+/******************************************************************************
+* intrusiveListPopFront / intrusiveListPopBack
+*
+* parameters:
+*  - list : IntrusiveList*
+*
+* returns: IntrusiveLink* ; the unlinked link, NULL if empty
+*
+* description: unlinks and returns the first / last link
+*
+******************************************************************************/
+IntrusiveLink* intrusiveListPopFront(IntrusiveList* list) {
+    IntrusiveLink* link = intrusiveListFront(list);
+    if (link != NULL) intrusiveListRemove(list, link);
+    return link;
+}
+
+IntrusiveLink* intrusiveListPopBack(IntrusiveList* list) {
+    IntrusiveLink* link = intrusiveListBack(list);
+    if (link != NULL) intrusiveListRemove(list, link);
+    return link;
+}
+
+/******************************************************************************
+* intrusiveListClear
+*
+* parameters:
+*  - list : IntrusiveList*
+*
+* returns: none
+*
+* description: unlinks every link so each can go on a list again; frees
+*              nothing, the objects belong to the caller
+*
+******************************************************************************/
+void intrusiveListClear(IntrusiveList* list) {
+    INTRUSIVE_LIST_FOR_EACH_SAFE(list, link, nextLink) {
+        intrusiveLinkInit(link);
+    }
+    intrusiveListInit(list);
+}
+
+#endif /* INTRUSIVELIST_H */
@@ -0,0 +1,65 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "IntrusiveList.h"
+#include "IntrusiveListTest.h"
+
+// Same fields as EventLog in 4_BasicIO/1_FileIO/FormattedText.h, plus one
+// link per list an event can be on
+typedef struct {
+    int eventId;
+    int serverId;
+    char timestamp[20];
+    char type[10];
+    char message[100];
+
+    IntrusiveLink byServer;
+    IntrusiveLink byType;
+} TrackedEvent;
+
+#define DEMO_SERVERS 2
+
+int main() {
+    TrackedEvent events[] = {
+        { 1001, 1, "2024-01-10 08:15:00", "INFO",    "Server started" },
+        { 1002, 2, "2024-01-10 08:20:00", "WARNING", "High memory usage" },
+        { 1003, 1, "2024-01-10 09:00:00", "ERROR",   "Disk failure" },
+        { 1004, 2, "2024-01-10 09:30:00", "ERROR",   "Service timeout" },
+        { 1005, 1, "2024-01-10 10:00:00", "INFO",    "Backup complete" },
+    };
+    const int eventCount = sizeof(events) / sizeof(events[0]);
+
+    IntrusiveList byServer[DEMO_SERVERS + 1];
+    IntrusiveList errors;
+    for (int s = 0; s <= DEMO_SERVERS; ++s) intrusiveListInit(&byServer[s]);
+    intrusiveListInit(&errors);
+
+    // One object, two lists, zero extra allocations
+    for (int i = 0; i < eventCount; ++i) {
+        intrusiveLinkInit(&events[i].byServer);
+        intrusiveLinkInit(&events[i].byType);
+        intrusiveListPushBack(&byServer[events[i].serverId], &events[i].byServer);
+        if (strcmp(events[i].type, "ERROR") == 0) intrusiveListPushBack(&errors, &events[i].byType);
+    }
+
+    for (int s = 1; s <= DEMO_SERVERS; ++s) {
+        printf("Server %d:", s);
+        INTRUSIVE_LIST_FOR_EACH_ENTRY(&byServer[s], event, TrackedEvent, byServer) {
+            printf(" EVT%d", event->eventId);
+        }
+        printf("\n");
+    }
+
+    printf("Errors:");
+    INTRUSIVE_LIST_FOR_EACH_ENTRY(&errors, event, TrackedEvent, byType) {
+        printf(" EVT%d (%s)", event->eventId, event->message);
+    }
+    printf("\n");
+
+    // Resolving an error takes it off the error list only
+    intrusiveListRemove(&errors, &events[2].byType);
+    printf("Errors after resolving EVT1003: %lu, server 1 still has %lu events\n",
+           intrusiveListSize(&errors), intrusiveListSize(&byServer[1]));
+
+    runIntrusiveListTests();
+}
\ No newline at end of file
@@ -0,0 +1,186 @@
+#ifndef INTRUSIVELISTTEST_H
+#define INTRUSIVELISTTEST_H
+
+#include "IntrusiveList.h"
+#include "TestsSummary.h"
+
+/* Testing functions **********************************************************/
+void testIntrusiveListPushPop();
+void testIntrusiveListContainerOf();
+void testIntrusiveListMultipleLists();
+void testIntrusiveListRemoveWhileIterating();
+/* End testing functions ******************************************************/
+
+typedef struct {
+    int value;
+    IntrusiveLink first;
+    IntrusiveLink second;
+} __IntrusiveTestItem;
+
+void __intrusiveTestItemsInit(__IntrusiveTestItem* items, int count) {
+    for (int i = 0; i < count; ++i) {
+        items[i].value = i;
+        intrusiveLinkInit(&items[i].first);
+        intrusiveLinkInit(&items[i].second);
+    }
+}
+
+void runIntrusiveListTests() {
+    TestsSummaryPrintHeader("IntrusiveList");
+
+    testIntrusiveListPushPop();
+    testIntrusiveListContainerOf();
+    testIntrusiveListMultipleLists();
+    testIntrusiveListRemoveWhileIterating();
+
+    TestsSummaryPrintFooter("IntrusiveList");
+}
+
+void testIntrusiveListPushPop() {
+    IntrusiveList list;
+    __IntrusiveTestItem items[3];
+    int successes = 0, failures = 0;
+
+    intrusiveListInit(&list);
+    __intrusiveTestItemsInit(items, 3);
+
+    intrusiveListPushBack(&list, &items[1].first);
+    intrusiveListPushBack(&list, &items[2].first);
+    intrusiveListPushFront(&list, &items[0].first);
+
+    if (intrusiveListSize(&list) != 3 || intrusiveListFront(&list) != &items[0].first
+        || intrusiveListBack(&list) != &items[2].first) {
+        printf("FAILED: testIntrusiveListPushPop: expected items 0, 1, 2\n");
+        failures++;
+    }
+    else successes++;
+
+    // a linked link can't be pushed again
+    if (intrusiveListPushBack(&list, &items[1].first)) {
+        printf("FAILED: testIntrusiveListPushPop: allowed pushing a linked link\n");
+        failures++;
+    }
+    else successes++;
+
+    IntrusiveLink* popped = intrusiveListPopBack(&list);
+    intrusiveListPopFront(&list);
+    if (popped != &items[2].first || intrusiveLinkIsLinked(popped) || intrusiveListFront(&list) != &items[1].first
+        || intrusiveListSize(&list) != 1) {
+        printf("FAILED: testIntrusiveListPushPop: wrong state after pops\n");
+        failures++;
+    }
+    else successes++;
+
+    intrusiveListPopFront(&list);
+    if (!intrusiveListEmpty(&list) || intrusiveListPopFront(&list) != NULL || intrusiveListBack(&list) != NULL) {
+        printf("FAILED: testIntrusiveListPushPop: expected empty list\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("IntrusiveListPushPop", successes, failures);
+}
+
+void testIntrusiveListContainerOf() {
+    __IntrusiveTestItem item;
+    int successes = 0, failures = 0;
+
+    if (container_of(&item.first, __IntrusiveTestItem, first) != &item
+        || container_of(&item.second, __IntrusiveTestItem, second) != &item) {
+        printf("FAILED: testIntrusiveListContainerOf: wrong containing struct\n");
+        failures++;
+    }
+    else successes++;
+
+    IntrusiveLink* nothing = NULL;
+    if (INTRUSIVE_LIST_ENTRY(nothing, __IntrusiveTestItem, first) != NULL) {
+        printf("FAILED: testIntrusiveListContainerOf: NULL link should give NULL entry\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("IntrusiveListContainerOf", successes, failures);
+}
+
+void testIntrusiveListMultipleLists() {
+    IntrusiveList all, evens;
+    __IntrusiveTestItem items[6];
+    int successes = 0, failures = 0;
+
+    intrusiveListInit(&all);
+    intrusiveListInit(&evens);
+    __intrusiveTestItemsInit(items, 6);
+
+    for (int i = 0; i < 6; ++i) {
+        intrusiveListPushBack(&all, &items[i].first);
+        if (i % 2 == 0) intrusiveListPushFront(&evens, &items[i].second);
+    }
+
+    // removing from one list leaves the object on the other
+    intrusiveListRemove(&all, &items[2].first);
+
+    int expectedAll[] = { 0, 1, 3, 4, 5 };
+    int index = 0;
+    bool allCorrect = true;
+    INTRUSIVE_LIST_FOR_EACH_ENTRY(&all, item, __IntrusiveTestItem, first) {
+        if (index >= 5 || item->value != expectedAll[index++]) allCorrect = false;
+    }
+    if (!allCorrect || index != 5) {
+        printf("FAILED: testIntrusiveListMultipleLists: wrong contents of first list\n");
+        failures++;
+    }
+    else successes++;
+
+    int expectedEvens[] = { 4, 2, 0 };
+    index = 0;
+    bool evensCorrect = true;
+    INTRUSIVE_LIST_FOR_EACH_ENTRY(&evens, item, __IntrusiveTestItem, second) {
+        if (index >= 3 || item->value != expectedEvens[index++]) evensCorrect = false;
+    }
+    if (!evensCorrect || index != 3 || !intrusiveLinkIsLinked(&items[2].second)) {
+        printf("FAILED: testIntrusiveListMultipleLists: second list disturbed\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("IntrusiveListMultipleLists", successes, failures);
+}
+
+void testIntrusiveListRemoveWhileIterating() {
+    IntrusiveList list;
+    __IntrusiveTestItem items[10];
+    int successes = 0, failures = 0;
+
+    intrusiveListInit(&list);
+    __intrusiveTestItemsInit(items, 10);
+    for (int i = 0; i < 10; ++i) intrusiveListPushBack(&list, &items[i].first);
+
+    INTRUSIVE_LIST_FOR_EACH_SAFE(&list, link, nextLink) {
+        if (INTRUSIVE_LIST_ENTRY(link, __IntrusiveTestItem, first)->value % 3 == 0) {
+            intrusiveListRemove(&list, link);
+        }
+    }
+
+    unsigned long counted = 0;
+    bool noneDivisible = true;
+    INTRUSIVE_LIST_FOR_EACH(&list, link) {
+        if (container_of(link, __IntrusiveTestItem, first)->value % 3 == 0) noneDivisible = false;
+        counted++;
+    }
+    if (!noneDivisible || counted != 6 || intrusiveListSize(&list) != 6) {
+        printf("FAILED: testIntrusiveListRemoveWhileIterating: expected 6 items left\n");
+        failures++;
+    }
+    else successes++;
+
+    intrusiveListClear(&list);
+    if (!intrusiveListEmpty(&list) || intrusiveLinkIsLinked(&items[1].first)) {
+        printf("FAILED: testIntrusiveListRemoveWhileIterating: clear left links linked\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("IntrusiveListRemoveWhileIterating", successes, failures);
+}
+
+#endif /* INTRUSIVELISTTEST_H */
@@ -0,0 +1,619 @@
+#ifndef BPLUSTREE_H
+#define BPLUSTREE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/******************************************************************************
+* BPlusTree
+*
+* implementation: B+tree ordered multimap; compile-time "generic" with
+*                 BPLUSTREE_KEY/BPLUSTREE_VALUE, ordered by BPLUSTREE_LESS.
+*                 Every key/value pair lives in a leaf; internal nodes only
+*                 hold separator keys. Leaves are chained both ways, so
+*                 ordered iteration and range scans walk leaves sequentially
+*                 instead of going back up the tree.
+*
+*                 Nodes are exactly BPLUSTREE_NODE_BYTES (8 cache lines) and
+*                 cache-line aligned: with 8-byte keys that is 31 keys per
+*                 node, so a search touches one node per level and the
+*                 tree stays about log_32(n) levels tall. Within a node
+*                 keys are binary searched.
+*
+*                 Equal keys are kept in insertion order. Separator keys[i]
+*                 of an internal node is <= every key in children[i + 1] and
+*                 >= every key in children[i]. A full node splits in half on
+*                 the way back up an insert. There is no erase: time-ordered
+*                 indexes are rebuilt with bPlusTreeBulkLoad instead.
+*
+* structures
+*  - BPlusTreeNode: count, leaf flag, keys, then either children or
+*                   values + leaf links
+*  - BPlusTree: root, first leaf, size and height
+*  - BPlusTreeCursor: a leaf and an index into it; leaf == NULL is the end
+*
+******************************************************************************/
+
+#define BPLUSTREE_KEY int64_t
+#define BPLUSTREE_VALUE int64_t
+#define BPLUSTREE_LESS(a, b) ((a) < (b))
+
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+#define BPLUSTREE_NODE_BYTES (8 * CACHE_LINE_SIZE)
+// 8 header + 31 * 8 keys + 32 * 8 children = 512
+#define BPLUSTREE_MAX_KEYS 31
+
+typedef struct BPlusTreeNode {
+    unsigned int count;     // keys in use
+    bool isLeaf;
+    BPLUSTREE_KEY keys[BPLUSTREE_MAX_KEYS];
+    union {
+        struct BPlusTreeNode* children[BPLUSTREE_MAX_KEYS + 1];     // internal: count + 1
+        struct {
+            BPLUSTREE_VALUE values[BPLUSTREE_MAX_KEYS - 1];
+            struct BPlusTreeNode* prev;
+            struct BPlusTreeNode* next;
+        } leaf;
+    };
+} BPlusTreeNode;
+
+_Static_assert(sizeof(BPlusTreeNode) == BPLUSTREE_NODE_BYTES, "BPlusTreeNode should fill its cache lines exactly");
+
+// leaves give up one slot for their prev/next links
+#define BPLUSTREE_LEAF_KEYS (BPLUSTREE_MAX_KEYS - 1)
+
+// Levels an insert can split, plus a new root; a half-full node holds 15
+// keys, so even 2^64 pairs are under 20 levels
+#define BPLUSTREE_MAX_SPLITS 24
+
+typedef struct BPlusTree {
+    BPlusTreeNode* root;
+    BPlusTreeNode* firstLeaf;
+    unsigned long size;
+    unsigned int height;    // 1 when the root is a leaf
+} BPlusTree;
+
+typedef struct BPlusTreeCursor {
+    BPlusTreeNode* leaf;
+    unsigned int index;
+} BPlusTreeCursor;
+
+/* Node helpers ***************************************************************/
+static BPlusTreeNode* __bPlusTreeNodeInit(bool isLeaf) {
+    BPlusTreeNode* node = aligned_alloc(CACHE_LINE_SIZE, sizeof(BPlusTreeNode));
+    if (node == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for BPlusTreeNode.\n");
+        return NULL;
+    }
+
+    node->count = 0;
+    node->isLeaf = isLeaf;
+    if (isLeaf) {
+        node->leaf.prev = NULL;
+        node->leaf.next = NULL;
+    }
+    return node;
+}
+
+static void __bPlusTreeNodeDestroy(BPlusTreeNode* node) {
+    if (node == NULL) return;
+    if (!node->isLeaf) {
+        for (unsigned int i = 0; i <= node->count; ++i) __bPlusTreeNodeDestroy(node->children[i]);
+    }
+    free(node);
+}
+
+// Index of the first key in node that is not less than key
+static unsigned int __bPlusTreeLowerIndex(const BPlusTreeNode* node, BPLUSTREE_KEY key) {
+    unsigned int low = 0, high = node->count;
+    while (low < high) {
+        unsigned int mid = (low + high) / 2;
+        if (BPLUSTREE_LESS(node->keys[mid], key)) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+// Index of the first key in node that is greater than key
+static unsigned int __bPlusTreeUpperIndex(const BPlusTreeNode* node, BPLUSTREE_KEY key) {
+    unsigned int low = 0, high = node->count;
+    while (low < high) {
+        unsigned int mid = (low + high) / 2;
+        if (BPLUSTREE_LESS(key, node->keys[mid])) high = mid;
+        else low = mid + 1;
+    }
+    return low;
+}
+
+// Smallest key under node
+static BPLUSTREE_KEY __bPlusTreeMinKey(const BPlusTreeNode* node) {
+    while (!node->isLeaf) node = node->children[0];
+    return node->keys[0];
+}
+/* End node helpers ***********************************************************/
+
+/******************************************************************************
+* bPlusTreeInit
+*
+* parameters: none
+*
+* returns: BPlusTree*
+*
+* description: initializes an empty tree whose root is an empty leaf
+*
+******************************************************************************/
+BPlusTree* bPlusTreeInit() {
+    BPlusTree* tree = malloc(sizeof(BPlusTree));
+    if (tree == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for BPlusTree.\n");
+        return NULL;
+    }
+
+    tree->root = __bPlusTreeNodeInit(true);
+    if (tree->root == NULL) {
+        free(tree);
+        return NULL;
+    }
+    tree->firstLeaf = tree->root;
+    tree->size = 0;
+    tree->height = 1;
+
+    return tree;
+}
+
+/******************************************************************************
+* bPlusTreeDestroy
+*
+* parameters:
+*  - tree : BPlusTree*
+*
+* returns: none
+*
+* description: frees every node and the tree
+*
+******************************************************************************/
+void bPlusTreeDestroy(BPlusTree* tree) {
+    if (tree == NULL) {
+        fprintf(stderr, "ERROR: attempted to destroy NULL BPlusTree.\n");
+        return;
+    }
+
+    __bPlusTreeNodeDestroy(tree->root);
+    free(tree);
+}
+
+/******************************************************************************
+* bPlusTreeSize
+*
+* parameters:
+*  - tree : BPlusTree*
+*
+* returns: unsigned long
+*
+* description: number of key/value pairs
+*
+******************************************************************************/
+unsigned long bPlusTreeSize(BPlusTree* tree) {
+    if (tree == NULL) {
+        fprintf(stderr, "ERROR: attempted to access size of NULL BPlusTree*.\n");
+        return 0;
+    }
+
+    return tree->size;
+}
+
+/* Insert helpers *************************************************************/
+// Nodes allocated before an insert touches the tree, one per split it will
+// make, so that an allocation failure leaves the tree as it was
+typedef struct BPlusTreeSpares {
+    BPlusTreeNode* nodes[BPLUSTREE_MAX_SPLITS];
+    unsigned int count;
+} BPlusTreeSpares;
+
+// Takes a reserved node and sets it up as an empty leaf or internal node
+static BPlusTreeNode* __bPlusTreeTakeSpare(BPlusTreeSpares* spares, bool isLeaf) {
+    BPlusTreeNode* node = spares->nodes[--spares->count];
+    node->count = 0;
+    node->isLeaf = isLeaf;
+    if (isLeaf) {
+        node->leaf.prev = NULL;
+        node->leaf.next = NULL;
+    }
+    return node;
+}
+
+// Reserves the nodes inserting key will need: the full nodes at the bottom
+// of its path each split, and a new root if that run reaches the root
+static bool __bPlusTreeReserve(BPlusTree* tree, BPLUSTREE_KEY key, BPlusTreeSpares* spares) {
+    unsigned int fullRun = 0;
+    for (BPlusTreeNode* node = tree->root;; node = node->children[__bPlusTreeUpperIndex(node, key)]) {
+        bool full = node->count == (node->isLeaf ? BPLUSTREE_LEAF_KEYS : BPLUSTREE_MAX_KEYS);
+        fullRun = full ? fullRun + 1 : 0;
+        if (node->isLeaf) break;
+    }
+    unsigned int needed = fullRun + (fullRun == tree->height ? 1 : 0);
+
+    spares->count = 0;
+    if (needed > BPLUSTREE_MAX_SPLITS) return false;
+    while (spares->count < needed) {
+        BPlusTreeNode* node = __bPlusTreeNodeInit(false);
+        if (node == NULL) {
+            while (spares->count > 0) free(spares->nodes[--spares->count]);
+            return false;
+        }
+        spares->nodes[spares->count++] = node;
+    }
+    return true;
+}
+
+// Inserts into the subtree at node, taking split nodes from spares. If node
+// had to split, *splitKey and *splitNode describe the new right sibling for
+// the parent to link.
+static void __bPlusTreeInsert(BPlusTreeNode* node, BPLUSTREE_KEY key, BPLUSTREE_VALUE value,
+                              BPlusTreeSpares* spares, BPLUSTREE_KEY* splitKey, BPlusTreeNode** splitNode) {
+    *splitNode = NULL;
+    unsigned int index = __bPlusTreeUpperIndex(node, key);
+
+    if (node->isLeaf) {
+        if (node->count == BPLUSTREE_LEAF_KEYS) {
+            BPlusTreeNode* right = __bPlusTreeTakeSpare(spares, true);
+
+            unsigned int keep = node->count / 2;
+            right->count = node->count - keep;
+            for (unsigned int i = 0; i < right->count; ++i) {
+                right->keys[i] = node->keys[keep + i];
+                right->leaf.values[i] = node->leaf.values[keep + i];
+            }
+            node->count = keep;
+
+            right->leaf.prev = node;
+            right->leaf.next = node->leaf.next;
+            if (node->leaf.next != NULL) node->leaf.next->leaf.prev = right;
+            node->leaf.next = right;
+
+            *splitKey = right->keys[0];
+            *splitNode = right;
+            if (index > keep) {
+                node = right;
+                index -= keep;
+            }
+        }
+
+        for (unsigned int i = node->count; i > index; --i) {
+            node->keys[i] = node->keys[i - 1];
+            node->leaf.values[i] = node->leaf.values[i - 1];
+        }
+        node->keys[index] = key;
+        node->leaf.values[index] = value;
+        node->count++;
+        return;
+    }
+
+    BPLUSTREE_KEY childSplitKey;
+    BPlusTreeNode* childSplit;
+    __bPlusTreeInsert(node->children[index], key, value, spares, &childSplitKey, &childSplit);
+    if (childSplit == NULL) return;
+
+    // link the child's new sibling at index + 1, splitting this node first
+    // if it is full. The middle key moves up instead of being copied.
+    if (node->count == BPLUSTREE_MAX_KEYS) {
+        BPlusTreeNode* right = __bPlusTreeTakeSpare(spares, false);
+
+        unsigned int keep = node->count / 2;
+        *splitKey = node->keys[keep];
+        right->count = node->count - keep - 1;
+        for (unsigned int i = 0; i < right->count; ++i) right->keys[i] = node->keys[keep + 1 + i];
+        for (unsigned int i = 0; i <= right->count; ++i) right->children[i] = node->children[keep + 1 + i];
+        node->count = keep;
+        *splitNode = right;
+
+        if (index > keep) {
+            node = right;
+            index -= keep + 1;
+        }
+    }
+
+    for (unsigned int i = node->count; i > index; --i) {
+        node->keys[i] = node->keys[i - 1];
+        node->children[i + 1] = node->children[i];
+    }
+    node->keys[index] = childSplitKey;
+    node->children[index + 1] = childSplit;
+    node->count++;
+}
+/* End insert helpers *********************************************************/
+
+/******************************************************************************
+* bPlusTreeInsert
+*
+* parameters:
+*  - tree : BPlusTree*
+*  - key : BPLUSTREE_KEY
+*  - value : BPLUSTREE_VALUE
+*
+* returns: bool ; success status
+*
+* description: inserts after any equal keys; when the root splits the tree
+*              grows a level at the top. The nodes the splits need are
+*              allocated first, so a failed insert leaves the tree unchanged.
+*
+******************************************************************************/
+bool bPlusTreeInsert(BPlusTree* tree, BPLUSTREE_KEY key, BPLUSTREE_VALUE value) {
+    if (tree == NULL) {
+        fprintf(stderr, "ERROR: attempted to insert into NULL BPlusTree*.\n");
+        return false;
+    }
+
+    BPlusTreeSpares spares;
+    if (!__bPlusTreeReserve(tree, key, &spares)) return false;
+
+    BPLUSTREE_KEY splitKey;
+    BPlusTreeNode* splitNode;
+    __bPlusTreeInsert(tree->root, key, value, &spares, &splitKey, &splitNode);
+
+    if (splitNode != NULL) {
+        BPlusTreeNode* newRoot = __bPlusTreeTakeSpare(&spares, false);
+        newRoot->count = 1;
+        newRoot->keys[0] = splitKey;
+        newRoot->children[0] = tree->root;
+        newRoot->children[1] = splitNode;
+        tree->root = newRoot;
+        tree->height++;
+    }
+
+    tree->size++;
+    return true;
+}
+
+/******************************************************************************
+* bPlusTreeBulkLoad
+*
+* parameters:
+*  - keys : const BPLUSTREE_KEY* ; sorted by BPLUSTREE_LESS
+*  - values : const BPLUSTREE_VALUE*
+*  - count : unsigned long
+*
+* returns: BPlusTree* ; NULL if keys are not sorted or on allocation failure
+*
+* description: builds a tree bottom-up in O(n) instead of n inserts: packs
+*              the pairs into leaves, then each level of parents over the
+*              level below, until one node is left. Nodes on a level get an
+*              even share of their entries, so none is left nearly empty.
+*
+******************************************************************************/
+BPlusTree* bPlusTreeBulkLoad(const BPLUSTREE_KEY* keys, const BPLUSTREE_VALUE* values, unsigned long count) {
+    for (unsigned long i = 1; i < count; ++i) {
+        if (BPLUSTREE_LESS(keys[i], keys[i - 1])) {
+            fprintf(stderr, "ERROR: bPlusTreeBulkLoad needs sorted keys (out of order at %lu).\n", i);
+            return NULL;
+        }
+    }
+
+    BPlusTree* tree = bPlusTreeInit();
+    if (tree == NULL || count == 0) return tree;
+
+    unsigned long leafCount = (count + BPLUSTREE_LEAF_KEYS - 1) / BPLUSTREE_LEAF_KEYS;
+    BPlusTreeNode** level = malloc(leafCount * sizeof(BPlusTreeNode*));
+    if (level == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for bulk load.\n");
+        bPlusTreeDestroy(tree);
+        return NULL;
+    }
+
+    // leaves; the root leaf from bPlusTreeInit becomes the first one
+    unsigned long next = 0;
+    BPlusTreeNode* previousLeaf = NULL;
+    for (unsigned long l = 0; l < leafCount; ++l) {
+        BPlusTreeNode* leaf = (l == 0) ? tree->root : __bPlusTreeNodeInit(true);
+        if (leaf == NULL) {
+            for (unsigned long i = 1; i < l; ++i) free(level[i]);
+            free(level);
+            bPlusTreeDestroy(tree);
+            return NULL;
+        }
+
+        unsigned long take = count / leafCount + (l < count % leafCount ? 1 : 0);
+        for (unsigned long i = 0; i < take; ++i) {
+            leaf->keys[i] = keys[next];
+            leaf->leaf.values[i] = values[next];
+            next++;
+        }
+        leaf->count = take;
+        leaf->leaf.prev = previousLeaf;
+        if (previousLeaf != NULL) previousLeaf->leaf.next = leaf;
+        previousLeaf = leaf;
+        level[l] = leaf;
+    }
+    tree->size = count;
+
+    // parents, a level at a time, reusing level[] in place
+    unsigned long levelCount = leafCount;
+    while (levelCount > 1) {
+        unsigned long parentCount = (levelCount + BPLUSTREE_MAX_KEYS) / (BPLUSTREE_MAX_KEYS + 1);
+        unsigned long child = 0;
+        for (unsigned long p = 0; p < parentCount; ++p) {
+            BPlusTreeNode* parent = __bPlusTreeNodeInit(false);
+            if (parent == NULL) {
+                // level[0, p) own everything built so far, level[child, levelCount) the rest
+                for (unsigned long i = 0; i < p; ++i) __bPlusTreeNodeDestroy(level[i]);
+                for (unsigned long i = child; i < levelCount; ++i) __bPlusTreeNodeDestroy(level[i]);
+                free(level);
+                free(tree);
+                return NULL;
+            }
+
+            unsigned long take = levelCount / parentCount + (p < levelCount % parentCount ? 1 : 0);
+            for (unsigned long i = 0; i < take; ++i) {
+                parent->children[i] = level[child + i];
+                if (i > 0) parent->keys[i - 1] = __bPlusTreeMinKey(level[child + i]);
+            }
+            parent->count = take - 1;
+            child += take;
+            level[p] = parent;
+        }
+        levelCount = parentCount;
+        tree->height++;
+    }
+
+    tree->root = level[0];
+    free(level);
+    return tree;
+}
+
+/******************************************************************************
+* bPlusTreeBegin / bPlusTreeLowerBound / bPlusTreeUpperBound
+*
+* parameters:
+*  - tree : BPlusTree*
+*  - key : BPLUSTREE_KEY
+*
+* returns: BPlusTreeCursor ; the end cursor if there is no such element
+*
+* description: cursor at the first pair / the first pair whose key is not
+*              less than key / the first pair whose key is greater than key
+*
+******************************************************************************/
+BPlusTreeCursor bPlusTreeBegin(BPlusTree* tree) {
+    BPlusTreeCursor cursor = { tree->firstLeaf, 0 };
+    if (tree->size == 0) cursor.leaf = NULL;
+    return cursor;
+}
+
+BPlusTreeCursor bPlusTreeLowerBound(BPlusTree* tree, BPLUSTREE_KEY key) {
+    BPlusTreeNode* node = tree->root;
+    while (!node->isLeaf) node = node->children[__bPlusTreeLowerIndex(node, key)];
+
+    BPlusTreeCursor cursor = { node, __bPlusTreeLowerIndex(node, key) };
+    // the first match can be the next leaf's first key
+    if (cursor.index == node->count) {
+        cursor.leaf = node->leaf.next;
+        cursor.index = 0;
+    }
+    return cursor;
+}
+
+BPlusTreeCursor bPlusTreeUpperBound(BPlusTree* tree, BPLUSTREE_KEY key) {
+    BPlusTreeNode* node = tree->root;
+    while (!node->isLeaf) node = node->children[__bPlusTreeUpperIndex(node, key)];
+
+    BPlusTreeCursor cursor = { node, __bPlusTreeUpperIndex(node, key) };
+    if (cursor.index == node->count) {
+        cursor.leaf = node->leaf.next;
+        cursor.index = 0;
+    }
+    return cursor;
+}
+
+/******************************************************************************
+* bPlusTreeCursorValid / bPlusTreeCursorKey / bPlusTreeCursorValue /
+* bPlusTreeCursorNext
+*
+* parameters:
+*  - cursor : BPlusTreeCursor*
+*
+* returns: bool / BPLUSTREE_KEY / BPLUSTREE_VALUE* / bool
+*
+* description: whether the cursor is on a pair, that pair's key and value,
+*              and step to the next pair in key order (false at the end)
+*
+******************************************************************************/
+bool bPlusTreeCursorValid(BPlusTreeCursor* cursor) {
+    return cursor->leaf != NULL;
+}
+
+BPLUSTREE_KEY bPlusTreeCursorKey(BPlusTreeCursor* cursor) {
+    return cursor->leaf->keys[cursor->index];
+}
+
+BPLUSTREE_VALUE* bPlusTreeCursorValue(BPlusTreeCursor* cursor) {
+    return &cursor->leaf->leaf.values[cursor->index];
+}
+
+bool bPlusTreeCursorNext(BPlusTreeCursor* cursor) {
+    if (cursor->leaf == NULL) return false;
+
+    if (++cursor->index == cursor->leaf->count) {
+        cursor->leaf = cursor->leaf->leaf.next;
+        cursor->index = 0;
+    }
+    return cursor->leaf != NULL;
+}
+
+/******************************************************************************
+* bPlusTreeFind
+*
+* parameters:
+*  - tree : BPlusTree*
+*  - key : BPLUSTREE_KEY
+*
+* returns: BPLUSTREE_VALUE* ; value of the first pair with key, NULL if none
+*
+* description: point lookup
+*
+******************************************************************************/
+BPLUSTREE_VALUE* bPlusTreeFind(BPlusTree* tree, BPLUSTREE_KEY key) {
+    BPlusTreeCursor cursor = bPlusTreeLowerBound(tree, key);
+    if (!bPlusTreeCursorValid(&cursor) || BPLUSTREE_LESS(key, bPlusTreeCursorKey(&cursor))) return NULL;
+    return bPlusTreeCursorValue(&cursor);
+}
+
+/******************************************************************************
+* bPlusTreeRangeScan
+*
+* parameters:
+*  - tree : BPlusTree*
+*  - low : BPLUSTREE_KEY ; inclusive
+*  - high : BPLUSTREE_KEY ; exclusive
+*  - visit : callback ; return false to stop early
+*  - context : void* ; passed through to visit
+*
+* returns: unsigned long ; number of pairs visited
+*
+* description: one descent to low, then a sequential walk over the leaf
+*              chain until a key reaches high
+*
+******************************************************************************/
+unsigned long bPlusTreeRangeScan(BPlusTree* tree, BPLUSTREE_KEY low, BPLUSTREE_KEY high,
+                                 bool (*visit)(BPLUSTREE_KEY key, BPLUSTREE_VALUE* value, void* context),
+                                 void* context) {
+    unsigned long visited = 0;
+    BPlusTreeCursor cursor = bPlusTreeLowerBound(tree, low);
+
+    while (bPlusTreeCursorValid(&cursor) && BPLUSTREE_LESS(bPlusTreeCursorKey(&cursor), high)) {
+        visited++;
+        if (!visit(bPlusTreeCursorKey(&cursor), bPlusTreeCursorValue(&cursor), context)) break;
+        bPlusTreeCursorNext(&cursor);
+    }
+    return visited;
+}
+
+/******************************************************************************
+* bPlusTreeToString
+*
+* parameters:
+*  - tree : BPlusTree*
+*
+* returns: none
+*
+* description: prints key:value pairs in order; leaf boundaries are marked
+*              with |
+*
+******************************************************************************/
+void bPlusTreeToString(BPlusTree* tree) {
+    printf("[ ");
+    for (BPlusTreeNode* leaf = tree->firstLeaf; leaf != NULL && tree->size > 0; leaf = leaf->leaf.next) {
+        for (unsigned int i = 0; i < leaf->count; ++i) {
+            printf("%lld:%lld", (long long)leaf->keys[i], (long long)leaf->leaf.values[i]);
+            if (i + 1 < leaf->count) printf(", ");
+        }
+        if (leaf->leaf.next != NULL) printf(" | ");
+    }
+    printf(" ]\n");
+}
+
+#endif /* BPLUSTREE_H */
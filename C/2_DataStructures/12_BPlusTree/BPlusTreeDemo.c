@@ -0,0 +1,33 @@
+#include <stdio.h>
+
+#include "BPlusTree.h"
+#include "BPlusTreeTest.h"
+
+static bool printEvent(BPLUSTREE_KEY key, BPLUSTREE_VALUE* value, void* context) {
+    printf("  t=%lld event %lld\n", (long long)key, (long long)*value);
+    return true;
+}
+
+int main() {
+    // Time-ordered event index: epoch seconds -> event id
+    BPLUSTREE_KEY timestamps[] = { 1704874500, 1704874800, 1704877200, 1704877200, 1704879000, 1704880800 };
+    BPLUSTREE_VALUE eventIds[] = { 1001, 1002, 1003, 1006, 1004, 1005 };
+
+    BPlusTree* tree = bPlusTreeBulkLoad(timestamps, eventIds, 6);
+    if (tree == NULL) return 1;
+
+    bPlusTreeInsert(tree, 1704876000, 1007);
+    bPlusTreeToString(tree);
+
+    printf("Events in [1704875000, 1704879000):\n");
+    bPlusTreeRangeScan(tree, 1704875000, 1704879000, printEvent, NULL);
+
+    BPlusTreeCursor first = bPlusTreeUpperBound(tree, 1704877200);
+    if (bPlusTreeCursorValid(&first)) {
+        printf("First event after 1704877200: %lld\n", (long long)*bPlusTreeCursorValue(&first));
+    }
+
+    bPlusTreeDestroy(tree);
+
+    runBPlusTreeTests();
+}
\ No newline at end of file
@@ -0,0 +1,334 @@
+#ifndef BPLUSTREETEST_H
+#define BPLUSTREETEST_H
+
+#include "BPlusTree.h"
+#include "TestsSummary.h"
+
+/* Testing functions **********************************************************/
+void testBPlusTreeInsertOrder();
+void testBPlusTreeDuplicates();
+void testBPlusTreeBounds();
+void testBPlusTreeRangeScan();
+void testBPlusTreeBulkLoad();
+void testBPlusTreeInsertReserve();
+/* End testing functions ******************************************************/
+
+/* Test setup/teardown functions **********************************************/
+BPlusTree* SetUp() {
+    return bPlusTreeInit();
+}
+
+void TearDown(BPlusTree* tree) {
+    bPlusTreeDestroy(tree);
+}
+/* End test setup/teardown functions ******************************************/
+
+#define BPLUSTREE_TEST_COUNT 100000
+
+// These tests assume BPLUSTREE_KEY and BPLUSTREE_VALUE are integers
+void runBPlusTreeTests() {
+    TestsSummaryPrintHeader("BPlusTree");
+
+    testBPlusTreeInsertOrder();
+    testBPlusTreeDuplicates();
+    testBPlusTreeBounds();
+    testBPlusTreeRangeScan();
+    testBPlusTreeBulkLoad();
+    testBPlusTreeInsertReserve();
+
+    TestsSummaryPrintFooter("BPlusTree");
+}
+
+// Structural checks for the subtree at node, whose keys must lie in
+// [low, high] when the bounds are given: sorted keys, separators that bound
+// their children, all leaves at the same depth. Returns the leaf depth, or
+// -1 if something is wrong.
+int __bPlusTreeCheckNode(BPlusTreeNode* node, const BPLUSTREE_KEY* low, const BPLUSTREE_KEY* high) {
+    for (unsigned int i = 0; i < node->count; ++i) {
+        if (i > 0 && BPLUSTREE_LESS(node->keys[i], node->keys[i - 1])) return -1;
+        if (low != NULL && BPLUSTREE_LESS(node->keys[i], *low)) return -1;
+        if (high != NULL && BPLUSTREE_LESS(*high, node->keys[i])) return -1;
+    }
+    if (node->isLeaf) return node->count <= BPLUSTREE_LEAF_KEYS ? 1 : -1;
+    if (node->count == 0) return -1;
+
+    int depth = -1;
+    for (unsigned int i = 0; i <= node->count; ++i) {
+        const BPLUSTREE_KEY* childLow = (i > 0) ? &node->keys[i - 1] : low;
+        const BPLUSTREE_KEY* childHigh = (i < node->count) ? &node->keys[i] : high;
+        int childDepth = __bPlusTreeCheckNode(node->children[i], childLow, childHigh);
+        if (childDepth < 0 || (depth >= 0 && childDepth != depth)) return -1;
+        depth = childDepth;
+    }
+    return depth + 1;
+}
+
+bool __bPlusTreeIsValid(BPlusTree* tree) {
+    int depth = __bPlusTreeCheckNode(tree->root, NULL, NULL);
+    if (depth != (int)tree->height) return false;
+
+    // the leaf chain visits exactly size pairs in order, with consistent prev links
+    unsigned long counted = 0;
+    BPlusTreeNode* previous = NULL;
+    for (BPlusTreeNode* leaf = tree->firstLeaf; leaf != NULL; leaf = leaf->leaf.next) {
+        if (leaf->leaf.prev != previous) return false;
+        if (previous != NULL && previous->count > 0 && leaf->count > 0
+            && BPLUSTREE_LESS(leaf->keys[0], previous->keys[previous->count - 1])) return false;
+        counted += leaf->count;
+        previous = leaf;
+    }
+    return counted == tree->size;
+}
+
+void testBPlusTreeInsertOrder() {
+    BPlusTree* tree = SetUp();
+    int successes = 0, failures = 0;
+
+    // a permutation of 0..COUNT-1, value = 2 * key
+    for (long i = 0; i < BPLUSTREE_TEST_COUNT; ++i) {
+        BPLUSTREE_KEY key = (i * 7919) % BPLUSTREE_TEST_COUNT;
+        bPlusTreeInsert(tree, key, key * 2);
+    }
+
+    if (!__bPlusTreeIsValid(tree) || bPlusTreeSize(tree) != BPLUSTREE_TEST_COUNT) {
+        printf("FAILED: testBPlusTreeInsertOrder: tree invariants broken after inserts\n");
+        failures++;
+    }
+    else successes++;
+
+    BPLUSTREE_KEY expected = 0;
+    bool inOrder = true;
+    for (BPlusTreeCursor cursor = bPlusTreeBegin(tree); bPlusTreeCursorValid(&cursor); bPlusTreeCursorNext(&cursor)) {
+        if (bPlusTreeCursorKey(&cursor) != expected || *bPlusTreeCursorValue(&cursor) != expected * 2) inOrder = false;
+        expected++;
+    }
+    if (!inOrder || expected != BPLUSTREE_TEST_COUNT) {
+        printf("FAILED: testBPlusTreeInsertOrder: iteration out of order\n");
+        failures++;
+    }
+    else successes++;
+
+    BPLUSTREE_VALUE* found = bPlusTreeFind(tree, 12345);
+    if (found == NULL || *found != 24690 || bPlusTreeFind(tree, -1) != NULL || bPlusTreeFind(tree, BPLUSTREE_TEST_COUNT) != NULL) {
+        printf("FAILED: testBPlusTreeInsertOrder: wrong point lookups\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("BPlusTreeInsertOrder", successes, failures);
+    TearDown(tree);
+}
+
+void testBPlusTreeDuplicates() {
+    BPlusTree* tree = SetUp();
+    int successes = 0, failures = 0;
+
+    // 100 copies each of keys 0..99, enough to span several leaves per key;
+    // the value records insertion order
+    for (long i = 0; i < 10000; ++i) bPlusTreeInsert(tree, i % 100, i);
+
+    if (!__bPlusTreeIsValid(tree)) {
+        printf("FAILED: testBPlusTreeDuplicates: tree invariants broken\n");
+        failures++;
+    }
+    else successes++;
+
+    // equal keys come back in insertion order: 42, 142, 242, ...
+    BPlusTreeCursor cursor = bPlusTreeLowerBound(tree, 42);
+    bool stable = true;
+    for (long copy = 0; copy < 100; ++copy) {
+        if (!bPlusTreeCursorValid(&cursor) || bPlusTreeCursorKey(&cursor) != 42 || *bPlusTreeCursorValue(&cursor) != 42 + copy * 100) {
+            stable = false;
+            break;
+        }
+        bPlusTreeCursorNext(&cursor);
+    }
+    if (!stable || bPlusTreeCursorKey(&cursor) != 43) {
+        printf("FAILED: testBPlusTreeDuplicates: equal keys not all found in insertion order\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("BPlusTreeDuplicates", successes, failures);
+    TearDown(tree);
+}
+
+void testBPlusTreeBounds() {
+    BPlusTree* tree = SetUp();
+    int successes = 0, failures = 0;
+
+    // even keys 0..2*(COUNT-1)
+    for (long i = 0; i < BPLUSTREE_TEST_COUNT; ++i) bPlusTreeInsert(tree, i * 2, i);
+
+    bool boundsCorrect = true;
+    for (long key = -1; key < 2 * BPLUSTREE_TEST_COUNT; key += 97) {
+        BPlusTreeCursor lower = bPlusTreeLowerBound(tree, key);
+        BPlusTreeCursor upper = bPlusTreeUpperBound(tree, key);
+        BPLUSTREE_KEY expectedLower = (key < 0) ? 0 : (key % 2 == 0 ? key : key + 1);
+        BPLUSTREE_KEY expectedUpper = (key < 0) ? 0 : (key % 2 == 0 ? key + 2 : key + 1);
+
+        bool lowerEnd = expectedLower >= 2 * BPLUSTREE_TEST_COUNT;
+        bool upperEnd = expectedUpper >= 2 * BPLUSTREE_TEST_COUNT;
+        if (bPlusTreeCursorValid(&lower) == lowerEnd || bPlusTreeCursorValid(&upper) == upperEnd) boundsCorrect = false;
+        else if (!lowerEnd && bPlusTreeCursorKey(&lower) != expectedLower) boundsCorrect = false;
+        else if (!upperEnd && bPlusTreeCursorKey(&upper) != expectedUpper) boundsCorrect = false;
+    }
+    BPlusTreeCursor past = bPlusTreeLowerBound(tree, 2 * BPLUSTREE_TEST_COUNT);
+    if (!boundsCorrect || bPlusTreeCursorValid(&past)) {
+        printf("FAILED: testBPlusTreeBounds: wrong lower/upper bound\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("BPlusTreeBounds", successes, failures);
+    TearDown(tree);
+}
+
+static bool __bPlusTreeTestSum(BPLUSTREE_KEY key, BPLUSTREE_VALUE* value, void* context) {
+    *(long long*)context += key;
+    return true;
+}
+
+static bool __bPlusTreeTestStopAtThree(BPLUSTREE_KEY key, BPLUSTREE_VALUE* value, void* context) {
+    return ++*(int*)context < 3;
+}
+
+void testBPlusTreeRangeScan() {
+    BPlusTree* tree = SetUp();
+    int successes = 0, failures = 0;
+
+    for (long i = 0; i < BPLUSTREE_TEST_COUNT; ++i) bPlusTreeInsert(tree, i, i);
+
+    long long sum = 0;
+    unsigned long visited = bPlusTreeRangeScan(tree, 1000, 2000, __bPlusTreeTestSum, &sum);
+    // 1000 + 1001 + ... + 1999
+    if (visited != 1000 || sum != 1499500) {
+        printf("FAILED: testBPlusTreeRangeScan: expected 1000 keys summing to 1499500, got %lu / %lld\n", visited, sum);
+        failures++;
+    }
+    else successes++;
+
+    int calls = 0;
+    visited = bPlusTreeRangeScan(tree, 0, BPLUSTREE_TEST_COUNT, __bPlusTreeTestStopAtThree, &calls);
+    sum = 0;
+    if (visited != 3 || bPlusTreeRangeScan(tree, 500, 500, __bPlusTreeTestSum, &sum) != 0) {
+        printf("FAILED: testBPlusTreeRangeScan: early stop or empty range misbehaved\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("BPlusTreeRangeScan", successes, failures);
+    TearDown(tree);
+}
+
+// Bulk loads count pairs with keys 0, 0, 0, 1, 1, 1, ... and checks the tree
+bool __bPlusTreeBulkLoadCheck(BPLUSTREE_KEY* keys, BPLUSTREE_VALUE* values, unsigned long count) {
+    for (unsigned long i = 0; i < count; ++i) {
+        keys[i] = (BPLUSTREE_KEY)(i / 3);
+        values[i] = (BPLUSTREE_VALUE)i;
+    }
+
+    BPlusTree* tree = bPlusTreeBulkLoad(keys, values, count);
+    if (tree == NULL) return false;
+
+    bool valid = __bPlusTreeIsValid(tree) && tree->size == count;
+    if (valid && count > 0) {
+        // the first of the three pairs with the middle key
+        BPLUSTREE_VALUE* found = bPlusTreeFind(tree, keys[count / 2]);
+        valid = found != NULL && *found == (BPLUSTREE_VALUE)(count / 2 / 3 * 3);
+    }
+    bPlusTreeDestroy(tree);
+    return valid;
+}
+
+void testBPlusTreeBulkLoad() {
+    int successes = 0, failures = 0;
+
+    BPLUSTREE_KEY* keys = malloc(BPLUSTREE_TEST_COUNT * sizeof(BPLUSTREE_KEY));
+    BPLUSTREE_VALUE* values = malloc(BPLUSTREE_TEST_COUNT * sizeof(BPLUSTREE_VALUE));
+    if (keys == NULL || values == NULL) {
+        free(keys);
+        free(values);
+        return;
+    }
+
+    // every size up to two levels' worth of boundaries, then bigger ones
+    bool allValid = true;
+    for (unsigned long count = 0; count < 2000; ++count) {
+        if (!__bPlusTreeBulkLoadCheck(keys, values, count)) allValid = false;
+    }
+    if (!__bPlusTreeBulkLoadCheck(keys, values, 20000) || !__bPlusTreeBulkLoadCheck(keys, values, BPLUSTREE_TEST_COUNT)) {
+        allValid = false;
+    }
+    if (!allValid) {
+        printf("FAILED: testBPlusTreeBulkLoad: bulk loaded tree invalid\n");
+        failures++;
+    }
+    else successes++;
+
+    // a bulk loaded tree keeps working with inserts
+    for (unsigned long i = 0; i < BPLUSTREE_TEST_COUNT; ++i) keys[i] = (BPLUSTREE_KEY)(i * 2);
+    BPlusTree* tree = bPlusTreeBulkLoad(keys, values, BPLUSTREE_TEST_COUNT);
+    for (long i = 0; i < 1000; ++i) bPlusTreeInsert(tree, i * 2 + 1, -i);
+    if (!__bPlusTreeIsValid(tree) || tree->size != BPLUSTREE_TEST_COUNT + 1000 || *bPlusTreeFind(tree, 7) != -3) {
+        printf("FAILED: testBPlusTreeBulkLoad: inserts after bulk load\n");
+        failures++;
+    }
+    else successes++;
+    bPlusTreeDestroy(tree);
+
+    // unsorted input is rejected
+    keys[10] = -5;
+    if (bPlusTreeBulkLoad(keys, values, 20) != NULL) {
+        printf("FAILED: testBPlusTreeBulkLoad: accepted unsorted keys\n");
+        failures++;
+    }
+    else successes++;
+
+    free(keys);
+    free(values);
+    TestsSummaryPrintResults("BPlusTreeBulkLoad", successes, failures);
+}
+
+// Nodes in the subtree at node
+unsigned long __bPlusTreeCountNodes(BPlusTreeNode* node) {
+    unsigned long count = 1;
+    if (!node->isLeaf) {
+        for (unsigned int i = 0; i <= node->count; ++i) count += __bPlusTreeCountNodes(node->children[i]);
+    }
+    return count;
+}
+
+// An insert allocates nothing after it starts changing the tree: it uses
+// exactly the nodes reserved for it, through leaf, internal and root splits
+void testBPlusTreeInsertReserve() {
+    BPlusTree* tree = SetUp();
+    int successes = 0, failures = 0;
+
+    bool exact = true;
+    unsigned long nodes = 1;
+    unsigned long state = 5;
+    for (long i = 0; i < 20000 && exact; ++i) {
+        state = state * 6364136223846793005UL + 1442695040888963407UL;
+        BPLUSTREE_KEY key = (i % 3 == 0) ? i : (BPLUSTREE_KEY)(state >> 50);
+        BPlusTreeSpares spares;
+        exact = __bPlusTreeReserve(tree, key, &spares);
+        unsigned int reserved = spares.count;
+        while (spares.count > 0) free(spares.nodes[--spares.count]);
+
+        exact = exact && bPlusTreeInsert(tree, key, i);
+        unsigned long after = __bPlusTreeCountNodes(tree->root);
+        exact = exact && after - nodes == reserved;
+        nodes = after;
+    }
+    if (!exact || !__bPlusTreeIsValid(tree) || tree->height < 3) {
+        printf("FAILED: testBPlusTreeInsertReserve: reserved nodes differ from the splits made\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("BPlusTreeInsertReserve", successes, failures);
+    TearDown(tree);
+}
+
+#endif /* BPLUSTREETEST_H */
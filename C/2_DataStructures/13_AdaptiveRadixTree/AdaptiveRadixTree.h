@@ -0,0 +1,729 @@
+#ifndef ADAPTIVERADIXTREE_H
+#define ADAPTIVERADIXTREE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/******************************************************************************
+* AdaptiveRadixTree
+*
+* implementation: adaptive radix tree (Leis et al., "The Adaptive Radix
+*                 Tree", ICDE 2013) mapping C strings to ART_VALUE. One key
+*                 byte is consumed per level, and each inner node is the
+*                 smallest of four layouts that fits its children:
+*                   Node4   : 4 sorted key bytes + 4 children
+*                   Node16  : 16 sorted key bytes + 16 children, searched
+*                             with one SSE2 compare when available
+*                   Node48  : 256-entry byte -> slot index + 48 children
+*                   Node256 : 256 children, indexed directly
+*                 A node grows to the next layout when it fills up.
+*
+*                 Path compression: a chain of single-child nodes is folded
+*                 into its child's prefix. The first ART_MAX_PREFIX_LENGTH
+*                 bytes are stored in the node; longer prefixes are checked
+*                 against a leaf below (hybrid pessimistic/optimistic).
+*
+*                 Keys are stored with their terminating '\0', so no key is
+*                 a prefix of another and a key that ends at a node hangs
+*                 off its '\0' child. '\0' sorts first, so iteration visits
+*                 keys in strcmp order.
+*
+*                 Insert (or update) and lookup are O(key length),
+*                 independent of how many keys are stored. There is no
+*                 removal.
+*
+* structures
+*  - ArtNode: header shared by all node kinds (kind, child count, prefix)
+*  - ArtNode4 / ArtNode16 / ArtNode48 / ArtNode256: inner nodes
+*  - ArtLeaf: value and the full key
+*  - AdaptiveRadixTree: root and size
+*
+******************************************************************************/
+
+#define ART_VALUE long
+#define ART_MAX_PREFIX_LENGTH 10
+
+typedef enum ArtNodeKind {
+    ART_LEAF,
+    ART_NODE4,
+    ART_NODE16,
+    ART_NODE48,
+    ART_NODE256
+} ArtNodeKind;
+
+// Aligned like a pointer so casts to the node kinds below are aligned too
+typedef struct ArtNode {
+    _Alignas(void*) uint8_t kind;
+    uint16_t childCount;
+    uint32_t prefixLength;
+    uint8_t prefix[ART_MAX_PREFIX_LENGTH];
+} ArtNode;
+
+typedef struct ArtNode4 {
+    ArtNode header;
+    uint8_t keys[4];
+    ArtNode* children[4];
+} ArtNode4;
+
+typedef struct ArtNode16 {
+    ArtNode header;
+    uint8_t keys[16];
+    ArtNode* children[16];
+} ArtNode16;
+
+typedef struct ArtNode48 {
+    ArtNode header;
+    uint8_t childIndex[256];    // slot + 1, 0 for no child
+    ArtNode* children[48];
+} ArtNode48;
+
+typedef struct ArtNode256 {
+    ArtNode header;
+    ArtNode* children[256];
+} ArtNode256;
+
+typedef struct ArtLeaf {
+    ArtNode header;             // kind only
+    ART_VALUE value;
+    uint32_t keyLength;         // including the '\0'
+    unsigned char key[];
+} ArtLeaf;
+
+typedef struct AdaptiveRadixTree {
+    ArtNode* root;
+    unsigned long size;
+} AdaptiveRadixTree;
+
+/* Node helpers ***************************************************************/
+static ArtNode* __artNodeInit(ArtNodeKind kind) {
+    size_t size = (kind == ART_NODE4) ? sizeof(ArtNode4)
+                : (kind == ART_NODE16) ? sizeof(ArtNode16)
+                : (kind == ART_NODE48) ? sizeof(ArtNode48)
+                : sizeof(ArtNode256);
+    ArtNode* node = calloc(1, size);
+    if (node == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for ArtNode.\n");
+        return NULL;
+    }
+    node->kind = kind;
+    return node;
+}
+
+static ArtLeaf* __artLeafInit(const unsigned char* key, uint32_t keyLength, ART_VALUE value) {
+    ArtLeaf* leaf = malloc(sizeof(ArtLeaf) + keyLength);
+    if (leaf == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for ArtLeaf.\n");
+        return NULL;
+    }
+    leaf->header.kind = ART_LEAF;
+    leaf->value = value;
+    leaf->keyLength = keyLength;
+    memcpy(leaf->key, key, keyLength);
+    return leaf;
+}
+
+static void __artNodeDestroy(ArtNode* node) {
+    if (node == NULL) return;
+
+    switch (node->kind) {
+    case ART_NODE4:
+        for (int i = 0; i < node->childCount; ++i) __artNodeDestroy(((ArtNode4*)node)->children[i]);
+        break;
+    case ART_NODE16:
+        for (int i = 0; i < node->childCount; ++i) __artNodeDestroy(((ArtNode16*)node)->children[i]);
+        break;
+    case ART_NODE48:
+        for (int i = 0; i < node->childCount; ++i) __artNodeDestroy(((ArtNode48*)node)->children[i]);
+        break;
+    case ART_NODE256:
+        for (int i = 0; i < 256; ++i) __artNodeDestroy(((ArtNode256*)node)->children[i]);
+        break;
+    default:
+        break;
+    }
+    free(node);
+}
+
+// Slot holding the child for byte, or NULL
+static ArtNode** __artFindChild(ArtNode* node, uint8_t byte) {
+    switch (node->kind) {
+    case ART_NODE4: {
+        ArtNode4* n = (ArtNode4*)node;
+        for (int i = 0; i < node->childCount; ++i) {
+            if (n->keys[i] == byte) return &n->children[i];
+        }
+        return NULL;
+    }
+    case ART_NODE16: {
+        ArtNode16* n = (ArtNode16*)node;
+#ifdef __SSE2__
+        __m128i matches = _mm_cmpeq_epi8(_mm_set1_epi8((char)byte), _mm_loadu_si128((const __m128i*)(const void*)n->keys));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(matches) & ((1u << node->childCount) - 1);
+        return mask ? &n->children[__builtin_ctz(mask)] : NULL;
+#else
+        for (int i = 0; i < node->childCount; ++i) {
+            if (n->keys[i] == byte) return &n->children[i];
+        }
+        return NULL;
+#endif
+    }
+    case ART_NODE48: {
+        ArtNode48* n = (ArtNode48*)node;
+        return n->childIndex[byte] ? &n->children[n->childIndex[byte] - 1] : NULL;
+    }
+    case ART_NODE256: {
+        ArtNode256* n = (ArtNode256*)node;
+        return n->children[byte] ? &n->children[byte] : NULL;
+    }
+    default:
+        return NULL;
+    }
+}
+
+// Leftmost leaf under node, used to recover prefix bytes beyond
+// ART_MAX_PREFIX_LENGTH
+static ArtLeaf* __artMinimumLeaf(ArtNode* node) {
+    while (node != NULL && node->kind != ART_LEAF) {
+        switch (node->kind) {
+        case ART_NODE4: node = ((ArtNode4*)node)->children[0]; break;
+        case ART_NODE16: node = ((ArtNode16*)node)->children[0]; break;
+        case ART_NODE48: {
+            ArtNode48* n = (ArtNode48*)node;
+            int byte = 0;
+            while (!n->childIndex[byte]) byte++;
+            node = n->children[n->childIndex[byte] - 1];
+            break;
+        }
+        default: {
+            ArtNode256* n = (ArtNode256*)node;
+            int byte = 0;
+            while (!n->children[byte]) byte++;
+            node = n->children[byte];
+            break;
+        }
+        }
+    }
+    return (ArtLeaf*)(void*)node;
+}
+
+static bool __artLeafMatches(const ArtLeaf* leaf, const unsigned char* key, uint32_t keyLength) {
+    return leaf->keyLength == keyLength && memcmp(leaf->key, key, keyLength) == 0;
+}
+
+// Number of node's prefix bytes that match key from depth, at most
+// min(prefixLength, keyLength - depth). Bytes past the stored ones are read
+// from the minimum leaf.
+static uint32_t __artPrefixMatch(ArtNode* node, const unsigned char* key, uint32_t keyLength, uint32_t depth) {
+    uint32_t limit = node->prefixLength;
+    if (keyLength - depth < limit) limit = keyLength - depth;
+
+    uint32_t stored = (limit < ART_MAX_PREFIX_LENGTH) ? limit : ART_MAX_PREFIX_LENGTH;
+    uint32_t i = 0;
+    for (; i < stored; ++i) {
+        if (node->prefix[i] != key[depth + i]) return i;
+    }
+    if (i < limit) {
+        ArtLeaf* leaf = __artMinimumLeaf(node);
+        for (; i < limit; ++i) {
+            if (leaf->key[depth + i] != key[depth + i]) return i;
+        }
+    }
+    return i;
+}
+
+// Links child under byte in node, growing node into the next kind when it
+// is full; *ref is updated if node is replaced
+static bool __artAddChild(ArtNode** ref, ArtNode* node, uint8_t byte, ArtNode* child) {
+    switch (node->kind) {
+    case ART_NODE4: {
+        ArtNode4* n = (ArtNode4*)node;
+        if (node->childCount < 4) {
+            int i = 0;
+            while (i < node->childCount && n->keys[i] < byte) i++;
+            memmove(&n->keys[i + 1], &n->keys[i], node->childCount - i);
+            memmove(&n->children[i + 1], &n->children[i], (node->childCount - i) * sizeof(ArtNode*));
+            n->keys[i] = byte;
+            n->children[i] = child;
+            node->childCount++;
+            return true;
+        }
+        ArtNode16* grown = (ArtNode16*)(void*)__artNodeInit(ART_NODE16);
+        if (grown == NULL) return false;
+        memcpy(&grown->header, node, sizeof(ArtNode));
+        grown->header.kind = ART_NODE16;
+        memcpy(grown->keys, n->keys, 4);
+        memcpy(grown->children, n->children, 4 * sizeof(ArtNode*));
+        *ref = &grown->header;
+        free(node);
+        return __artAddChild(ref, &grown->header, byte, child);
+    }
+    case ART_NODE16: {
+        ArtNode16* n = (ArtNode16*)node;
+        if (node->childCount < 16) {
+            int i = 0;
+            while (i < node->childCount && n->keys[i] < byte) i++;
+            memmove(&n->keys[i + 1], &n->keys[i], node->childCount - i);
+            memmove(&n->children[i + 1], &n->children[i], (node->childCount - i) * sizeof(ArtNode*));
+            n->keys[i] = byte;
+            n->children[i] = child;
+            node->childCount++;
+            return true;
+        }
+        ArtNode48* grown = (ArtNode48*)(void*)__artNodeInit(ART_NODE48);
+        if (grown == NULL) return false;
+        memcpy(&grown->header, node, sizeof(ArtNode));
+        grown->header.kind = ART_NODE48;
+        for (int i = 0; i < 16; ++i) {
+            grown->children[i] = n->children[i];
+            grown->childIndex[n->keys[i]] = (uint8_t)(i + 1);
+        }
+        *ref = &grown->header;
+        free(node);
+        return __artAddChild(ref, &grown->header, byte, child);
+    }
+    case ART_NODE48: {
+        ArtNode48* n = (ArtNode48*)node;
+        if (node->childCount < 48) {
+            // slots fill in order and are never freed, so the next one is free
+            n->children[node->childCount] = child;
+            n->childIndex[byte] = (uint8_t)(node->childCount + 1);
+            node->childCount++;
+            return true;
+        }
+        ArtNode256* grown = (ArtNode256*)(void*)__artNodeInit(ART_NODE256);
+        if (grown == NULL) return false;
+        memcpy(&grown->header, node, sizeof(ArtNode));
+        grown->header.kind = ART_NODE256;
+        for (int b = 0; b < 256; ++b) {
+            if (n->childIndex[b]) grown->children[b] = n->children[n->childIndex[b] - 1];
+        }
+        *ref = &grown->header;
+        free(node);
+        return __artAddChild(ref, &grown->header, byte, child);
+    }
+    case ART_NODE256: {
+        ArtNode256* n = (ArtNode256*)node;
+        n->children[byte] = child;
+        node->childCount++;
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+/* End node helpers ***********************************************************/
+
+/******************************************************************************
+* artInit
+*
+* parameters: none
+*
+* returns: AdaptiveRadixTree*
+*
+* description: initializes an empty tree
+*
+******************************************************************************/
+AdaptiveRadixTree* artInit() {
+    AdaptiveRadixTree* tree = malloc(sizeof(AdaptiveRadixTree));
+    if (tree == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for AdaptiveRadixTree.\n");
+        return NULL;
+    }
+
+    tree->root = NULL;
+    tree->size = 0;
+    return tree;
+}
+
+/******************************************************************************
+* artDestroy
+*
+* parameters:
+*  - tree : AdaptiveRadixTree*
+*
+* returns: none
+*
+* description: frees every node and leaf, and the tree
+*
+******************************************************************************/
+void artDestroy(AdaptiveRadixTree* tree) {
+    if (tree == NULL) {
+        fprintf(stderr, "ERROR: attempted to destroy NULL AdaptiveRadixTree.\n");
+        return;
+    }
+
+    __artNodeDestroy(tree->root);
+    free(tree);
+}
+
+/******************************************************************************
+* artSize
+*
+* parameters:
+*  - tree : AdaptiveRadixTree*
+*
+* returns: unsigned long
+*
+* description: number of keys
+*
+******************************************************************************/
+unsigned long artSize(AdaptiveRadixTree* tree) {
+    if (tree == NULL) {
+        fprintf(stderr, "ERROR: attempted to access size of NULL AdaptiveRadixTree*.\n");
+        return 0;
+    }
+
+    return tree->size;
+}
+
+/******************************************************************************
+* artInsert
+*
+* parameters:
+*  - tree : AdaptiveRadixTree*
+*  - key : const char*
+*  - value : ART_VALUE
+*
+* returns: bool ; success status
+*
+* description: adds key, or replaces its value if it is already there.
+*              Where key leaves the existing paths, either a leaf becomes a
+*              Node4 holding both keys, or a compressed prefix is split at
+*              the first differing byte.
+*
+******************************************************************************/
+bool artInsert(AdaptiveRadixTree* tree, const char* key, ART_VALUE value) {
+    if (tree == NULL || key == NULL) {
+        fprintf(stderr, "ERROR: attempted to insert NULL key or into NULL AdaptiveRadixTree*.\n");
+        return false;
+    }
+
+    const unsigned char* bytes = (const unsigned char*)key;
+    uint32_t keyLength = (uint32_t)strlen(key) + 1;
+    ArtNode** ref = &tree->root;
+    uint32_t depth = 0;
+
+    while (true) {
+        ArtNode* node = *ref;
+
+        if (node == NULL) {
+            ArtLeaf* leaf = __artLeafInit(bytes, keyLength, value);
+            if (leaf == NULL) return false;
+            *ref = &leaf->header;
+            tree->size++;
+            return true;
+        }
+
+        if (node->kind == ART_LEAF) {
+            ArtLeaf* existing = (ArtLeaf*)(void*)node;
+            if (__artLeafMatches(existing, bytes, keyLength)) {
+                existing->value = value;
+                return true;
+            }
+
+            // both keys share bytes [depth, depth + common); branch after that
+            uint32_t common = 0;
+            while (existing->key[depth + common] == bytes[depth + common]) common++;
+
+            ArtNode* split = __artNodeInit(ART_NODE4);
+            ArtLeaf* leaf = __artLeafInit(bytes, keyLength, value);
+            if (split == NULL || leaf == NULL) {
+                free(split);
+                free(leaf);
+                return false;
+            }
+            split->prefixLength = common;
+            memcpy(split->prefix, bytes + depth, common < ART_MAX_PREFIX_LENGTH ? common : ART_MAX_PREFIX_LENGTH);
+            __artAddChild(ref, split, existing->key[depth + common], node);
+            __artAddChild(ref, split, bytes[depth + common], &leaf->header);
+            *ref = split;
+            tree->size++;
+            return true;
+        }
+
+        if (node->prefixLength > 0) {
+            uint32_t matched = __artPrefixMatch(node, bytes, keyLength, depth);
+            if (matched < node->prefixLength) {
+                // split the prefix: a new Node4 takes the matched part and
+                // branches on the first differing byte
+                ArtNode* split = __artNodeInit(ART_NODE4);
+                ArtLeaf* leaf = __artLeafInit(bytes, keyLength, value);
+                if (split == NULL || leaf == NULL) {
+                    free(split);
+                    free(leaf);
+                    return false;
+                }
+                split->prefixLength = matched;
+                memcpy(split->prefix, node->prefix, matched < ART_MAX_PREFIX_LENGTH ? matched : ART_MAX_PREFIX_LENGTH);
+
+                // node keeps what follows the branching byte; read it from
+                // a leaf if it was not all stored
+                uint8_t branchByte;
+                uint32_t remaining = node->prefixLength - matched - 1;
+                if (node->prefixLength <= ART_MAX_PREFIX_LENGTH) {
+                    branchByte = node->prefix[matched];
+                    memmove(node->prefix, node->prefix + matched + 1, remaining);
+                }
+                else {
+                    ArtLeaf* minimum = __artMinimumLeaf(node);
+                    branchByte = minimum->key[depth + matched];
+                    memcpy(node->prefix, minimum->key + depth + matched + 1,
+                           remaining < ART_MAX_PREFIX_LENGTH ? remaining : ART_MAX_PREFIX_LENGTH);
+                }
+                node->prefixLength = remaining;
+
+                __artAddChild(ref, split, branchByte, node);
+                __artAddChild(ref, split, bytes[depth + matched], &leaf->header);
+                *ref = split;
+                tree->size++;
+                return true;
+            }
+            depth += node->prefixLength;
+        }
+
+        ArtNode** child = __artFindChild(node, bytes[depth]);
+        if (child != NULL) {
+            ref = child;
+            depth++;
+            continue;
+        }
+
+        ArtLeaf* leaf = __artLeafInit(bytes, keyLength, value);
+        if (leaf == NULL) return false;
+        if (!__artAddChild(ref, node, bytes[depth], &leaf->header)) {
+            free(leaf);
+            return false;
+        }
+        tree->size++;
+        return true;
+    }
+}
+
+/******************************************************************************
+* artSearch
+*
+* parameters:
+*  - tree : AdaptiveRadixTree*
+*  - key : const char*
+*
+* returns: ART_VALUE* ; NULL if key is not present
+*
+* description: exact lookup. Long prefixes are skipped without comparing
+*              (optimistic); the final leaf comparison catches mismatches.
+*
+******************************************************************************/
+ART_VALUE* artSearch(AdaptiveRadixTree* tree, const char* key) {
+    if (tree == NULL || key == NULL) return NULL;
+
+    const unsigned char* bytes = (const unsigned char*)key;
+    uint32_t keyLength = (uint32_t)strlen(key) + 1;
+    ArtNode* node = tree->root;
+    uint32_t depth = 0;
+
+    while (node != NULL) {
+        if (node->kind == ART_LEAF) {
+            ArtLeaf* leaf = (ArtLeaf*)(void*)node;
+            return __artLeafMatches(leaf, bytes, keyLength) ? &leaf->value : NULL;
+        }
+
+        if (node->prefixLength > 0) {
+            uint32_t stored = node->prefixLength < ART_MAX_PREFIX_LENGTH ? node->prefixLength : ART_MAX_PREFIX_LENGTH;
+            if (keyLength - depth <= stored) return NULL;
+            if (memcmp(node->prefix, bytes + depth, stored) != 0) return NULL;
+            depth += node->prefixLength;
+            if (depth >= keyLength) return NULL;
+        }
+
+        ArtNode** child = __artFindChild(node, bytes[depth]);
+        node = (child != NULL) ? *child : NULL;
+        depth++;
+    }
+    return NULL;
+}
+
+/* Iteration helpers **********************************************************/
+// Visits every leaf under node in key order; false once visit asks to stop
+static bool __artVisitAll(ArtNode* node, bool (*visit)(const char* key, ART_VALUE* value, void* context),
+                          void* context, unsigned long* visited) {
+    if (node == NULL) return true;
+
+    switch (node->kind) {
+    case ART_LEAF: {
+        ArtLeaf* leaf = (ArtLeaf*)(void*)node;
+        (*visited)++;
+        return visit((const char*)leaf->key, &leaf->value, context);
+    }
+    case ART_NODE4:
+        for (int i = 0; i < node->childCount; ++i) {
+            if (!__artVisitAll(((ArtNode4*)node)->children[i], visit, context, visited)) return false;
+        }
+        return true;
+    case ART_NODE16:
+        for (int i = 0; i < node->childCount; ++i) {
+            if (!__artVisitAll(((ArtNode16*)node)->children[i], visit, context, visited)) return false;
+        }
+        return true;
+    case ART_NODE48: {
+        ArtNode48* n = (ArtNode48*)node;
+        for (int b = 0; b < 256; ++b) {
+            if (n->childIndex[b] && !__artVisitAll(n->children[n->childIndex[b] - 1], visit, context, visited)) return false;
+        }
+        return true;
+    }
+    default: {
+        ArtNode256* n = (ArtNode256*)node;
+        for (int b = 0; b < 256; ++b) {
+            if (!__artVisitAll(n->children[b], visit, context, visited)) return false;
+        }
+        return true;
+    }
+    }
+}
+/* End iteration helpers ******************************************************/
+
+/******************************************************************************
+* artPrefixIterate
+*
+* parameters:
+*  - tree : AdaptiveRadixTree*
+*  - prefix : const char* ; "" visits every key
+*  - visit : callback ; return false to stop early
+*  - context : void* ; passed through to visit
+*
+* returns: unsigned long ; number of keys visited
+*
+* description: descends along prefix to the subtree holding every key that
+*              starts with it, then visits that subtree in key order. Cost
+*              is O(prefix length + matches), not a scan of every key.
+*
+******************************************************************************/
+unsigned long artPrefixIterate(AdaptiveRadixTree* tree, const char* prefix,
+                               bool (*visit)(const char* key, ART_VALUE* value, void* context),
+                               void* context) {
+    if (tree == NULL || prefix == NULL) {
+        fprintf(stderr, "ERROR: attempted to iterate NULL AdaptiveRadixTree* or with NULL prefix.\n");
+        return 0;
+    }
+
+    const unsigned char* bytes = (const unsigned char*)prefix;
+    uint32_t prefixLength = (uint32_t)strlen(prefix);
+    ArtNode* node = tree->root;
+    uint32_t depth = 0;
+    unsigned long visited = 0;
+
+    while (node != NULL) {
+        if (node->kind == ART_LEAF) {
+            ArtLeaf* leaf = (ArtLeaf*)(void*)node;
+            if (leaf->keyLength - 1 >= prefixLength && memcmp(leaf->key, bytes, prefixLength) == 0) {
+                visited++;
+                visit((const char*)leaf->key, &leaf->value, context);
+            }
+            return visited;
+        }
+
+        if (depth == prefixLength) break;
+
+        if (node->prefixLength > 0) {
+            uint32_t matched = __artPrefixMatch(node, bytes, prefixLength, depth);
+            if (matched < node->prefixLength && depth + matched < prefixLength) return visited;
+            // prefix ends inside this node's compressed path: all of it matches
+            if (depth + node->prefixLength >= prefixLength) break;
+            depth += node->prefixLength;
+        }
+
+        ArtNode** child = __artFindChild(node, bytes[depth]);
+        node = (child != NULL) ? *child : NULL;
+        depth++;
+    }
+
+    __artVisitAll(node, visit, context, &visited);
+    return visited;
+}
+
+/******************************************************************************
+* artLongestPrefixMatch
+*
+* parameters:
+*  - tree : AdaptiveRadixTree*
+*  - key : const char*
+*  - matchedKey : const char** ; out, the stored key found (may be NULL)
+*
+* returns: ART_VALUE* ; value of the longest stored key that is a prefix of
+*          key (or key itself), NULL if none is
+*
+* description: walks down along key; every node passed may have a key
+*              ending right there (its '\0' child), and the deepest one
+*              found wins. Candidates are verified against the full key.
+*
+******************************************************************************/
+ART_VALUE* artLongestPrefixMatch(AdaptiveRadixTree* tree, const char* key, const char** matchedKey) {
+    if (tree == NULL || key == NULL) return NULL;
+
+    const unsigned char* bytes = (const unsigned char*)key;
+    uint32_t length = (uint32_t)strlen(key);
+    ArtNode* node = tree->root;
+    uint32_t depth = 0;
+    ArtLeaf* best = NULL;
+
+    while (node != NULL) {
+        if (node->kind == ART_LEAF) {
+            ArtLeaf* leaf = (ArtLeaf*)(void*)node;
+            if (leaf->keyLength - 1 <= length && memcmp(leaf->key, bytes, leaf->keyLength - 1) == 0) best = leaf;
+            break;
+        }
+
+        if (node->prefixLength > 0) {
+            if (__artPrefixMatch(node, bytes, length, depth) < node->prefixLength) break;
+            depth += node->prefixLength;
+        }
+
+        ArtNode** terminator = __artFindChild(node, 0);
+        if (terminator != NULL) {
+            ArtLeaf* leaf = (ArtLeaf*)(void*)*terminator;
+            if (leaf->keyLength - 1 <= length && memcmp(leaf->key, bytes, leaf->keyLength - 1) == 0) best = leaf;
+        }
+
+        if (depth >= length) break;
+        ArtNode** child = __artFindChild(node, bytes[depth]);
+        node = (child != NULL) ? *child : NULL;
+        depth++;
+    }
+
+    if (best == NULL) return NULL;
+    if (matchedKey != NULL) *matchedKey = (const char*)best->key;
+    return &best->value;
+}
+
+static bool __artPrintPair(const char* key, ART_VALUE* value, void* context) {
+    bool* first = context;
+    printf("%s%s:%ld", *first ? "" : ", ", key, (long)*value);
+    *first = false;
+    return true;
+}
+
+/******************************************************************************
+* artToString
+*
+* parameters:
+*  - tree : AdaptiveRadixTree*
+*
+* returns: none
+*
+* description: prints key:value pairs in key order
+*
+******************************************************************************/
+void artToString(AdaptiveRadixTree* tree) {
+    bool first = true;
+    printf("[ ");
+    artPrefixIterate(tree, "", __artPrintPair, &first);
+    printf(" ]\n");
+}
+
+#endif /* ADAPTIVERADIXTREE_H */
@@ -0,0 +1,126 @@
+#ifndef ADAPTIVERADIXTREEBENCH_H
+#define ADAPTIVERADIXTREEBENCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "AdaptiveRadixTree.h"
+#include "Dictionary.h"
+#include "util.h"
+
+/******************************************************************************
+* AdaptiveRadixTreeBench.h
+*
+* AdaptiveRadixTree vs. the chained hash table in 0_Dictionary on point
+* lookups, with keys shaped like the IDs in __common/data.csv (8 characters
+* from [0-9A-Z]). Each case runs in a forked child so RSS is its own.
+*
+*  - build: insert every key, RSS growth after building
+*  - hit: look every key up again, in a different order than inserted
+*  - miss: look up as many keys that were never inserted
+*
+* Dictionary has a fixed DICT_CAPACITY buckets, so it is measured at a load
+* factor of about 1 as well as at the larger size, where chains grow long.
+*
+******************************************************************************/
+
+#define ART_BENCH_KEY_SIZE 9
+
+// Key i; keys from different seeds never collide for the sizes used here
+static void __artBenchKey(unsigned long i, unsigned long seed, char* key) {
+    unsigned long state = (i + 1) * 0x9E3779B97F4A7C15UL ^ seed;
+    for (int c = 0; c < 8; ++c) {
+        state ^= state >> 29;
+        state *= 0xBF58476D1CE4E5B9UL;
+        key[c] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"[(state >> 40) % 36];
+    }
+    key[8] = '\0';
+}
+
+static void __artBenchCase(bool useArt, unsigned long count) {
+    char (*keys)[ART_BENCH_KEY_SIZE] = malloc(count * ART_BENCH_KEY_SIZE);
+    char (*missing)[ART_BENCH_KEY_SIZE] = malloc(count * ART_BENCH_KEY_SIZE);
+    unsigned long* order = malloc(count * sizeof(unsigned long));
+    for (unsigned long i = 0; i < count; ++i) {
+        __artBenchKey(i, 1, keys[i]);
+        __artBenchKey(i, 2, missing[i]);
+        order[i] = i;
+    }
+    for (unsigned long i = count - 1; i > 0; --i) {
+        unsigned long j = (i * 2654435761UL) % (i + 1);
+        unsigned long swap = order[i];
+        order[i] = order[j];
+        order[j] = swap;
+    }
+
+    double start, buildSeconds, hitSeconds, missSeconds;
+    unsigned long found = 0;
+    long rssBefore = benchRssKb(), rssAfter;
+
+    if (useArt) {
+        AdaptiveRadixTree* tree = artInit();
+        start = benchSeconds();
+        for (unsigned long i = 0; i < count; ++i) artInsert(tree, keys[i], (ART_VALUE)i);
+        buildSeconds = benchSeconds() - start;
+        rssAfter = benchRssKb();
+
+        start = benchSeconds();
+        for (unsigned long i = 0; i < count; ++i) found += artSearch(tree, keys[order[i]]) != NULL;
+        hitSeconds = benchSeconds() - start;
+
+        start = benchSeconds();
+        for (unsigned long i = 0; i < count; ++i) found += artSearch(tree, missing[i]) != NULL;
+        missSeconds = benchSeconds() - start;
+        artDestroy(tree);
+    }
+    else {
+        Dictionary* dict = dictionaryInit();
+        start = benchSeconds();
+        for (unsigned long i = 0; i < count; ++i) dictionaryInsert(dict, keys[i], "1");
+        buildSeconds = benchSeconds() - start;
+        rssAfter = benchRssKb();
+
+        start = benchSeconds();
+        for (unsigned long i = 0; i < count; ++i) found += dictionaryGet(dict, keys[order[i]]) != NULL;
+        hitSeconds = benchSeconds() - start;
+
+        start = benchSeconds();
+        for (unsigned long i = 0; i < count; ++i) found += dictionaryGet(dict, missing[i]) != NULL;
+        missSeconds = benchSeconds() - start;
+        dictionaryDestroy(dict);
+    }
+
+    printf("%-10s %8lu keys  build %6.1f ns/key  hit %6.1f ns  miss %6.1f ns  RSS +%ld KB (%.1f B/key)  found %lu\n",
+           useArt ? "ART" : "Dictionary", count,
+           buildSeconds * 1e9 / count, hitSeconds * 1e9 / count, missSeconds * 1e9 / count,
+           rssAfter - rssBefore, (rssAfter - rssBefore) * 1024.0 / count, found);
+
+    free(keys);
+    free(missing);
+    free(order);
+}
+
+void runAdaptiveRadixTreeBenchmarks() {
+    unsigned long counts[] = { DICT_CAPACITY, 1000000 };
+
+    printf("\nAdaptiveRadixTree benchmarks: point lookups vs. Dictionary\n");
+    printf("==========================================================\n");
+    fflush(stdout);
+
+    for (int c = 0; c < 2; ++c) {
+        for (int useArt = 0; useArt <= 1; ++useArt) {
+            pid_t pid = fork();
+            if (pid == 0) {
+                __artBenchCase(useArt, counts[c]);
+                fflush(stdout);
+                _exit(0);
+            }
+            waitpid(pid, NULL, 0);
+        }
+    }
+}
+
+#endif /* ADAPTIVERADIXTREEBENCH_H */
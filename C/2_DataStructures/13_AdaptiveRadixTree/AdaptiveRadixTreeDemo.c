@@ -0,0 +1,62 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "AdaptiveRadixTree.h"
+#include "AdaptiveRadixTreeTest.h"
+
+#ifdef RUN_BENCHMARKS
+#include "AdaptiveRadixTreeBench.h"
+#endif
+
+static bool printId(const char* key, ART_VALUE* value, void* context) {
+    printf("  %s (row %ld)\n", key, (long)*value);
+    return true;
+}
+
+int main() {
+    // Patient ID -> row, from the third column of data.csv
+    FILE* file = fopen("../../../__common/data.csv", "r");
+    if (file == NULL) {
+        fprintf(stderr, "ERROR: failed to open data.csv\n");
+        return 1;
+    }
+
+    AdaptiveRadixTree* tree = artInit();
+    char line[256];
+    long row = 0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (row++ == 0) continue;    // header
+        char* id = strchr(line, ',');
+        if (id == NULL) continue;
+        id = strchr(id + 1, ',');
+        if (id == NULL) continue;
+        char* end = strchr(++id, ',');
+        if (end == NULL) continue;
+        *end = '\0';
+        artInsert(tree, id, row - 1);
+    }
+    fclose(file);
+
+    printf("%lu patient IDs\n", artSize(tree));
+
+    printf("IDs starting with MBP:\n");
+    artPrefixIterate(tree, "MBP", printId, NULL);
+    printf("IDs starting with P:\n");
+    artPrefixIterate(tree, "P", printId, NULL);
+
+    ART_VALUE* found = artSearch(tree, "PZ1276ML");
+    if (found != NULL) printf("PZ1276ML is row %ld\n", (long)*found);
+
+    const char* matched = NULL;
+    if (artLongestPrefixMatch(tree, "MBPL0CD0-2024-01", &matched) != NULL) {
+        printf("Longest stored prefix of MBPL0CD0-2024-01: %s\n", matched);
+    }
+
+    artDestroy(tree);
+
+    runAdaptiveRadixTreeTests();
+
+#ifdef RUN_BENCHMARKS
+    runAdaptiveRadixTreeBenchmarks();
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,333 @@
+#ifndef ADAPTIVERADIXTREETEST_H
+#define ADAPTIVERADIXTREETEST_H
+
+#include "AdaptiveRadixTree.h"
+#include "TestsSummary.h"
+
+/* Testing functions **********************************************************/
+void testArtInsertSearch();
+void testArtNodeGrowth();
+void testArtLongPrefixes();
+void testArtPrefixIterate();
+void testArtLongestPrefixMatch();
+/* End testing functions ******************************************************/
+
+/* Test setup/teardown functions **********************************************/
+AdaptiveRadixTree* SetUp() {
+    return artInit();
+}
+
+void TearDown(AdaptiveRadixTree* tree) {
+    artDestroy(tree);
+}
+/* End test setup/teardown functions ******************************************/
+
+#define ART_TEST_COUNT 20000
+#define ART_TEST_KEY_SIZE 32
+
+// These tests assume ART_VALUE is an integer
+void runAdaptiveRadixTreeTests() {
+    TestsSummaryPrintHeader("AdaptiveRadixTree");
+
+    testArtInsertSearch();
+    testArtNodeGrowth();
+    testArtLongPrefixes();
+    testArtPrefixIterate();
+    testArtLongestPrefixMatch();
+
+    TestsSummaryPrintFooter("AdaptiveRadixTree");
+}
+
+// Deterministic keys over a small alphabet so that many share prefixes and
+// some are prefixes of others: 1 to 12 characters from "abcd"
+void __artTestKey(unsigned long i, char* key) {
+    unsigned long state = i * 2654435761UL + 12345;
+    int length = 1 + (int)(state % 12);
+    for (int c = 0; c < length; ++c) {
+        state = state * 6364136223846793005UL + 1442695040888963407UL;
+        key[c] = "abcd"[(state >> 33) % 4];
+    }
+    key[length] = '\0';
+}
+
+static int __artTestCompareKeys(const void* a, const void* b) {
+    return strcmp(a, b);
+}
+
+// Sorted, de-duplicated copy of the first count test keys
+unsigned long __artTestSortedKeys(unsigned long count, char (*keys)[ART_TEST_KEY_SIZE]) {
+    for (unsigned long i = 0; i < count; ++i) __artTestKey(i, keys[i]);
+    qsort(keys, count, ART_TEST_KEY_SIZE, __artTestCompareKeys);
+
+    unsigned long unique = 0;
+    for (unsigned long i = 0; i < count; ++i) {
+        if (unique == 0 || strcmp(keys[unique - 1], keys[i]) != 0) memmove(keys[unique++], keys[i], ART_TEST_KEY_SIZE);
+    }
+    return unique;
+}
+
+void testArtInsertSearch() {
+    AdaptiveRadixTree* tree = SetUp();
+    int successes = 0, failures = 0;
+    char key[ART_TEST_KEY_SIZE];
+
+    // later duplicates overwrite, so every key maps to its last index
+    for (unsigned long i = 0; i < ART_TEST_COUNT; ++i) {
+        __artTestKey(i, key);
+        artInsert(tree, key, (ART_VALUE)i);
+    }
+
+    char (*keys)[ART_TEST_KEY_SIZE] = malloc(ART_TEST_COUNT * ART_TEST_KEY_SIZE);
+    unsigned long unique = __artTestSortedKeys(ART_TEST_COUNT, keys);
+    if (artSize(tree) != unique) {
+        printf("FAILED: testArtInsertSearch: size %lu, expected %lu\n", artSize(tree), unique);
+        failures++;
+    }
+    else successes++;
+
+    bool found = true;
+    for (unsigned long i = 0; i < ART_TEST_COUNT; ++i) {
+        __artTestKey(i, key);
+        ART_VALUE* value = artSearch(tree, key);
+        if (value == NULL) found = false;
+        else {
+            // no later index may have produced the same key
+            char later[ART_TEST_KEY_SIZE];
+            __artTestKey((unsigned long)*value, later);
+            if ((unsigned long)*value < i || strcmp(later, key) != 0) found = false;
+        }
+    }
+    if (!found) {
+        printf("FAILED: testArtInsertSearch: inserted key missing or with wrong value\n");
+        failures++;
+    }
+    else successes++;
+
+    // "e" is outside the alphabet and keys are at most 12 characters
+    if (artSearch(tree, "abce") != NULL || artSearch(tree, "aaaaaaaaaaaaa") != NULL || artSearch(tree, "") != NULL) {
+        printf("FAILED: testArtInsertSearch: found a key that was never inserted\n");
+        failures++;
+    }
+    else successes++;
+
+    artInsert(tree, "", 7);
+    ART_VALUE* empty = artSearch(tree, "");
+    if (empty == NULL || *empty != 7 || artSize(tree) != unique + 1) {
+        printf("FAILED: testArtInsertSearch: empty key not stored\n");
+        failures++;
+    }
+    else successes++;
+
+    free(keys);
+    TestsSummaryPrintResults("ArtInsertSearch", successes, failures);
+    TearDown(tree);
+}
+
+void testArtNodeGrowth() {
+    AdaptiveRadixTree* tree = SetUp();
+    int successes = 0, failures = 0;
+    char key[3] = { 'k', 0, 0 };
+
+    // children of the node after "k" go 4 -> 16 -> 48 -> 256
+    int expectedKinds[] = { ART_NODE4, ART_NODE16, ART_NODE48, ART_NODE256 };
+    int thresholds[] = { 4, 16, 48, 255 };
+    bool grew = true;
+    int byte = 1;
+    for (int stage = 0; stage < 4; ++stage) {
+        for (; byte <= thresholds[stage]; ++byte) {
+            key[1] = (char)byte;
+            artInsert(tree, key, byte);
+        }
+        if (tree->root->kind != expectedKinds[stage] || tree->root->prefixLength != 1) grew = false;
+    }
+    if (!grew) {
+        printf("FAILED: testArtNodeGrowth: node did not grow through every kind\n");
+        failures++;
+    }
+    else successes++;
+
+    bool found = true;
+    for (byte = 1; byte <= 255; ++byte) {
+        key[1] = (char)byte;
+        ART_VALUE* value = artSearch(tree, key);
+        if (value == NULL || *value != byte) found = false;
+    }
+    if (!found || artSize(tree) != 255) {
+        printf("FAILED: testArtNodeGrowth: keys lost while growing\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("ArtNodeGrowth", successes, failures);
+    TearDown(tree);
+}
+
+void testArtLongPrefixes() {
+    AdaptiveRadixTree* tree = SetUp();
+    int successes = 0, failures = 0;
+
+    // shared runs well past ART_MAX_PREFIX_LENGTH, split at several depths
+    const char* keys[] = {
+        "0123456789abcdefghijklmnopqrstuvwxyz",
+        "0123456789abcdefghijklmnopqrstuvwxyZ",
+        "0123456789abcdefghijKLMNOP",
+        "0123456789abcdefghijklmnopqrstuvwxyz0123456789",
+        "0123456789abcdefghij",
+        "0123456789ABC",
+        "01234567",
+        "0123456789abcdefghijklmnopqrstu",
+    };
+    int count = sizeof(keys) / sizeof(keys[0]);
+    for (int i = 0; i < count; ++i) artInsert(tree, keys[i], i);
+
+    bool found = true;
+    for (int i = 0; i < count; ++i) {
+        ART_VALUE* value = artSearch(tree, keys[i]);
+        if (value == NULL || *value != i) found = false;
+    }
+    if (!found || artSize(tree) != (unsigned long)count) {
+        printf("FAILED: testArtLongPrefixes: inserted key missing\n");
+        failures++;
+    }
+    else successes++;
+
+    // differ only inside a compressed run that is not stored in the node
+    if (artSearch(tree, "0123456789abcdefghijklmnopqrsXuvwxyz") != NULL
+        || artSearch(tree, "0123456789abcdefghijklmnopqrstuvwxy") != NULL
+        || artSearch(tree, "0123456789abcdefghi") != NULL) {
+        printf("FAILED: testArtLongPrefixes: found a key that was never inserted\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("ArtLongPrefixes", successes, failures);
+    TearDown(tree);
+}
+
+typedef struct {
+    char (*keys)[ART_TEST_KEY_SIZE];
+    unsigned long count;
+    bool inOrder;
+} __ArtTestExpected;
+
+static bool __artTestCheckVisit(const char* key, ART_VALUE* value, void* context) {
+    __ArtTestExpected* expected = context;
+    if (strcmp(key, expected->keys[expected->count]) != 0) expected->inOrder = false;
+    expected->count++;
+    return expected->inOrder;
+}
+
+static bool __artTestStopAtThree(const char* key, ART_VALUE* value, void* context) {
+    return ++*(int*)context < 3;
+}
+
+void testArtPrefixIterate() {
+    AdaptiveRadixTree* tree = SetUp();
+    int successes = 0, failures = 0;
+    char key[ART_TEST_KEY_SIZE];
+
+    for (unsigned long i = 0; i < ART_TEST_COUNT; ++i) {
+        __artTestKey(i, key);
+        artInsert(tree, key, (ART_VALUE)i);
+    }
+    char (*keys)[ART_TEST_KEY_SIZE] = malloc(ART_TEST_COUNT * ART_TEST_KEY_SIZE);
+    unsigned long unique = __artTestSortedKeys(ART_TEST_COUNT, keys);
+
+    // every prefix of up to 4 characters, checked against the sorted keys
+    bool correct = true;
+    const char* prefixes[] = { "", "a", "b", "ab", "dd", "abc", "cab", "dddd", "abcd", "e", "ae" };
+    for (unsigned long p = 0; p < sizeof(prefixes) / sizeof(prefixes[0]); ++p) {
+        size_t length = strlen(prefixes[p]);
+        unsigned long first = 0;
+        while (first < unique && strncmp(keys[first], prefixes[p], length) < 0) first++;
+        unsigned long last = first;
+        while (last < unique && strncmp(keys[last], prefixes[p], length) == 0) last++;
+
+        __ArtTestExpected expected = { keys + first, 0, true };
+        unsigned long visited = artPrefixIterate(tree, prefixes[p], __artTestCheckVisit, &expected);
+        if (!expected.inOrder || visited != last - first || expected.count != last - first) correct = false;
+    }
+    if (!correct) {
+        printf("FAILED: testArtPrefixIterate: wrong keys or order for a prefix\n");
+        failures++;
+    }
+    else successes++;
+
+    int calls = 0;
+    if (artPrefixIterate(tree, "a", __artTestStopAtThree, &calls) != 3 || calls != 3) {
+        printf("FAILED: testArtPrefixIterate: visit returning false did not stop the scan\n");
+        failures++;
+    }
+    else successes++;
+
+    free(keys);
+    TestsSummaryPrintResults("ArtPrefixIterate", successes, failures);
+    TearDown(tree);
+}
+
+void testArtLongestPrefixMatch() {
+    AdaptiveRadixTree* tree = SetUp();
+    int successes = 0, failures = 0;
+
+    const char* routes[] = { "/", "/api", "/api/v1", "/api/v1/users", "/api/v2", "/static/images/icons" };
+    for (int i = 0; i < 6; ++i) artInsert(tree, routes[i], i);
+
+    const char* queries[] = { "/api/v1/users/42", "/api/v1/user", "/api/v3", "/apiary", "/static/images/i",
+                              "/static/images/icons/a.png", "/api", "index.html" };
+    const char* expected[] = { "/api/v1/users", "/api/v1", "/api", "/api", "/",
+                               "/static/images/icons", "/api", NULL };
+    bool correct = true;
+    for (int q = 0; q < 8; ++q) {
+        const char* matched = NULL;
+        ART_VALUE* value = artLongestPrefixMatch(tree, queries[q], &matched);
+        if (expected[q] == NULL) {
+            if (value != NULL) correct = false;
+        }
+        else if (value == NULL || strcmp(matched, expected[q]) != 0 || strcmp(routes[*value], expected[q]) != 0) {
+            correct = false;
+        }
+    }
+    if (!correct) {
+        printf("FAILED: testArtLongestPrefixMatch: wrong match for a query\n");
+        failures++;
+    }
+    else successes++;
+
+    // brute force over random keys: the longest inserted key that prefixes the query
+    AdaptiveRadixTree* random = artInit();
+    char (*keys)[ART_TEST_KEY_SIZE] = malloc(ART_TEST_COUNT * ART_TEST_KEY_SIZE);
+    unsigned long count = 2000;
+    for (unsigned long i = 0; i < count; ++i) {
+        __artTestKey(i, keys[i]);
+        artInsert(random, keys[i], (ART_VALUE)i);
+    }
+    correct = true;
+    char query[ART_TEST_KEY_SIZE];
+    for (unsigned long q = count; q < count + 2000; ++q) {
+        __artTestKey(q, query);
+        size_t best = 0;
+        bool any = false;
+        for (unsigned long i = 0; i < count; ++i) {
+            size_t length = strlen(keys[i]);
+            if (strncmp(keys[i], query, length) == 0 && (!any || length > best)) {
+                best = length;
+                any = true;
+            }
+        }
+        const char* matched = NULL;
+        ART_VALUE* value = artLongestPrefixMatch(random, query, &matched);
+        if ((value != NULL) != any || (any && strlen(matched) != best)) correct = false;
+    }
+    if (!correct) {
+        printf("FAILED: testArtLongestPrefixMatch: disagrees with brute force\n");
+        failures++;
+    }
+    else successes++;
+
+    free(keys);
+    artDestroy(random);
+    TestsSummaryPrintResults("ArtLongestPrefixMatch", successes, failures);
+    TearDown(tree);
+}
+
+#endif /* ADAPTIVERADIXTREETEST_H */
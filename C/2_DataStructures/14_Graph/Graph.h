@@ -0,0 +1,694 @@
+#ifndef GRAPH_H
+#define GRAPH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "CsvParser.h"
+
+/******************************************************************************
+* Graph
+*
+* implementation: compressed sparse row (CSR) adjacency. Vertices are
+*                 0..vertexCount-1; the out-neighbors of v are
+*                 targets[offsets[v] .. offsets[v + 1]), so the whole graph
+*                 is two arrays instead of one allocation per edge.
+*
+*                 Built from an edge list in two passes: count every
+*                 vertex's degree and prefix-sum the counts into offsets,
+*                 then scatter each edge to its slot. Neighbors keep the
+*                 order of the edge list.
+*
+*                 Directed graphs also keep the reverse CSR (in-neighbors),
+*                 which bottom-up BFS steps need. Undirected graphs store
+*                 each edge in both directions and share one CSR for both.
+*
+*                 graphBfsParallel is a direction-optimizing BFS (Beamer et
+*                 al., SC 2012) over pthreads. A top-down step expands the
+*                 frontier queue and claims vertices with a CAS. A
+*                 bottom-up step lets every unvisited vertex look for a
+*                 parent in the frontier bitmap, and stops at the first one
+*                 found. Bottom-up is used while the frontier's edges
+*                 outnumber the unexplored edges / GRAPH_BFS_ALPHA, which
+*                 skips most edge checks on the few huge middle levels of
+*                 small-world graphs.
+*
+* structures
+*  - GraphEdge: (from, to) pair of an edge list
+*  - Graph: out CSR, in CSR, sizes
+*
+******************************************************************************/
+
+#define GRAPH_UNREACHED UINT32_MAX
+
+// Direction-optimizing BFS tuning (values from Beamer et al.)
+#define GRAPH_BFS_ALPHA 15
+#define GRAPH_BFS_BETA 18
+#define GRAPH_BFS_CHUNK 256         // vertices per work item; multiple of 64
+#define GRAPH_BFS_LOCAL_QUEUE 256   // per-thread discoveries before a flush
+
+typedef struct GraphEdge {
+    uint32_t from;
+    uint32_t to;
+} GraphEdge;
+
+typedef struct Graph {
+    uint32_t vertexCount;
+    unsigned long edgeCount;        // stored arcs; twice the input for undirected
+    bool undirected;
+    unsigned long* offsets;         // vertexCount + 1
+    uint32_t* targets;              // edgeCount
+    unsigned long* inOffsets;       // same arrays as offsets/targets when undirected
+    uint32_t* inSources;
+} Graph;
+
+/* Build helpers **************************************************************/
+// Two-pass CSR build: degree counts -> offsets, then scatter. from/to select
+// the edge direction so the same code builds the reverse CSR.
+static bool __graphBuildCsr(const GraphEdge* edges, unsigned long edgeCount, uint32_t vertexCount,
+                            bool reverse, bool undirected, unsigned long** outOffsets, uint32_t** outTargets) {
+    unsigned long arcCount = 0;
+    unsigned long* offsets = calloc((unsigned long)vertexCount + 1, sizeof(unsigned long));
+    if (offsets == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for Graph offsets.\n");
+        return false;
+    }
+
+    for (unsigned long e = 0; e < edgeCount; ++e) {
+        uint32_t from = reverse ? edges[e].to : edges[e].from;
+        uint32_t to = reverse ? edges[e].from : edges[e].to;
+        offsets[from + 1]++;
+        if (undirected && from != to) offsets[to + 1]++;
+    }
+    for (uint32_t v = 0; v < vertexCount; ++v) offsets[v + 1] += offsets[v];
+    arcCount = offsets[vertexCount];
+
+    uint32_t* targets = malloc((arcCount ? arcCount : 1) * sizeof(uint32_t));
+    unsigned long* cursor = malloc(((unsigned long)vertexCount + 1) * sizeof(unsigned long));
+    if (targets == NULL || cursor == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for Graph targets.\n");
+        free(offsets);
+        free(targets);
+        free(cursor);
+        return false;
+    }
+    memcpy(cursor, offsets, ((unsigned long)vertexCount + 1) * sizeof(unsigned long));
+
+    for (unsigned long e = 0; e < edgeCount; ++e) {
+        uint32_t from = reverse ? edges[e].to : edges[e].from;
+        uint32_t to = reverse ? edges[e].from : edges[e].to;
+        targets[cursor[from]++] = to;
+        if (undirected && from != to) targets[cursor[to]++] = from;
+    }
+
+    free(cursor);
+    *outOffsets = offsets;
+    *outTargets = targets;
+    return true;
+}
+/* End build helpers **********************************************************/
+
+/******************************************************************************
+* graphInitFromEdges
+*
+* parameters:
+*  - edges : const GraphEdge*
+*  - edgeCount : unsigned long
+*  - vertexCount : uint32_t ; 0 to use the largest vertex id + 1
+*  - undirected : bool ; store every edge in both directions
+*
+* returns: Graph* ; NULL if an edge names a vertex >= vertexCount
+*
+* description: builds the CSR in two passes over edges; the edge list is
+*              not referenced afterwards
+*
+******************************************************************************/
+Graph* graphInitFromEdges(const GraphEdge* edges, unsigned long edgeCount, uint32_t vertexCount, bool undirected) {
+    if (edges == NULL && edgeCount > 0) {
+        fprintf(stderr, "ERROR: attempted to build Graph from NULL edge list.\n");
+        return NULL;
+    }
+
+    uint32_t largest = 0;
+    for (unsigned long e = 0; e < edgeCount; ++e) {
+        if (edges[e].from > largest) largest = edges[e].from;
+        if (edges[e].to > largest) largest = edges[e].to;
+    }
+    if (vertexCount == 0 && edgeCount > 0) vertexCount = largest + 1;
+    if (edgeCount > 0 && largest >= vertexCount) {
+        fprintf(stderr, "ERROR: Graph edge names vertex %u, but there are only %u vertices.\n", largest, vertexCount);
+        return NULL;
+    }
+
+    Graph* graph = malloc(sizeof(Graph));
+    if (graph == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for Graph.\n");
+        return NULL;
+    }
+    graph->vertexCount = vertexCount;
+    graph->undirected = undirected;
+
+    if (!__graphBuildCsr(edges, edgeCount, vertexCount, false, undirected, &graph->offsets, &graph->targets)) {
+        free(graph);
+        return NULL;
+    }
+    graph->edgeCount = graph->offsets[vertexCount];
+
+    if (undirected) {
+        graph->inOffsets = graph->offsets;
+        graph->inSources = graph->targets;
+    }
+    else if (!__graphBuildCsr(edges, edgeCount, vertexCount, true, false, &graph->inOffsets, &graph->inSources)) {
+        free(graph->offsets);
+        free(graph->targets);
+        free(graph);
+        return NULL;
+    }
+
+    return graph;
+}
+
+/* CSV loading helpers ********************************************************/
+typedef struct {
+    GraphEdge* edges;
+    unsigned long count;
+    unsigned long capacity;
+    bool failed;
+} __GraphEdgeBuffer;
+
+static bool __graphParseVertex(const char* text, uint32_t* vertex) {
+    char* end;
+    while (*text == ' ' || *text == '\t') text++;
+    if (*text < '0' || *text > '9') return false;
+    unsigned long value = strtoul(text, &end, 10);
+    while (*end == ' ' || *end == '\t' || *end == '\r' || *end == '\n') end++;
+    if (*end != '\0' || value >= GRAPH_UNREACHED) return false;
+    *vertex = (uint32_t)value;
+    return true;
+}
+
+static void __graphCollectEdge(size_t rowIndex, const char** columns, size_t columnCount, void* userData) {
+    __GraphEdgeBuffer* buffer = userData;
+    if (buffer->failed) return;
+
+    GraphEdge edge;
+    if (columnCount < 2 || !__graphParseVertex(columns[0], &edge.from) || !__graphParseVertex(columns[1], &edge.to)) {
+        // a header row is allowed; anything else is malformed
+        if (rowIndex == 0) return;
+        fprintf(stderr, "ERROR: Graph CSV row %zu is not a \"from,to\" pair of vertex ids.\n", rowIndex);
+        buffer->failed = true;
+        return;
+    }
+
+    if (buffer->count == buffer->capacity) {
+        unsigned long capacity = buffer->capacity ? buffer->capacity * 2 : 1024;
+        GraphEdge* grown = realloc(buffer->edges, capacity * sizeof(GraphEdge));
+        if (grown == NULL) {
+            fprintf(stderr, "ERROR: failed to grow Graph edge list.\n");
+            buffer->failed = true;
+            return;
+        }
+        buffer->edges = grown;
+        buffer->capacity = capacity;
+    }
+    buffer->edges[buffer->count++] = edge;
+}
+/* End CSV loading helpers ****************************************************/
+
+/******************************************************************************
+* graphLoadCsv
+*
+* parameters:
+*  - filePath : const char* ; one "from,to" edge per row, optional header
+*  - vertexCount : uint32_t ; 0 to use the largest vertex id + 1
+*  - undirected : bool
+*
+* returns: Graph* ; NULL if the file can't be read or a row is malformed
+*
+* description: reads the edge list with parseCsvFile (3_CommonParsing),
+*              then builds the CSR with graphInitFromEdges. Columns past the
+*              second (e.g. weights) are ignored.
+*
+******************************************************************************/
+Graph* graphLoadCsv(const char* filePath, uint32_t vertexCount, bool undirected) {
+    __GraphEdgeBuffer buffer = { NULL, 0, 0, false };
+    CsvParserConfig config = {
+        .delimiter = ',',
+        .quoteChar = '"',
+        .quotedFieldsAllowed = false,
+        .shouldTrimWhitespace = false,
+        .rowHandler = __graphCollectEdge,
+        .userData = &buffer
+    };
+
+    if (!parseCsvFile(filePath, &config) || buffer.failed) {
+        fprintf(stderr, "ERROR: failed to load Graph edges from %s.\n", filePath ? filePath : "(null)");
+        free(buffer.edges);
+        return NULL;
+    }
+
+    Graph* graph = graphInitFromEdges(buffer.edges, buffer.count, vertexCount, undirected);
+    free(buffer.edges);
+    return graph;
+}
+
+/******************************************************************************
+* graphDestroy
+*
+* parameters:
+*  - graph : Graph*
+*
+* returns: none
+*
+* description: frees both CSRs and the graph
+*
+******************************************************************************/
+void graphDestroy(Graph* graph) {
+    if (graph == NULL) {
+        fprintf(stderr, "ERROR: attempted to destroy NULL Graph*.\n");
+        return;
+    }
+
+    if (!graph->undirected) {
+        free(graph->inOffsets);
+        free(graph->inSources);
+    }
+    free(graph->offsets);
+    free(graph->targets);
+    free(graph);
+}
+
+/******************************************************************************
+* graphVertexCount / graphEdgeCount
+*
+* parameters:
+*  - graph : Graph*
+*
+* returns: uint32_t / unsigned long
+*
+* description: number of vertices / stored arcs (an undirected edge counts
+*              twice, a self-loop once)
+*
+******************************************************************************/
+uint32_t graphVertexCount(Graph* graph) {
+    return graph->vertexCount;
+}
+
+unsigned long graphEdgeCount(Graph* graph) {
+    return graph->edgeCount;
+}
+
+/******************************************************************************
+* graphNeighbors
+*
+* parameters:
+*  - graph : Graph*
+*  - vertex : uint32_t
+*  - degree : unsigned long* ; out, number of neighbors
+*
+* returns: const uint32_t* ; out-neighbors of vertex, NULL if out of range
+*
+* description: O(1); the array belongs to the graph
+*
+******************************************************************************/
+const uint32_t* graphNeighbors(Graph* graph, uint32_t vertex, unsigned long* degree) {
+    if (graph == NULL || vertex >= graph->vertexCount) {
+        fprintf(stderr, "ERROR: Graph vertex out of bounds.\n");
+        *degree = 0;
+        return NULL;
+    }
+
+    *degree = graph->offsets[vertex + 1] - graph->offsets[vertex];
+    return &graph->targets[graph->offsets[vertex]];
+}
+
+/******************************************************************************
+* graphBfs
+*
+* parameters:
+*  - graph : Graph*
+*  - source : uint32_t
+*  - distances : uint32_t* ; out, vertexCount entries; GRAPH_UNREACHED for
+*                vertices not reachable from source
+*
+* returns: unsigned long ; number of vertices reached, including source
+*
+* description: sequential top-down BFS with an array queue
+*
+******************************************************************************/
+unsigned long graphBfs(Graph* graph, uint32_t source, uint32_t* distances) {
+    if (graph == NULL || distances == NULL || source >= graph->vertexCount) {
+        fprintf(stderr, "ERROR: invalid Graph, distances or source for BFS.\n");
+        return 0;
+    }
+
+    uint32_t* queue = malloc((unsigned long)graph->vertexCount * sizeof(uint32_t));
+    if (queue == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for BFS queue.\n");
+        return 0;
+    }
+
+    for (uint32_t v = 0; v < graph->vertexCount; ++v) distances[v] = GRAPH_UNREACHED;
+    distances[source] = 0;
+    queue[0] = source;
+    unsigned long head = 0, tail = 1;
+
+    while (head < tail) {
+        uint32_t u = queue[head++];
+        for (unsigned long e = graph->offsets[u]; e < graph->offsets[u + 1]; ++e) {
+            uint32_t v = graph->targets[e];
+            if (distances[v] == GRAPH_UNREACHED) {
+                distances[v] = distances[u] + 1;
+                queue[tail++] = v;
+            }
+        }
+    }
+
+    free(queue);
+    return tail;
+}
+
+/******************************************************************************
+* graphDfs
+*
+* parameters:
+*  - graph : Graph*
+*  - source : uint32_t
+*  - visit : callback ; called in preorder, return false to stop early
+*  - context : void* ; passed through to visit
+*
+* returns: unsigned long ; number of vertices visited
+*
+* description: iterative DFS with an explicit stack of (vertex, next edge)
+*              so deep graphs can't overflow the call stack; neighbors are
+*              explored in adjacency order, as the recursive version would
+*
+******************************************************************************/
+unsigned long graphDfs(Graph* graph, uint32_t source, bool (*visit)(uint32_t vertex, void* context), void* context) {
+    if (graph == NULL || visit == NULL || source >= graph->vertexCount) {
+        fprintf(stderr, "ERROR: invalid Graph, visit or source for DFS.\n");
+        return 0;
+    }
+
+    uint32_t* stackVertex = malloc((unsigned long)graph->vertexCount * sizeof(uint32_t));
+    unsigned long* stackEdge = malloc((unsigned long)graph->vertexCount * sizeof(unsigned long));
+    uint8_t* seen = calloc(graph->vertexCount, 1);
+    if (stackVertex == NULL || stackEdge == NULL || seen == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for DFS stack.\n");
+        free(stackVertex);
+        free(stackEdge);
+        free(seen);
+        return 0;
+    }
+
+    unsigned long visited = 1, depth = 1;
+    bool keepGoing = visit(source, context);
+    seen[source] = 1;
+    stackVertex[0] = source;
+    stackEdge[0] = graph->offsets[source];
+
+    while (keepGoing && depth > 0) {
+        uint32_t u = stackVertex[depth - 1];
+        if (stackEdge[depth - 1] == graph->offsets[u + 1]) {
+            depth--;
+            continue;
+        }
+
+        uint32_t v = graph->targets[stackEdge[depth - 1]++];
+        if (seen[v]) continue;
+        seen[v] = 1;
+        visited++;
+        keepGoing = visit(v, context);
+        stackVertex[depth] = v;
+        stackEdge[depth] = graph->offsets[v];
+        depth++;
+    }
+
+    free(stackVertex);
+    free(stackEdge);
+    free(seen);
+    return visited;
+}
+
+/* Parallel BFS helpers *******************************************************/
+typedef struct {
+    Graph* graph;
+    atomic_uint* depth;
+    uint32_t level;
+    bool bottomUp;
+    bool finished;
+
+    // current frontier as a queue (top-down) or a bitmap (bottom-up)
+    uint32_t* frontier;
+    unsigned long frontierSize;
+    uint64_t* frontierBits;
+
+    // next frontier; bottom-up steps fill the bitmap as well as the queue
+    uint32_t* next;
+    atomic_ulong nextSize;
+    atomic_ulong nextEdges;         // sum of the next frontier's out-degrees
+    uint64_t* nextBits;
+
+    atomic_ulong nextChunk;         // work distribution within a step
+
+    // barrier for the calling thread and the workers; parties can drop if a
+    // worker fails to start
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    unsigned int parties;
+    unsigned int waiting;
+    unsigned long generation;
+} __GraphBfsShared;
+
+static void __graphBfsBarrier(__GraphBfsShared* shared) {
+    pthread_mutex_lock(&shared->lock);
+    unsigned long generation = shared->generation;
+    if (++shared->waiting >= shared->parties) {
+        shared->waiting = 0;
+        shared->generation++;
+        pthread_cond_broadcast(&shared->wake);
+    }
+    else {
+        while (generation == shared->generation) pthread_cond_wait(&shared->wake, &shared->lock);
+    }
+    pthread_mutex_unlock(&shared->lock);
+}
+
+static void __graphBfsFlush(__GraphBfsShared* shared, uint32_t* local, unsigned int count) {
+    unsigned long at = atomic_fetch_add_explicit(&shared->nextSize, count, memory_order_relaxed);
+    memcpy(&shared->next[at], local, count * sizeof(uint32_t));
+}
+
+// One level, run by every thread; work is handed out GRAPH_BFS_CHUNK items
+// at a time. Chunks are multiples of 64 vertices, so in a bottom-up step
+// each nextBits word has a single writer.
+static void __graphBfsStep(__GraphBfsShared* shared) {
+    Graph* graph = shared->graph;
+    uint32_t local[GRAPH_BFS_LOCAL_QUEUE];
+    unsigned int localCount = 0;
+    unsigned long edges = 0, begin;
+    uint32_t nextLevel = shared->level + 1;
+
+    if (!shared->bottomUp) {
+        while ((begin = atomic_fetch_add_explicit(&shared->nextChunk, GRAPH_BFS_CHUNK, memory_order_relaxed)) < shared->frontierSize) {
+            unsigned long end = begin + GRAPH_BFS_CHUNK < shared->frontierSize ? begin + GRAPH_BFS_CHUNK : shared->frontierSize;
+            for (unsigned long i = begin; i < end; ++i) {
+                uint32_t u = shared->frontier[i];
+                for (unsigned long e = graph->offsets[u]; e < graph->offsets[u + 1]; ++e) {
+                    uint32_t v = graph->targets[e];
+                    unsigned int expected = GRAPH_UNREACHED;
+                    if (atomic_load_explicit(&shared->depth[v], memory_order_relaxed) != GRAPH_UNREACHED) continue;
+                    if (!atomic_compare_exchange_strong_explicit(&shared->depth[v], &expected, nextLevel,
+                                                                 memory_order_relaxed, memory_order_relaxed)) continue;
+                    edges += graph->offsets[v + 1] - graph->offsets[v];
+                    local[localCount++] = v;
+                    if (localCount == GRAPH_BFS_LOCAL_QUEUE) {
+                        __graphBfsFlush(shared, local, localCount);
+                        localCount = 0;
+                    }
+                }
+            }
+        }
+    }
+    else {
+        while ((begin = atomic_fetch_add_explicit(&shared->nextChunk, GRAPH_BFS_CHUNK, memory_order_relaxed)) < graph->vertexCount) {
+            unsigned long end = begin + GRAPH_BFS_CHUNK < graph->vertexCount ? begin + GRAPH_BFS_CHUNK : graph->vertexCount;
+            for (unsigned long v = begin; v < end; ++v) {
+                if (atomic_load_explicit(&shared->depth[v], memory_order_relaxed) != GRAPH_UNREACHED) continue;
+                for (unsigned long e = graph->inOffsets[v]; e < graph->inOffsets[v + 1]; ++e) {
+                    uint32_t u = graph->inSources[e];
+                    if (!((shared->frontierBits[u >> 6] >> (u & 63)) & 1)) continue;
+
+                    atomic_store_explicit(&shared->depth[v], nextLevel, memory_order_relaxed);
+                    shared->nextBits[v >> 6] |= 1ULL << (v & 63);
+                    edges += graph->offsets[v + 1] - graph->offsets[v];
+                    local[localCount++] = (uint32_t)v;
+                    if (localCount == GRAPH_BFS_LOCAL_QUEUE) {
+                        __graphBfsFlush(shared, local, localCount);
+                        localCount = 0;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    if (localCount > 0) __graphBfsFlush(shared, local, localCount);
+    atomic_fetch_add_explicit(&shared->nextEdges, edges, memory_order_relaxed);
+}
+
+static void* __graphBfsWorker(void* arg) {
+    __GraphBfsShared* shared = arg;
+    while (true) {
+        __graphBfsBarrier(shared);
+        if (shared->finished) break;
+        __graphBfsStep(shared);
+        __graphBfsBarrier(shared);
+    }
+    return NULL;
+}
+/* End parallel BFS helpers ***************************************************/
+
+/******************************************************************************
+* graphBfsParallel
+*
+* parameters:
+*  - graph : Graph*
+*  - source : uint32_t
+*  - distances : uint32_t* ; out, as in graphBfs
+*  - threadCount : unsigned int ; including the calling thread
+*
+* returns: unsigned long ; number of vertices reached, including source
+*
+* description: level-synchronous direction-optimizing BFS. Each level, the
+*              calling thread picks the direction, then every thread runs
+*              the step between two barriers:
+*                top-down -> bottom-up when frontier edges >
+*                            unexplored edges / GRAPH_BFS_ALPHA
+*                bottom-up -> top-down when frontier vertices <
+*                             vertexCount / GRAPH_BFS_BETA
+*              Distances match graphBfs exactly; only the work differs.
+*
+******************************************************************************/
+unsigned long graphBfsParallel(Graph* graph, uint32_t source, uint32_t* distances, unsigned int threadCount) {
+    if (graph == NULL || distances == NULL || source >= graph->vertexCount) {
+        fprintf(stderr, "ERROR: invalid Graph, distances or source for BFS.\n");
+        return 0;
+    }
+    if (threadCount == 0) threadCount = 1;
+
+    unsigned long n = graph->vertexCount;
+    unsigned long words = (n + 63) / 64;
+    __GraphBfsShared shared;
+    shared.graph = graph;
+    shared.depth = malloc(n * sizeof(atomic_uint));
+    shared.frontier = malloc(n * sizeof(uint32_t));
+    shared.next = malloc(n * sizeof(uint32_t));
+    shared.frontierBits = calloc(words, sizeof(uint64_t));
+    shared.nextBits = calloc(words, sizeof(uint64_t));
+    pthread_t* threads = malloc(threadCount * sizeof(pthread_t));
+    if (shared.depth == NULL || shared.frontier == NULL || shared.next == NULL
+        || shared.frontierBits == NULL || shared.nextBits == NULL || threads == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for parallel BFS.\n");
+        free(shared.depth);
+        free(shared.frontier);
+        free(shared.next);
+        free(shared.frontierBits);
+        free(shared.nextBits);
+        free(threads);
+        return 0;
+    }
+
+    for (unsigned long v = 0; v < n; ++v) atomic_init(&shared.depth[v], GRAPH_UNREACHED);
+    atomic_init(&shared.depth[source], 0);
+    shared.frontier[0] = source;
+    shared.frontierSize = 1;
+    shared.level = 0;
+    shared.bottomUp = false;
+    shared.finished = false;
+    atomic_init(&shared.nextSize, 0);
+    atomic_init(&shared.nextEdges, 0);
+    atomic_init(&shared.nextChunk, 0);
+    pthread_mutex_init(&shared.lock, NULL);
+    pthread_cond_init(&shared.wake, NULL);
+    shared.parties = threadCount;
+    shared.waiting = 0;
+    shared.generation = 0;
+
+    unsigned int started = 1;
+    for (; started < threadCount; ++started) {
+        if (pthread_create(&threads[started], NULL, __graphBfsWorker, &shared) != 0) break;
+    }
+    if (started < threadCount) {
+        fprintf(stderr, "ERROR: failed to start BFS thread %u, continuing with %u.\n", started, started);
+        pthread_mutex_lock(&shared.lock);
+        shared.parties = started;
+        pthread_mutex_unlock(&shared.lock);
+    }
+
+    unsigned long reached = 1;
+    unsigned long frontierEdges = graph->offsets[source + 1] - graph->offsets[source];
+    unsigned long unexploredEdges = graph->edgeCount - frontierEdges;
+    bool bitsCurrent = false;       // frontierBits matches frontier
+
+    while (shared.frontierSize > 0) {
+        if (!shared.bottomUp && frontierEdges > unexploredEdges / GRAPH_BFS_ALPHA) shared.bottomUp = true;
+        else if (shared.bottomUp && shared.frontierSize < n / GRAPH_BFS_BETA) shared.bottomUp = false;
+
+        if (shared.bottomUp) {
+            if (!bitsCurrent) {
+                memset(shared.frontierBits, 0, words * sizeof(uint64_t));
+                for (unsigned long i = 0; i < shared.frontierSize; ++i) {
+                    shared.frontierBits[shared.frontier[i] >> 6] |= 1ULL << (shared.frontier[i] & 63);
+                }
+            }
+            memset(shared.nextBits, 0, words * sizeof(uint64_t));
+        }
+        atomic_store_explicit(&shared.nextSize, 0, memory_order_relaxed);
+        atomic_store_explicit(&shared.nextEdges, 0, memory_order_relaxed);
+        atomic_store_explicit(&shared.nextChunk, 0, memory_order_relaxed);
+
+        __graphBfsBarrier(&shared);
+        __graphBfsStep(&shared);
+        __graphBfsBarrier(&shared);
+
+        uint32_t* swapQueue = shared.frontier;
+        shared.frontier = shared.next;
+        shared.next = swapQueue;
+        shared.frontierSize = atomic_load_explicit(&shared.nextSize, memory_order_relaxed);
+        if (shared.bottomUp) {
+            uint64_t* swapBits = shared.frontierBits;
+            shared.frontierBits = shared.nextBits;
+            shared.nextBits = swapBits;
+        }
+        bitsCurrent = shared.bottomUp;
+
+        reached += shared.frontierSize;
+        frontierEdges = atomic_load_explicit(&shared.nextEdges, memory_order_relaxed);
+        unexploredEdges = (unexploredEdges > frontierEdges) ? unexploredEdges - frontierEdges : 0;
+        shared.level++;
+    }
+
+    shared.finished = true;
+    __graphBfsBarrier(&shared);
+    for (unsigned int t = 1; t < started; ++t) pthread_join(threads[t], NULL);
+
+    for (unsigned long v = 0; v < n; ++v) distances[v] = atomic_load_explicit(&shared.depth[v], memory_order_relaxed);
+
+    pthread_mutex_destroy(&shared.lock);
+    pthread_cond_destroy(&shared.wake);
+    free(shared.depth);
+    free(shared.frontier);
+    free(shared.next);
+    free(shared.frontierBits);
+    free(shared.nextBits);
+    free(threads);
+    return reached;
+}
+
+#endif /* GRAPH_H */
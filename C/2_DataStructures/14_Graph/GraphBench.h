@@ -0,0 +1,108 @@
+#ifndef GRAPHBENCH_H
+#define GRAPHBENCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <unistd.h>
+
+#include "Graph.h"
+#include "util.h"
+
+/******************************************************************************
+* GraphBench.h
+*
+* CSR build and BFS on an R-MAT graph (Chakrabarti et al.; a = 0.57,
+* b = c = 0.19), whose skewed degrees and small diameter are what
+* direction-optimizing BFS is designed for. 2^GRAPH_BENCH_SCALE vertices,
+* GRAPH_BENCH_EDGE_FACTOR undirected edges per vertex.
+*
+*  - build: two-pass CSR construction from the edge list
+*  - bfs: sequential top-down graphBfs
+*  - bfs parallel: graphBfsParallel with 1, 2 and 4 threads
+*
+* Edges checked per second (TEPS) use the input edge count, as in Graph500.
+*
+******************************************************************************/
+
+#define GRAPH_BENCH_SCALE 20
+#define GRAPH_BENCH_EDGE_FACTOR 16
+
+static unsigned long __graphBenchRandom(unsigned long* state) {
+    *state = *state * 6364136223846793005UL + 1442695040888963407UL;
+    return *state >> 33;
+}
+
+static GraphEdge* __graphBenchRmat(unsigned long edgeCount) {
+    GraphEdge* edges = malloc(edgeCount * sizeof(GraphEdge));
+    if (edges == NULL) return NULL;
+
+    unsigned long state = 42;
+    for (unsigned long e = 0; e < edgeCount; ++e) {
+        uint32_t from = 0, to = 0;
+        for (int bit = 0; bit < GRAPH_BENCH_SCALE; ++bit) {
+            unsigned long r = __graphBenchRandom(&state) % 100;
+            // quadrants: 57% top-left, 19% top-right, 19% bottom-left, 5% bottom-right
+            if (r >= 57 && r < 76) to |= 1u << bit;
+            else if (r >= 76 && r < 95) from |= 1u << bit;
+            else if (r >= 95) {
+                from |= 1u << bit;
+                to |= 1u << bit;
+            }
+        }
+        edges[e] = (GraphEdge){ from, to };
+    }
+    return edges;
+}
+
+void runGraphBenchmarks() {
+    uint32_t vertexCount = 1u << GRAPH_BENCH_SCALE;
+    unsigned long edgeCount = (unsigned long)vertexCount * GRAPH_BENCH_EDGE_FACTOR;
+
+    printf("\nGraph benchmarks: R-MAT scale %d, %lu undirected edges\n", GRAPH_BENCH_SCALE, edgeCount);
+    printf("=====================================================\n");
+
+    GraphEdge* edges = __graphBenchRmat(edgeCount);
+    uint32_t* distances = malloc(vertexCount * sizeof(uint32_t));
+    if (edges == NULL || distances == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate benchmark graph.\n");
+        free(edges);
+        free(distances);
+        return;
+    }
+
+    double start = benchSeconds();
+    Graph* graph = graphInitFromEdges(edges, edgeCount, vertexCount, true);
+    double buildSeconds = benchSeconds() - start;
+    free(edges);
+    if (graph == NULL) {
+        free(distances);
+        return;
+    }
+    printf("build          %7.3f s  (%.1f ns/edge, %.1f B/edge)\n", buildSeconds, buildSeconds * 1e9 / edgeCount,
+           (double)((vertexCount + 1UL) * sizeof(unsigned long) + graph->edgeCount * sizeof(uint32_t)) / edgeCount);
+
+    // start from the highest-degree vertex so the search covers the giant component
+    uint32_t source = 0;
+    for (uint32_t v = 1; v < vertexCount; ++v) {
+        if (graph->offsets[v + 1] - graph->offsets[v] > graph->offsets[source + 1] - graph->offsets[source]) source = v;
+    }
+
+    start = benchSeconds();
+    unsigned long reached = graphBfs(graph, source, distances);
+    double seconds = benchSeconds() - start;
+    printf("bfs            %7.3f s  (%.1f MTEPS, %lu reached)\n", seconds, edgeCount / seconds / 1e6, reached);
+
+    for (unsigned int threads = 1; threads <= 4; threads *= 2) {
+        start = benchSeconds();
+        reached = graphBfsParallel(graph, source, distances, threads);
+        seconds = benchSeconds() - start;
+        printf("bfs parallel %u %7.3f s  (%.1f MTEPS, %lu reached)\n", threads, seconds, edgeCount / seconds / 1e6, reached);
+    }
+    printf("(%ld CPUs online)\n", sysconf(_SC_NPROCESSORS_ONLN));
+
+    graphDestroy(graph);
+    free(distances);
+}
+
+#endif /* GRAPHBENCH_H */
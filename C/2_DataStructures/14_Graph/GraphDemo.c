@@ -0,0 +1,48 @@
+#include <stdio.h>
+
+#include "Graph.h"
+#include "GraphTest.h"
+
+#ifdef RUN_BENCHMARKS
+#include "GraphBench.h"
+#endif
+
+static const char* serverNames[] = { "gateway", "auth", "catalog", "orders", "payments", "inventory", "database", "reports" };
+
+static bool printServer(uint32_t vertex, void* context) {
+    printf("  %s\n", serverNames[vertex]);
+    return true;
+}
+
+int main() {
+    // Server dependency graph: "from,to" means from calls to
+    Graph* graph = graphLoadCsv("dependencies.csv", 8, false);
+    if (graph == NULL) return 1;
+
+    printf("%u servers, %lu dependencies\n", graphVertexCount(graph), graphEdgeCount(graph));
+
+    unsigned long degree;
+    const uint32_t* neighbors = graphNeighbors(graph, 3, &degree);
+    printf("%s calls:", serverNames[3]);
+    for (unsigned long i = 0; i < degree; ++i) printf(" %s", serverNames[neighbors[i]]);
+    printf("\n");
+
+    uint32_t hops[8];
+    graphBfsParallel(graph, 0, hops, 2);
+    printf("Hops from %s:\n", serverNames[0]);
+    for (uint32_t v = 0; v < 8; ++v) {
+        if (hops[v] == GRAPH_UNREACHED) printf("  %-10s unreachable\n", serverNames[v]);
+        else printf("  %-10s %u\n", serverNames[v], hops[v]);
+    }
+
+    printf("Depth-first from %s:\n", serverNames[0]);
+    graphDfs(graph, 0, printServer, NULL);
+
+    graphDestroy(graph);
+
+    runGraphTests();
+
+#ifdef RUN_BENCHMARKS
+    runGraphBenchmarks();
+#endif
+}
\ No newline at end of file
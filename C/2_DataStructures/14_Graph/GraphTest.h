@@ -0,0 +1,225 @@
+#ifndef GRAPHTEST_H
+#define GRAPHTEST_H
+
+#include <unistd.h>
+
+#include "Graph.h"
+#include "TestsSummary.h"
+
+/* Testing functions **********************************************************/
+void testGraphBuild();
+void testGraphBfs();
+void testGraphDfs();
+void testGraphBfsParallel();
+void testGraphLoadCsv();
+/* End testing functions ******************************************************/
+
+/* Test setup/teardown functions **********************************************/
+// Edge list of a random graph; the caller frees it
+GraphEdge* SetUp(uint32_t vertexCount, unsigned long edgeCount, unsigned long seed) {
+    GraphEdge* edges = malloc(edgeCount * sizeof(GraphEdge));
+    unsigned long state = seed;
+    for (unsigned long e = 0; e < edgeCount; ++e) {
+        state = state * 6364136223846793005UL + 1442695040888963407UL;
+        edges[e].from = (uint32_t)((state >> 33) % vertexCount);
+        state = state * 6364136223846793005UL + 1442695040888963407UL;
+        edges[e].to = (uint32_t)((state >> 33) % vertexCount);
+    }
+    return edges;
+}
+
+void TearDown(Graph* graph, GraphEdge* edges) {
+    graphDestroy(graph);
+    free(edges);
+}
+/* End test setup/teardown functions ******************************************/
+
+#define GRAPH_TEST_VERTICES 20000
+#define GRAPH_TEST_THREADS 4
+
+void runGraphTests() {
+    TestsSummaryPrintHeader("Graph");
+
+    testGraphBuild();
+    testGraphBfs();
+    testGraphDfs();
+    testGraphBfsParallel();
+    testGraphLoadCsv();
+
+    TestsSummaryPrintFooter("Graph");
+}
+
+void testGraphBuild() {
+    int successes = 0, failures = 0;
+    GraphEdge edges[] = { { 0, 1 }, { 0, 2 }, { 2, 1 }, { 3, 3 }, { 0, 3 } };
+
+    Graph* directed = graphInitFromEdges(edges, 5, 0, false);
+    unsigned long degree;
+    const uint32_t* neighbors = graphNeighbors(directed, 0, &degree);
+    if (graphVertexCount(directed) != 4 || graphEdgeCount(directed) != 5
+        || degree != 3 || neighbors[0] != 1 || neighbors[1] != 2 || neighbors[2] != 3) {
+        printf("FAILED: testGraphBuild: wrong directed CSR\n");
+        failures++;
+    }
+    else successes++;
+
+    // reverse CSR: in-neighbors of 1 are 0 then 2
+    if (directed->inOffsets[2] - directed->inOffsets[1] != 2
+        || directed->inSources[directed->inOffsets[1]] != 0 || directed->inSources[directed->inOffsets[1] + 1] != 2) {
+        printf("FAILED: testGraphBuild: wrong reverse CSR\n");
+        failures++;
+    }
+    else successes++;
+
+    // undirected: both directions, the self-loop only once
+    Graph* undirected = graphInitFromEdges(edges, 5, 6, true);
+    graphNeighbors(undirected, 3, &degree);
+    unsigned long isolated;
+    graphNeighbors(undirected, 5, &isolated);
+    if (graphVertexCount(undirected) != 6 || graphEdgeCount(undirected) != 9 || degree != 2 || isolated != 0) {
+        printf("FAILED: testGraphBuild: wrong undirected CSR\n");
+        failures++;
+    }
+    else successes++;
+
+    if (graphInitFromEdges(edges, 5, 3, false) != NULL) {
+        printf("FAILED: testGraphBuild: accepted an edge to a vertex past vertexCount\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("GraphBuild", successes, failures);
+    graphDestroy(directed);
+    graphDestroy(undirected);
+}
+
+void testGraphBfs() {
+    int successes = 0, failures = 0;
+
+    // path 0 -> 1 -> ... -> 9, plus a shortcut 0 -> 5 and an unreachable 10 -> 0
+    GraphEdge edges[11];
+    for (uint32_t v = 0; v < 9; ++v) edges[v] = (GraphEdge){ v, v + 1 };
+    edges[9] = (GraphEdge){ 0, 5 };
+    edges[10] = (GraphEdge){ 10, 0 };
+    Graph* graph = graphInitFromEdges(edges, 11, 0, false);
+
+    uint32_t distances[11];
+    uint32_t expected[11] = { 0, 1, 2, 3, 4, 1, 2, 3, 4, 5, GRAPH_UNREACHED };
+    unsigned long reached = graphBfs(graph, 0, distances);
+    if (reached != 10 || memcmp(distances, expected, sizeof(expected)) != 0) {
+        printf("FAILED: testGraphBfs: wrong distances\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("GraphBfs", successes, failures);
+    graphDestroy(graph);
+}
+
+typedef struct {
+    uint32_t order[16];
+    int count;
+    int limit;
+} __GraphTestVisits;
+
+static bool __graphTestRecord(uint32_t vertex, void* context) {
+    __GraphTestVisits* visits = context;
+    visits->order[visits->count++] = vertex;
+    return visits->count < visits->limit;
+}
+
+void testGraphDfs() {
+    int successes = 0, failures = 0;
+
+    // 0 -> {1, 4}, 1 -> {2, 3}, 3 -> 5, 4 -> 5, 5 -> 0; 5 is first reached from 3
+    GraphEdge edges[] = { { 0, 1 }, { 0, 4 }, { 1, 2 }, { 1, 3 }, { 3, 5 }, { 4, 5 }, { 5, 0 } };
+    Graph* graph = graphInitFromEdges(edges, 7, 0, false);
+
+    __GraphTestVisits visits = { { 0 }, 0, 16 };
+    uint32_t expected[] = { 0, 1, 2, 3, 5, 4 };
+    if (graphDfs(graph, 0, __graphTestRecord, &visits) != 6 || visits.count != 6
+        || memcmp(visits.order, expected, sizeof(expected)) != 0) {
+        printf("FAILED: testGraphDfs: wrong preorder\n");
+        failures++;
+    }
+    else successes++;
+
+    __GraphTestVisits stopped = { { 0 }, 0, 3 };
+    if (graphDfs(graph, 0, __graphTestRecord, &stopped) != 3 || stopped.count != 3) {
+        printf("FAILED: testGraphDfs: visit returning false did not stop the search\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("GraphDfs", successes, failures);
+    graphDestroy(graph);
+}
+
+void testGraphBfsParallel() {
+    int successes = 0, failures = 0;
+    uint32_t* expected = malloc(GRAPH_TEST_VERTICES * sizeof(uint32_t));
+    uint32_t* distances = malloc(GRAPH_TEST_VERTICES * sizeof(uint32_t));
+
+    // sparse graphs stay mostly top-down, dense ones switch to bottom-up
+    unsigned long edgeCounts[] = { GRAPH_TEST_VERTICES, GRAPH_TEST_VERTICES * 4, GRAPH_TEST_VERTICES * 32 };
+    bool matches = true;
+    for (int density = 0; density < 3; ++density) {
+        for (int undirected = 0; undirected <= 1; ++undirected) {
+            GraphEdge* edges = SetUp(GRAPH_TEST_VERTICES, edgeCounts[density], density * 2 + undirected + 1);
+            Graph* graph = graphInitFromEdges(edges, edgeCounts[density], GRAPH_TEST_VERTICES, undirected);
+
+            unsigned long reached = graphBfs(graph, 0, expected);
+            for (unsigned int threads = 1; threads <= GRAPH_TEST_THREADS; ++threads) {
+                if (graphBfsParallel(graph, 0, distances, threads) != reached
+                    || memcmp(distances, expected, GRAPH_TEST_VERTICES * sizeof(uint32_t)) != 0) {
+                    matches = false;
+                }
+            }
+            TearDown(graph, edges);
+        }
+    }
+    if (!matches) {
+        printf("FAILED: testGraphBfsParallel: distances differ from sequential BFS\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("GraphBfsParallel", successes, failures);
+    free(expected);
+    free(distances);
+}
+
+void testGraphLoadCsv() {
+    int successes = 0, failures = 0;
+
+    char path[] = "/tmp/graphTestXXXXXX";
+    int fd = mkstemp(path);
+    FILE* file = fdopen(fd, "w");
+    fprintf(file, "from,to\n0,1\n1,2\n2,0\n2,3\n");
+    fclose(file);
+
+    Graph* graph = graphLoadCsv(path, 0, false);
+    unsigned long degree = 0;
+    const uint32_t* neighbors = graph ? graphNeighbors(graph, 2, &degree) : NULL;
+    if (graph == NULL || graphVertexCount(graph) != 4 || graphEdgeCount(graph) != 4
+        || degree != 2 || neighbors[0] != 0 || neighbors[1] != 3) {
+        printf("FAILED: testGraphLoadCsv: wrong graph from CSV\n");
+        failures++;
+    }
+    else successes++;
+    if (graph != NULL) graphDestroy(graph);
+
+    file = fopen(path, "w");
+    fprintf(file, "0,1\n1,x\n");
+    fclose(file);
+    if (graphLoadCsv(path, 0, false) != NULL) {
+        printf("FAILED: testGraphLoadCsv: accepted a malformed row\n");
+        failures++;
+    }
+    else successes++;
+
+    unlink(path);
+    TestsSummaryPrintResults("GraphLoadCsv", successes, failures);
+}
+
+#endif /* GRAPHTEST_H */
@@ -0,0 +1,347 @@
+#ifndef INTERVALINDEX_H
+#define INTERVALINDEX_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+/******************************************************************************
+* IntervalIndex
+*
+* implementation: static interval index over half-open [start, end)
+*                 intervals of epoch seconds, built once in bulk. It has two
+*                 parts:
+*                   - the intervals sorted by start
+*                   - a centered interval tree (Edelsbrunner) over them. Each
+*                     node has a center point and holds the intervals that
+*                     contain it twice, sorted by ascending start and by
+*                     descending end. Intervals wholly left of the center go
+*                     to the left subtree, those wholly right to the right.
+*
+*                 Stabbing query t: walk from the root towards t. At each
+*                 node, scan the list sorted by start (t < center) or by
+*                 end (t >= center), and stop at the first interval that
+*                 doesn't contain t. O(log n + k).
+*
+*                 Overlap query [low, high): every hit either contains low
+*                 (a stabbing query) or starts inside (low, high) (a binary
+*                 search on the sorted starts plus a scan). The two sets
+*                 are disjoint, so nothing is reported twice. O(log n + k).
+*
+*                 The center is the median start of the node's intervals,
+*                 so the tree has O(log n) depth. Building is O(n log n),
+*                 and nodes and lists live in flat arrays.
+*
+* structures
+*  - Interval: start, end, value (e.g. the index of the record it came from)
+*  - IntervalNode: center, slice of the two lists, children
+*  - IntervalIndex: sorted intervals, nodes and lists
+*
+******************************************************************************/
+
+#define INTERVALINDEX_VALUE long
+
+typedef struct Interval {
+    long long start;        // inclusive
+    long long end;          // exclusive, > start
+    INTERVALINDEX_VALUE value;
+} Interval;
+
+typedef struct IntervalNode {
+    long long center;
+    unsigned long first;    // this node's intervals are byStart/byEnd[first .. first + count)
+    unsigned long count;
+    long left;              // node index, -1 if none
+    long right;
+} IntervalNode;
+
+typedef struct IntervalIndex {
+    Interval* intervals;    // sorted by start
+    unsigned long size;
+    IntervalNode* nodes;
+    unsigned long nodeCount;
+    unsigned long* byStart; // positions in intervals, per node ascending start
+    unsigned long* byEnd;   // positions in intervals, per node descending end
+    long root;
+} IntervalIndex;
+
+/* Build helpers **************************************************************/
+static int __intervalCompareStart(const void* a, const void* b) {
+    const Interval* x = a;
+    const Interval* y = b;
+    if (x->start != y->start) return (x->start < y->start) ? -1 : 1;
+    return (x->end < y->end) ? -1 : (x->end > y->end);
+}
+
+// qsort has no context argument, so the per-node end sort compares
+// positions through this file-scope pointer; building is single-threaded
+static const Interval* __intervalSortBase;
+
+static int __intervalCompareEndDescending(const void* a, const void* b) {
+    long long x = __intervalSortBase[*(const unsigned long*)a].end;
+    long long y = __intervalSortBase[*(const unsigned long*)b].end;
+    return (x > y) ? -1 : (x < y);
+}
+
+// positions[0 .. count) are in start order; scratch has room for count.
+// Returns the node index, or -1 for an empty set.
+static long __intervalIndexBuildNode(IntervalIndex* index, unsigned long* positions, unsigned long count,
+                                     unsigned long* scratch, unsigned long* listEnd) {
+    if (count == 0) return -1;
+
+    long long center = index->intervals[positions[count / 2]].start;
+    long node = (long)index->nodeCount++;
+    unsigned long leftCount = 0, rightCount = 0, here = 0;
+
+    // stable three-way split: left part into positions, right part into
+    // scratch, and this node's intervals straight into the lists
+    for (unsigned long i = 0; i < count; ++i) {
+        const Interval* interval = &index->intervals[positions[i]];
+        if (interval->end <= center) positions[leftCount++] = positions[i];
+        else if (interval->start > center) scratch[rightCount++] = positions[i];
+        else index->byStart[*listEnd + here++] = positions[i];
+    }
+
+    IntervalNode* n = &index->nodes[node];
+    n->center = center;
+    n->first = *listEnd;
+    n->count = here;
+    memcpy(&index->byEnd[n->first], &index->byStart[n->first], here * sizeof(unsigned long));
+    __intervalSortBase = index->intervals;
+    qsort(&index->byEnd[n->first], here, sizeof(unsigned long), __intervalCompareEndDescending);
+    *listEnd += here;
+
+    // the right part moves to the tail of positions, freeing scratch for the
+    // recursion; both parts are still in start order
+    memcpy(&positions[count - rightCount], scratch, rightCount * sizeof(unsigned long));
+    long left = __intervalIndexBuildNode(index, positions, leftCount, scratch, listEnd);
+    long right = __intervalIndexBuildNode(index, &positions[count - rightCount], rightCount, scratch, listEnd);
+    index->nodes[node].left = left;
+    index->nodes[node].right = right;
+    return node;
+}
+/* End build helpers **********************************************************/
+
+/******************************************************************************
+* intervalIndexBuild
+*
+* parameters:
+*  - intervals : const Interval* ; copied, may be freed afterwards
+*  - count : unsigned long
+*
+* returns: IntervalIndex* ; NULL if an interval has end <= start
+*
+* description: bulk build in O(n log n): one sort by start, then the tree is
+*              built top-down, each level splitting its parent's
+*              start-ordered positions stably
+*
+******************************************************************************/
+IntervalIndex* intervalIndexBuild(const Interval* intervals, unsigned long count) {
+    if (intervals == NULL && count > 0) {
+        fprintf(stderr, "ERROR: attempted to build IntervalIndex from NULL intervals.\n");
+        return NULL;
+    }
+    for (unsigned long i = 0; i < count; ++i) {
+        if (intervals[i].end <= intervals[i].start) {
+            fprintf(stderr, "ERROR: interval %lu is empty (end <= start).\n", i);
+            return NULL;
+        }
+    }
+
+    IntervalIndex* index = malloc(sizeof(IntervalIndex));
+    if (index == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for IntervalIndex.\n");
+        return NULL;
+    }
+
+    // every node holds at least its median interval, so count nodes is enough
+    unsigned long slots = count ? count : 1;
+    index->intervals = malloc(slots * sizeof(Interval));
+    index->nodes = malloc(slots * sizeof(IntervalNode));
+    index->byStart = malloc(slots * sizeof(unsigned long));
+    index->byEnd = malloc(slots * sizeof(unsigned long));
+    unsigned long* positions = malloc(slots * sizeof(unsigned long));
+    unsigned long* scratch = malloc(slots * sizeof(unsigned long));
+    if (index->intervals == NULL || index->nodes == NULL || index->byStart == NULL
+        || index->byEnd == NULL || positions == NULL || scratch == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for IntervalIndex arrays.\n");
+        free(index->intervals);
+        free(index->nodes);
+        free(index->byStart);
+        free(index->byEnd);
+        free(positions);
+        free(scratch);
+        free(index);
+        return NULL;
+    }
+
+    if (count > 0) memcpy(index->intervals, intervals, count * sizeof(Interval));
+    qsort(index->intervals, count, sizeof(Interval), __intervalCompareStart);
+    index->size = count;
+    index->nodeCount = 0;
+
+    for (unsigned long i = 0; i < count; ++i) positions[i] = i;
+    unsigned long listEnd = 0;
+    index->root = __intervalIndexBuildNode(index, positions, count, scratch, &listEnd);
+
+    free(positions);
+    free(scratch);
+    return index;
+}
+
+/******************************************************************************
+* intervalIndexDestroy
+*
+* parameters:
+*  - index : IntervalIndex*
+*
+* returns: none
+*
+* description: frees the index
+*
+******************************************************************************/
+void intervalIndexDestroy(IntervalIndex* index) {
+    if (index == NULL) {
+        fprintf(stderr, "ERROR: attempted to destroy NULL IntervalIndex*.\n");
+        return;
+    }
+
+    free(index->intervals);
+    free(index->nodes);
+    free(index->byStart);
+    free(index->byEnd);
+    free(index);
+}
+
+/******************************************************************************
+* intervalIndexSize
+*
+* parameters:
+*  - index : IntervalIndex*
+*
+* returns: unsigned long
+*
+* description: number of intervals
+*
+******************************************************************************/
+unsigned long intervalIndexSize(IntervalIndex* index) {
+    if (index == NULL) {
+        fprintf(stderr, "ERROR: attempted to access size of NULL IntervalIndex*.\n");
+        return 0;
+    }
+
+    return index->size;
+}
+
+/* Query helpers **************************************************************/
+// Stabbing walk shared by both queries; *stopped is set if visit asked to stop
+static unsigned long __intervalIndexStab(IntervalIndex* index, long long point,
+                                         bool (*visit)(const Interval* interval, void* context), void* context,
+                                         bool* stopped) {
+    unsigned long visited = 0;
+    long node = index->root;
+
+    while (node >= 0) {
+        const IntervalNode* n = &index->nodes[node];
+        if (point < n->center) {
+            // every interval here ends after center > point
+            for (unsigned long i = n->first; i < n->first + n->count; ++i) {
+                const Interval* interval = &index->intervals[index->byStart[i]];
+                if (interval->start > point) break;
+                visited++;
+                if (!visit(interval, context)) {
+                    *stopped = true;
+                    return visited;
+                }
+            }
+            node = n->left;
+        }
+        else {
+            // every interval here starts at or before center <= point
+            for (unsigned long i = n->first; i < n->first + n->count; ++i) {
+                const Interval* interval = &index->intervals[index->byEnd[i]];
+                if (interval->end <= point) break;
+                visited++;
+                if (!visit(interval, context)) {
+                    *stopped = true;
+                    return visited;
+                }
+            }
+            node = n->right;
+        }
+    }
+    return visited;
+}
+/* End query helpers **********************************************************/
+
+/******************************************************************************
+* intervalIndexStab
+*
+* parameters:
+*  - index : IntervalIndex*
+*  - point : long long
+*  - visit : callback ; return false to stop early
+*  - context : void* ; passed through to visit
+*
+* returns: unsigned long ; number of intervals visited
+*
+* description: visits every interval with start <= point < end, in no
+*              particular order
+*
+******************************************************************************/
+unsigned long intervalIndexStab(IntervalIndex* index, long long point,
+                                bool (*visit)(const Interval* interval, void* context), void* context) {
+    if (index == NULL || visit == NULL) {
+        fprintf(stderr, "ERROR: attempted to query NULL IntervalIndex* or with NULL visit.\n");
+        return 0;
+    }
+
+    bool stopped = false;
+    return __intervalIndexStab(index, point, visit, context, &stopped);
+}
+
+/******************************************************************************
+* intervalIndexOverlap
+*
+* parameters:
+*  - index : IntervalIndex*
+*  - low : long long ; inclusive
+*  - high : long long ; exclusive
+*  - visit : callback ; return false to stop early
+*  - context : void* ; passed through to visit
+*
+* returns: unsigned long ; number of intervals visited
+*
+* description: visits every interval overlapping [low, high), i.e. with
+*              start < high and end > low: first those containing low, then
+*              those starting in (low, high) in start order
+*
+******************************************************************************/
+unsigned long intervalIndexOverlap(IntervalIndex* index, long long low, long long high,
+                                   bool (*visit)(const Interval* interval, void* context), void* context) {
+    if (index == NULL || visit == NULL) {
+        fprintf(stderr, "ERROR: attempted to query NULL IntervalIndex* or with NULL visit.\n");
+        return 0;
+    }
+    if (high <= low) return 0;
+
+    bool stopped = false;
+    unsigned long visited = __intervalIndexStab(index, low, visit, context, &stopped);
+    if (stopped) return visited;
+
+    // first interval starting after low
+    unsigned long lo = 0, hi = index->size;
+    while (lo < hi) {
+        unsigned long mid = lo + (hi - lo) / 2;
+        if (index->intervals[mid].start <= low) lo = mid + 1;
+        else hi = mid;
+    }
+    for (unsigned long i = lo; i < index->size && index->intervals[i].start < high; ++i) {
+        visited++;
+        if (!visit(&index->intervals[i], context)) break;
+    }
+    return visited;
+}
+
+#endif /* INTERVALINDEX_H */
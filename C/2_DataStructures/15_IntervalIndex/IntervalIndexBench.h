@@ -0,0 +1,74 @@
+#ifndef INTERVALINDEXBENCH_H
+#define INTERVALINDEXBENCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "IntervalIndex.h"
+#include "util.h"
+
+/******************************************************************************
+* IntervalIndexBench.h
+*
+* IntervalIndex vs. a linear scan over the same intervals, for overlap
+* queries on an event-log-like workload: INTERVALINDEX_BENCH_COUNT events
+* spread over 30 days, lasting minutes to hours, queried with windows
+* of 5 minutes (incident windows).
+*
+******************************************************************************/
+
+#define INTERVALINDEX_BENCH_COUNT 1000000UL
+#define INTERVALINDEX_BENCH_QUERIES 2000UL
+
+static bool __intervalIndexBenchCount(const Interval* interval, void* context) {
+    (*(unsigned long*)context)++;
+    return true;
+}
+
+void runIntervalIndexBenchmarks() {
+    const long long days = 30 * 86400LL;
+    Interval* intervals = malloc(INTERVALINDEX_BENCH_COUNT * sizeof(Interval));
+    if (intervals == NULL) return;
+
+    unsigned long state = 7;
+    for (unsigned long i = 0; i < INTERVALINDEX_BENCH_COUNT; ++i) {
+        state = state * 6364136223846793005UL + 1442695040888963407UL;
+        long long start = (long long)((state >> 33) % days);
+        state = state * 6364136223846793005UL + 1442695040888963407UL;
+        long long length = 60 + (long long)((state >> 33) % 7200);
+        intervals[i] = (Interval){ start, start + length, (INTERVALINDEX_VALUE)i };
+    }
+
+    printf("\nIntervalIndex benchmarks: %lu intervals, %lu overlap queries\n", INTERVALINDEX_BENCH_COUNT, INTERVALINDEX_BENCH_QUERIES);
+    printf("==============================================================\n");
+
+    double start = benchSeconds();
+    IntervalIndex* index = intervalIndexBuild(intervals, INTERVALINDEX_BENCH_COUNT);
+    printf("build        %8.3f s\n", benchSeconds() - start);
+
+    unsigned long indexHits = 0, scanHits = 0;
+    start = benchSeconds();
+    for (unsigned long q = 0; q < INTERVALINDEX_BENCH_QUERIES; ++q) {
+        long long low = (long long)(q * (days / INTERVALINDEX_BENCH_QUERIES));
+        intervalIndexOverlap(index, low, low + 300, __intervalIndexBenchCount, &indexHits);
+    }
+    double indexSeconds = benchSeconds() - start;
+
+    start = benchSeconds();
+    for (unsigned long q = 0; q < INTERVALINDEX_BENCH_QUERIES; ++q) {
+        long long low = (long long)(q * (days / INTERVALINDEX_BENCH_QUERIES));
+        for (unsigned long i = 0; i < INTERVALINDEX_BENCH_COUNT; ++i) {
+            if (intervals[i].start < low + 300 && intervals[i].end > low) scanHits++;
+        }
+    }
+    double scanSeconds = benchSeconds() - start;
+
+    printf("index        %8.3f s  (%8.2f us/query, %lu hits)\n", indexSeconds, indexSeconds * 1e6 / INTERVALINDEX_BENCH_QUERIES, indexHits);
+    printf("linear scan  %8.3f s  (%8.2f us/query, %lu hits)\n", scanSeconds, scanSeconds * 1e6 / INTERVALINDEX_BENCH_QUERIES, scanHits);
+
+    intervalIndexDestroy(index);
+    free(intervals);
+}
+
+#endif /* INTERVALINDEXBENCH_H */
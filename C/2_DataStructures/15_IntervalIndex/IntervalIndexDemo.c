@@ -0,0 +1,80 @@
+#include <stdio.h>
+
+#include "IntervalIndex.h"
+#include "LogIntervals.h"
+#include "IntervalIndexTest.h"
+
+#ifdef RUN_BENCHMARKS
+#include "IntervalIndexBench.h"
+#endif
+
+typedef struct {
+    const EventLog* events;
+    const ErrorDetail* errors;
+} LogRecords;
+
+static bool printEvent(const Interval* interval, void* context) {
+    const EventLog* event = &((const LogRecords*)context)->events[interval->value];
+    printf("  EVT%03d server %d %s %s\n", event->eventId, event->serverId, event->timestamp, event->message);
+    return true;
+}
+
+static bool printError(const Interval* interval, void* context) {
+    const ErrorDetail* error = &((const LogRecords*)context)->errors[interval->value];
+    printf("  ERR%d server %d %s %s\n", error->errorId, error->serverId, error->timestamp, error->errorCode);
+    return true;
+}
+
+int main() {
+    FILE* file = fopen("../../../__common/formatted.txt", "r");
+    if (file == NULL) {
+        fprintf(stderr, "ERROR: failed to open formatted.txt\n");
+        return 1;
+    }
+
+    // zeroed: the parsers strncpy size - 1 bytes and rely on the terminator
+    ServerInfo servers[FORMATTED_H_MAX_ENTRIES] = { 0 };
+    EventLog events[FORMATTED_H_MAX_ENTRIES] = { 0 };
+    ErrorDetail errors[FORMATTED_H_MAX_ENTRIES] = { 0 };
+    int serverCount = 0, eventCount = 0, errorCount = 0;
+    char line[FORMATTED_H_MAX_LINE_LENGTH];
+    while (fgets(line, FORMATTED_H_MAX_LINE_LENGTH, file)) {
+        if (strstr(line, "--- Server Information")) {
+            parseServerInfo(file, servers, &serverCount, line);
+            parseEventLogs(file, events, &eventCount, line);
+            parseErrorDetails(file, errors, &errorCount, line);
+        }
+    }
+    fclose(file);
+
+    // a server's state holds until its next event, or an hour; errors open 30 minute incidents
+    Interval intervals[FORMATTED_H_MAX_ENTRIES];
+    IntervalIndex* eventIndex = intervalIndexBuild(intervals, eventLogIntervals(events, eventCount, 3600, intervals));
+    IntervalIndex* errorIndex = intervalIndexBuild(intervals, errorDetailIntervals(errors, errorCount, 1800, intervals));
+    if (eventIndex == NULL || errorIndex == NULL) return 1;
+    LogRecords records = { events, errors };
+
+    long long low, high;
+    timestampToEpoch("2024-10-26 18:00:00", &low);
+    timestampToEpoch("2024-10-26 18:30:00", &high);
+    printf("Incident window 2024-10-26 18:00:00 - 18:30:00\n");
+    printf("Server states overlapping:\n");
+    intervalIndexOverlap(eventIndex, low, high, printEvent, &records);
+    printf("Errors overlapping:\n");
+    intervalIndexOverlap(errorIndex, low, high, printError, &records);
+
+    long long point;
+    timestampToEpoch("2024-10-27 01:30:00", &point);
+    printf("In effect at 2024-10-27 01:30:00:\n");
+    intervalIndexStab(eventIndex, point, printEvent, &records);
+    intervalIndexStab(errorIndex, point, printError, &records);
+
+    intervalIndexDestroy(eventIndex);
+    intervalIndexDestroy(errorIndex);
+
+    runIntervalIndexTests();
+
+#ifdef RUN_BENCHMARKS
+    runIntervalIndexBenchmarks();
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,223 @@
+#ifndef INTERVALINDEXTEST_H
+#define INTERVALINDEXTEST_H
+
+#include "IntervalIndex.h"
+#include "LogIntervals.h"
+#include "TestsSummary.h"
+
+/* Testing functions **********************************************************/
+void testIntervalIndexStab();
+void testIntervalIndexOverlap();
+void testIntervalIndexEdges();
+void testIntervalIndexLogIntervals();
+/* End testing functions ******************************************************/
+
+/* Test setup/teardown functions **********************************************/
+// Random intervals with a mix of short and very long extents; the caller
+// frees them
+Interval* SetUp(unsigned long count, unsigned long seed) {
+    Interval* intervals = malloc(count * sizeof(Interval));
+    unsigned long state = seed;
+    for (unsigned long i = 0; i < count; ++i) {
+        state = state * 6364136223846793005UL + 1442695040888963407UL;
+        long long start = (long long)((state >> 33) % 100000);
+        state = state * 6364136223846793005UL + 1442695040888963407UL;
+        long long length = 1 + (long long)((state >> 33) % ((i % 10 == 0) ? 20000 : 100));
+        intervals[i] = (Interval){ start, start + length, (INTERVALINDEX_VALUE)i };
+    }
+    return intervals;
+}
+
+void TearDown(IntervalIndex* index, Interval* intervals) {
+    intervalIndexDestroy(index);
+    free(intervals);
+}
+/* End test setup/teardown functions ******************************************/
+
+#define INTERVALINDEX_TEST_COUNT 5000
+
+// These tests assume INTERVALINDEX_VALUE is an integer
+void runIntervalIndexTests() {
+    TestsSummaryPrintHeader("IntervalIndex");
+
+    testIntervalIndexStab();
+    testIntervalIndexOverlap();
+    testIntervalIndexEdges();
+    testIntervalIndexLogIntervals();
+
+    TestsSummaryPrintFooter("IntervalIndex");
+}
+
+typedef struct {
+    unsigned char* seen;    // per value, how many times it was visited
+    unsigned long count;
+} __IntervalIndexTestHits;
+
+static bool __intervalIndexTestRecord(const Interval* interval, void* context) {
+    __IntervalIndexTestHits* hits = context;
+    hits->seen[interval->value]++;
+    hits->count++;
+    return true;
+}
+
+static bool __intervalIndexTestStopAtTwo(const Interval* interval, void* context) {
+    return ++*(int*)context < 2;
+}
+
+// Every interval overlapping [low, high) visited exactly once, nothing else
+bool __intervalIndexTestMatches(const Interval* intervals, unsigned long count, long long low, long long high,
+                                const __IntervalIndexTestHits* hits, unsigned long visited) {
+    unsigned long expected = 0;
+    for (unsigned long i = 0; i < count; ++i) {
+        bool overlaps = intervals[i].start < high && intervals[i].end > low;
+        if (hits->seen[i] != (overlaps ? 1 : 0)) return false;
+        expected += overlaps;
+    }
+    return hits->count == expected && visited == expected;
+}
+
+void testIntervalIndexStab() {
+    Interval* intervals = SetUp(INTERVALINDEX_TEST_COUNT, 1);
+    IntervalIndex* index = intervalIndexBuild(intervals, INTERVALINDEX_TEST_COUNT);
+    int successes = 0, failures = 0;
+
+    __IntervalIndexTestHits hits = { calloc(INTERVALINDEX_TEST_COUNT, 1), 0 };
+    bool correct = true;
+    for (long long point = -5; point < 125000; point += 37) {
+        memset(hits.seen, 0, INTERVALINDEX_TEST_COUNT);
+        hits.count = 0;
+        unsigned long visited = intervalIndexStab(index, point, __intervalIndexTestRecord, &hits);
+        if (!__intervalIndexTestMatches(intervals, INTERVALINDEX_TEST_COUNT, point, point + 1, &hits, visited)) correct = false;
+    }
+    if (!correct) {
+        printf("FAILED: testIntervalIndexStab: differs from a linear scan\n");
+        failures++;
+    }
+    else successes++;
+
+    // endpoints: start is inside, end is not
+    memset(hits.seen, 0, INTERVALINDEX_TEST_COUNT);
+    hits.count = 0;
+    intervalIndexStab(index, intervals[7].start, __intervalIndexTestRecord, &hits);
+    bool startIn = hits.seen[7] == 1;
+    memset(hits.seen, 0, INTERVALINDEX_TEST_COUNT);
+    intervalIndexStab(index, intervals[7].end, __intervalIndexTestRecord, &hits);
+    if (!startIn || hits.seen[7] != 0) {
+        printf("FAILED: testIntervalIndexStab: intervals are not half-open\n");
+        failures++;
+    }
+    else successes++;
+
+    free(hits.seen);
+    TestsSummaryPrintResults("IntervalIndexStab", successes, failures);
+    TearDown(index, intervals);
+}
+
+void testIntervalIndexOverlap() {
+    Interval* intervals = SetUp(INTERVALINDEX_TEST_COUNT, 2);
+    IntervalIndex* index = intervalIndexBuild(intervals, INTERVALINDEX_TEST_COUNT);
+    int successes = 0, failures = 0;
+
+    __IntervalIndexTestHits hits = { calloc(INTERVALINDEX_TEST_COUNT, 1), 0 };
+    bool correct = true;
+    long long widths[] = { 1, 10, 500, 30000 };
+    for (int w = 0; w < 4; ++w) {
+        for (long long low = -100; low < 121000; low += 211) {
+            memset(hits.seen, 0, INTERVALINDEX_TEST_COUNT);
+            hits.count = 0;
+            unsigned long visited = intervalIndexOverlap(index, low, low + widths[w], __intervalIndexTestRecord, &hits);
+            if (!__intervalIndexTestMatches(intervals, INTERVALINDEX_TEST_COUNT, low, low + widths[w], &hits, visited)) correct = false;
+        }
+    }
+    if (!correct) {
+        printf("FAILED: testIntervalIndexOverlap: differs from a linear scan\n");
+        failures++;
+    }
+    else successes++;
+
+    int calls = 0;
+    if (intervalIndexOverlap(index, 0, 100000, __intervalIndexTestStopAtTwo, &calls) != 2 || calls != 2
+        || intervalIndexOverlap(index, 50, 50, __intervalIndexTestRecord, &hits) != 0) {
+        printf("FAILED: testIntervalIndexOverlap: early stop or empty window wrong\n");
+        failures++;
+    }
+    else successes++;
+
+    free(hits.seen);
+    TestsSummaryPrintResults("IntervalIndexOverlap", successes, failures);
+    TearDown(index, intervals);
+}
+
+void testIntervalIndexEdges() {
+    int successes = 0, failures = 0;
+
+    IntervalIndex* empty = intervalIndexBuild(NULL, 0);
+    int calls = 0;
+    if (empty == NULL || intervalIndexSize(empty) != 0
+        || intervalIndexStab(empty, 0, __intervalIndexTestStopAtTwo, &calls) != 0
+        || intervalIndexOverlap(empty, 0, 10, __intervalIndexTestStopAtTwo, &calls) != 0) {
+        printf("FAILED: testIntervalIndexEdges: empty index\n");
+        failures++;
+    }
+    else successes++;
+    if (empty != NULL) intervalIndexDestroy(empty);
+
+    // identical and nested intervals all share one center
+    Interval same[] = { { 10, 20, 0 }, { 10, 20, 1 }, { 10, 20, 2 }, { 12, 15, 3 }, { 0, 100, 4 } };
+    IntervalIndex* index = intervalIndexBuild(same, 5);
+    __IntervalIndexTestHits hits = { calloc(5, 1), 0 };
+    unsigned long visited = intervalIndexStab(index, 14, __intervalIndexTestRecord, &hits);
+    if (visited != 5 || !__intervalIndexTestMatches(same, 5, 14, 15, &hits, visited)) {
+        printf("FAILED: testIntervalIndexEdges: duplicate or nested intervals\n");
+        failures++;
+    }
+    else successes++;
+    free(hits.seen);
+    intervalIndexDestroy(index);
+
+    Interval bad[] = { { 10, 20, 0 }, { 30, 30, 1 } };
+    if (intervalIndexBuild(bad, 2) != NULL) {
+        printf("FAILED: testIntervalIndexEdges: accepted an empty interval\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("IntervalIndexEdges", successes, failures);
+}
+
+void testIntervalIndexLogIntervals() {
+    int successes = 0, failures = 0;
+
+    EventLog events[4] = {
+        { 1, 100, "2024-10-26 12:00:00", "INFO", "" },
+        { 2, 200, "2024-10-26 12:30:00", "INFO", "" },
+        { 3, 100, "2024-10-26 13:00:00", "INFO", "" },
+        { 4, 100, "bad timestamp", "INFO", "" },
+    };
+    Interval intervals[4];
+    unsigned long count = eventLogIntervals(events, 4, 600, intervals);
+
+    // server 100: [12:00, 13:00) then [13:00, 13:10); server 200: [12:30, 12:40)
+    long long noon = 1729944000;
+    bool correct = count == 3
+        && intervals[0].value == 0 && intervals[0].start == noon && intervals[0].end == noon + 3600
+        && intervals[1].value == 2 && intervals[1].start == noon + 3600 && intervals[1].end == noon + 4200
+        && intervals[2].value == 1 && intervals[2].start == noon + 1800 && intervals[2].end == noon + 2400;
+    if (!correct) {
+        printf("FAILED: testIntervalIndexLogIntervals: wrong event intervals\n");
+        failures++;
+    }
+    else successes++;
+
+    ErrorDetail errors[1] = { { 101, 100, "2024-10-26 12:45:00", "HIGH", "X", "", "" } };
+    if (errorDetailIntervals(errors, 1, 900, intervals) != 1
+        || intervals[0].start != noon + 2700 || intervals[0].end != noon + 3600 || intervals[0].value != 0) {
+        printf("FAILED: testIntervalIndexLogIntervals: wrong error intervals\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("IntervalIndexLogIntervals", successes, failures);
+}
+
+#endif /* INTERVALINDEXTEST_H */
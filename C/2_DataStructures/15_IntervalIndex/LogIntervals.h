@@ -0,0 +1,112 @@
+#ifndef LOGINTERVALS_H
+#define LOGINTERVALS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FormattedText.h"
+#include "IntervalIndex.h"
+
+/******************************************************************************
+* LogIntervals.h
+*
+* Turns parsed EventLog / ErrorDetail records (4_BasicIO/1_FileIO) into
+* Interval arrays for intervalIndexBuild. Each Interval's value is the
+* record's position in the input array. Records carry a single timestamp, so
+* their extent is derived:
+*  - an event lasts until the next event on the same server (the server's
+*    state changed), or lastDuration seconds for a server's last event
+*  - an error lasts a fixed duration (the incident window it opened)
+*
+******************************************************************************/
+
+typedef struct {
+    int serverId;
+    long long start;
+    int record;
+} __LogIntervalsEntry;
+
+static int __logIntervalsCompare(const void* a, const void* b) {
+    const __LogIntervalsEntry* x = a;
+    const __LogIntervalsEntry* y = b;
+    if (x->serverId != y->serverId) return (x->serverId < y->serverId) ? -1 : 1;
+    if (x->start != y->start) return (x->start < y->start) ? -1 : 1;
+    return (x->record > y->record) - (x->record < y->record);
+}
+
+/******************************************************************************
+* eventLogIntervals
+*
+* parameters:
+*  - events : const EventLog*
+*  - count : int
+*  - lastDuration : long long ; seconds, for each server's last event
+*  - out : Interval* ; room for count intervals
+*
+* returns: unsigned long ; number of intervals written (records with a
+*          malformed timestamp are skipped)
+*
+* description: sorts (server, time) pairs once, so each event's successor
+*              on its server is its neighbor; O(n log n) overall
+*
+******************************************************************************/
+unsigned long eventLogIntervals(const EventLog* events, int count, long long lastDuration, Interval* out) {
+    __LogIntervalsEntry* entries = malloc((count > 0 ? count : 1) * sizeof(__LogIntervalsEntry));
+    if (entries == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for event intervals.\n");
+        return 0;
+    }
+
+    int parsed = 0;
+    for (int i = 0; i < count; ++i) {
+        if (!timestampToEpoch(events[i].timestamp, &entries[parsed].start)) {
+            fprintf(stderr, "ERROR: event %d has malformed timestamp \"%s\".\n", events[i].eventId, events[i].timestamp);
+            continue;
+        }
+        entries[parsed].serverId = events[i].serverId;
+        entries[parsed].record = i;
+        parsed++;
+    }
+    qsort(entries, parsed, sizeof(__LogIntervalsEntry), __logIntervalsCompare);
+
+    for (int i = 0; i < parsed; ++i) {
+        long long end = entries[i].start + lastDuration;
+        if (i + 1 < parsed && entries[i + 1].serverId == entries[i].serverId) end = entries[i + 1].start;
+        // events at the same second still get a non-empty interval
+        if (end <= entries[i].start) end = entries[i].start + 1;
+        out[i] = (Interval){ entries[i].start, end, entries[i].record };
+    }
+
+    free(entries);
+    return (unsigned long)parsed;
+}
+
+/******************************************************************************
+* errorDetailIntervals
+*
+* parameters:
+*  - errors : const ErrorDetail*
+*  - count : int
+*  - duration : long long ; seconds, > 0
+*  - out : Interval* ; room for count intervals
+*
+* returns: unsigned long ; number of intervals written (records with a
+*          malformed timestamp are skipped)
+*
+* description: [timestamp, timestamp + duration) for each error
+*
+******************************************************************************/
+unsigned long errorDetailIntervals(const ErrorDetail* errors, int count, long long duration, Interval* out) {
+    unsigned long written = 0;
+    for (int i = 0; i < count; ++i) {
+        long long start;
+        if (!timestampToEpoch(errors[i].timestamp, &start)) {
+            fprintf(stderr, "ERROR: error %d has malformed timestamp \"%s\".\n", errors[i].errorId, errors[i].timestamp);
+            continue;
+        }
+        out[written++] = (Interval){ start, start + (duration > 0 ? duration : 1), i };
+    }
+    return written;
+}
+
+#endif /* LOGINTERVALS_H */
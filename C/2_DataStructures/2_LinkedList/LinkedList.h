@@ -11,14 +11,30 @@
 * LinkedList
 *
 * implementation: doubly-linked list. pointers all the way down. compile-time
-*                 "generic" with LISTNODE_TYPE.
+*                 "generic" with LISTNODE_TYPE, ordered by LISTNODE_LESS for
+*                 sort and merge. Nodes come from a pool instead of one
+*                 malloc each.
+*
+*                 Lists created with linkedListInitSharingPool share one
+*                 ref-counted pool, so nodes can be relinked between them
+*                 (linkedListSplice, linkedListMerge) without copying. Between
+*                 lists with different pools those fall back to copying each
+*                 node. A pool is not thread-safe, shared or not.
 *
 * structures
-*  - Array: holds the data, along with size and capacity
+*  - ListNode: holds one element and its neighbors
+*  - ListNodeSlab: a block of LISTNODE_POOL_SLAB_NODES nodes, one allocation
+*  - ListNodePool: slabs handed out front to back, a free list of nodes
+*                  returned by pops and the number of lists using it
+*  - LinkedList: head, tail, size and the node pool
 * 
 ******************************************************************************/
 
 #define LISTNODE_TYPE int
+#define LISTNODE_LESS(a, b) ((a) < (b))
+
+// Nodes per slab. 4096 * 24 bytes is 96KB per allocation.
+#define LISTNODE_POOL_SLAB_NODES 4096
 
 typedef struct ListNode {
     LISTNODE_TYPE data;
@@ -34,7 +50,9 @@ typedef struct ListNode {
 *
 * returns: ListNode*
 * 
-* description: initializes a ListNode with data
+* description: initializes a standalone, individually malloc'd ListNode with
+*              data. LinkedList itself takes nodes from its pool instead
+*              (listNodePoolAcquire).
 * 
 ******************************************************************************/
 ListNode* listNodeInit(LISTNODE_TYPE data) {
@@ -45,17 +63,141 @@ ListNode* listNodeInit(LISTNODE_TYPE data) {
     }
 
     node->data = data;
+    node->prev = NULL;
     node->next = NULL;
 
     return node;
 }
 
+typedef struct ListNodeSlab {
+    struct ListNodeSlab* next;
+    ListNode nodes[LISTNODE_POOL_SLAB_NODES];
+} ListNodeSlab;
+
+typedef struct ListNodePool {
+    ListNodeSlab* slabs;     // newest first
+    unsigned long slabUsed;  // nodes handed out from slabs->nodes so far
+    ListNode* freeList;      // returned nodes, chained through next
+    unsigned long refCount;  // lists using this pool
+} ListNodePool;
+
+/******************************************************************************
+* listNodePoolInit
+*
+* parameters:
+*  - pool : ListNodePool*
+*
+* returns: none
+*
+* description: sets up an empty pool; the first slab is allocated lazily.
+*              refCount is left to the caller.
+*
+******************************************************************************/
+void listNodePoolInit(ListNodePool* pool) {
+    pool->slabs = NULL;
+    pool->slabUsed = LISTNODE_POOL_SLAB_NODES;
+    pool->freeList = NULL;
+}
+
+/******************************************************************************
+* listNodePoolAcquire
+*
+* parameters:
+*  - pool : ListNodePool*
+*  - data : LISTNODE_TYPE
+*
+* returns: ListNode*
+*
+* description: the pool's replacement for listNodeInit. Reuses a returned
+*              node if there is one, otherwise carves the next node out of
+*              the newest slab, allocating a new slab only when it runs out.
+*
+******************************************************************************/
+ListNode* listNodePoolAcquire(ListNodePool* pool, LISTNODE_TYPE data) {
+    ListNode* node;
+
+    if (pool->freeList != NULL) {
+        node = pool->freeList;
+        pool->freeList = node->next;
+    }
+    else {
+        if (pool->slabUsed == LISTNODE_POOL_SLAB_NODES) {
+            ListNodeSlab* slab = malloc(sizeof(ListNodeSlab));
+            if (slab == NULL) {
+                fprintf(stderr, "ERROR: failed to allocate memory for ListNodeSlab.\n");
+                return NULL;
+            }
+            slab->next = pool->slabs;
+            pool->slabs = slab;
+            pool->slabUsed = 0;
+        }
+        node = &pool->slabs->nodes[pool->slabUsed++];
+    }
+
+    node->data = data;
+    node->prev = NULL;
+    node->next = NULL;
+
+    return node;
+}
+
+/******************************************************************************
+* listNodePoolRelease
+*
+* parameters:
+*  - pool : ListNodePool*
+*  - node : ListNode* ; must have come from this pool
+*
+* returns: none
+*
+* description: puts node on the free list for the next acquire
+*
+******************************************************************************/
+void listNodePoolRelease(ListNodePool* pool, ListNode* node) {
+    node->next = pool->freeList;
+    pool->freeList = node;
+}
+
+/******************************************************************************
+* listNodePoolReleaseAll
+*
+* parameters:
+*  - pool : ListNodePool*
+*
+* returns: none
+*
+* description: frees every slab, invalidating every node at once, including
+*              nodes of other lists sharing the pool
+*
+******************************************************************************/
+void listNodePoolReleaseAll(ListNodePool* pool) {
+    ListNodeSlab* slab = pool->slabs;
+    while (slab != NULL) {
+        ListNodeSlab* nextSlab = slab->next;
+        free(slab);
+        slab = nextSlab;
+    }
+    listNodePoolInit(pool);
+}
+
 typedef struct LinkedList {
     ListNode* head;
     ListNode* tail;
     unsigned long size;
+    ListNodePool* pool;
 } LinkedList;
 
+// Returns every node of list to its pool's free list, one by one; used when
+// other lists share the pool and its slabs must stay alive
+static void __linkedListReturnNodes(LinkedList* list) {
+    ListNode* currentNode = list->head;
+    while (currentNode != NULL) {
+        ListNode* nextNode = currentNode->next;
+        listNodePoolRelease(list->pool, currentNode);
+        currentNode = nextNode;
+    }
+}
+
 /******************************************************************************
 * linkedListInit
 *
@@ -63,7 +205,7 @@ typedef struct LinkedList {
 *
 * returns: LinkedList*
 * 
-* description: initializes memory for the LinkedList
+* description: initializes memory for the LinkedList, with a pool of its own
 * 
 ******************************************************************************/
 LinkedList* linkedListInit() {
@@ -73,6 +215,51 @@ LinkedList* linkedListInit() {
         return NULL;
     }
 
+    list->pool = malloc(sizeof(ListNodePool));
+    if (list->pool == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for ListNodePool.\n");
+        free(list);
+        return NULL;
+    }
+    listNodePoolInit(list->pool);
+    list->pool->refCount = 1;
+
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+
+    return list;
+}
+
+/******************************************************************************
+* linkedListInitSharingPool
+*
+* parameters:
+*  - other : LinkedList*
+*
+* returns: LinkedList*
+* 
+* description: initializes an empty LinkedList that takes its nodes from
+*              other's pool, so splices and merges between the two relink
+*              nodes instead of copying them. The pool lives until the last
+*              list using it is destroyed.
+* 
+******************************************************************************/
+LinkedList* linkedListInitSharingPool(LinkedList* other) {
+    if (other == NULL) {
+        fprintf(stderr, "ERROR: attempted to share the pool of NULL LinkedList*.\n");
+        return NULL;
+    }
+
+    LinkedList* list = malloc(sizeof(LinkedList));
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for LinkedList.\n");
+        return NULL;
+    }
+
+    list->pool = other->pool;
+    list->pool->refCount++;
+
     list->head = NULL;
     list->tail = NULL;
     list->size = 0;
@@ -88,7 +275,9 @@ LinkedList* linkedListInit() {
 *
 * returns: none
 * 
-* description: frees the heap memory associated with the LinkedList*
+* description: frees the heap memory associated with the LinkedList*. The
+*              last list using a pool releases it a slab at a time; earlier
+*              ones return their nodes to it.
 * 
 ******************************************************************************/
 void linkedListDestroy(LinkedList* list) {
@@ -97,13 +286,13 @@ void linkedListDestroy(LinkedList* list) {
         return;
     }
 
-    ListNode* currentNode = list->head;
-    while (currentNode != NULL) {
-        ListNode* nextNode = currentNode->next;
-        free(currentNode);
-        currentNode = nextNode;
+    if (--list->pool->refCount == 0) {
+        listNodePoolReleaseAll(list->pool);
+        free(list->pool);
+    }
+    else {
+        __linkedListReturnNodes(list);
     }
-
     free(list);
 }
 
@@ -230,7 +419,7 @@ bool linkedListPushBack(LinkedList* list, LISTNODE_TYPE data) {
         return false;
     }
     
-    ListNode* newNode = listNodeInit(data);
+    ListNode* newNode = listNodePoolAcquire(list->pool, data);
     if (newNode == NULL) {
         return false;
     }
@@ -265,7 +454,7 @@ bool linkedListPushFront(LinkedList* list, LISTNODE_TYPE data) {
         return false;
     }
 
-    ListNode* newNode = listNodeInit(data);
+    ListNode* newNode = listNodePoolAcquire(list->pool, data);
     if (newNode == NULL) {
         return false;
     }
@@ -310,7 +499,7 @@ bool linkedListPopBack(LinkedList* list) {
         list->head = NULL;
     }
 
-    free(nodeToRemove);
+    listNodePoolRelease(list->pool, nodeToRemove);
     list->size--;
     return true;
 }
@@ -342,7 +531,7 @@ bool linkedListPopFront(LinkedList* list) {
         list->tail = NULL;
     }
 
-    free(nodeToRemove);
+    listNodePoolRelease(list->pool, nodeToRemove);
     list->size--;
     return true;
 }
@@ -355,13 +544,237 @@ bool linkedListPopFront(LinkedList* list) {
 *
 * returns: none 
 * 
-* description: removes all nodes from the list
+* description: removes all nodes from the list by releasing the pool's slabs,
+*              or, if other lists share the pool, by returning each node to
+*              its free list
 * 
 ******************************************************************************/
 void linkedListClear(LinkedList* list) {
-    while (!linkedListEmpty(list)) {
-        linkedListPopFront(list);
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: attempted to clear NULL LinkedList*.\n");
+        return;
+    }
+
+    if (list->pool->refCount == 1) {
+        listNodePoolReleaseAll(list->pool);
+    }
+    else {
+        __linkedListReturnNodes(list);
+    }
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+}
+
+/* Relinking helpers **********************************************************/
+// Links the chain first..last (already connected through next/prev) into
+// list before pos, or at the back if pos is NULL. Does not touch size.
+static void __linkedListLinkBefore(LinkedList* list, ListNode* pos, ListNode* first, ListNode* last) {
+    ListNode* before = (pos != NULL) ? pos->prev : list->tail;
+
+    first->prev = before;
+    last->next = pos;
+
+    if (before != NULL) before->next = first;
+    else list->head = first;
+
+    if (pos != NULL) pos->prev = last;
+    else list->tail = last;
+}
+
+// Unlinks the chain first..last from list, leaving its inner links intact.
+// Does not touch size.
+static void __linkedListUnlinkRange(LinkedList* list, ListNode* first, ListNode* last) {
+    if (first->prev != NULL) first->prev->next = last->next;
+    else list->head = last->next;
+
+    if (last->next != NULL) last->next->prev = first->prev;
+    else list->tail = first->prev;
+}
+/* End relinking helpers ******************************************************/
+
+/******************************************************************************
+* linkedListSplice
+*
+* parameters:
+*  - dst : LinkedList*
+*  - pos : ListNode* ; node of dst to insert before, NULL for the back
+*  - src : LinkedList* ; may be dst itself
+*  - first : ListNode* ; first node of src to move
+*  - last : ListNode* ; node of src to stop before, NULL for the end of src
+*
+* returns: bool ; success status
+* 
+* description: moves [first, last) out of src and into dst before pos.
+*              When dst and src share a pool the nodes are relinked in
+*              place: O(1), except that moving part of src into another list
+*              counts the range to keep both sizes right (moving all of src,
+*              or within one list, needs no count). Otherwise each node is
+*              copied into dst's pool and released to src's, O(range).
+*              pos must not lie inside [first, last).
+* 
+******************************************************************************/
+bool linkedListSplice(LinkedList* dst, ListNode* pos, LinkedList* src, ListNode* first, ListNode* last) {
+    if (dst == NULL || src == NULL) {
+        fprintf(stderr, "ERROR: attempted to splice with NULL LinkedList*.\n");
+        return false;
+    }
+    if (first == NULL || first == last) return true;
+
+    if (dst->pool != src->pool) {
+        ListNode* currentNode = first;
+        while (currentNode != last) {
+            ListNode* nextNode = currentNode->next;
+            ListNode* copy = listNodePoolAcquire(dst->pool, currentNode->data);
+            if (copy == NULL) return false;
+
+            __linkedListLinkBefore(dst, pos, copy, copy);
+            dst->size++;
+            __linkedListUnlinkRange(src, currentNode, currentNode);
+            listNodePoolRelease(src->pool, currentNode);
+            src->size--;
+
+            currentNode = nextNode;
+        }
+        return true;
     }
+
+    ListNode* lastMoved = (last != NULL) ? last->prev : src->tail;
+    unsigned long count = 0;
+    if (dst != src) {
+        if (first == src->head && last == NULL) {
+            count = src->size;
+        }
+        else {
+            for (ListNode* node = first; node != last; node = node->next) count++;
+        }
+    }
+
+    __linkedListUnlinkRange(src, first, lastMoved);
+    __linkedListLinkBefore(dst, pos, first, lastMoved);
+    src->size -= count;
+    dst->size += count;
+    return true;
+}
+
+/******************************************************************************
+* linkedListMerge
+*
+* parameters:
+*  - dst : LinkedList* ; sorted by LISTNODE_LESS
+*  - src : LinkedList* ; sorted by LISTNODE_LESS, emptied by the merge
+*
+* returns: bool ; success status
+* 
+* description: merges src into dst, keeping dst sorted. Stable: of equal
+*              elements, dst's come first. Each run of src nodes that
+*              belongs before the same dst node is moved with one
+*              linkedListSplice, so with a shared pool nothing is copied.
+* 
+******************************************************************************/
+bool linkedListMerge(LinkedList* dst, LinkedList* src) {
+    if (dst == NULL || src == NULL) {
+        fprintf(stderr, "ERROR: attempted to merge with NULL LinkedList*.\n");
+        return false;
+    }
+    if (dst == src) return true;
+
+    ListNode* pos = dst->head;
+    while (src->head != NULL) {
+        while (pos != NULL && !LISTNODE_LESS(src->head->data, pos->data)) {
+            pos = pos->next;
+        }
+        if (pos == NULL) {
+            return linkedListSplice(dst, NULL, src, src->head, NULL);
+        }
+
+        ListNode* runEnd = src->head->next;
+        while (runEnd != NULL && LISTNODE_LESS(runEnd->data, pos->data)) {
+            runEnd = runEnd->next;
+        }
+        if (!linkedListSplice(dst, pos, src, src->head, runEnd)) return false;
+    }
+    return true;
+}
+
+/******************************************************************************
+* linkedListSort
+*
+* parameters:
+*  - list : LinkedList*
+*
+* returns: none
+* 
+* description: stable bottom-up merge sort by LISTNODE_LESS. Pass k merges
+*              neighboring sorted runs of 2^k nodes by relinking, until one
+*              pass does a single merge. No recursion, no allocation:
+*              O(n log n) time, O(1) extra space.
+* 
+******************************************************************************/
+void linkedListSort(LinkedList* list) {
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: attempted to sort NULL LinkedList*.\n");
+        return;
+    }
+    if (list->size < 2) return;
+
+    ListNode* head = list->head;
+    ListNode* tail = NULL;
+    unsigned long width = 1;
+
+    while (true) {
+        ListNode* left = head;
+        unsigned long merges = 0;
+        head = NULL;
+        tail = NULL;
+
+        while (left != NULL) {
+            merges++;
+
+            // right run starts width nodes after left
+            ListNode* right = left;
+            unsigned long leftSize = 0;
+            while (leftSize < width && right != NULL) {
+                right = right->next;
+                leftSize++;
+            }
+            unsigned long rightSize = width;
+
+            while (leftSize > 0 || (rightSize > 0 && right != NULL)) {
+                ListNode* next;
+                // take from the left run on ties to stay stable
+                if (leftSize == 0) {
+                    next = right;
+                    right = right->next;
+                    rightSize--;
+                }
+                else if (rightSize == 0 || right == NULL || !LISTNODE_LESS(right->data, left->data)) {
+                    next = left;
+                    left = left->next;
+                    leftSize--;
+                }
+                else {
+                    next = right;
+                    right = right->next;
+                    rightSize--;
+                }
+
+                next->prev = tail;
+                if (tail != NULL) tail->next = next;
+                else head = next;
+                tail = next;
+            }
+
+            left = right;
+        }
+
+        tail->next = NULL;
+        if (merges <= 1) break;
+        width *= 2;
+    }
+
+    list->head = head;
+    list->tail = tail;
 }
 
 /******************************************************************************
@@ -0,0 +1,132 @@
+#ifndef LINKEDLISTBENCH_H
+#define LINKEDLISTBENCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "LinkedList.h"
+#include "util.h"
+
+/******************************************************************************
+* LinkedListBench.h
+*
+* Pooled LinkedList vs. the previous one-malloc-per-node list (reproduced
+* below with listNodeInit/free). Each case runs in a forked child so its
+* RSS isn't polluted by memory the previous case freed but malloc kept.
+*
+*  - build: LINKEDLIST_BENCH_NODES push backs, RSS growth after building
+*  - churn: LINKEDLIST_BENCH_NODES push back + pop front pairs on a list
+*           holding LINKEDLIST_BENCH_STEADY elements (work queue pattern)
+*  - destroy: tear down the built list
+*
+******************************************************************************/
+
+#define LINKEDLIST_BENCH_NODES 10000000UL
+#define LINKEDLIST_BENCH_STEADY 1000UL
+
+/* Baseline: malloc/free per node *********************************************/
+typedef struct {
+    ListNode* head;
+    ListNode* tail;
+} __MallocList;
+
+static void __mallocListPushBack(__MallocList* list, LISTNODE_TYPE data) {
+    ListNode* node = listNodeInit(data);
+    node->prev = list->tail;
+    if (list->tail != NULL) list->tail->next = node;
+    else list->head = node;
+    list->tail = node;
+}
+
+static void __mallocListPopFront(__MallocList* list) {
+    ListNode* node = list->head;
+    list->head = node->next;
+    if (list->head != NULL) list->head->prev = NULL;
+    else list->tail = NULL;
+    free(node);
+}
+
+static void __mallocListDestroy(__MallocList* list) {
+    ListNode* node = list->head;
+    while (node != NULL) {
+        ListNode* next = node->next;
+        free(node);
+        node = next;
+    }
+}
+/* End baseline ***************************************************************/
+
+static void __linkedListBenchCase(bool pooled) {
+    double start, buildSeconds, churnSeconds, destroySeconds;
+    long rssBefore = benchRssKb(), rssAfter;
+
+    if (pooled) {
+        LinkedList* list = linkedListInit();
+        start = benchSeconds();
+        for (unsigned long i = 0; i < LINKEDLIST_BENCH_NODES; ++i) linkedListPushBack(list, (int)i);
+        buildSeconds = benchSeconds() - start;
+        rssAfter = benchRssKb();
+
+        start = benchSeconds();
+        linkedListDestroy(list);
+        destroySeconds = benchSeconds() - start;
+
+        list = linkedListInit();
+        for (unsigned long i = 0; i < LINKEDLIST_BENCH_STEADY; ++i) linkedListPushBack(list, (int)i);
+        start = benchSeconds();
+        for (unsigned long i = 0; i < LINKEDLIST_BENCH_NODES; ++i) {
+            linkedListPushBack(list, (int)i);
+            linkedListPopFront(list);
+        }
+        churnSeconds = benchSeconds() - start;
+        linkedListDestroy(list);
+    }
+    else {
+        __MallocList list = { NULL, NULL };
+        start = benchSeconds();
+        for (unsigned long i = 0; i < LINKEDLIST_BENCH_NODES; ++i) __mallocListPushBack(&list, (int)i);
+        buildSeconds = benchSeconds() - start;
+        rssAfter = benchRssKb();
+
+        start = benchSeconds();
+        __mallocListDestroy(&list);
+        destroySeconds = benchSeconds() - start;
+
+        list = (__MallocList){ NULL, NULL };
+        for (unsigned long i = 0; i < LINKEDLIST_BENCH_STEADY; ++i) __mallocListPushBack(&list, (int)i);
+        start = benchSeconds();
+        for (unsigned long i = 0; i < LINKEDLIST_BENCH_NODES; ++i) {
+            __mallocListPushBack(&list, (int)i);
+            __mallocListPopFront(&list);
+        }
+        churnSeconds = benchSeconds() - start;
+        __mallocListDestroy(&list);
+    }
+
+    printf("%-15s build %6.3f s (%5.1f ns/node)  churn %6.3f s (%5.1f ns/pair)  destroy %6.3f s  RSS +%ld KB (%.1f B/node)\n",
+           pooled ? "pooled" : "malloc per node",
+           buildSeconds, buildSeconds * 1e9 / LINKEDLIST_BENCH_NODES,
+           churnSeconds, churnSeconds * 1e9 / LINKEDLIST_BENCH_NODES,
+           destroySeconds, rssAfter - rssBefore, (rssAfter - rssBefore) * 1024.0 / LINKEDLIST_BENCH_NODES);
+}
+
+void runLinkedListBenchmarks() {
+    printf("\nLinkedList benchmarks: %lu nodes\n", LINKEDLIST_BENCH_NODES);
+    printf("================================\n");
+    fflush(stdout);
+
+    for (int pooled = 0; pooled <= 1; ++pooled) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            __linkedListBenchCase(pooled);
+            fflush(stdout);
+            _exit(0);
+        }
+        waitpid(pid, NULL, 0);
+    }
+}
+
+#endif /* LINKEDLISTBENCH_H */
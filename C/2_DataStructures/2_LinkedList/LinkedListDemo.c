@@ -1,7 +1,10 @@
 #include <stdio.h> 
 
 #include "LinkedList.h"
-// #include "LinkedListTest.h" // TODO
+#include "LinkedListTest.h"
+#ifdef RUN_BENCHMARKS
+#include "LinkedListBench.h"
+#endif
 
 int main() {
     LinkedList* list = linkedListInit();
@@ -25,8 +28,30 @@ int main() {
 
     linkedListToString(list);
 
+    // Sort, then merge in another sorted list sharing the same node pool
+    linkedListPushBack(list, 15);
+    linkedListPushBack(list, 5);
+    linkedListSort(list);
+    linkedListToString(list);
+
+    LinkedList* other = linkedListInitSharingPool(list);
+    if (other != NULL) {
+        linkedListPushBack(other, 1);
+        linkedListPushBack(other, 12);
+        linkedListPushBack(other, 40);
+        linkedListMerge(list, other);
+        linkedListToString(list);
+        linkedListDestroy(other);
+    }
+
     linkedListClear(list);
     linkedListToString(list);
 
     linkedListDestroy(list);
+
+    runLinkedListTests();
+
+#ifdef RUN_BENCHMARKS
+    runLinkedListBenchmarks();
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,420 @@
+#ifndef LINKEDLISTTEST_H
+#define LINKEDLISTTEST_H
+
+#include "LinkedList.h"
+#include "TestsSummary.h"
+
+/* Testing functions **********************************************************/
+void testLinkedListPushBack();
+void testLinkedListPushFront();
+void testLinkedListPop();
+void testLinkedListAt();
+void testLinkedListClear();
+void testLinkedListNodePool();
+void testLinkedListSharedPool();
+void testLinkedListSplice();
+void testLinkedListSpliceCopy();
+void testLinkedListMerge();
+void testLinkedListSort();
+/* End testing functions ******************************************************/
+
+/* Test setup/teardown functions **********************************************/
+LinkedList* SetUp() {
+    return linkedListInit();
+}
+
+void TearDown(LinkedList* list) {
+    linkedListDestroy(list);
+}
+/* End test setup/teardown functions ******************************************/
+
+// These tests assume LISTNODE_TYPE is int
+void runLinkedListTests() {
+    TestsSummaryPrintHeader("LinkedList");
+
+    testLinkedListPushBack();
+    testLinkedListPushFront();
+    testLinkedListPop();
+    testLinkedListAt();
+    testLinkedListClear();
+    testLinkedListNodePool();
+    testLinkedListSharedPool();
+    testLinkedListSplice();
+    testLinkedListSpliceCopy();
+    testLinkedListMerge();
+    testLinkedListSort();
+
+    TestsSummaryPrintFooter("LinkedList");
+}
+
+void testLinkedListPushBack() {
+    LinkedList* list = SetUp();
+    int successes = 0, failures = 0;
+
+    linkedListPushBack(list, 10);
+    linkedListPushBack(list, 20);
+    linkedListPushBack(list, 30);
+
+    if (*linkedListFront(list) != 10 || *linkedListBack(list) != 30 || linkedListSize(list) != 3) {
+        printf("FAILED: testLinkedListPushBack: expected front 10, back 30, size 3\n");
+        failures++;
+    }
+    else successes++;
+
+    // links are consistent in both directions
+    if (list->head->prev != NULL || list->tail->next != NULL || list->tail->prev->prev != list->head) {
+        printf("FAILED: testLinkedListPushBack: prev/next links are inconsistent\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("LinkedListPushBack", successes, failures);
+    TearDown(list);
+}
+
+void testLinkedListPushFront() {
+    LinkedList* list = SetUp();
+    int successes = 0, failures = 0;
+
+    linkedListPushFront(list, 10);
+    linkedListPushFront(list, 20);
+
+    if (*linkedListFront(list) != 20 || *linkedListBack(list) != 10) {
+        printf("FAILED: testLinkedListPushFront: expected front 20, back 10\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("LinkedListPushFront", successes, failures);
+    TearDown(list);
+}
+
+void testLinkedListPop() {
+    LinkedList* list = SetUp();
+    int successes = 0, failures = 0;
+
+    // single element pushed at the back, popped from the back
+    linkedListPushBack(list, 1);
+    linkedListPopBack(list);
+    if (!linkedListEmpty(list) || list->head != NULL || list->tail != NULL) {
+        printf("FAILED: testLinkedListPop: expected empty list after popping its only element\n");
+        failures++;
+    }
+    else successes++;
+
+    linkedListPushBack(list, 1);
+    linkedListPushBack(list, 2);
+    linkedListPushBack(list, 3);
+    linkedListPopFront(list);
+    linkedListPopBack(list);
+    if (linkedListSize(list) != 1 || *linkedListFront(list) != 2 || *linkedListBack(list) != 2) {
+        printf("FAILED: testLinkedListPop: expected only 2 to remain\n");
+        failures++;
+    }
+    else successes++;
+
+    linkedListPopFront(list);
+    if (linkedListPopFront(list) || linkedListPopBack(list)) {
+        printf("FAILED: testLinkedListPop: incorrectly allowed pop from empty list\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("LinkedListPop", successes, failures);
+    TearDown(list);
+}
+
+void testLinkedListAt() {
+    LinkedList* list = SetUp();
+    int successes = 0, failures = 0;
+
+    for (int i = 0; i < 5; ++i) linkedListPushBack(list, i * 10);
+
+    if (*linkedListAt(list, 3) != 30) {
+        printf("FAILED: testLinkedListAt: expected 30 at index 3 but got %d\n", *linkedListAt(list, 3));
+        failures++;
+    }
+    else successes++;
+
+    if (linkedListAt(list, 5) != NULL) {
+        printf("FAILED: testLinkedListAt: incorrectly allowed index past the end\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("LinkedListAt", successes, failures);
+    TearDown(list);
+}
+
+void testLinkedListClear() {
+    LinkedList* list = SetUp();
+    int successes = 0, failures = 0;
+
+    for (int i = 0; i < LISTNODE_POOL_SLAB_NODES * 2 + 5; ++i) linkedListPushBack(list, i);
+    linkedListClear(list);
+
+    if (!linkedListEmpty(list) || list->head != NULL || list->pool->slabs != NULL) {
+        printf("FAILED: testLinkedListClear: expected empty list with no slabs after clear\n");
+        failures++;
+    }
+    else successes++;
+
+    // still usable after clear
+    linkedListPushBack(list, 7);
+    if (*linkedListFront(list) != 7 || linkedListSize(list) != 1) {
+        printf("FAILED: testLinkedListClear: list unusable after clear\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("LinkedListClear", successes, failures);
+    TearDown(list);
+}
+
+void testLinkedListNodePool() {
+    LinkedList* list = SetUp();
+    int successes = 0, failures = 0;
+
+    // popped nodes are recycled, so churn never needs a second slab
+    for (int i = 0; i < 100; ++i) linkedListPushBack(list, i);
+    for (int i = 0; i < LISTNODE_POOL_SLAB_NODES * 3; ++i) {
+        linkedListPushBack(list, i);
+        linkedListPopFront(list);
+    }
+
+    if (list->pool->slabs == NULL || list->pool->slabs->next != NULL) {
+        printf("FAILED: testLinkedListNodePool: expected push/pop churn to stay within one slab\n");
+        failures++;
+    }
+    else successes++;
+
+    // filling past one slab allocates another
+    for (int i = 0; i < LISTNODE_POOL_SLAB_NODES; ++i) linkedListPushBack(list, i);
+    if (list->pool->slabs->next == NULL) {
+        printf("FAILED: testLinkedListNodePool: expected a second slab once the first is full\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("LinkedListNodePool", successes, failures);
+    TearDown(list);
+}
+
+// Checks data against expected and that prev links mirror next links
+bool __linkedListEquals(LinkedList* list, const int* expected, unsigned long count) {
+    if (list->size != count) return false;
+
+    ListNode* previousNode = NULL;
+    ListNode* currentNode = list->head;
+    for (unsigned long i = 0; i < count; ++i) {
+        if (currentNode == NULL || currentNode->data != expected[i] || currentNode->prev != previousNode) return false;
+        previousNode = currentNode;
+        currentNode = currentNode->next;
+    }
+    return currentNode == NULL && list->tail == previousNode;
+}
+
+void testLinkedListSharedPool() {
+    LinkedList* list = SetUp();
+    LinkedList* other = linkedListInitSharingPool(list);
+    int successes = 0, failures = 0;
+
+    linkedListPushBack(list, 1);
+    linkedListPushBack(other, 2);
+    if (list->pool != other->pool || list->pool->refCount != 2) {
+        printf("FAILED: testLinkedListSharedPool: expected one pool used by two lists\n");
+        failures++;
+    }
+    else successes++;
+
+    // clearing one list must not free slabs the other still uses
+    linkedListClear(list);
+    linkedListPushBack(other, 3);
+    const int expected[] = { 2, 3 };
+    if (!__linkedListEquals(other, expected, 2) || list->pool->slabs == NULL) {
+        printf("FAILED: testLinkedListSharedPool: clearing one list disturbed the other\n");
+        failures++;
+    }
+    else successes++;
+
+    TearDown(list);
+    if (other->pool->refCount != 1 || *linkedListBack(other) != 3) {
+        printf("FAILED: testLinkedListSharedPool: destroying one list disturbed the other\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("LinkedListSharedPool", successes, failures);
+    TearDown(other);
+}
+
+void testLinkedListSplice() {
+    LinkedList* dst = SetUp();
+    LinkedList* src = linkedListInitSharingPool(dst);
+    int successes = 0, failures = 0;
+
+    for (int i = 0; i < 4; ++i) linkedListPushBack(dst, i * 10);  // 0 10 20 30
+    for (int i = 1; i <= 5; ++i) linkedListPushBack(src, i);      // 1 2 3 4 5
+
+    // move 2 3 4 before 20; the very same nodes end up in dst
+    ListNode* first = src->head->next;
+    ListNode* last = first->next->next->next;
+    ListNode* pos = dst->head->next->next;
+    linkedListSplice(dst, pos, src, first, last);
+
+    const int expectedDst[] = { 0, 10, 2, 3, 4, 20, 30 };
+    const int expectedSrc[] = { 1, 5 };
+    if (!__linkedListEquals(dst, expectedDst, 7) || !__linkedListEquals(src, expectedSrc, 2) || pos->prev->prev->prev != first) {
+        printf("FAILED: testLinkedListSplice: range splice between lists\n");
+        failures++;
+    }
+    else successes++;
+
+    // all of src to the front of dst
+    linkedListSplice(dst, dst->head, src, src->head, NULL);
+    const int expectedAll[] = { 1, 5, 0, 10, 2, 3, 4, 20, 30 };
+    if (!__linkedListEquals(dst, expectedAll, 9) || !linkedListEmpty(src) || src->head != NULL || src->tail != NULL) {
+        printf("FAILED: testLinkedListSplice: whole-list splice\n");
+        failures++;
+    }
+    else successes++;
+
+    // within one list: move the front two to the back
+    linkedListSplice(dst, NULL, dst, dst->head, dst->head->next->next);
+    const int expectedRotated[] = { 0, 10, 2, 3, 4, 20, 30, 1, 5 };
+    if (!__linkedListEquals(dst, expectedRotated, 9)) {
+        printf("FAILED: testLinkedListSplice: splice within one list\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("LinkedListSplice", successes, failures);
+    TearDown(src);
+    TearDown(dst);
+}
+
+void testLinkedListSpliceCopy() {
+    LinkedList* dst = SetUp();
+    LinkedList* src = SetUp();
+    int successes = 0, failures = 0;
+
+    linkedListPushBack(dst, 0);
+    for (int i = 1; i <= 3; ++i) linkedListPushBack(src, i);
+
+    // different pools: nodes are copied, and src can be destroyed safely
+    linkedListSplice(dst, NULL, src, src->head, src->tail);
+    const int expectedDst[] = { 0, 1, 2 };
+    const int expectedSrc[] = { 3 };
+    if (!__linkedListEquals(dst, expectedDst, 3) || !__linkedListEquals(src, expectedSrc, 1)) {
+        printf("FAILED: testLinkedListSpliceCopy: splice between pools\n");
+        failures++;
+    }
+    else successes++;
+
+    TearDown(src);
+    linkedListPushBack(dst, 4);
+    const int expectedAfter[] = { 0, 1, 2, 4 };
+    if (!__linkedListEquals(dst, expectedAfter, 4)) {
+        printf("FAILED: testLinkedListSpliceCopy: copied nodes did not outlive their source\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("LinkedListSpliceCopy", successes, failures);
+    TearDown(dst);
+}
+
+void testLinkedListMerge() {
+    LinkedList* dst = SetUp();
+    LinkedList* src = linkedListInitSharingPool(dst);
+    int successes = 0, failures = 0;
+
+    const int dstValues[] = { 1, 3, 3, 7, 9 };
+    const int srcValues[] = { 0, 3, 4, 5, 10, 11 };
+    for (int i = 0; i < 5; ++i) linkedListPushBack(dst, dstValues[i]);
+    for (int i = 0; i < 6; ++i) linkedListPushBack(src, srcValues[i]);
+
+    ListNode* srcThree = src->head->next;
+    ListNode* dstLastThree = dst->head->next->next;
+    linkedListMerge(dst, src);
+
+    const int expected[] = { 0, 1, 3, 3, 3, 4, 5, 7, 9, 10, 11 };
+    if (!__linkedListEquals(dst, expected, 11) || !linkedListEmpty(src)) {
+        printf("FAILED: testLinkedListMerge: merged list out of order\n");
+        failures++;
+    }
+    else successes++;
+
+    // stable: src's 3 comes after both of dst's
+    if (dstLastThree->next != srcThree) {
+        printf("FAILED: testLinkedListMerge: merge is not stable\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("LinkedListMerge", successes, failures);
+    TearDown(src);
+    TearDown(dst);
+}
+
+void testLinkedListSort() {
+    LinkedList* list = SetUp();
+    int successes = 0, failures = 0;
+    const int count = 1000;
+
+    // values 0..99 ten times over, in scrambled order
+    for (int i = 0; i < count; ++i) linkedListPushBack(list, (i * 7919) % 100);
+
+    // remember the nodes holding 42, in list order, to check stability
+    ListNode* fortyTwos[10];
+    int found = 0;
+    for (ListNode* node = list->head; node != NULL; node = node->next) {
+        if (node->data == 42) fortyTwos[found++] = node;
+    }
+
+    unsigned long slabUsedBefore = list->pool->slabUsed;
+    linkedListSort(list);
+
+    bool sorted = list->size == (unsigned long)count && list->head->prev == NULL && list->tail->next == NULL;
+    for (ListNode* node = list->head; node != NULL && node->next != NULL; node = node->next) {
+        if (node->next->data < node->data || node->next->prev != node) sorted = false;
+    }
+    if (!sorted || list->pool->slabUsed != slabUsedBefore) {
+        printf("FAILED: testLinkedListSort: list not sorted, or sort allocated nodes\n");
+        failures++;
+    }
+    else successes++;
+
+    ListNode* node = list->head;
+    while (node->data != 42) node = node->next;
+    bool stable = true;
+    for (int i = 0; i < found; ++i, node = node->next) {
+        if (node != fortyTwos[i]) stable = false;
+    }
+    if (!stable) {
+        printf("FAILED: testLinkedListSort: equal elements were reordered\n");
+        failures++;
+    }
+    else successes++;
+
+    // sizes that aren't powers of two, including 0 and 1
+    bool smallSorted = true;
+    for (int size = 0; size < 20; ++size) {
+        linkedListClear(list);
+        for (int i = size; i > 0; --i) linkedListPushBack(list, i);
+        linkedListSort(list);
+        int expected[20];
+        for (int i = 0; i < size; ++i) expected[i] = i + 1;
+        if (!__linkedListEquals(list, expected, size)) smallSorted = false;
+    }
+    if (!smallSorted) {
+        printf("FAILED: testLinkedListSort: failed on a small list\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("LinkedListSort", successes, failures);
+    TearDown(list);
+}
+
+#endif /* LINKEDLISTTEST_H */
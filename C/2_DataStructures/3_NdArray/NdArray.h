@@ -0,0 +1,508 @@
+#ifndef NDARRAY_H
+#define NDARRAY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+/******************************************************************************
+* NdArray
+*
+* implementation: one contiguous row-major buffer plus a shape and per-dim
+*                 strides (in elements); compile-time "generic" with
+*                 NDARRAY_TYPE. Slices and transposes are views: they share
+*                 the buffer and only rewrite shape/strides/data.
+*
+* structures
+*  - NdArray: pointer to the first element, shape, strides, and whether the
+*             buffer is owned (allocated by ndArrayInit) or borrowed (a view)
+*
+******************************************************************************/
+
+#define NDARRAY_TYPE double
+#define NDARRAY_MAX_DIMS 4
+
+// Tile edge (in elements) for the blocked kernels. 3 tiles of 64x64 doubles
+// is 96KB, which sits comfortably in a typical L2.
+#define NDARRAY_BLOCK_SIZE 64
+
+// Buffers are aligned to a cache line so row 0 doesn't straddle two lines
+#define NDARRAY_ALIGNMENT 64
+
+typedef struct NdArray {
+    NDARRAY_TYPE* data;
+    unsigned long ndim;
+    unsigned long size;
+    unsigned long shape[NDARRAY_MAX_DIMS];
+    long strides[NDARRAY_MAX_DIMS];
+    bool ownsData;
+} NdArray;
+
+/******************************************************************************
+* ndArrayInit
+*
+* parameters:
+*  - ndim : unsigned long ; number of dimensions, 1..NDARRAY_MAX_DIMS
+*  - shape : const unsigned long* ; extent of each dimension
+*
+* returns: NdArray*
+*
+* description: allocates a zero-filled, contiguous row-major NdArray
+*
+******************************************************************************/
+NdArray* ndArrayInit(unsigned long ndim, const unsigned long* shape) {
+    if (ndim == 0 || ndim > NDARRAY_MAX_DIMS || shape == NULL) {
+        fprintf(stderr, "ERROR: NdArray must have between 1 and %d dimensions.\n", NDARRAY_MAX_DIMS);
+        return NULL;
+    }
+
+    NdArray* array = malloc(sizeof(NdArray));
+    if (array == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for struct NdArray.\n");
+        return NULL;
+    }
+
+    array->ndim = ndim;
+    array->size = 1;
+    for (unsigned long i = 0; i < ndim; ++i) {
+        array->shape[i] = shape[i];
+        array->size *= shape[i];
+    }
+
+    // row-major: the last dimension is contiguous
+    long stride = 1;
+    for (unsigned long i = ndim; i-- > 0;) {
+        array->strides[i] = stride;
+        stride *= (long)shape[i];
+    }
+
+    // aligned_alloc wants the size to be a multiple of the alignment
+    size_t bytes = array->size * sizeof(NDARRAY_TYPE);
+    bytes = (bytes + NDARRAY_ALIGNMENT - 1) / NDARRAY_ALIGNMENT * NDARRAY_ALIGNMENT;
+    if (bytes == 0) bytes = NDARRAY_ALIGNMENT;
+
+    array->data = aligned_alloc(NDARRAY_ALIGNMENT, bytes);
+    if (array->data == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for NdArray's data.\n");
+        free(array);
+        return NULL;
+    }
+    memset(array->data, 0, bytes);
+    array->ownsData = true;
+
+    return array;
+}
+
+/******************************************************************************
+* ndArrayInitMatrix
+*
+* parameters:
+*  - rows : unsigned long
+*  - cols : unsigned long
+*
+* returns: NdArray*
+*
+* description: convenience wrapper around ndArrayInit for 2-D arrays
+*
+******************************************************************************/
+NdArray* ndArrayInitMatrix(unsigned long rows, unsigned long cols) {
+    unsigned long shape[2] = { rows, cols };
+    return ndArrayInit(2, shape);
+}
+
+/******************************************************************************
+* ndArrayDestroy
+*
+* parameters:
+*  - array : NdArray*
+*
+* returns: none
+*
+* description: frees an NdArray created by ndArrayInit. Views are plain
+*              values and are never destroyed.
+*
+******************************************************************************/
+void ndArrayDestroy(NdArray* array) {
+    if (array == NULL) {
+        fprintf(stderr, "ERROR: attempted to destroy NULL NdArray*.\n");
+        return;
+    }
+
+    if (array->ownsData) free(array->data);
+    free(array);
+}
+
+/******************************************************************************
+* ndArrayAt
+*
+* parameters:
+*  - array : NdArray*
+*  - index : const unsigned long* ; one index per dimension
+*
+* returns: NDARRAY_TYPE*
+*
+* description: returns a pointer to the element at index, with bounds checking
+*
+******************************************************************************/
+NDARRAY_TYPE* ndArrayAt(NdArray* array, const unsigned long* index) {
+    if (array == NULL || index == NULL) {
+        fprintf(stderr, "ERROR: attempted to index NULL NdArray*.\n");
+        return NULL;
+    }
+
+    long offset = 0;
+    for (unsigned long i = 0; i < array->ndim; ++i) {
+        if (index[i] >= array->shape[i]) {
+            fprintf(stderr, "ERROR: NdArray index out of bounds in dimension %lu.\n", i);
+            return NULL;
+        }
+        offset += (long)index[i] * array->strides[i];
+    }
+
+    return array->data + offset;
+}
+
+/******************************************************************************
+* ndArrayAt2
+*
+* parameters:
+*  - array : NdArray* ; must be 2-D
+*  - row : unsigned long
+*  - col : unsigned long
+*
+* returns: NDARRAY_TYPE*
+*
+* description: matrix accessor; no bounds checking, for use in hot loops
+*
+******************************************************************************/
+NDARRAY_TYPE* ndArrayAt2(NdArray* array, unsigned long row, unsigned long col) {
+    return array->data + (long)row * array->strides[0] + (long)col * array->strides[1];
+}
+
+/******************************************************************************
+* ndArrayIsContiguous
+*
+* parameters:
+*  - array : NdArray*
+*
+* returns: bool
+*
+* description: returns whether the elements are laid out densely in row-major
+*              order, i.e. the array can be treated as a flat built-in array
+*
+******************************************************************************/
+bool ndArrayIsContiguous(NdArray* array) {
+    long expected = 1;
+    for (unsigned long i = array->ndim; i-- > 0;) {
+        if (array->shape[i] != 1 && array->strides[i] != expected) return false;
+        expected *= (long)array->shape[i];
+    }
+    return true;
+}
+
+/******************************************************************************
+* ndArraySlice
+*
+* parameters:
+*  - array : NdArray*
+*  - dim : unsigned long ; dimension to slice
+*  - start : unsigned long ; first index kept
+*  - stop : unsigned long ; one past the last index kept
+*  - step : unsigned long ; keep every step-th index
+*
+* returns: NdArray ; a view sharing array's buffer; ndim 0 on error
+*
+* description: numpy-style array[..., start:stop:step, ...] without copying
+*
+******************************************************************************/
+NdArray ndArraySlice(NdArray* array, unsigned long dim, unsigned long start,
+                     unsigned long stop, unsigned long step) {
+    NdArray view = { 0 };
+    if (array == NULL || dim >= array->ndim || step == 0 || start > stop || stop > array->shape[dim]) {
+        fprintf(stderr, "ERROR: invalid NdArray slice.\n");
+        return view;
+    }
+
+    view = *array;
+    view.ownsData = false;
+    view.data = array->data + (long)start * array->strides[dim];
+    view.shape[dim] = (stop - start + step - 1) / step;
+    view.strides[dim] = array->strides[dim] * (long)step;
+
+    view.size = 1;
+    for (unsigned long i = 0; i < view.ndim; ++i) view.size *= view.shape[i];
+
+    return view;
+}
+
+/******************************************************************************
+* ndArrayRow / ndArrayColumn
+*
+* parameters:
+*  - array : NdArray* ; must be 2-D
+*  - index : unsigned long
+*
+* returns: NdArray ; 1-D view; ndim 0 on error
+*
+* description: views of a single row (contiguous) or column (strided)
+*
+******************************************************************************/
+NdArray ndArrayRow(NdArray* array, unsigned long index) {
+    NdArray view = ndArraySlice(array, 0, index, index + 1, 1);
+    if (view.ndim != 2) return view;
+
+    view.ndim = 1;
+    view.shape[0] = view.shape[1];
+    view.strides[0] = view.strides[1];
+    return view;
+}
+
+NdArray ndArrayColumn(NdArray* array, unsigned long index) {
+    NdArray view = ndArraySlice(array, 1, index, index + 1, 1);
+    if (view.ndim != 2) return view;
+
+    view.ndim = 1;
+    return view;
+}
+
+/******************************************************************************
+* ndArrayTransposeView
+*
+* parameters:
+*  - array : NdArray* ; must be 2-D
+*
+* returns: NdArray ; view with rows and columns swapped; ndim 0 on error
+*
+* description: O(1) transpose by swapping shape and strides. Walking the
+*              result row by row is a strided walk over array; use
+*              ndArrayTranspose when the transposed data will be read often.
+*
+******************************************************************************/
+NdArray ndArrayTransposeView(NdArray* array) {
+    NdArray view = { 0 };
+    if (array == NULL || array->ndim != 2) {
+        fprintf(stderr, "ERROR: transpose requires a 2-D NdArray.\n");
+        return view;
+    }
+
+    view = *array;
+    view.ownsData = false;
+    view.shape[0] = array->shape[1];
+    view.shape[1] = array->shape[0];
+    view.strides[0] = array->strides[1];
+    view.strides[1] = array->strides[0];
+    return view;
+}
+
+/******************************************************************************
+* ndArrayFill
+*
+* parameters:
+*  - array : NdArray*
+*  - value : NDARRAY_TYPE
+*
+* returns: none
+*
+* description: sets every element of array (or view) to value
+*
+******************************************************************************/
+void ndArrayFill(NdArray* array, NDARRAY_TYPE value) {
+    if (array == NULL) {
+        fprintf(stderr, "ERROR: attempted to fill NULL NdArray*.\n");
+        return;
+    }
+
+    if (ndArrayIsContiguous(array)) {
+        for (unsigned long i = 0; i < array->size; ++i) array->data[i] = value;
+        return;
+    }
+
+    // odometer over every index; the last dimension spins fastest
+    unsigned long index[NDARRAY_MAX_DIMS] = { 0 };
+    for (unsigned long n = 0; n < array->size; ++n) {
+        *ndArrayAt(array, index) = value;
+        for (unsigned long d = array->ndim; d-- > 0;) {
+            if (++index[d] < array->shape[d]) break;
+            index[d] = 0;
+        }
+    }
+}
+
+/******************************************************************************
+* ndArrayCopy
+*
+* parameters:
+*  - dst : NdArray*
+*  - src : NdArray* ; same shape as dst, any strides
+*
+* returns: bool ; success status
+*
+* description: copies src into dst element by element. Use it to materialize
+*              a view into a contiguous array.
+*
+******************************************************************************/
+bool ndArrayCopy(NdArray* dst, NdArray* src) {
+    if (dst == NULL || src == NULL || dst->ndim != src->ndim) {
+        fprintf(stderr, "ERROR: NdArray copy requires arrays of the same shape.\n");
+        return false;
+    }
+    for (unsigned long i = 0; i < dst->ndim; ++i) {
+        if (dst->shape[i] != src->shape[i]) {
+            fprintf(stderr, "ERROR: NdArray copy requires arrays of the same shape.\n");
+            return false;
+        }
+    }
+
+    if (ndArrayIsContiguous(dst) && ndArrayIsContiguous(src)) {
+        memmove(dst->data, src->data, dst->size * sizeof(NDARRAY_TYPE));
+        return true;
+    }
+
+    unsigned long index[NDARRAY_MAX_DIMS] = { 0 };
+    for (unsigned long n = 0; n < dst->size; ++n) {
+        *ndArrayAt(dst, index) = *ndArrayAt(src, index);
+        for (unsigned long d = dst->ndim; d-- > 0;) {
+            if (++index[d] < dst->shape[d]) break;
+            index[d] = 0;
+        }
+    }
+    return true;
+}
+
+/******************************************************************************
+* ndArrayTranspose
+*
+* parameters:
+*  - dst : NdArray* ; cols x rows
+*  - src : NdArray* ; rows x cols
+*
+* returns: bool ; success status
+*
+* description: materialized transpose, copied one NDARRAY_BLOCK_SIZE square
+*              tile at a time. A naive transpose reads rows and writes
+*              columns, so every write touches a new cache line; tiling keeps
+*              both the source and destination lines resident until they are
+*              fully used. dst must not overlap src.
+*
+******************************************************************************/
+bool ndArrayTranspose(NdArray* dst, NdArray* src) {
+    if (dst == NULL || src == NULL || dst->ndim != 2 || src->ndim != 2
+        || dst->shape[0] != src->shape[1] || dst->shape[1] != src->shape[0]) {
+        fprintf(stderr, "ERROR: transpose requires 2-D NdArrays of shape (r, c) and (c, r).\n");
+        return false;
+    }
+
+    unsigned long rows = src->shape[0];
+    unsigned long cols = src->shape[1];
+
+    for (unsigned long ii = 0; ii < rows; ii += NDARRAY_BLOCK_SIZE) {
+        unsigned long iEnd = (ii + NDARRAY_BLOCK_SIZE < rows) ? ii + NDARRAY_BLOCK_SIZE : rows;
+        for (unsigned long jj = 0; jj < cols; jj += NDARRAY_BLOCK_SIZE) {
+            unsigned long jEnd = (jj + NDARRAY_BLOCK_SIZE < cols) ? jj + NDARRAY_BLOCK_SIZE : cols;
+
+            for (unsigned long i = ii; i < iEnd; ++i) {
+                for (unsigned long j = jj; j < jEnd; ++j) {
+                    *ndArrayAt2(dst, j, i) = *ndArrayAt2(src, i, j);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+/******************************************************************************
+* ndArrayMatMul
+*
+* parameters:
+*  - c : NdArray* ; n x m, overwritten with a * b
+*  - a : NdArray* ; n x k
+*  - b : NdArray* ; k x m
+*
+* returns: bool ; success status
+*
+* description: blocked matrix multiply. Loops are tiled in all three
+*              dimensions and ordered i-k-j inside a tile, so the innermost
+*              loop streams along a row of b and a row of c (unit stride for
+*              contiguous arrays, which the compiler can vectorize) while
+*              a[i][k] stays in a register. c must not overlap a or b.
+*
+******************************************************************************/
+bool ndArrayMatMul(NdArray* c, NdArray* a, NdArray* b) {
+    if (a == NULL || b == NULL || c == NULL || a->ndim != 2 || b->ndim != 2 || c->ndim != 2
+        || a->shape[1] != b->shape[0] || c->shape[0] != a->shape[0] || c->shape[1] != b->shape[1]) {
+        fprintf(stderr, "ERROR: matmul requires 2-D NdArrays of shape (n, k), (k, m) and (n, m).\n");
+        return false;
+    }
+
+    unsigned long n = a->shape[0];
+    unsigned long inner = a->shape[1];
+    unsigned long m = b->shape[1];
+
+    ndArrayFill(c, 0);
+
+    for (unsigned long ii = 0; ii < n; ii += NDARRAY_BLOCK_SIZE) {
+        unsigned long iEnd = (ii + NDARRAY_BLOCK_SIZE < n) ? ii + NDARRAY_BLOCK_SIZE : n;
+        for (unsigned long kk = 0; kk < inner; kk += NDARRAY_BLOCK_SIZE) {
+            unsigned long kEnd = (kk + NDARRAY_BLOCK_SIZE < inner) ? kk + NDARRAY_BLOCK_SIZE : inner;
+            for (unsigned long jj = 0; jj < m; jj += NDARRAY_BLOCK_SIZE) {
+                unsigned long jEnd = (jj + NDARRAY_BLOCK_SIZE < m) ? jj + NDARRAY_BLOCK_SIZE : m;
+
+                for (unsigned long i = ii; i < iEnd; ++i) {
+                    NDARRAY_TYPE* cRow = ndArrayAt2(c, i, 0);
+                    for (unsigned long k = kk; k < kEnd; ++k) {
+                        NDARRAY_TYPE aik = *ndArrayAt2(a, i, k);
+                        NDARRAY_TYPE* bRow = ndArrayAt2(b, k, 0);
+
+                        if (b->strides[1] == 1 && c->strides[1] == 1) {
+                            for (unsigned long j = jj; j < jEnd; ++j) cRow[j] += aik * bRow[j];
+                        }
+                        else {
+                            for (unsigned long j = jj; j < jEnd; ++j) {
+                                cRow[(long)j * c->strides[1]] += aik * bRow[(long)j * b->strides[1]];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+/******************************************************************************
+* ndArrayToString
+*
+* parameters:
+*  - array : NdArray* ; 1-D or 2-D
+*
+* returns: none
+*
+* description: prints a vector on one line, or a matrix one row per line
+*
+******************************************************************************/
+void ndArrayToString(NdArray* array) {
+    if (array == NULL || array->ndim > 2) {
+        fprintf(stderr, "ERROR: can only print 1-D or 2-D NdArrays.\n");
+        return;
+    }
+
+    unsigned long rows = (array->ndim == 2) ? array->shape[0] : 1;
+    unsigned long cols = (array->ndim == 2) ? array->shape[1] : array->shape[0];
+    long colStride = (array->ndim == 2) ? array->strides[1] : array->strides[0];
+
+    if (array->ndim == 2) printf("[");
+    for (unsigned long i = 0; i < rows; ++i) {
+        NDARRAY_TYPE* row = array->data + (long)i * array->strides[0];
+        printf("%s[ ", (i == 0) ? "" : " ");
+        for (unsigned long j = 0; j < cols; ++j) {
+            printf("%g%s", row[(long)j * colStride], (j < cols - 1) ? ", " : "");
+        }
+        printf(" ]%s", (i < rows - 1) ? "\n" : "");
+    }
+    printf("%s\n", (array->ndim == 2) ? "]" : "");
+}
+
+#endif /* NDARRAY_H */
@@ -0,0 +1,47 @@
+#include <stdio.h> 
+
+#include "NdArray.h"
+#include "NdArrayTest.h"
+
+int main(int argc, char* argv[]) {
+    // 3x4 matrix, filled row by row: one allocation, rows adjacent in memory
+    NdArray* matrix = ndArrayInitMatrix(3, 4);
+    if (matrix == NULL) return 1;
+
+    for (unsigned long i = 0; i < 3; ++i) {
+        for (unsigned long j = 0; j < 4; ++j) {
+            *ndArrayAt2(matrix, i, j) = (double)(i * 4 + j);
+        }
+    }
+    printf("Matrix:\n");
+    ndArrayToString(matrix);
+
+    // Views share the buffer; nothing is copied
+    NdArray column = ndArrayColumn(matrix, 2);
+    printf("Column 2: ");
+    ndArrayToString(&column);
+
+    NdArray everyOtherColumn = ndArraySlice(matrix, 1, 0, 4, 2);
+    printf("Every other column:\n");
+    ndArrayToString(&everyOtherColumn);
+
+    NdArray transposedView = ndArrayTransposeView(matrix);
+    printf("Transposed (view):\n");
+    ndArrayToString(&transposedView);
+
+    // Writing through a view writes to the original
+    *ndArrayAt2(&transposedView, 0, 1) = -1;
+    printf("After writing -1 through the view at (0, 1), matrix:\n");
+    ndArrayToString(matrix);
+
+    // matrix * matrix^T
+    NdArray* product = ndArrayInitMatrix(3, 3);
+    ndArrayMatMul(product, matrix, &transposedView);
+    printf("matrix * matrix^T:\n");
+    ndArrayToString(product);
+
+    ndArrayDestroy(product);
+    ndArrayDestroy(matrix);
+
+    runNdArrayTests();
+}
@@ -0,0 +1,246 @@
+#ifndef NDARRAYTEST_H
+#define NDARRAYTEST_H
+
+#include "NdArray.h"
+#include "TestsSummary.h"
+
+/* Testing functions **********************************************************/
+void testNdArrayInitAt();
+void testNdArraySlice();
+void testNdArrayTransposeView();
+void testNdArrayCopy();
+void testNdArrayTranspose();
+void testNdArrayMatMul();
+/* End testing functions ******************************************************/
+
+/* Test setup/teardown functions **********************************************/
+NdArray* SetUp(unsigned long rows, unsigned long cols) {
+    NdArray* matrix = ndArrayInitMatrix(rows, cols);
+    for (unsigned long i = 0; i < rows; ++i) {
+        for (unsigned long j = 0; j < cols; ++j) {
+            *ndArrayAt2(matrix, i, j) = (double)(i * cols + j);
+        }
+    }
+    return matrix;
+}
+
+void TearDown(NdArray* array) {
+    ndArrayDestroy(array);
+}
+/* End test setup/teardown functions ******************************************/
+
+// These tests assume NDARRAY_TYPE is double
+void runNdArrayTests() {
+    TestsSummaryPrintHeader("NdArray");
+
+    testNdArrayInitAt();
+    testNdArraySlice();
+    testNdArrayTransposeView();
+    testNdArrayCopy();
+    testNdArrayTranspose();
+    testNdArrayMatMul();
+
+    TestsSummaryPrintFooter("NdArray");
+}
+
+void testNdArrayInitAt() {
+    int successes = 0, failures = 0;
+
+    unsigned long shape[3] = { 2, 3, 4 };
+    NdArray* cube = ndArrayInit(3, shape);
+
+    if (cube->size != 24 || cube->strides[0] != 12 || cube->strides[1] != 4 || cube->strides[2] != 1) {
+        printf("FAILED: testNdArrayInitAt: expected size 24 and strides (12, 4, 1) but got size %lu and strides (%ld, %ld, %ld)\n",
+               cube->size, cube->strides[0], cube->strides[1], cube->strides[2]);
+        failures++;
+    }
+    else successes++;
+
+    unsigned long index[3] = { 1, 2, 3 };
+    *ndArrayAt(cube, index) = 7;
+    if (cube->data[23] != 7) {
+        printf("FAILED: testNdArrayInitAt: expected element (1, 2, 3) at flat index 23\n");
+        failures++;
+    }
+    else successes++;
+
+    unsigned long outOfBounds[3] = { 2, 0, 0 };
+    if (ndArrayAt(cube, outOfBounds) != NULL) {
+        printf("FAILED: testNdArrayInitAt: incorrectly allowed out of bounds index\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("NdArrayInitAt", successes, failures);
+    TearDown(cube);
+}
+
+void testNdArraySlice() {
+    NdArray* matrix = SetUp(4, 5);
+    int successes = 0, failures = 0;
+
+    // rows 1..3, every other column starting at 1 -> 3x2
+    NdArray rows = ndArraySlice(matrix, 0, 1, 4, 1);
+    NdArray view = ndArraySlice(&rows, 1, 1, 5, 2);
+
+    if (view.shape[0] != 3 || view.shape[1] != 2) {
+        printf("FAILED: testNdArraySlice: expected shape (3, 2) but got (%lu, %lu)\n", view.shape[0], view.shape[1]);
+        failures++;
+    }
+    else successes++;
+
+    // view(2, 1) == matrix(3, 3) == 18
+    if (*ndArrayAt2(&view, 2, 1) != 18) {
+        printf("FAILED: testNdArraySlice: expected 18 but got %g\n", *ndArrayAt2(&view, 2, 1));
+        failures++;
+    }
+    else successes++;
+
+    if (view.data < matrix->data || view.data >= matrix->data + matrix->size || view.ownsData) {
+        printf("FAILED: testNdArraySlice: expected view to borrow the matrix's buffer\n");
+        failures++;
+    }
+    else successes++;
+
+    NdArray column = ndArrayColumn(matrix, 4);
+    if (column.ndim != 1 || column.shape[0] != 4 || column.data[column.strides[0] * 3] != 19) {
+        printf("FAILED: testNdArraySlice: expected column 4 to end with 19\n");
+        failures++;
+    }
+    else successes++;
+
+    NdArray invalid = ndArraySlice(matrix, 0, 3, 6, 1);
+    if (invalid.ndim != 0) {
+        printf("FAILED: testNdArraySlice: incorrectly allowed a slice past the end\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("NdArraySlice", successes, failures);
+    TearDown(matrix);
+}
+
+void testNdArrayTransposeView() {
+    NdArray* matrix = SetUp(2, 3);
+    int successes = 0, failures = 0;
+
+    NdArray transposed = ndArrayTransposeView(matrix);
+    if (transposed.shape[0] != 3 || transposed.shape[1] != 2 || *ndArrayAt2(&transposed, 2, 1) != 5) {
+        printf("FAILED: testNdArrayTransposeView: expected (2, 1) of the transpose to be 5\n");
+        failures++;
+    }
+    else successes++;
+
+    if (ndArrayIsContiguous(&transposed) || !ndArrayIsContiguous(matrix)) {
+        printf("FAILED: testNdArrayTransposeView: contiguity not reported correctly\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("NdArrayTransposeView", successes, failures);
+    TearDown(matrix);
+}
+
+void testNdArrayCopy() {
+    NdArray* matrix = SetUp(3, 3);
+    NdArray* copy = ndArrayInitMatrix(3, 3);
+    int successes = 0, failures = 0;
+
+    NdArray transposed = ndArrayTransposeView(matrix);
+    ndArrayCopy(copy, &transposed);
+
+    if (!ndArrayIsContiguous(copy) || copy->data[1] != 3 || copy->data[5] != 7) {
+        printf("FAILED: testNdArrayCopy: expected a contiguous copy of the transpose\n");
+        failures++;
+    }
+    else successes++;
+
+    NdArray* wrongShape = ndArrayInitMatrix(2, 3);
+    if (ndArrayCopy(wrongShape, matrix)) {
+        printf("FAILED: testNdArrayCopy: incorrectly allowed copy between different shapes\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("NdArrayCopy", successes, failures);
+    TearDown(wrongShape);
+    TearDown(copy);
+    TearDown(matrix);
+}
+
+void testNdArrayTranspose() {
+    // not a multiple of NDARRAY_BLOCK_SIZE in either dimension
+    NdArray* matrix = SetUp(NDARRAY_BLOCK_SIZE * 2 + 3, NDARRAY_BLOCK_SIZE + 5);
+    NdArray* transposed = ndArrayInitMatrix(matrix->shape[1], matrix->shape[0]);
+    int successes = 0, failures = 0;
+
+    ndArrayTranspose(transposed, matrix);
+
+    unsigned long mismatches = 0;
+    for (unsigned long i = 0; i < matrix->shape[0]; ++i) {
+        for (unsigned long j = 0; j < matrix->shape[1]; ++j) {
+            if (*ndArrayAt2(transposed, j, i) != *ndArrayAt2(matrix, i, j)) mismatches++;
+        }
+    }
+
+    if (mismatches != 0) {
+        printf("FAILED: testNdArrayTranspose: %lu elements differ from the source\n", mismatches);
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("NdArrayTranspose", successes, failures);
+    TearDown(transposed);
+    TearDown(matrix);
+}
+
+void testNdArrayMatMul() {
+    unsigned long n = NDARRAY_BLOCK_SIZE + 7, k = NDARRAY_BLOCK_SIZE * 2 + 1, m = 33;
+    NdArray* a = SetUp(n, k);
+    NdArray* b = SetUp(k, m);
+    NdArray* c = ndArrayInitMatrix(n, m);
+    int successes = 0, failures = 0;
+
+    ndArrayMatMul(c, a, b);
+
+    unsigned long mismatches = 0;
+    for (unsigned long i = 0; i < n; ++i) {
+        for (unsigned long j = 0; j < m; ++j) {
+            double expected = 0;
+            for (unsigned long p = 0; p < k; ++p) expected += *ndArrayAt2(a, i, p) * *ndArrayAt2(b, p, j);
+            if (*ndArrayAt2(c, i, j) != expected) mismatches++;
+        }
+    }
+
+    if (mismatches != 0) {
+        printf("FAILED: testNdArrayMatMul: %lu elements differ from the naive product\n", mismatches);
+        failures++;
+    }
+    else successes++;
+
+    // strided operands: a * a^T through a view
+    NdArray* square = ndArrayInitMatrix(n, n);
+    NdArray aT = ndArrayTransposeView(a);
+    ndArrayMatMul(square, a, &aT);
+    if (*ndArrayAt2(square, 3, 5) != *ndArrayAt2(square, 5, 3)) {
+        printf("FAILED: testNdArrayMatMul: expected a * a^T to be symmetric\n");
+        failures++;
+    }
+    else successes++;
+
+    NdArray* wrongShape = ndArrayInitMatrix(m, n);
+    if (ndArrayMatMul(wrongShape, a, b)) {
+        printf("FAILED: testNdArrayMatMul: incorrectly allowed mismatched shapes\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("NdArrayMatMul", successes, failures);
+    TearDown(wrongShape);
+    TearDown(square);
+    TearDown(c);
+    TearDown(b);
+    TearDown(a);
+}
+
+#endif /* NDARRAYTEST_H */
@@ -0,0 +1,227 @@
+#ifndef STRUCTOFARRAYS_H
+#define STRUCTOFARRAYS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+/******************************************************************************
+* StructOfArrays
+*
+* implementation: X-macro generator. A field list is written once as
+*                 X(ctx, type, name) entries and SOA_DEFINE expands it into a
+*                 row struct plus a container holding one growable array per
+*                 field. Scanning a single field then only pulls that field's
+*                 bytes through the cache instead of every whole record.
+*
+* usage:
+*     #define EVENT_LOG_FIELDS(X, ctx) \
+*         X(ctx, int, eventId)          \
+*         X(ctx, int, serverId)         \
+*         X(ctx, EventMessage, message)
+*
+*     SOA_DEFINE(EventLogColumns, eventLogColumns, EventLogRow, EVENT_LOG_FIELDS)
+*
+*   Array-typed fields (e.g. char[100]) need a typedef first,
+*   `typedef char EventMessage[100];`, because a field is copied with memcpy
+*   and declared as `type name`. ctx is opaque to the field list; it carries
+*   (Name, prefix) through to the per-column expanders.
+*
+* generated structures
+*  - Row: a plain struct with every field; used to push and get whole rows
+*  - Name: size, capacity and one `type* name` column per field
+*
+* generated functions (prefix = second SOA_DEFINE argument)
+*  - Name* prefixInit(unsigned long capacity)
+*  - void prefixDestroy(Name* columns)
+*  - bool prefixReserve(Name* columns, unsigned long capacity)
+*  - bool prefixPushBack(Name* columns, const Row* row)
+*  - long prefixEmplaceBack(Name* columns) ; appends a zeroed row, returns its
+*                                            index or -1 on failure
+*  - bool prefixGet(Name* columns, unsigned long index, Row* out)
+*  - unsigned long prefixSize(Name* columns)
+*  - void prefixClear(Name* columns)
+*  - type* prefix_name(Name* columns) ; base of a column, for iteration
+*  - type* prefix_nameAt(Name* columns, unsigned long index) ; bounds-checked
+*
+******************************************************************************/
+
+#define SOA_INITIAL_CAPACITY 16
+
+// Iterate the row indices of any generated container
+#define SOA_FOR_EACH_INDEX(columns, i) for (unsigned long i = 0; i < (columns)->size; ++i)
+
+/* Field list expanders *******************************************************/
+#define __SOA_ROW_FIELD(ctx, type, name) type name;
+#define __SOA_COLUMN_FIELD(ctx, type, name) type* name;
+#define __SOA_COLUMN_NULL(ctx, type, name) columns->name = NULL;
+#define __SOA_COLUMN_FREE(ctx, type, name) free(columns->name);
+#define __SOA_COLUMN_GROW(ctx, type, name)                                     \
+    {                                                                          \
+        type* grown = realloc(columns->name, capacity * sizeof(type));         \
+        if (grown == NULL) {                                                   \
+            fprintf(stderr, "ERROR: failed to grow column " #name ".\n");      \
+            return false;                                                      \
+        }                                                                      \
+        columns->name = grown;                                                 \
+    }
+#define __SOA_COLUMN_STORE(ctx, type, name)                                    \
+    memcpy(&columns->name[columns->size], &row->name, sizeof(type));
+#define __SOA_COLUMN_ZERO(ctx, type, name)                                     \
+    memset(&columns->name[columns->size], 0, sizeof(type));
+#define __SOA_COLUMN_LOAD(ctx, type, name)                                     \
+    memcpy(&out->name, &columns->name[index], sizeof(type));
+/* End field list expanders ***************************************************/
+
+/******************************************************************************
+* SOA_DEFINE
+*
+* parameters:
+*  - Name : container struct name, e.g. EventLogColumns
+*  - prefix : function name prefix, e.g. eventLogColumns
+*  - Row : row struct name, e.g. EventLogRow
+*  - FIELDS : field list macro taking (X, ctx), expanding X(ctx, type, name)
+*
+* description: defines Row, Name and the functions listed in the header,
+*              including the per-column accessors for every field
+*
+******************************************************************************/
+#define SOA_DEFINE(Name, prefix, Row, FIELDS)                                  \
+                                                                               \
+typedef struct Row {                                                           \
+    FIELDS(__SOA_ROW_FIELD, (Name, prefix))                                    \
+} Row;                                                                         \
+                                                                               \
+typedef struct Name {                                                          \
+    unsigned long size;                                                        \
+    unsigned long capacity;                                                    \
+    FIELDS(__SOA_COLUMN_FIELD, (Name, prefix))                                 \
+} Name;                                                                        \
+                                                                               \
+bool prefix##Reserve(Name* columns, unsigned long capacity) {                  \
+    if (columns == NULL) {                                                     \
+        fprintf(stderr, "ERROR: attempted to reserve NULL " #Name "*.\n");     \
+        return false;                                                          \
+    }                                                                          \
+    if (capacity <= columns->capacity) return true;                            \
+                                                                               \
+    FIELDS(__SOA_COLUMN_GROW, (Name, prefix))                                  \
+    columns->capacity = capacity;                                              \
+    return true;                                                               \
+}                                                                              \
+                                                                               \
+void prefix##Destroy(Name* columns) {                                          \
+    if (columns == NULL) {                                                     \
+        fprintf(stderr, "ERROR: attempted to destroy NULL " #Name "*.\n");     \
+        return;                                                                \
+    }                                                                          \
+                                                                               \
+    FIELDS(__SOA_COLUMN_FREE, (Name, prefix))                                  \
+    free(columns);                                                             \
+}                                                                              \
+                                                                               \
+Name* prefix##Init(unsigned long capacity) {                                   \
+    Name* columns = malloc(sizeof(Name));                                      \
+    if (columns == NULL) {                                                     \
+        fprintf(stderr, "ERROR: failed to allocate memory for " #Name ".\n");  \
+        return NULL;                                                           \
+    }                                                                          \
+                                                                               \
+    columns->size = 0;                                                         \
+    columns->capacity = 0;                                                     \
+    FIELDS(__SOA_COLUMN_NULL, (Name, prefix))                                  \
+                                                                               \
+    if (capacity == 0) capacity = SOA_INITIAL_CAPACITY;                        \
+    if (!prefix##Reserve(columns, capacity)) {                                 \
+        prefix##Destroy(columns);                                              \
+        return NULL;                                                           \
+    }                                                                          \
+    return columns;                                                            \
+}                                                                              \
+                                                                               \
+bool prefix##PushBack(Name* columns, const Row* row) {                         \
+    if (columns == NULL || row == NULL) {                                      \
+        fprintf(stderr, "ERROR: attempted to push NULL row into " #Name ".\n"); \
+        return false;                                                          \
+    }                                                                          \
+    if (columns->size == columns->capacity                                     \
+        && !prefix##Reserve(columns, columns->capacity * 2)) {                 \
+        return false;                                                          \
+    }                                                                          \
+                                                                               \
+    FIELDS(__SOA_COLUMN_STORE, (Name, prefix))                                 \
+    columns->size++;                                                           \
+    return true;                                                               \
+}                                                                              \
+                                                                               \
+long prefix##EmplaceBack(Name* columns) {                                      \
+    if (columns == NULL) {                                                     \
+        fprintf(stderr, "ERROR: attempted to add row to NULL " #Name "*.\n");  \
+        return -1;                                                             \
+    }                                                                          \
+    if (columns->size == columns->capacity                                     \
+        && !prefix##Reserve(columns, columns->capacity * 2)) {                 \
+        return -1;                                                             \
+    }                                                                          \
+                                                                               \
+    FIELDS(__SOA_COLUMN_ZERO, (Name, prefix))                                  \
+    return (long)columns->size++;                                              \
+}                                                                              \
+                                                                               \
+bool prefix##Get(Name* columns, unsigned long index, Row* out) {               \
+    if (columns == NULL || out == NULL || index >= columns->size) {            \
+        fprintf(stderr, "ERROR: " #Name " index out of bounds.\n");            \
+        return false;                                                          \
+    }                                                                          \
+                                                                               \
+    FIELDS(__SOA_COLUMN_LOAD, (Name, prefix))                                  \
+    return true;                                                               \
+}                                                                              \
+                                                                               \
+unsigned long prefix##Size(Name* columns) {                                    \
+    if (columns == NULL) {                                                     \
+        fprintf(stderr, "ERROR: attempted to access size of NULL " #Name "*.\n"); \
+        return 0;                                                              \
+    }                                                                          \
+    return columns->size;                                                      \
+}                                                                              \
+                                                                               \
+void prefix##Clear(Name* columns) {                                            \
+    if (columns == NULL) {                                                     \
+        fprintf(stderr, "ERROR: attempted to clear NULL " #Name "*.\n");       \
+        return;                                                                \
+    }                                                                          \
+    columns->size = 0;                                                         \
+}                                                                              \
+                                                                               \
+FIELDS(__SOA_COLUMN_ACCESSORS, (Name, prefix))
+
+/* Per-column accessors *******************************************************/
+// ctx is the parenthesized (Name, prefix) pair; unpack it, then go through one
+// more level so prefix is fully expanded before it is pasted.
+#define __SOA_CTX_NAME(Name, prefix) Name
+#define __SOA_CTX_PREFIX(Name, prefix) prefix
+#define __SOA_COLUMN_ACCESSORS(ctx, type, name)                                \
+    __SOA_COLUMN_ACCESSORS_EXPAND(__SOA_CTX_NAME ctx, __SOA_CTX_PREFIX ctx, type, name)
+#define __SOA_COLUMN_ACCESSORS_EXPAND(Name, prefix, type, name)                \
+    __SOA_COLUMN_ACCESSORS_IMPL(Name, prefix, type, name)
+#define __SOA_COLUMN_ACCESSORS_IMPL(Name, prefix, type, name)                  \
+type* prefix##_##name(Name* columns) {                                         \
+    if (columns == NULL) {                                                     \
+        fprintf(stderr, "ERROR: attempted to access column of NULL " #Name "*.\n"); \
+        return NULL;                                                           \
+    }                                                                          \
+    return columns->name;                                                      \
+}                                                                              \
+                                                                               \
+type* prefix##_##name##At(Name* columns, unsigned long index) {                \
+    if (columns == NULL || index >= columns->size) {                           \
+        fprintf(stderr, "ERROR: " #Name " index out of bounds.\n");            \
+        return NULL;                                                           \
+    }                                                                          \
+    return &columns->name[index];                                              \
+}
+/* End per-column accessors ***************************************************/
+
+#endif /* STRUCTOFARRAYS_H */
@@ -0,0 +1,56 @@
+#include <stdio.h> 
+
+#include "StructOfArrays.h"
+#include "StructOfArraysTest.h"
+
+// Same fields as EventLog in 4_BasicIO/1_FileIO/FormattedText.h
+typedef char EventTimestamp[20];
+typedef char EventType[10];
+typedef char EventMessage[100];
+
+#define EVENT_LOG_FIELDS(X, ctx)        \
+    X(ctx, int, eventId)                \
+    X(ctx, int, serverId)               \
+    X(ctx, EventTimestamp, timestamp)   \
+    X(ctx, EventType, type)             \
+    X(ctx, EventMessage, message)
+
+SOA_DEFINE(EventLogColumns, eventLogColumns, EventLogRow, EVENT_LOG_FIELDS)
+
+int main(int argc, char* argv[]) {
+    EventLogColumns* events = eventLogColumnsInit(0);
+    if (events == NULL) return 1;
+
+    // Push whole rows...
+    EventLogRow row = { 1, 12345, "2024-10-26 12:32:45", "INFO", "Backup completed successfully." };
+    eventLogColumnsPushBack(events, &row);
+
+    EventLogRow row2 = { 2, 12346, "2024-10-26 15:47:22", "WARNING", "High CPU usage detected." };
+    eventLogColumnsPushBack(events, &row2);
+
+    // ...or add an empty row and fill it one field at a time, the way the
+    // FormattedText.h parsers see one "Key: value" line at a time
+    long index = eventLogColumnsEmplaceBack(events);
+    *eventLogColumns_eventIdAt(events, index) = 3;
+    *eventLogColumns_serverIdAt(events, index) = 12345;
+    snprintf(*eventLogColumns_timestampAt(events, index), sizeof(EventTimestamp), "%s", "2024-10-26 18:05:10");
+    snprintf(*eventLogColumns_typeAt(events, index), sizeof(EventType), "%s", "ERROR");
+    snprintf(*eventLogColumns_messageAt(events, index), sizeof(EventMessage), "%s", "Disk failure on /dev/sda1.");
+
+    // Scanning one column only reads that column's memory
+    int* serverIds = eventLogColumns_serverId(events);
+    unsigned long matches = 0;
+    SOA_FOR_EACH_INDEX(events, i) {
+        if (serverIds[i] == 12345) matches++;
+    }
+    printf("Events for server 12345: %lu\n", matches);
+    printf("Bytes per row scanned: %zu (column) vs %zu (whole record)\n", sizeof(int), sizeof(EventLogRow));
+
+    EventLogRow out;
+    eventLogColumnsGet(events, 2, &out);
+    printf("Row 2: EVT%03d server %d at %s [%s] %s\n", out.eventId, out.serverId, out.timestamp, out.type, out.message);
+
+    eventLogColumnsDestroy(events);
+
+    runStructOfArraysTests();
+}
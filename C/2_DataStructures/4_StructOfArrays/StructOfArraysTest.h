@@ -0,0 +1,164 @@
+#ifndef STRUCTOFARRAYSTEST_H
+#define STRUCTOFARRAYSTEST_H
+
+#include "StructOfArrays.h"
+#include "TestsSummary.h"
+
+typedef char TestLabel[16];
+
+#define TEST_RECORD_FIELDS(X, ctx)  \
+    X(ctx, int, id)                 \
+    X(ctx, double, score)           \
+    X(ctx, TestLabel, label)
+
+SOA_DEFINE(TestColumns, testColumns, TestRow, TEST_RECORD_FIELDS)
+
+/* Testing functions **********************************************************/
+void testStructOfArraysPushGet();
+void testStructOfArraysGrowth();
+void testStructOfArraysEmplace();
+void testStructOfArraysColumns();
+/* End testing functions ******************************************************/
+
+/* Test setup/teardown functions **********************************************/
+TestColumns* SetUp(unsigned long capacity) {
+    return testColumnsInit(capacity);
+}
+
+void TearDown(TestColumns* columns) {
+    testColumnsDestroy(columns);
+}
+/* End test setup/teardown functions ******************************************/
+
+void runStructOfArraysTests() {
+    TestsSummaryPrintHeader("StructOfArrays");
+
+    testStructOfArraysPushGet();
+    testStructOfArraysGrowth();
+    testStructOfArraysEmplace();
+    testStructOfArraysColumns();
+
+    TestsSummaryPrintFooter("StructOfArrays");
+}
+
+void testStructOfArraysPushGet() {
+    TestColumns* columns = SetUp(4);
+    int successes = 0, failures = 0;
+
+    TestRow row = { 7, 2.5, "seven" };
+    testColumnsPushBack(columns, &row);
+
+    TestRow out = { 0 };
+    testColumnsGet(columns, 0, &out);
+    if (out.id != 7 || out.score != 2.5 || strcmp(out.label, "seven") != 0) {
+        printf("FAILED: testStructOfArraysPushGet: expected (7, 2.5, seven) but got (%d, %g, %s)\n",
+               out.id, out.score, out.label);
+        failures++;
+    }
+    else successes++;
+
+    if (testColumnsGet(columns, 1, &out)) {
+        printf("FAILED: testStructOfArraysPushGet: incorrectly allowed get past the end\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("StructOfArraysPushGet", successes, failures);
+    TearDown(columns);
+}
+
+void testStructOfArraysGrowth() {
+    TestColumns* columns = SetUp(1);
+    int successes = 0, failures = 0;
+
+    for (int i = 0; i < 1000; ++i) {
+        TestRow row = { i, i * 0.5, "" };
+        snprintf(row.label, sizeof(TestLabel), "row%d", i);
+        testColumnsPushBack(columns, &row);
+    }
+
+    if (testColumnsSize(columns) != 1000 || columns->capacity < 1000) {
+        printf("FAILED: testStructOfArraysGrowth: expected size 1000 but got %lu\n", testColumnsSize(columns));
+        failures++;
+    }
+    else successes++;
+
+    TestRow out;
+    testColumnsGet(columns, 999, &out);
+    if (out.id != 999 || out.score != 499.5 || strcmp(out.label, "row999") != 0) {
+        printf("FAILED: testStructOfArraysGrowth: row 999 corrupted after growth\n");
+        failures++;
+    }
+    else successes++;
+
+    testColumnsClear(columns);
+    if (testColumnsSize(columns) != 0) {
+        printf("FAILED: testStructOfArraysGrowth: expected size 0 after clear\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("StructOfArraysGrowth", successes, failures);
+    TearDown(columns);
+}
+
+void testStructOfArraysEmplace() {
+    TestColumns* columns = SetUp(2);
+    int successes = 0, failures = 0;
+
+    long index = testColumnsEmplaceBack(columns);
+    if (index != 0 || *testColumns_idAt(columns, 0) != 0 || *testColumns_scoreAt(columns, 0) != 0) {
+        printf("FAILED: testStructOfArraysEmplace: expected a zeroed row at index 0\n");
+        failures++;
+    }
+    else successes++;
+
+    *testColumns_scoreAt(columns, index) = 9.75;
+    TestRow out;
+    testColumnsGet(columns, index, &out);
+    if (out.score != 9.75) {
+        printf("FAILED: testStructOfArraysEmplace: expected score 9.75 but got %g\n", out.score);
+        failures++;
+    }
+    else successes++;
+
+    if (testColumns_idAt(columns, 1) != NULL) {
+        printf("FAILED: testStructOfArraysEmplace: incorrectly allowed column access past the end\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("StructOfArraysEmplace", successes, failures);
+    TearDown(columns);
+}
+
+void testStructOfArraysColumns() {
+    TestColumns* columns = SetUp(8);
+    int successes = 0, failures = 0;
+
+    for (int i = 0; i < 8; ++i) {
+        TestRow row = { i, 1.0, "x" };
+        testColumnsPushBack(columns, &row);
+    }
+
+    // each column is its own dense array
+    int* ids = testColumns_id(columns);
+    int sum = 0;
+    SOA_FOR_EACH_INDEX(columns, i) sum += ids[i];
+    if (sum != 28) {
+        printf("FAILED: testStructOfArraysColumns: expected id column to sum to 28 but got %d\n", sum);
+        failures++;
+    }
+    else successes++;
+
+    if ((char*)&testColumns_score(columns)[1] - (char*)&testColumns_score(columns)[0] != sizeof(double)) {
+        printf("FAILED: testStructOfArraysColumns: expected score column to be densely packed\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("StructOfArraysColumns", successes, failures);
+    TearDown(columns);
+}
+
+#endif /* STRUCTOFARRAYSTEST_H */
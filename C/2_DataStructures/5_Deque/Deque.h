@@ -0,0 +1,430 @@
+#ifndef DEQUE_H
+#define DEQUE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+/******************************************************************************
+* Deque
+*
+* implementation: ring buffer with a power-of-two capacity, so wrapping an
+*                 index is a mask instead of a modulo; compile-time "generic"
+*                 with DEQUE_TYPE. The buffer doubles when full and never
+*                 shrinks, so once a queue has reached its working size,
+*                 pushes and pops don't touch the allocator.
+*
+* structures
+*  - Deque: holds the ring buffer, the index of the front element, the number
+*           of elements, and capacity - 1 as the wrap mask
+*
+******************************************************************************/
+
+#define DEQUE_TYPE int
+#define DEQUE_MIN_CAPACITY 8
+
+typedef struct Deque {
+    DEQUE_TYPE* data;
+    unsigned long head;
+    unsigned long size;
+    unsigned long mask;
+} Deque;
+
+// Internal helper: smallest power of two >= n (and >= DEQUE_MIN_CAPACITY)
+static unsigned long __dequeRoundUpPow2(unsigned long n) {
+    unsigned long capacity = DEQUE_MIN_CAPACITY;
+    while (capacity < n) capacity <<= 1;
+    return capacity;
+}
+
+/******************************************************************************
+* dequeInit
+*
+* parameters:
+*  - capacity : unsigned long ; rounded up to a power of two
+*
+* returns: Deque*
+*
+* description: initializes the Deque's memory; data is NOT initialized
+*
+******************************************************************************/
+Deque* dequeInit(unsigned long capacity) {
+    Deque* deque = malloc(sizeof(Deque));
+    if (deque == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for struct Deque.\n");
+        return NULL;
+    }
+
+    capacity = __dequeRoundUpPow2(capacity);
+    deque->data = malloc(capacity * sizeof(DEQUE_TYPE));
+    if (deque->data == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for Deque's data.\n");
+        free(deque);
+        return NULL;
+    }
+
+    deque->head = 0;
+    deque->size = 0;
+    deque->mask = capacity - 1;
+
+    return deque;
+}
+
+/******************************************************************************
+* dequeDestroy
+*
+* parameters:
+*  - deque : Deque*
+*
+* returns: none
+*
+* description: frees the memory used by the Deque
+*
+******************************************************************************/
+void dequeDestroy(Deque* deque) {
+    if (deque == NULL) {
+        fprintf(stderr, "ERROR: attempted to destroy NULL Deque*.\n");
+        return;
+    }
+
+    free(deque->data);
+    free(deque);
+}
+
+/******************************************************************************
+* dequeSize / dequeCapacity / dequeEmpty
+*
+* parameters:
+*  - deque : Deque*
+*
+* returns: unsigned long / unsigned long / bool
+*
+* description: number of elements held, number of elements that fit before
+*              the next growth, and whether size is 0
+*
+******************************************************************************/
+unsigned long dequeSize(Deque* deque) {
+    if (deque == NULL) {
+        fprintf(stderr, "ERROR: attempted to access size of NULL Deque*.\n");
+        return 0;
+    }
+    return deque->size;
+}
+
+unsigned long dequeCapacity(Deque* deque) {
+    if (deque == NULL) {
+        fprintf(stderr, "ERROR: attempted to access capacity of NULL Deque*.\n");
+        return 0;
+    }
+    return deque->mask + 1;
+}
+
+bool dequeEmpty(Deque* deque) {
+    if (deque == NULL) {
+        fprintf(stderr, "ERROR: attempted to access size of NULL Deque*.\n");
+        return false;
+    }
+    return deque->size == 0;
+}
+
+/******************************************************************************
+* dequeReserve
+*
+* parameters:
+*  - deque : Deque*
+*  - capacity : unsigned long ; rounded up to a power of two
+*
+* returns: bool ; success status
+*
+* description: grows the ring so it holds at least capacity elements. If the
+*              elements wrapped around the end of the old buffer, the front
+*              segment is moved to the end of the new one so the ring stays
+*              in order.
+*
+******************************************************************************/
+bool dequeReserve(Deque* deque, unsigned long capacity) {
+    if (deque == NULL) {
+        fprintf(stderr, "ERROR: attempted to reserve space in NULL Deque*.\n");
+        return false;
+    }
+
+    unsigned long oldCapacity = deque->mask + 1;
+    if (capacity <= oldCapacity) return true;
+    capacity = __dequeRoundUpPow2(capacity);
+
+    DEQUE_TYPE* data = realloc(deque->data, capacity * sizeof(DEQUE_TYPE));
+    if (data == NULL) {
+        fprintf(stderr, "ERROR: failed to grow Deque's data.\n");
+        return false;
+    }
+
+    // [head, oldCapacity) is the front of the ring; the rest wrapped to [0, ..)
+    if (deque->head + deque->size > oldCapacity) {
+        unsigned long frontCount = oldCapacity - deque->head;
+        unsigned long newHead = capacity - frontCount;
+        memcpy(data + newHead, data + deque->head, frontCount * sizeof(DEQUE_TYPE));
+        deque->head = newHead;
+    }
+
+    deque->data = data;
+    deque->mask = capacity - 1;
+    return true;
+}
+
+/******************************************************************************
+* dequeAt
+*
+* parameters:
+*  - deque : Deque*
+*  - index : unsigned long ; 0 is the front
+*
+* returns: DEQUE_TYPE*
+*
+* description: returns the element at the given logical index, with bounds
+*              checking performed
+*
+******************************************************************************/
+DEQUE_TYPE* dequeAt(Deque* deque, unsigned long index) {
+    if (deque == NULL || index >= deque->size) {
+        fprintf(stderr, "ERROR: deque index out of bounds.\n");
+        return NULL;
+    }
+    return &deque->data[(deque->head + index) & deque->mask];
+}
+
+/******************************************************************************
+* dequeFront / dequeBack
+*
+* parameters:
+*  - deque : Deque*
+*
+* returns: DEQUE_TYPE*
+*
+* description: returns the element at the front/back of the Deque
+*
+******************************************************************************/
+DEQUE_TYPE* dequeFront(Deque* deque) {
+    return dequeAt(deque, 0);
+}
+
+DEQUE_TYPE* dequeBack(Deque* deque) {
+    if (deque == NULL || deque->size == 0) {
+        fprintf(stderr, "ERROR: deque is empty.\n");
+        return NULL;
+    }
+    return dequeAt(deque, deque->size - 1);
+}
+
+/******************************************************************************
+* dequePushBack / dequePushFront
+*
+* parameters:
+*  - deque : Deque*
+*  - value : DEQUE_TYPE
+*
+* returns: bool ; success status
+*
+* description: adds value at the back/front, doubling the ring if it is full
+*
+******************************************************************************/
+bool dequePushBack(Deque* deque, DEQUE_TYPE value) {
+    if (deque == NULL) {
+        fprintf(stderr, "ERROR: attempted to add element to NULL Deque*.\n");
+        return false;
+    }
+    if (deque->size > deque->mask && !dequeReserve(deque, (deque->mask + 1) * 2)) {
+        return false;
+    }
+
+    deque->data[(deque->head + deque->size) & deque->mask] = value;
+    deque->size++;
+    return true;
+}
+
+bool dequePushFront(Deque* deque, DEQUE_TYPE value) {
+    if (deque == NULL) {
+        fprintf(stderr, "ERROR: attempted to add element to NULL Deque*.\n");
+        return false;
+    }
+    if (deque->size > deque->mask && !dequeReserve(deque, (deque->mask + 1) * 2)) {
+        return false;
+    }
+
+    deque->head = (deque->head - 1) & deque->mask;
+    deque->data[deque->head] = value;
+    deque->size++;
+    return true;
+}
+
+/******************************************************************************
+* dequePopBack / dequePopFront
+*
+* parameters:
+*  - deque : Deque*
+*  - out : DEQUE_TYPE* ; receives the removed element; may be NULL
+*
+* returns: bool ; success status
+*
+* description: removes the element at the back/front of the Deque
+*
+******************************************************************************/
+bool dequePopBack(Deque* deque, DEQUE_TYPE* out) {
+    if (deque == NULL || deque->size == 0) {
+        fprintf(stderr, "ERROR: deque is empty.\n");
+        return false;
+    }
+
+    deque->size--;
+    if (out != NULL) *out = deque->data[(deque->head + deque->size) & deque->mask];
+    return true;
+}
+
+bool dequePopFront(Deque* deque, DEQUE_TYPE* out) {
+    if (deque == NULL || deque->size == 0) {
+        fprintf(stderr, "ERROR: deque is empty.\n");
+        return false;
+    }
+
+    if (out != NULL) *out = deque->data[deque->head];
+    deque->head = (deque->head + 1) & deque->mask;
+    deque->size--;
+    return true;
+}
+
+// Internal helpers: copy count elements between a flat array and the ring
+// starting at physical index start. At most two memcpys, split at the wrap.
+static void __dequeCopyIn(Deque* deque, unsigned long start, const DEQUE_TYPE* values, unsigned long count) {
+    unsigned long firstCount = deque->mask + 1 - start;
+    if (firstCount > count) firstCount = count;
+    memcpy(deque->data + start, values, firstCount * sizeof(DEQUE_TYPE));
+    memcpy(deque->data, values + firstCount, (count - firstCount) * sizeof(DEQUE_TYPE));
+}
+
+static void __dequeCopyOut(Deque* deque, unsigned long start, DEQUE_TYPE* values, unsigned long count) {
+    unsigned long firstCount = deque->mask + 1 - start;
+    if (firstCount > count) firstCount = count;
+    memcpy(values, deque->data + start, firstCount * sizeof(DEQUE_TYPE));
+    memcpy(values + firstCount, deque->data, (count - firstCount) * sizeof(DEQUE_TYPE));
+}
+
+/******************************************************************************
+* dequePushBackSpan / dequePushFrontSpan
+*
+* parameters:
+*  - deque : Deque*
+*  - values : const DEQUE_TYPE* ; contiguous elements to add
+*  - count : unsigned long
+*
+* returns: bool ; success status
+*
+* description: adds count elements in one step, growing at most once.
+*              PushBackSpan leaves values[0] nearest the front (same as
+*              pushing each in order); PushFrontSpan puts the whole span in
+*              front of the current front, in the same order as values.
+*
+******************************************************************************/
+bool dequePushBackSpan(Deque* deque, const DEQUE_TYPE* values, unsigned long count) {
+    if (deque == NULL || (values == NULL && count > 0)) {
+        fprintf(stderr, "ERROR: attempted to add NULL span to Deque.\n");
+        return false;
+    }
+    if (!dequeReserve(deque, deque->size + count)) return false;
+
+    __dequeCopyIn(deque, (deque->head + deque->size) & deque->mask, values, count);
+    deque->size += count;
+    return true;
+}
+
+bool dequePushFrontSpan(Deque* deque, const DEQUE_TYPE* values, unsigned long count) {
+    if (deque == NULL || (values == NULL && count > 0)) {
+        fprintf(stderr, "ERROR: attempted to add NULL span to Deque.\n");
+        return false;
+    }
+    if (!dequeReserve(deque, deque->size + count)) return false;
+
+    deque->head = (deque->head - count) & deque->mask;
+    __dequeCopyIn(deque, deque->head, values, count);
+    deque->size += count;
+    return true;
+}
+
+/******************************************************************************
+* dequePopFrontSpan / dequePopBackSpan
+*
+* parameters:
+*  - deque : Deque*
+*  - out : DEQUE_TYPE* ; room for count elements; may be NULL to discard
+*  - count : unsigned long ; maximum number of elements to remove
+*
+* returns: unsigned long ; number of elements removed
+*
+* description: removes up to count elements in one step. out receives them
+*              in front-to-back order for both functions.
+*
+******************************************************************************/
+unsigned long dequePopFrontSpan(Deque* deque, DEQUE_TYPE* out, unsigned long count) {
+    if (deque == NULL) {
+        fprintf(stderr, "ERROR: attempted to remove span from NULL Deque*.\n");
+        return 0;
+    }
+    if (count > deque->size) count = deque->size;
+
+    if (out != NULL) __dequeCopyOut(deque, deque->head, out, count);
+    deque->head = (deque->head + count) & deque->mask;
+    deque->size -= count;
+    return count;
+}
+
+unsigned long dequePopBackSpan(Deque* deque, DEQUE_TYPE* out, unsigned long count) {
+    if (deque == NULL) {
+        fprintf(stderr, "ERROR: attempted to remove span from NULL Deque*.\n");
+        return 0;
+    }
+    if (count > deque->size) count = deque->size;
+
+    deque->size -= count;
+    if (out != NULL) __dequeCopyOut(deque, (deque->head + deque->size) & deque->mask, out, count);
+    return count;
+}
+
+/******************************************************************************
+* dequeClear
+*
+* parameters:
+*  - deque : Deque*
+*
+* returns: none
+*
+* description: removes all elements; the buffer is kept for reuse
+*
+******************************************************************************/
+void dequeClear(Deque* deque) {
+    if (deque == NULL) {
+        fprintf(stderr, "ERROR: attempted to clear NULL Deque*.\n");
+        return;
+    }
+    deque->head = 0;
+    deque->size = 0;
+}
+
+/******************************************************************************
+* dequeToString
+*
+* parameters:
+*  - deque : Deque*
+*
+* returns: none
+*
+* description: prints the elements from front to back
+*
+******************************************************************************/
+void dequeToString(Deque* deque) {
+    printf("[ ");
+    for (unsigned long i = 0; i < deque->size; ++i) {
+        printf("%d%s", deque->data[(deque->head + i) & deque->mask], (i < deque->size - 1) ? ", " : "");
+    }
+    printf(" ]\n");
+}
+
+#endif /* DEQUE_H */
@@ -0,0 +1,46 @@
+#include <stdio.h> 
+
+#include "Deque.h"
+#include "DequeTest.h"
+
+int main(int argc, char* argv[]) {
+    Deque* deque = dequeInit(4);
+    if (deque == NULL) return 1;
+
+    dequePushBack(deque, 10);
+    dequePushBack(deque, 20);
+    dequePushFront(deque, 5);
+    dequeToString(deque);
+
+    printf("Front: %d\n", *dequeFront(deque));
+    printf("Back: %d\n", *dequeBack(deque));
+    printf("At index 1: %d\n", *dequeAt(deque, 1));
+
+    // Bulk operations copy at most two contiguous runs
+    int batch[] = { 30, 40, 50, 60, 70, 80 };
+    dequePushBackSpan(deque, batch, sizeof batch / sizeof batch[0]);
+    printf("After pushing a span of 6 (capacity %lu): ", dequeCapacity(deque));
+    dequeToString(deque);
+
+    int work[4];
+    unsigned long taken = dequePopFrontSpan(deque, work, 4);
+    printf("Took %lu items from the front: %d %d %d %d\n", taken, work[0], work[1], work[2], work[3]);
+
+    int back;
+    dequePopBack(deque, &back);
+    printf("Popped %d from the back, size: %lu\n", back, dequeSize(deque));
+
+    // Steady state: the ring already has room, so this loop never allocates
+    for (int i = 0; i < 1000; ++i) {
+        dequePushBack(deque, i);
+        dequePopFront(deque, NULL);
+    }
+    printf("After 1000 push/pop pairs, capacity is still %lu\n", dequeCapacity(deque));
+
+    dequeClear(deque);
+    printf("After clear, size: %lu\n", dequeSize(deque));
+
+    dequeDestroy(deque);
+
+    runDequeTests();
+}
@@ -0,0 +1,195 @@
+#ifndef DEQUETEST_H
+#define DEQUETEST_H
+
+#include "Deque.h"
+#include "TestsSummary.h"
+
+/* Testing functions **********************************************************/
+void testDequePushPop();
+void testDequeWrapAround();
+void testDequeGrowth();
+void testDequeSpans();
+void testDequeAt();
+/* End testing functions ******************************************************/
+
+/* Test setup/teardown functions **********************************************/
+Deque* SetUp(unsigned long capacity) {
+    return dequeInit(capacity);
+}
+
+void TearDown(Deque* deque) {
+    dequeDestroy(deque);
+}
+/* End test setup/teardown functions ******************************************/
+
+// These tests assume DEQUE_TYPE is int
+void runDequeTests() {
+    TestsSummaryPrintHeader("Deque");
+
+    testDequePushPop();
+    testDequeWrapAround();
+    testDequeGrowth();
+    testDequeSpans();
+    testDequeAt();
+
+    TestsSummaryPrintFooter("Deque");
+}
+
+void testDequePushPop() {
+    Deque* deque = SetUp(8);
+    int successes = 0, failures = 0;
+
+    dequePushBack(deque, 2);
+    dequePushFront(deque, 1);
+    dequePushBack(deque, 3);
+
+    if (*dequeFront(deque) != 1 || *dequeBack(deque) != 3 || dequeSize(deque) != 3) {
+        printf("FAILED: testDequePushPop: expected front 1, back 3, size 3\n");
+        failures++;
+    }
+    else successes++;
+
+    int value = 0;
+    dequePopFront(deque, &value);
+    if (value != 1) {
+        printf("FAILED: testDequePushPop: expected to pop 1 from the front but got %d\n", value);
+        failures++;
+    }
+    else successes++;
+
+    dequePopBack(deque, &value);
+    if (value != 3) {
+        printf("FAILED: testDequePushPop: expected to pop 3 from the back but got %d\n", value);
+        failures++;
+    }
+    else successes++;
+
+    dequePopBack(deque, NULL);
+    if (!dequeEmpty(deque) || dequePopFront(deque, &value)) {
+        printf("FAILED: testDequePushPop: incorrectly allowed pop from empty deque\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("DequePushPop", successes, failures);
+    TearDown(deque);
+}
+
+void testDequeWrapAround() {
+    Deque* deque = SetUp(8);
+    int successes = 0, failures = 0;
+
+    // walk head all the way around the ring several times
+    bool inOrder = true;
+    for (int i = 0; i < 100; ++i) {
+        dequePushBack(deque, i);
+        dequePushBack(deque, i + 1000);
+        int a, b;
+        dequePopFront(deque, &a);
+        dequePopFront(deque, &b);
+        if (a != i || b != i + 1000) inOrder = false;
+    }
+
+    if (!inOrder || dequeCapacity(deque) != 8) {
+        printf("FAILED: testDequeWrapAround: expected FIFO order with no growth (capacity %lu)\n", dequeCapacity(deque));
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("DequeWrapAround", successes, failures);
+    TearDown(deque);
+}
+
+void testDequeGrowth() {
+    Deque* deque = SetUp(8);
+    int successes = 0, failures = 0;
+
+    // wrap first, so growth has to move the front segment
+    for (int i = 0; i < 6; ++i) dequePushBack(deque, -1);
+    for (int i = 0; i < 6; ++i) dequePopFront(deque, NULL);
+    for (int i = 0; i < 20; ++i) dequePushBack(deque, i);
+    for (int i = 1; i <= 5; ++i) dequePushFront(deque, -i);
+
+    if (dequeSize(deque) != 25 || dequeCapacity(deque) != 32) {
+        printf("FAILED: testDequeGrowth: expected size 25, capacity 32 but got %lu, %lu\n",
+               dequeSize(deque), dequeCapacity(deque));
+        failures++;
+    }
+    else successes++;
+
+    bool inOrder = true;
+    for (unsigned long i = 0; i < 25; ++i) {
+        int expected = (int)i - 5; // -5..-1 pushed in front of 0..19
+        if (*dequeAt(deque, i) != expected) inOrder = false;
+    }
+    if (!inOrder) {
+        printf("FAILED: testDequeGrowth: elements out of order after growth\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("DequeGrowth", successes, failures);
+    TearDown(deque);
+}
+
+void testDequeSpans() {
+    Deque* deque = SetUp(8);
+    int successes = 0, failures = 0;
+
+    int values[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    dequePushBack(deque, 100);
+    dequePopFront(deque, NULL); // head is now 1; the span will wrap after growth
+    dequePushBackSpan(deque, values, 10);
+    dequePushFrontSpan(deque, values, 3);
+
+    int out[16] = { 0 };
+    unsigned long taken = dequePopFrontSpan(deque, out, 5);
+    if (taken != 5 || out[0] != 0 || out[2] != 2 || out[3] != 0 || out[4] != 1) {
+        printf("FAILED: testDequeSpans: expected 0 1 2 0 1 from the front\n");
+        failures++;
+    }
+    else successes++;
+
+    taken = dequePopBackSpan(deque, out, 3);
+    if (taken != 3 || out[0] != 7 || out[2] != 9) {
+        printf("FAILED: testDequeSpans: expected 7 8 9 from the back\n");
+        failures++;
+    }
+    else successes++;
+
+    taken = dequePopFrontSpan(deque, out, 16);
+    if (taken != 5 || !dequeEmpty(deque) || out[0] != 2 || out[4] != 6) {
+        printf("FAILED: testDequeSpans: expected the remaining 5 elements 2..6 but got %lu\n", taken);
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("DequeSpans", successes, failures);
+    TearDown(deque);
+}
+
+void testDequeAt() {
+    Deque* deque = SetUp(8);
+    int successes = 0, failures = 0;
+
+    dequePushBack(deque, 1);
+    dequePushBack(deque, 2);
+    *dequeAt(deque, 1) = 20;
+
+    if (*dequeBack(deque) != 20) {
+        printf("FAILED: testDequeAt: expected write through dequeAt to change the back\n");
+        failures++;
+    }
+    else successes++;
+
+    if (dequeAt(deque, 2) != NULL) {
+        printf("FAILED: testDequeAt: incorrectly allowed index past the end\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("DequeAt", successes, failures);
+    TearDown(deque);
+}
+
+#endif /* DEQUETEST_H */
@@ -0,0 +1,170 @@
+#ifndef CONCURRENTQUEUEBENCH_H
+#define CONCURRENTQUEUEBENCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "SpscQueue.h"
+#include "MpmcQueue.h"
+#include "util.h"
+
+/******************************************************************************
+* ConcurrentQueueBench.h
+*
+* Throughput and latency under contention. Producers enqueue their current
+* CLOCK_MONOTONIC time; consumers subtract it from the time they dequeue it,
+* so each sample is the time an item spent in the queue (plus the time spent
+* waiting for a free slot). Every CQ_BENCH_SAMPLE_EVERY-th item is recorded
+* and the merged samples are sorted for percentiles.
+*
+******************************************************************************/
+
+#define CQ_BENCH_ITEMS 4000000UL
+#define CQ_BENCH_CAPACITY 1024
+#define CQ_BENCH_BATCH 32
+#define CQ_BENCH_SAMPLE_EVERY 16
+
+typedef enum { CQ_BENCH_SPSC, CQ_BENCH_MPMC } CqBenchKind;
+
+typedef struct {
+    CqBenchKind kind;
+    void* queue;
+    unsigned long batch;
+    unsigned long items;
+    unsigned long* samples;
+    unsigned long sampleCount;
+    atomic_ulong* remaining;
+} CqBenchWorker;
+
+// latency stamps travel through the queue as whole nanoseconds
+static unsigned long __cqBenchNowNs() {
+    return (unsigned long)(benchSeconds() * 1e9);
+}
+
+static unsigned long __cqBenchPush(CqBenchWorker* worker, const unsigned long* values, unsigned long count) {
+    if (worker->kind == CQ_BENCH_SPSC) return spscQueuePushBatch(worker->queue, values, count);
+    return mpmcQueuePushBatch(worker->queue, values, count);
+}
+
+static unsigned long __cqBenchPop(CqBenchWorker* worker, unsigned long* out, unsigned long maxCount) {
+    if (worker->kind == CQ_BENCH_SPSC) return spscQueuePopBatch(worker->queue, out, maxCount);
+    return mpmcQueuePopBatch(worker->queue, out, maxCount);
+}
+
+void* __cqBenchProducer(void* arg) {
+    CqBenchWorker* worker = arg;
+    unsigned long values[CQ_BENCH_BATCH];
+
+    for (unsigned long sent = 0; sent < worker->items;) {
+        unsigned long count = worker->items - sent;
+        if (count > worker->batch) count = worker->batch;
+
+        unsigned long now = __cqBenchNowNs();
+        for (unsigned long i = 0; i < count; ++i) values[i] = now;
+
+        unsigned long pushed = 0;
+        while (pushed < count) {
+            unsigned long n = __cqBenchPush(worker, values + pushed, count - pushed);
+            if (n == 0) sched_yield();
+            pushed += n;
+        }
+        sent += count;
+    }
+    return NULL;
+}
+
+void* __cqBenchConsumer(void* arg) {
+    CqBenchWorker* worker = arg;
+    unsigned long values[CQ_BENCH_BATCH];
+    unsigned long received = 0;
+
+    while (atomic_load_explicit(worker->remaining, memory_order_relaxed) > 0) {
+        unsigned long popped = __cqBenchPop(worker, values, worker->batch);
+        if (popped == 0) {
+            sched_yield();
+            continue;
+        }
+        atomic_fetch_sub_explicit(worker->remaining, popped, memory_order_relaxed);
+
+        unsigned long now = __cqBenchNowNs();
+        for (unsigned long i = 0; i < popped; ++i, ++received) {
+            if (received % CQ_BENCH_SAMPLE_EVERY == 0) {
+                worker->samples[worker->sampleCount++] = now - values[i];
+            }
+        }
+    }
+    return NULL;
+}
+
+static int __cqBenchCompare(const void* a, const void* b) {
+    unsigned long x = *(const unsigned long*)a, y = *(const unsigned long*)b;
+    return (x > y) - (x < y);
+}
+
+void cqBenchRun(const char* name, CqBenchKind kind, int producers, int consumers, unsigned long batch) {
+    void* queue = (kind == CQ_BENCH_SPSC) ? (void*)spscQueueInit(CQ_BENCH_CAPACITY)
+                                          : (void*)mpmcQueueInit(CQ_BENCH_CAPACITY);
+    atomic_ulong remaining;
+    atomic_init(&remaining, CQ_BENCH_ITEMS);
+
+    pthread_t threads[producers + consumers];
+    CqBenchWorker workers[producers + consumers];
+    unsigned long perProducer = CQ_BENCH_ITEMS / producers;
+
+    for (int i = 0; i < producers + consumers; ++i) {
+        bool isProducer = i < producers;
+        workers[i] = (CqBenchWorker){ kind, queue, batch, 0, NULL, 0, &remaining };
+        if (isProducer) {
+            workers[i].items = (i == producers - 1) ? CQ_BENCH_ITEMS - perProducer * i : perProducer;
+        }
+        else {
+            workers[i].samples = malloc((CQ_BENCH_ITEMS / CQ_BENCH_SAMPLE_EVERY + CQ_BENCH_BATCH) * sizeof(unsigned long));
+        }
+    }
+
+    double start = benchSeconds();
+    for (int i = 0; i < producers + consumers; ++i) {
+        pthread_create(&threads[i], NULL, (i < producers) ? __cqBenchProducer : __cqBenchConsumer, &workers[i]);
+    }
+    for (int i = 0; i < producers + consumers; ++i) pthread_join(threads[i], NULL);
+    double seconds = benchSeconds() - start;
+
+    // merge consumer samples
+    unsigned long sampleCount = 0;
+    for (int i = producers; i < producers + consumers; ++i) sampleCount += workers[i].sampleCount;
+    unsigned long* samples = malloc((sampleCount + 1) * sizeof(unsigned long));
+    unsigned long offset = 0;
+    for (int i = producers; i < producers + consumers; ++i) {
+        for (unsigned long j = 0; j < workers[i].sampleCount; ++j) samples[offset++] = workers[i].samples[j];
+        free(workers[i].samples);
+    }
+    qsort(samples, sampleCount, sizeof(unsigned long), __cqBenchCompare);
+
+    printf("%-22s %dP/%dC batch %-3lu %8.2f Mops/s   latency ns p50 %8lu  p99 %9lu  p99.9 %9lu  max %10lu\n",
+           name, producers, consumers, batch, CQ_BENCH_ITEMS / seconds / 1e6,
+           samples[sampleCount / 2], samples[sampleCount * 99 / 100],
+           samples[sampleCount * 999 / 1000], samples[sampleCount - 1]);
+
+    free(samples);
+    if (kind == CQ_BENCH_SPSC) spscQueueDestroy(queue);
+    else mpmcQueueDestroy(queue);
+}
+
+void runConcurrentQueueBenchmarks() {
+    printf("\nConcurrentQueue benchmarks: %lu items, capacity %d\n", CQ_BENCH_ITEMS, CQ_BENCH_CAPACITY);
+    printf("==========================================================\n");
+
+    cqBenchRun("SpscQueue", CQ_BENCH_SPSC, 1, 1, 1);
+    cqBenchRun("SpscQueue", CQ_BENCH_SPSC, 1, 1, CQ_BENCH_BATCH);
+    cqBenchRun("MpmcQueue", CQ_BENCH_MPMC, 1, 1, 1);
+    cqBenchRun("MpmcQueue", CQ_BENCH_MPMC, 1, 1, CQ_BENCH_BATCH);
+    cqBenchRun("MpmcQueue", CQ_BENCH_MPMC, 2, 2, 1);
+    cqBenchRun("MpmcQueue", CQ_BENCH_MPMC, 2, 2, CQ_BENCH_BATCH);
+    cqBenchRun("MpmcQueue", CQ_BENCH_MPMC, 4, 4, 1);
+    cqBenchRun("MpmcQueue", CQ_BENCH_MPMC, 4, 4, CQ_BENCH_BATCH);
+}
+
+#endif /* CONCURRENTQUEUEBENCH_H */
@@ -0,0 +1,58 @@
+#include <stdio.h> 
+#include <pthread.h>
+#include <sched.h>
+
+#include "SpscQueue.h"
+#include "MpmcQueue.h"
+#include "ConcurrentQueueTest.h"
+#ifdef RUN_BENCHMARKS
+#include "ConcurrentQueueBench.h"
+#endif
+
+#define DEMO_ROWS 10
+
+// A parser thread hands "row numbers" to a worker without any mutex
+void* parserThread(void* arg) {
+    SpscQueue* rows = arg;
+    for (unsigned long row = 1; row <= DEMO_ROWS; ++row) {
+        while (!spscQueueTryPush(rows, row)) sched_yield();
+    }
+    return NULL;
+}
+
+int main(int argc, char* argv[]) {
+    SpscQueue* rows = spscQueueInit(4);
+    if (rows == NULL) return 1;
+
+    pthread_t parser;
+    pthread_create(&parser, NULL, parserThread, rows);
+
+    unsigned long received = 0, batch[4];
+    while (received < DEMO_ROWS) {
+        unsigned long count = spscQueuePopBatch(rows, batch, 4);
+        if (count == 0) {
+            sched_yield();
+            continue;
+        }
+        printf("Worker got %lu row(s):", count);
+        for (unsigned long i = 0; i < count; ++i) printf(" %lu", batch[i]);
+        printf("\n");
+        received += count;
+    }
+    pthread_join(parser, NULL);
+    spscQueueDestroy(rows);
+
+    // MPMC works the same way, but any number of threads may push and pop
+    MpmcQueue* jobs = mpmcQueueInit(8);
+    unsigned long jobIds[5] = { 100, 101, 102, 103, 104 };
+    printf("Queued %lu jobs\n", mpmcQueuePushBatch(jobs, jobIds, 5));
+    unsigned long job;
+    while (mpmcQueueTryPop(jobs, &job)) printf("Ran job %lu\n", job);
+    mpmcQueueDestroy(jobs);
+
+    runConcurrentQueueTests();
+
+#ifdef RUN_BENCHMARKS
+    runConcurrentQueueBenchmarks();
+#endif
+}
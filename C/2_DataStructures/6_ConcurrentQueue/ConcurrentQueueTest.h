@@ -0,0 +1,248 @@
+#ifndef CONCURRENTQUEUETEST_H
+#define CONCURRENTQUEUETEST_H
+
+#include <pthread.h>
+#include <sched.h>
+
+#include "SpscQueue.h"
+#include "MpmcQueue.h"
+#include "TestsSummary.h"
+
+#define CONCURRENT_QUEUE_TEST_ITEMS 200000UL
+
+/* Testing functions **********************************************************/
+void testSpscQueueFifo();
+void testSpscQueueBatch();
+void testSpscQueueThreaded();
+void testMpmcQueueFifo();
+void testMpmcQueueBatch();
+void testMpmcQueueThreaded();
+/* End testing functions ******************************************************/
+
+void runConcurrentQueueTests() {
+    TestsSummaryPrintHeader("ConcurrentQueue");
+
+    testSpscQueueFifo();
+    testSpscQueueBatch();
+    testSpscQueueThreaded();
+    testMpmcQueueFifo();
+    testMpmcQueueBatch();
+    testMpmcQueueThreaded();
+
+    TestsSummaryPrintFooter("ConcurrentQueue");
+}
+
+void testSpscQueueFifo() {
+    SpscQueue* queue = spscQueueInit(4);
+    int successes = 0, failures = 0;
+
+    for (unsigned long i = 1; i <= 4; ++i) spscQueueTryPush(queue, i);
+    if (spscQueueTryPush(queue, 5)) {
+        printf("FAILED: testSpscQueueFifo: incorrectly allowed push into a full queue\n");
+        failures++;
+    }
+    else successes++;
+
+    bool inOrder = true;
+    unsigned long value;
+    for (unsigned long i = 1; i <= 4; ++i) {
+        if (!spscQueueTryPop(queue, &value) || value != i) inOrder = false;
+    }
+    if (!inOrder || spscQueueTryPop(queue, &value)) {
+        printf("FAILED: testSpscQueueFifo: expected 1..4 in order, then empty\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("SpscQueueFifo", successes, failures);
+    spscQueueDestroy(queue);
+}
+
+void testSpscQueueBatch() {
+    SpscQueue* queue = spscQueueInit(8);
+    int successes = 0, failures = 0;
+
+    unsigned long values[12] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+    unsigned long out[12] = { 0 };
+
+    unsigned long pushed = spscQueuePushBatch(queue, values, 12);
+    if (pushed != 8) {
+        printf("FAILED: testSpscQueueBatch: expected partial push of 8 but got %lu\n", pushed);
+        failures++;
+    }
+    else successes++;
+
+    // wrap: take 5, add 4 more, take everything
+    spscQueuePopBatch(queue, out, 5);
+    spscQueuePushBatch(queue, values + 8, 4);
+    unsigned long popped = spscQueuePopBatch(queue, out, 12);
+    if (popped != 7 || out[0] != 5 || out[3] != 8 || out[6] != 11) {
+        printf("FAILED: testSpscQueueBatch: expected 5..11 after wrapping but got %lu values\n", popped);
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("SpscQueueBatch", successes, failures);
+    spscQueueDestroy(queue);
+}
+
+void* __spscTestProducer(void* arg) {
+    SpscQueue* queue = arg;
+    for (unsigned long i = 1; i <= CONCURRENT_QUEUE_TEST_ITEMS; ++i) {
+        while (!spscQueueTryPush(queue, i)) sched_yield();
+    }
+    return NULL;
+}
+
+void testSpscQueueThreaded() {
+    SpscQueue* queue = spscQueueInit(64);
+    int successes = 0, failures = 0;
+
+    pthread_t producer;
+    pthread_create(&producer, NULL, __spscTestProducer, queue);
+
+    unsigned long expected = 1, received = 0, value;
+    bool inOrder = true;
+    while (received < CONCURRENT_QUEUE_TEST_ITEMS) {
+        if (!spscQueueTryPop(queue, &value)) {
+            sched_yield();
+            continue;
+        }
+        if (value != expected++) inOrder = false;
+        received++;
+    }
+    pthread_join(producer, NULL);
+
+    if (!inOrder) {
+        printf("FAILED: testSpscQueueThreaded: values arrived out of order\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("SpscQueueThreaded", successes, failures);
+    spscQueueDestroy(queue);
+}
+
+void testMpmcQueueFifo() {
+    MpmcQueue* queue = mpmcQueueInit(4);
+    int successes = 0, failures = 0;
+
+    for (unsigned long i = 1; i <= 4; ++i) mpmcQueueTryPush(queue, i);
+    if (mpmcQueueTryPush(queue, 5)) {
+        printf("FAILED: testMpmcQueueFifo: incorrectly allowed push into a full queue\n");
+        failures++;
+    }
+    else successes++;
+
+    bool inOrder = true;
+    unsigned long value;
+    for (unsigned long i = 1; i <= 4; ++i) {
+        if (!mpmcQueueTryPop(queue, &value) || value != i) inOrder = false;
+    }
+    if (!inOrder || mpmcQueueTryPop(queue, &value)) {
+        printf("FAILED: testMpmcQueueFifo: expected 1..4 in order, then empty\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("MpmcQueueFifo", successes, failures);
+    mpmcQueueDestroy(queue);
+}
+
+void testMpmcQueueBatch() {
+    MpmcQueue* queue = mpmcQueueInit(8);
+    int successes = 0, failures = 0;
+
+    unsigned long values[12] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+    unsigned long out[12] = { 0 };
+
+    unsigned long pushed = mpmcQueuePushBatch(queue, values, 12);
+    if (pushed != 8) {
+        printf("FAILED: testMpmcQueueBatch: expected partial push of 8 but got %lu\n", pushed);
+        failures++;
+    }
+    else successes++;
+
+    mpmcQueuePopBatch(queue, out, 5);
+    mpmcQueuePushBatch(queue, values + 8, 4);
+    unsigned long popped = mpmcQueuePopBatch(queue, out, 12);
+    if (popped != 7 || out[0] != 5 || out[3] != 8 || out[6] != 11) {
+        printf("FAILED: testMpmcQueueBatch: expected 5..11 after wrapping but got %lu values\n", popped);
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("MpmcQueueBatch", successes, failures);
+    mpmcQueueDestroy(queue);
+}
+
+typedef struct {
+    MpmcQueue* queue;
+    unsigned long first;
+    unsigned long count;
+    unsigned long sum;
+} __MpmcTestArgs;
+
+atomic_ulong __mpmcTestReceived;
+
+void* __mpmcTestProducer(void* arg) {
+    __MpmcTestArgs* args = arg;
+    for (unsigned long i = args->first; i < args->first + args->count; ++i) {
+        while (!mpmcQueueTryPush(args->queue, i)) sched_yield();
+    }
+    return NULL;
+}
+
+void* __mpmcTestConsumer(void* arg) {
+    __MpmcTestArgs* args = arg;
+    unsigned long batch[16];
+    while (atomic_load(&__mpmcTestReceived) < CONCURRENT_QUEUE_TEST_ITEMS) {
+        unsigned long popped = mpmcQueuePopBatch(args->queue, batch, 16);
+        if (popped == 0) {
+            sched_yield();
+            continue;
+        }
+        for (unsigned long i = 0; i < popped; ++i) args->sum += batch[i];
+        atomic_fetch_add(&__mpmcTestReceived, popped);
+    }
+    return NULL;
+}
+
+void testMpmcQueueThreaded() {
+    MpmcQueue* queue = mpmcQueueInit(64);
+    int successes = 0, failures = 0;
+    enum { PRODUCERS = 3, CONSUMERS = 3 };
+
+    pthread_t producers[PRODUCERS], consumers[CONSUMERS];
+    __MpmcTestArgs producerArgs[PRODUCERS], consumerArgs[CONSUMERS];
+    unsigned long perProducer = CONCURRENT_QUEUE_TEST_ITEMS / PRODUCERS;
+    atomic_store(&__mpmcTestReceived, 0);
+
+    for (int i = 0; i < CONSUMERS; ++i) {
+        consumerArgs[i] = (__MpmcTestArgs){ queue, 0, 0, 0 };
+        pthread_create(&consumers[i], NULL, __mpmcTestConsumer, &consumerArgs[i]);
+    }
+    for (int i = 0; i < PRODUCERS; ++i) {
+        // the last producer picks up the remainder
+        unsigned long count = (i == PRODUCERS - 1) ? CONCURRENT_QUEUE_TEST_ITEMS - perProducer * i : perProducer;
+        producerArgs[i] = (__MpmcTestArgs){ queue, 1 + perProducer * i, count, 0 };
+        pthread_create(&producers[i], NULL, __mpmcTestProducer, &producerArgs[i]);
+    }
+    for (int i = 0; i < PRODUCERS; ++i) pthread_join(producers[i], NULL);
+    for (int i = 0; i < CONSUMERS; ++i) pthread_join(consumers[i], NULL);
+
+    // every value 1..N delivered exactly once
+    unsigned long sum = 0;
+    for (int i = 0; i < CONSUMERS; ++i) sum += consumerArgs[i].sum;
+    unsigned long expected = CONCURRENT_QUEUE_TEST_ITEMS * (CONCURRENT_QUEUE_TEST_ITEMS + 1) / 2;
+    if (sum != expected) {
+        printf("FAILED: testMpmcQueueThreaded: expected sum %lu but got %lu\n", expected, sum);
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("MpmcQueueThreaded", successes, failures);
+    mpmcQueueDestroy(queue);
+}
+
+#endif /* CONCURRENTQUEUETEST_H */
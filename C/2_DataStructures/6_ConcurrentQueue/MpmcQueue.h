@@ -0,0 +1,236 @@
+#ifndef MPMCQUEUE_H
+#define MPMCQUEUE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/******************************************************************************
+* MpmcQueue
+*
+* implementation: Dmitry Vyukov's bounded multi-producer/multi-consumer
+*                 queue; compile-time "generic" with MPMCQUEUE_TYPE.
+*                 Lock-free: a thread only retries when another thread made
+*                 progress.
+*
+*                 Every cell carries a sequence number. For the cell at
+*                 position pos (pos & mask in the ring):
+*                   sequence == pos       -> empty, a producer may claim it
+*                   sequence == pos + 1   -> full, a consumer may claim it
+*                 Producers claim positions by CAS on enqueuePos, write the
+*                 data, then publish with sequence = pos + 1. Consumers claim
+*                 by CAS on dequeuePos, read, then hand the cell to the next
+*                 lap with sequence = pos + capacity.
+*
+* structures
+*  - MpmcCell: sequence number + data
+*  - MpmcQueue: producer counter, consumer counter and the ring description,
+*               each on its own cache line
+*
+******************************************************************************/
+
+#define MPMCQUEUE_TYPE unsigned long
+
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+typedef struct MpmcCell {
+    atomic_ulong sequence;
+    MPMCQUEUE_TYPE data;
+} MpmcCell;
+
+typedef struct MpmcQueue {
+    _Alignas(CACHE_LINE_SIZE) atomic_ulong enqueuePos;
+    _Alignas(CACHE_LINE_SIZE) atomic_ulong dequeuePos;
+    _Alignas(CACHE_LINE_SIZE) unsigned long mask;
+    MpmcCell* cells;
+} MpmcQueue;
+
+/******************************************************************************
+* mpmcQueueInit
+*
+* parameters:
+*  - capacity : unsigned long ; rounded up to a power of two
+*
+* returns: MpmcQueue*
+*
+* description: initializes an empty queue
+*
+******************************************************************************/
+MpmcQueue* mpmcQueueInit(unsigned long capacity) {
+    MpmcQueue* queue = aligned_alloc(CACHE_LINE_SIZE, sizeof(MpmcQueue));
+    if (queue == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for MpmcQueue.\n");
+        return NULL;
+    }
+
+    unsigned long roundedCapacity = 2;
+    while (roundedCapacity < capacity) roundedCapacity <<= 1;
+
+    queue->cells = malloc(roundedCapacity * sizeof(MpmcCell));
+    if (queue->cells == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for MpmcQueue's cells.\n");
+        free(queue);
+        return NULL;
+    }
+
+    for (unsigned long i = 0; i < roundedCapacity; ++i) {
+        atomic_init(&queue->cells[i].sequence, i);
+    }
+    atomic_init(&queue->enqueuePos, 0);
+    atomic_init(&queue->dequeuePos, 0);
+    queue->mask = roundedCapacity - 1;
+
+    return queue;
+}
+
+/******************************************************************************
+* mpmcQueueDestroy
+*
+* parameters:
+*  - queue : MpmcQueue*
+*
+* returns: none
+*
+* description: frees the queue; no thread may be using it
+*
+******************************************************************************/
+void mpmcQueueDestroy(MpmcQueue* queue) {
+    if (queue == NULL) {
+        fprintf(stderr, "ERROR: attempted to destroy NULL MpmcQueue*.\n");
+        return;
+    }
+
+    free(queue->cells);
+    free(queue);
+}
+
+/******************************************************************************
+* mpmcQueuePushBatch
+*
+* parameters:
+*  - queue : MpmcQueue*
+*  - values : const MPMCQUEUE_TYPE*
+*  - count : unsigned long
+*
+* returns: unsigned long ; number of values enqueued (may be < count if full)
+*
+* description: counts how many consecutive cells from enqueuePos are empty,
+*              then claims all of them with one CAS. An empty cell at or past
+*              enqueuePos can only be changed by whoever claims its position,
+*              so the cells are still empty once the CAS succeeds.
+*
+******************************************************************************/
+unsigned long mpmcQueuePushBatch(MpmcQueue* queue, const MPMCQUEUE_TYPE* values, unsigned long count) {
+    if (count == 0) return 0;
+
+    unsigned long pos = atomic_load_explicit(&queue->enqueuePos, memory_order_relaxed);
+    unsigned long claimed;
+
+    while (true) {
+        claimed = 0;
+        while (claimed < count && claimed <= queue->mask) {
+            MpmcCell* cell = &queue->cells[(pos + claimed) & queue->mask];
+            unsigned long sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+            if (sequence != pos + claimed) break;
+            claimed++;
+        }
+
+        if (claimed == 0) {
+            // either full, or another producer moved enqueuePos under us
+            MpmcCell* cell = &queue->cells[pos & queue->mask];
+            long diff = (long)atomic_load_explicit(&cell->sequence, memory_order_acquire) - (long)pos;
+            if (diff < 0) return 0;
+            pos = atomic_load_explicit(&queue->enqueuePos, memory_order_relaxed);
+            continue;
+        }
+
+        if (atomic_compare_exchange_weak_explicit(&queue->enqueuePos, &pos, pos + claimed,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+            break;
+        }
+        // CAS failure reloaded pos; count again
+    }
+
+    for (unsigned long i = 0; i < claimed; ++i) {
+        MpmcCell* cell = &queue->cells[(pos + i) & queue->mask];
+        cell->data = values[i];
+        atomic_store_explicit(&cell->sequence, pos + i + 1, memory_order_release);
+    }
+    return claimed;
+}
+
+/******************************************************************************
+* mpmcQueuePopBatch
+*
+* parameters:
+*  - queue : MpmcQueue*
+*  - out : MPMCQUEUE_TYPE* ; room for maxCount values
+*  - maxCount : unsigned long
+*
+* returns: unsigned long ; number of values dequeued
+*
+* description: mirror of mpmcQueuePushBatch; counts consecutive full cells
+*              from dequeuePos and claims them with one CAS
+*
+******************************************************************************/
+unsigned long mpmcQueuePopBatch(MpmcQueue* queue, MPMCQUEUE_TYPE* out, unsigned long maxCount) {
+    if (maxCount == 0) return 0;
+
+    unsigned long pos = atomic_load_explicit(&queue->dequeuePos, memory_order_relaxed);
+    unsigned long claimed;
+
+    while (true) {
+        claimed = 0;
+        while (claimed < maxCount && claimed <= queue->mask) {
+            MpmcCell* cell = &queue->cells[(pos + claimed) & queue->mask];
+            unsigned long sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+            if (sequence != pos + claimed + 1) break;
+            claimed++;
+        }
+
+        if (claimed == 0) {
+            MpmcCell* cell = &queue->cells[pos & queue->mask];
+            long diff = (long)atomic_load_explicit(&cell->sequence, memory_order_acquire) - (long)(pos + 1);
+            if (diff < 0) return 0;
+            pos = atomic_load_explicit(&queue->dequeuePos, memory_order_relaxed);
+            continue;
+        }
+
+        if (atomic_compare_exchange_weak_explicit(&queue->dequeuePos, &pos, pos + claimed,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    for (unsigned long i = 0; i < claimed; ++i) {
+        MpmcCell* cell = &queue->cells[(pos + i) & queue->mask];
+        out[i] = cell->data;
+        atomic_store_explicit(&cell->sequence, pos + i + queue->mask + 1, memory_order_release);
+    }
+    return claimed;
+}
+
+/******************************************************************************
+* mpmcQueueTryPush / mpmcQueueTryPop
+*
+* parameters:
+*  - queue : MpmcQueue*
+*  - value : MPMCQUEUE_TYPE / out : MPMCQUEUE_TYPE*
+*
+* returns: bool ; false if the queue was full / empty
+*
+* description: single-element versions of the batch operations
+*
+******************************************************************************/
+bool mpmcQueueTryPush(MpmcQueue* queue, MPMCQUEUE_TYPE value) {
+    return mpmcQueuePushBatch(queue, &value, 1) == 1;
+}
+
+bool mpmcQueueTryPop(MpmcQueue* queue, MPMCQUEUE_TYPE* out) {
+    return mpmcQueuePopBatch(queue, out, 1) == 1;
+}
+
+#endif /* MPMCQUEUE_H */
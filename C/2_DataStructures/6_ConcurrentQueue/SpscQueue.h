@@ -0,0 +1,215 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/******************************************************************************
+* SpscQueue
+*
+* implementation: bounded single-producer/single-consumer ring buffer with a
+*                 power-of-two capacity; compile-time "generic" with
+*                 SPSCQUEUE_TYPE. Wait-free: every push/pop finishes in a
+*                 bounded number of steps, no CAS loops, no locks.
+*
+*                 head and tail are free-running counters (wrapping is fine
+*                 for unsigned arithmetic) masked into the ring on access. Each
+*                 side keeps a private cached copy of the other side's
+*                 counter and only re-reads the shared one when the cache says
+*                 the queue looks full/empty, so in the common case a push or
+*                 pop touches no cache line the other thread writes to.
+*
+* structures
+*  - SpscQueue: consumer line (head + cached tail), producer line (tail +
+*               cached head), then the read-only ring description. Each group
+*               sits on its own cache line so the two threads never
+*               false-share.
+*
+******************************************************************************/
+
+#define SPSCQUEUE_TYPE unsigned long
+
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+typedef struct SpscQueue {
+    // written by the consumer
+    _Alignas(CACHE_LINE_SIZE) atomic_ulong head;
+    unsigned long cachedTail;
+
+    // written by the producer
+    _Alignas(CACHE_LINE_SIZE) atomic_ulong tail;
+    unsigned long cachedHead;
+
+    // written once at init
+    _Alignas(CACHE_LINE_SIZE) unsigned long mask;
+    SPSCQUEUE_TYPE* data;
+} SpscQueue;
+
+/******************************************************************************
+* spscQueueInit
+*
+* parameters:
+*  - capacity : unsigned long ; rounded up to a power of two
+*
+* returns: SpscQueue*
+*
+* description: initializes an empty queue
+*
+******************************************************************************/
+SpscQueue* spscQueueInit(unsigned long capacity) {
+    SpscQueue* queue = aligned_alloc(CACHE_LINE_SIZE, sizeof(SpscQueue));
+    if (queue == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for SpscQueue.\n");
+        return NULL;
+    }
+
+    unsigned long roundedCapacity = 2;
+    while (roundedCapacity < capacity) roundedCapacity <<= 1;
+
+    queue->data = malloc(roundedCapacity * sizeof(SPSCQUEUE_TYPE));
+    if (queue->data == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for SpscQueue's data.\n");
+        free(queue);
+        return NULL;
+    }
+
+    atomic_init(&queue->head, 0);
+    atomic_init(&queue->tail, 0);
+    queue->cachedHead = 0;
+    queue->cachedTail = 0;
+    queue->mask = roundedCapacity - 1;
+
+    return queue;
+}
+
+/******************************************************************************
+* spscQueueDestroy
+*
+* parameters:
+*  - queue : SpscQueue*
+*
+* returns: none
+*
+* description: frees the queue; neither thread may be using it
+*
+******************************************************************************/
+void spscQueueDestroy(SpscQueue* queue) {
+    if (queue == NULL) {
+        fprintf(stderr, "ERROR: attempted to destroy NULL SpscQueue*.\n");
+        return;
+    }
+
+    free(queue->data);
+    free(queue);
+}
+
+/******************************************************************************
+* spscQueuePushBatch
+*
+* parameters:
+*  - queue : SpscQueue* ; producer thread only
+*  - values : const SPSCQUEUE_TYPE*
+*  - count : unsigned long
+*
+* returns: unsigned long ; number of values enqueued (may be < count if full)
+*
+* description: copies as many values as fit, then publishes them all with a
+*              single release store of tail
+*
+******************************************************************************/
+unsigned long spscQueuePushBatch(SpscQueue* queue, const SPSCQUEUE_TYPE* values, unsigned long count) {
+    unsigned long tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    unsigned long capacity = queue->mask + 1;
+
+    unsigned long freeSlots = capacity - (tail - queue->cachedHead);
+    if (freeSlots < count) {
+        queue->cachedHead = atomic_load_explicit(&queue->head, memory_order_acquire);
+        freeSlots = capacity - (tail - queue->cachedHead);
+        if (count > freeSlots) count = freeSlots;
+        if (count == 0) return 0;
+    }
+
+    for (unsigned long i = 0; i < count; ++i) {
+        queue->data[(tail + i) & queue->mask] = values[i];
+    }
+
+    atomic_store_explicit(&queue->tail, tail + count, memory_order_release);
+    return count;
+}
+
+/******************************************************************************
+* spscQueuePopBatch
+*
+* parameters:
+*  - queue : SpscQueue* ; consumer thread only
+*  - out : SPSCQUEUE_TYPE* ; room for maxCount values
+*  - maxCount : unsigned long
+*
+* returns: unsigned long ; number of values dequeued
+*
+* description: copies out up to maxCount values, then releases their slots to
+*              the producer with a single release store of head
+*
+******************************************************************************/
+unsigned long spscQueuePopBatch(SpscQueue* queue, SPSCQUEUE_TYPE* out, unsigned long maxCount) {
+    unsigned long head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+
+    unsigned long available = queue->cachedTail - head;
+    if (available < maxCount) {
+        queue->cachedTail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+        available = queue->cachedTail - head;
+    }
+    unsigned long count = (available < maxCount) ? available : maxCount;
+    if (count == 0) return 0;
+
+    for (unsigned long i = 0; i < count; ++i) {
+        out[i] = queue->data[(head + i) & queue->mask];
+    }
+
+    atomic_store_explicit(&queue->head, head + count, memory_order_release);
+    return count;
+}
+
+/******************************************************************************
+* spscQueueTryPush / spscQueueTryPop
+*
+* parameters:
+*  - queue : SpscQueue*
+*  - value : SPSCQUEUE_TYPE / out : SPSCQUEUE_TYPE*
+*
+* returns: bool ; false if the queue was full / empty
+*
+* description: single-element versions of the batch operations
+*
+******************************************************************************/
+bool spscQueueTryPush(SpscQueue* queue, SPSCQUEUE_TYPE value) {
+    return spscQueuePushBatch(queue, &value, 1) == 1;
+}
+
+bool spscQueueTryPop(SpscQueue* queue, SPSCQUEUE_TYPE* out) {
+    return spscQueuePopBatch(queue, out, 1) == 1;
+}
+
+/******************************************************************************
+* spscQueueSize
+*
+* parameters:
+*  - queue : SpscQueue*
+*
+* returns: unsigned long
+*
+* description: number of queued elements; only a snapshot while the other
+*              thread is running
+*
+******************************************************************************/
+unsigned long spscQueueSize(SpscQueue* queue) {
+    unsigned long head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    unsigned long tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    return tail - head;
+}
+
+#endif /* SPSCQUEUE_H */
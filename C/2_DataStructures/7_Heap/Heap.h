@@ -0,0 +1,394 @@
+#ifndef HEAP_H
+#define HEAP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "Array.h"
+
+/******************************************************************************
+* Heap
+*
+* implementation: array-backed d-ary min-heap; compile-time "generic" with
+*                 HEAP_TYPE, ordered by HEAP_LESS. Children of i are
+*                 d*i + 1 .. d*i + d. A wider node makes the tree shallower
+*                 (fewer levels to sift through), and its children are
+*                 contiguous: with d = 4 and 4-byte elements they are 16
+*                 bytes, read from one cache line for most nodes. The array
+*                 is not offset to align the groups, so with 64-byte lines
+*                 a quarter of them straddle two (nodes i with i % 4 == 3
+*                 when the array starts on a line).
+*
+*                 Every pushed element gets a handle: a stable index into
+*                 handleToPosition, which the heap keeps pointing at the
+*                 element's current slot as it moves. decrease-key looks up
+*                 the slot through the handle in O(1).
+*
+* structures
+*  - Heap: elements, their handles (parallel arrays), the handle -> slot
+*          map, and a free list of retired handles for reuse
+*
+******************************************************************************/
+
+#define HEAP_TYPE int
+#define HEAP_LESS(a, b) ((a) < (b))
+#define HEAP_DEFAULT_ARITY 4
+#define HEAP_NO_POSITION ((unsigned long)-1)
+
+typedef struct Heap {
+    HEAP_TYPE* data;
+    unsigned long* handles;          // handles[slot] -> handle of the element in slot
+    unsigned long* handleToPosition; // handleToPosition[handle] -> slot, or HEAP_NO_POSITION
+    unsigned long* freeHandles;      // stack of handles whose element was popped
+    unsigned long freeHandleCount;
+    unsigned long handleCount;       // handles ever issued
+    unsigned long size;
+    unsigned long capacity;
+    unsigned long arity;
+} Heap;
+
+/******************************************************************************
+* heapInit
+*
+* parameters:
+*  - capacity : unsigned long ; initial capacity; grows as needed
+*  - arity : unsigned long ; children per node (d); 0 for HEAP_DEFAULT_ARITY
+*
+* returns: Heap*
+*
+* description: initializes an empty heap
+*
+******************************************************************************/
+Heap* heapInit(unsigned long capacity, unsigned long arity) {
+    Heap* heap = malloc(sizeof(Heap));
+    if (heap == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for struct Heap.\n");
+        return NULL;
+    }
+
+    if (capacity == 0) capacity = 16;
+    if (arity == 0) arity = HEAP_DEFAULT_ARITY;
+    if (arity < 2) {
+        fprintf(stderr, "ERROR: heap arity must be at least 2.\n");
+        free(heap);
+        return NULL;
+    }
+
+    heap->data = malloc(capacity * sizeof(HEAP_TYPE));
+    heap->handles = malloc(capacity * sizeof(unsigned long));
+    heap->handleToPosition = malloc(capacity * sizeof(unsigned long));
+    heap->freeHandles = malloc(capacity * sizeof(unsigned long));
+    if (heap->data == NULL || heap->handles == NULL || heap->handleToPosition == NULL || heap->freeHandles == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for Heap's data.\n");
+        free(heap->data);
+        free(heap->handles);
+        free(heap->handleToPosition);
+        free(heap->freeHandles);
+        free(heap);
+        return NULL;
+    }
+
+    heap->freeHandleCount = 0;
+    heap->handleCount = 0;
+    heap->size = 0;
+    heap->capacity = capacity;
+    heap->arity = arity;
+
+    return heap;
+}
+
+/******************************************************************************
+* heapDestroy
+*
+* parameters:
+*  - heap : Heap*
+*
+* returns: none
+*
+* description: frees the memory used by the Heap
+*
+******************************************************************************/
+void heapDestroy(Heap* heap) {
+    if (heap == NULL) {
+        fprintf(stderr, "ERROR: attempted to destroy NULL Heap*.\n");
+        return;
+    }
+
+    free(heap->data);
+    free(heap->handles);
+    free(heap->handleToPosition);
+    free(heap->freeHandles);
+    free(heap);
+}
+
+/******************************************************************************
+* heapSize / heapEmpty
+*
+* parameters:
+*  - heap : Heap*
+*
+* returns: unsigned long / bool
+*
+* description: number of elements in the heap / whether it is empty
+*
+******************************************************************************/
+unsigned long heapSize(Heap* heap) {
+    if (heap == NULL) {
+        fprintf(stderr, "ERROR: attempted to access size of NULL Heap*.\n");
+        return 0;
+    }
+    return heap->size;
+}
+
+bool heapEmpty(Heap* heap) {
+    if (heap == NULL) {
+        fprintf(stderr, "ERROR: attempted to access size of NULL Heap*.\n");
+        return false;
+    }
+    return heap->size == 0;
+}
+
+// Internal helper: grow every parallel array. Handles never outnumber the
+// capacity: live handles == size and retired ones sit on the free list.
+static bool __heapGrow(Heap* heap, unsigned long capacity) {
+    HEAP_TYPE* data = realloc(heap->data, capacity * sizeof(HEAP_TYPE));
+    if (data != NULL) heap->data = data;
+    unsigned long* handles = realloc(heap->handles, capacity * sizeof(unsigned long));
+    if (handles != NULL) heap->handles = handles;
+    unsigned long* handleToPosition = realloc(heap->handleToPosition, capacity * sizeof(unsigned long));
+    if (handleToPosition != NULL) heap->handleToPosition = handleToPosition;
+    unsigned long* freeHandles = realloc(heap->freeHandles, capacity * sizeof(unsigned long));
+    if (freeHandles != NULL) heap->freeHandles = freeHandles;
+
+    if (data == NULL || handles == NULL || handleToPosition == NULL || freeHandles == NULL) {
+        fprintf(stderr, "ERROR: failed to grow Heap's data.\n");
+        return false;
+    }
+
+    heap->capacity = capacity;
+    return true;
+}
+
+// Internal helper: put element/handle into slot and record where it went
+static void __heapPlace(Heap* heap, unsigned long slot, HEAP_TYPE value, unsigned long handle) {
+    heap->data[slot] = value;
+    heap->handles[slot] = handle;
+    heap->handleToPosition[handle] = slot;
+}
+
+// Internal helper: move the element at slot toward the root. The element is
+// held aside and parents are shifted down into the hole, which halves the
+// writes compared to swapping at every level.
+static void __heapSiftUp(Heap* heap, unsigned long slot) {
+    HEAP_TYPE value = heap->data[slot];
+    unsigned long handle = heap->handles[slot];
+
+    while (slot > 0) {
+        unsigned long parent = (slot - 1) / heap->arity;
+        if (!HEAP_LESS(value, heap->data[parent])) break;
+        __heapPlace(heap, slot, heap->data[parent], heap->handles[parent]);
+        slot = parent;
+    }
+    __heapPlace(heap, slot, value, handle);
+}
+
+// Internal helper: move the element at slot toward the leaves, picking the
+// smallest of its (up to) arity children at each level.
+static void __heapSiftDown(Heap* heap, unsigned long slot) {
+    HEAP_TYPE value = heap->data[slot];
+    unsigned long handle = heap->handles[slot];
+
+    while (true) {
+        unsigned long first = slot * heap->arity + 1;
+        if (first >= heap->size) break;
+
+        unsigned long last = first + heap->arity;
+        if (last > heap->size) last = heap->size;
+
+        unsigned long best = first;
+        for (unsigned long child = first + 1; child < last; ++child) {
+            if (HEAP_LESS(heap->data[child], heap->data[best])) best = child;
+        }
+        if (!HEAP_LESS(heap->data[best], value)) break;
+
+        __heapPlace(heap, slot, heap->data[best], heap->handles[best]);
+        slot = best;
+    }
+    __heapPlace(heap, slot, value, handle);
+}
+
+/******************************************************************************
+* heapPush
+*
+* parameters:
+*  - heap : Heap*
+*  - value : HEAP_TYPE
+*
+* returns: unsigned long ; handle for value (for heapDecreaseKey), or
+*                          HEAP_NO_POSITION on failure
+*
+* description: adds value to the heap in O(log_d n)
+*
+******************************************************************************/
+unsigned long heapPush(Heap* heap, HEAP_TYPE value) {
+    if (heap == NULL) {
+        fprintf(stderr, "ERROR: attempted to push element into NULL Heap*.\n");
+        return HEAP_NO_POSITION;
+    }
+    if (heap->size == heap->capacity && !__heapGrow(heap, heap->capacity * 2)) {
+        return HEAP_NO_POSITION;
+    }
+
+    unsigned long handle = (heap->freeHandleCount > 0) ? heap->freeHandles[--heap->freeHandleCount]
+                                                       : heap->handleCount++;
+    __heapPlace(heap, heap->size, value, handle);
+    heap->size++;
+    __heapSiftUp(heap, heap->size - 1);
+
+    return handle;
+}
+
+/******************************************************************************
+* heapPeek
+*
+* parameters:
+*  - heap : Heap*
+*
+* returns: HEAP_TYPE* ; the minimum element, or NULL if empty
+*
+* description: returns the root without removing it
+*
+******************************************************************************/
+HEAP_TYPE* heapPeek(Heap* heap) {
+    if (heap == NULL || heap->size == 0) {
+        fprintf(stderr, "ERROR: heap is empty.\n");
+        return NULL;
+    }
+    return &heap->data[0];
+}
+
+/******************************************************************************
+* heapPop
+*
+* parameters:
+*  - heap : Heap*
+*  - out : HEAP_TYPE* ; receives the minimum element; may be NULL
+*
+* returns: bool ; success status
+*
+* description: removes the root in O(d log_d n); its handle becomes invalid
+*              and may be reissued by a later push
+*
+******************************************************************************/
+bool heapPop(Heap* heap, HEAP_TYPE* out) {
+    if (heap == NULL || heap->size == 0) {
+        fprintf(stderr, "ERROR: heap is empty.\n");
+        return false;
+    }
+
+    if (out != NULL) *out = heap->data[0];
+
+    unsigned long rootHandle = heap->handles[0];
+    heap->handleToPosition[rootHandle] = HEAP_NO_POSITION;
+    heap->freeHandles[heap->freeHandleCount++] = rootHandle;
+
+    heap->size--;
+    if (heap->size > 0) {
+        __heapPlace(heap, 0, heap->data[heap->size], heap->handles[heap->size]);
+        __heapSiftDown(heap, 0);
+    }
+    return true;
+}
+
+/******************************************************************************
+* heapDecreaseKey
+*
+* parameters:
+*  - heap : Heap*
+*  - handle : unsigned long ; returned by heapPush / heapFromArray
+*  - value : HEAP_TYPE ; must not be greater than the current value
+*
+* returns: bool ; success status
+*
+* description: lowers the element's key and restores heap order in
+*              O(log_d n), e.g. relaxing an edge in Dijkstra's algorithm
+*
+******************************************************************************/
+bool heapDecreaseKey(Heap* heap, unsigned long handle, HEAP_TYPE value) {
+    if (heap == NULL || handle >= heap->handleCount || heap->handleToPosition[handle] == HEAP_NO_POSITION) {
+        fprintf(stderr, "ERROR: invalid heap handle.\n");
+        return false;
+    }
+
+    unsigned long slot = heap->handleToPosition[handle];
+    if (HEAP_LESS(heap->data[slot], value)) {
+        fprintf(stderr, "ERROR: heapDecreaseKey would increase the key.\n");
+        return false;
+    }
+
+    heap->data[slot] = value;
+    __heapSiftUp(heap, slot);
+    return true;
+}
+
+/******************************************************************************
+* heapFromArray
+*
+* parameters:
+*  - array : Array* ; see 1_Array; ARRAY_TYPE must match HEAP_TYPE
+*  - arity : unsigned long ; 0 for HEAP_DEFAULT_ARITY
+*
+* returns: Heap* ; element i of array gets handle i
+*
+* description: builds a heap from an existing Array in O(n) (Floyd's
+*              method): copy everything, then sift down every internal node
+*              from the last one back to the root. Most nodes are near the
+*              leaves and barely move, unlike n pushes at O(log n) each.
+*
+******************************************************************************/
+Heap* heapFromArray(Array* array, unsigned long arity) {
+    if (array == NULL) {
+        fprintf(stderr, "ERROR: attempted to build Heap from NULL Array*.\n");
+        return NULL;
+    }
+
+    Heap* heap = heapInit(array->size, arity);
+    if (heap == NULL) return NULL;
+
+    for (unsigned long i = 0; i < array->size; ++i) {
+        __heapPlace(heap, i, array->data[i], i);
+    }
+    heap->size = array->size;
+    heap->handleCount = array->size;
+
+    if (heap->size > 1) {
+        for (unsigned long slot = (heap->size - 2) / heap->arity + 1; slot-- > 0;) {
+            __heapSiftDown(heap, slot);
+        }
+    }
+    return heap;
+}
+
+/******************************************************************************
+* heapClear
+*
+* parameters:
+*  - heap : Heap*
+*
+* returns: none
+*
+* description: removes every element and invalidates every handle
+*
+******************************************************************************/
+void heapClear(Heap* heap) {
+    if (heap == NULL) {
+        fprintf(stderr, "ERROR: attempted to clear NULL Heap*.\n");
+        return;
+    }
+    heap->size = 0;
+    heap->handleCount = 0;
+    heap->freeHandleCount = 0;
+}
+
+#endif /* HEAP_H */
@@ -0,0 +1,74 @@
+#ifndef HEAPBENCH_H
+#define HEAPBENCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Heap.h"
+#include "util.h"
+
+/******************************************************************************
+* HeapBench.h
+*
+* Compares arities on HEAP_BENCH_OPS random keys: heapify (heapFromArray),
+* then HEAP_BENCH_OPS pushes, then HEAP_BENCH_OPS pops.
+*
+******************************************************************************/
+
+#define HEAP_BENCH_OPS 10000000UL
+
+// xorshift; rand() is too slow to not dominate the push loop
+static unsigned int __heapBenchRandom(unsigned int* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+void heapBenchRun(unsigned long arity, Array* keys) {
+    double start = benchSeconds();
+    Heap* heap = heapFromArray(keys, arity);
+    double heapifySeconds = benchSeconds() - start;
+    heapClear(heap);
+
+    unsigned int state = 2463534242u;
+    start = benchSeconds();
+    for (unsigned long i = 0; i < HEAP_BENCH_OPS; ++i) {
+        heapPush(heap, (int)(__heapBenchRandom(&state) >> 1));
+    }
+    double pushSeconds = benchSeconds() - start;
+
+    long checksum = 0;
+    int value;
+    start = benchSeconds();
+    for (unsigned long i = 0; i < HEAP_BENCH_OPS; ++i) {
+        heapPop(heap, &value);
+        checksum += value & 1;
+    }
+    double popSeconds = benchSeconds() - start;
+
+    printf("d=%lu  heapify %7.3f s   push %7.3f s (%6.1f ns/op)   pop %7.3f s (%6.1f ns/op)   [%ld]\n",
+           arity, heapifySeconds, pushSeconds, pushSeconds * 1e9 / HEAP_BENCH_OPS,
+           popSeconds, popSeconds * 1e9 / HEAP_BENCH_OPS, checksum);
+
+    heapDestroy(heap);
+}
+
+void runHeapBenchmarks() {
+    printf("\nHeap benchmarks: %lu operations each\n", HEAP_BENCH_OPS);
+    printf("===================================\n");
+
+    Array* keys = arrayInit(HEAP_BENCH_OPS);
+    unsigned int state = 88172645u;
+    for (unsigned long i = 0; i < HEAP_BENCH_OPS; ++i) {
+        arrayPushBack(keys, (int)(__heapBenchRandom(&state) >> 1));
+    }
+
+    heapBenchRun(2, keys);
+    heapBenchRun(4, keys);
+    heapBenchRun(8, keys);
+
+    arrayDestroy(keys);
+}
+
+#endif /* HEAPBENCH_H */
@@ -0,0 +1,53 @@
+#include <stdio.h> 
+
+#include "Array.h"
+#include "Heap.h"
+#include "HeapTest.h"
+#ifdef RUN_BENCHMARKS
+#include "HeapBench.h"
+#endif
+
+int main(int argc, char* argv[]) {
+    Heap* heap = heapInit(8, 0); // default arity (4)
+    if (heap == NULL) return 1;
+
+    heapPush(heap, 42);
+    unsigned long handle = heapPush(heap, 17);
+    heapPush(heap, 8);
+    heapPush(heap, 23);
+
+    printf("Min: %d\n", *heapPeek(heap));
+
+    heapDecreaseKey(heap, handle, 3);
+    printf("After decreasing 17 to 3, min: %d\n", *heapPeek(heap));
+
+    printf("Popping in order:");
+    int value;
+    while (!heapEmpty(heap)) {
+        heapPop(heap, &value);
+        printf(" %d", value);
+    }
+    printf("\n");
+    heapDestroy(heap);
+
+    // Top-3 of an existing Array: heapify in O(n), then pop 3
+    Array* scores = arrayInit(8);
+    int raw[] = { 55, 12, 99, 31, 7, 64, 18, 40 };
+    for (int i = 0; i < 8; ++i) arrayPushBack(scores, raw[i]);
+
+    Heap* fromArray = heapFromArray(scores, 2);
+    printf("3 smallest scores:");
+    for (int i = 0; i < 3; ++i) {
+        heapPop(fromArray, &value);
+        printf(" %d", value);
+    }
+    printf("\n");
+    heapDestroy(fromArray);
+    arrayDestroy(scores);
+
+    runHeapTests();
+
+#ifdef RUN_BENCHMARKS
+    runHeapBenchmarks();
+#endif
+}
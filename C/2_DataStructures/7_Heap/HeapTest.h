@@ -0,0 +1,192 @@
+#ifndef HEAPTEST_H
+#define HEAPTEST_H
+
+#include "Heap.h"
+#include "TestsSummary.h"
+
+/* Testing functions **********************************************************/
+void testHeapPushPop();
+void testHeapPeek();
+void testHeapDecreaseKey();
+void testHeapFromArray();
+void testHeapHandleReuse();
+/* End testing functions ******************************************************/
+
+/* Test setup/teardown functions **********************************************/
+Heap* SetUp(unsigned long arity) {
+    return heapInit(4, arity);
+}
+
+void TearDown(Heap* heap) {
+    heapDestroy(heap);
+}
+/* End test setup/teardown functions ******************************************/
+
+// These tests assume HEAP_TYPE is int and HEAP_LESS is <
+void runHeapTests() {
+    TestsSummaryPrintHeader("Heap");
+
+    testHeapPushPop();
+    testHeapPeek();
+    testHeapDecreaseKey();
+    testHeapFromArray();
+    testHeapHandleReuse();
+
+    TestsSummaryPrintFooter("Heap");
+}
+
+void testHeapPushPop() {
+    int successes = 0, failures = 0;
+    unsigned long arities[] = { 2, 3, 4, 8 };
+
+    for (int a = 0; a < 4; ++a) {
+        Heap* heap = SetUp(arities[a]);
+
+        // pseudo-random keys with duplicates; forces several growths
+        for (int i = 0; i < 1000; ++i) heapPush(heap, (i * 7919) % 503);
+
+        bool sorted = true;
+        int previous = -1, value;
+        while (!heapEmpty(heap)) {
+            heapPop(heap, &value);
+            if (value < previous) sorted = false;
+            previous = value;
+        }
+
+        if (!sorted) {
+            printf("FAILED: testHeapPushPop: d=%lu popped out of order\n", arities[a]);
+            failures++;
+        }
+        else successes++;
+
+        TearDown(heap);
+    }
+
+    Heap* heap = SetUp(0);
+    if (heapPop(heap, NULL)) {
+        printf("FAILED: testHeapPushPop: incorrectly allowed pop from empty heap\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("HeapPushPop", successes, failures);
+    TearDown(heap);
+}
+
+void testHeapPeek() {
+    Heap* heap = SetUp(0);
+    int successes = 0, failures = 0;
+
+    heapPush(heap, 5);
+    heapPush(heap, 3);
+    heapPush(heap, 9);
+
+    if (*heapPeek(heap) != 3 || heapSize(heap) != 3) {
+        printf("FAILED: testHeapPeek: expected min 3 and size 3 but got %d and %lu\n", *heapPeek(heap), heapSize(heap));
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("HeapPeek", successes, failures);
+    TearDown(heap);
+}
+
+void testHeapDecreaseKey() {
+    Heap* heap = SetUp(4);
+    int successes = 0, failures = 0;
+
+    unsigned long handles[20];
+    for (int i = 0; i < 20; ++i) handles[i] = heapPush(heap, 100 + i);
+
+    heapDecreaseKey(heap, handles[17], 1);
+    if (*heapPeek(heap) != 1) {
+        printf("FAILED: testHeapDecreaseKey: expected new min 1 but got %d\n", *heapPeek(heap));
+        failures++;
+    }
+    else successes++;
+
+    if (heapDecreaseKey(heap, handles[3], 500)) {
+        printf("FAILED: testHeapDecreaseKey: incorrectly allowed the key to increase\n");
+        failures++;
+    }
+    else successes++;
+
+    heapPop(heap, NULL);
+    if (heapDecreaseKey(heap, handles[17], 0)) {
+        printf("FAILED: testHeapDecreaseKey: incorrectly allowed a popped handle\n");
+        failures++;
+    }
+    else successes++;
+
+    // handles still track elements after other elements moved
+    heapDecreaseKey(heap, handles[19], 50);
+    heapDecreaseKey(heap, handles[0], 49);
+    int first, second;
+    heapPop(heap, &first);
+    heapPop(heap, &second);
+    if (first != 49 || second != 50) {
+        printf("FAILED: testHeapDecreaseKey: expected 49 then 50 but got %d then %d\n", first, second);
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("HeapDecreaseKey", successes, failures);
+    TearDown(heap);
+}
+
+void testHeapFromArray() {
+    int successes = 0, failures = 0;
+
+    Array* array = arrayInit(257);
+    for (int i = 0; i < 257; ++i) arrayPushBack(array, (i * 37) % 101);
+
+    Heap* heap = heapFromArray(array, 3);
+    bool sorted = true;
+    int previous = -1, value;
+    while (!heapEmpty(heap)) {
+        heapPop(heap, &value);
+        if (value < previous) sorted = false;
+        previous = value;
+    }
+    if (!sorted) {
+        printf("FAILED: testHeapFromArray: heapified elements popped out of order\n");
+        failures++;
+    }
+    else successes++;
+    TearDown(heap);
+
+    // element i of the array gets handle i
+    heap = heapFromArray(array, 0);
+    heapDecreaseKey(heap, 200, -5);
+    if (*heapPeek(heap) != -5) {
+        printf("FAILED: testHeapFromArray: expected handle 200 to address array element 200\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("HeapFromArray", successes, failures);
+    TearDown(heap);
+    arrayDestroy(array);
+}
+
+void testHeapHandleReuse() {
+    Heap* heap = SetUp(2);
+    int successes = 0, failures = 0;
+
+    // steady push/pop must not grow the handle space
+    for (int i = 0; i < 1000; ++i) {
+        heapPush(heap, i);
+        heapPop(heap, NULL);
+    }
+    if (heap->handleCount != 1 || heap->capacity != 4) {
+        printf("FAILED: testHeapHandleReuse: expected 1 handle and capacity 4 but got %lu and %lu\n",
+               heap->handleCount, heap->capacity);
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("HeapHandleReuse", successes, failures);
+    TearDown(heap);
+}
+
+#endif /* HEAPTEST_H */
@@ -0,0 +1,517 @@
+#ifndef UNROLLEDLIST_H
+#define UNROLLEDLIST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+/******************************************************************************
+* UnrolledList
+*
+* implementation: doubly-linked list of small arrays; compile-time "generic"
+*                 with UNROLLEDLIST_TYPE. Each node is UNROLLEDLIST_NODE_BYTES
+*                 (two cache lines) and packs as many elements as fit after
+*                 its links, so a traversal takes one pointer chase per node
+*                 instead of one per element, and the per-element overhead
+*                 is the node header spread over a whole array.
+*
+*                 Elements of a node sit in data[0, count). Pushing into a
+*                 full end node starts a new node; inserting into a full
+*                 middle node splits it in half so later inserts nearby have
+*                 room. A node that becomes empty is freed.
+*
+* structures
+*  - UnrolledListNode: links, element count and the element array
+*  - UnrolledList: head, tail, total element count and node count
+*  - UnrolledListCursor: a node and an index into it; node == NULL is the
+*                        end position
+*
+******************************************************************************/
+
+#define UNROLLEDLIST_TYPE int
+
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+#define UNROLLEDLIST_NODE_BYTES (2 * CACHE_LINE_SIZE)
+#define UNROLLEDLIST_NODE_HEADER_BYTES (2 * sizeof(void*) + sizeof(unsigned int))
+#define UNROLLEDLIST_NODE_CAPACITY \
+    ((UNROLLEDLIST_NODE_BYTES - UNROLLEDLIST_NODE_HEADER_BYTES) / sizeof(UNROLLEDLIST_TYPE))
+
+typedef struct UnrolledListNode {
+    _Alignas(CACHE_LINE_SIZE) struct UnrolledListNode* prev;
+    struct UnrolledListNode* next;
+    unsigned int count;
+    UNROLLEDLIST_TYPE data[UNROLLEDLIST_NODE_CAPACITY];
+} UnrolledListNode;
+
+typedef struct UnrolledList {
+    UnrolledListNode* head;
+    UnrolledListNode* tail;
+    unsigned long size;
+    unsigned long nodeCount;
+} UnrolledList;
+
+typedef struct UnrolledListCursor {
+    UnrolledListNode* node;
+    unsigned int index;
+} UnrolledListCursor;
+
+/******************************************************************************
+* unrolledListNodeInit
+*
+* parameters: none
+*
+* returns: UnrolledListNode*
+*
+* description: allocates an empty, cache-line aligned node
+*
+******************************************************************************/
+UnrolledListNode* unrolledListNodeInit() {
+    UnrolledListNode* node = aligned_alloc(CACHE_LINE_SIZE, sizeof(UnrolledListNode));
+    if (node == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for UnrolledListNode.\n");
+        return NULL;
+    }
+
+    node->prev = NULL;
+    node->next = NULL;
+    node->count = 0;
+
+    return node;
+}
+
+/******************************************************************************
+* unrolledListInit
+*
+* parameters: none
+*
+* returns: UnrolledList*
+*
+* description: initializes memory for the UnrolledList
+*
+******************************************************************************/
+UnrolledList* unrolledListInit() {
+    UnrolledList* list = malloc(sizeof(UnrolledList));
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for UnrolledList.\n");
+        return NULL;
+    }
+
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+    list->nodeCount = 0;
+
+    return list;
+}
+
+/******************************************************************************
+* unrolledListClear
+*
+* parameters:
+*  - list : UnrolledList*
+*
+* returns: none
+*
+* description: frees every node
+*
+******************************************************************************/
+void unrolledListClear(UnrolledList* list) {
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: attempted to clear NULL UnrolledList*.\n");
+        return;
+    }
+
+    UnrolledListNode* node = list->head;
+    while (node != NULL) {
+        UnrolledListNode* next = node->next;
+        free(node);
+        node = next;
+    }
+
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+    list->nodeCount = 0;
+}
+
+/******************************************************************************
+* unrolledListDestroy
+*
+* parameters:
+*  - list : UnrolledList*
+*
+* returns: none
+*
+* description: frees the heap memory associated with the UnrolledList*
+*
+******************************************************************************/
+void unrolledListDestroy(UnrolledList* list) {
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: attempted to destroy NULL UnrolledList.\n");
+        return;
+    }
+
+    unrolledListClear(list);
+    free(list);
+}
+
+/******************************************************************************
+* unrolledListSize / unrolledListEmpty
+*
+* parameters:
+*  - list : UnrolledList*
+*
+* returns: unsigned long / bool
+*
+* description: number of elements / whether there are none
+*
+******************************************************************************/
+unsigned long unrolledListSize(UnrolledList* list) {
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: attempted to access size of NULL UnrolledList*.\n");
+        return 0;
+    }
+
+    return list->size;
+}
+
+bool unrolledListEmpty(UnrolledList* list) {
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: attempted to access size of NULL UnrolledList*.\n");
+        return false;
+    }
+
+    return list->size == 0;
+}
+
+/******************************************************************************
+* unrolledListFront / unrolledListBack
+*
+* parameters:
+*  - list : UnrolledList*
+*
+* returns: UNROLLEDLIST_TYPE* ; NULL if empty
+*
+* description: the first / last element
+*
+******************************************************************************/
+UNROLLEDLIST_TYPE* unrolledListFront(UnrolledList* list) {
+    if (list->head == NULL) {
+        fprintf(stderr, "Error: list is empty\n");
+        return NULL;
+    }
+
+    return &list->head->data[0];
+}
+
+UNROLLEDLIST_TYPE* unrolledListBack(UnrolledList* list) {
+    if (list->tail == NULL) {
+        fprintf(stderr, "Error: list is empty\n");
+        return NULL;
+    }
+
+    return &list->tail->data[list->tail->count - 1];
+}
+
+/******************************************************************************
+* unrolledListAt
+*
+* parameters:
+*  - list : UnrolledList*
+*  - index : unsigned long
+*
+* returns: UNROLLEDLIST_TYPE* ; NULL if out of bounds
+*
+* description: still linear, but skips a whole node per step
+*
+******************************************************************************/
+UNROLLEDLIST_TYPE* unrolledListAt(UnrolledList* list, unsigned long index) {
+    if (index >= list->size) {
+        fprintf(stderr, "Error: index out of bounds\n");
+        return NULL;
+    }
+
+    UnrolledListNode* node = list->head;
+    while (index >= node->count) {
+        index -= node->count;
+        node = node->next;
+    }
+
+    return &node->data[index];
+}
+
+/* Node linking helpers *******************************************************/
+// Links newNode after node, or as the new head if node is NULL
+static void __unrolledListLinkAfter(UnrolledList* list, UnrolledListNode* node, UnrolledListNode* newNode) {
+    newNode->prev = node;
+    newNode->next = (node != NULL) ? node->next : list->head;
+
+    if (newNode->next != NULL) newNode->next->prev = newNode;
+    else list->tail = newNode;
+
+    if (node != NULL) node->next = newNode;
+    else list->head = newNode;
+
+    list->nodeCount++;
+}
+
+static void __unrolledListUnlink(UnrolledList* list, UnrolledListNode* node) {
+    if (node->prev != NULL) node->prev->next = node->next;
+    else list->head = node->next;
+
+    if (node->next != NULL) node->next->prev = node->prev;
+    else list->tail = node->prev;
+
+    free(node);
+    list->nodeCount--;
+}
+/* End node linking helpers ***************************************************/
+
+/******************************************************************************
+* unrolledListPushBack
+*
+* parameters:
+*  - list : UnrolledList*
+*  - data : UNROLLEDLIST_TYPE
+*
+* returns: bool ; success status
+*
+* description: appends to the tail node, starting a new one when it is full
+*
+******************************************************************************/
+bool unrolledListPushBack(UnrolledList* list, UNROLLEDLIST_TYPE data) {
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: attempted to add element to NULL UnrolledList*.\n");
+        return false;
+    }
+
+    if (list->tail == NULL || list->tail->count == UNROLLEDLIST_NODE_CAPACITY) {
+        UnrolledListNode* newNode = unrolledListNodeInit();
+        if (newNode == NULL) return false;
+        __unrolledListLinkAfter(list, list->tail, newNode);
+    }
+
+    list->tail->data[list->tail->count++] = data;
+    list->size++;
+    return true;
+}
+
+/******************************************************************************
+* unrolledListPushFront
+*
+* parameters:
+*  - list : UnrolledList*
+*  - data : UNROLLEDLIST_TYPE
+*
+* returns: bool ; success status
+*
+* description: prepends to the head node, shifting at most one node's worth
+*              of elements, or starts a new head node when it is full
+*
+******************************************************************************/
+bool unrolledListPushFront(UnrolledList* list, UNROLLEDLIST_TYPE data) {
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: attempted to add element to NULL UnrolledList*.\n");
+        return false;
+    }
+
+    if (list->head == NULL || list->head->count == UNROLLEDLIST_NODE_CAPACITY) {
+        UnrolledListNode* newNode = unrolledListNodeInit();
+        if (newNode == NULL) return false;
+        __unrolledListLinkAfter(list, NULL, newNode);
+    }
+
+    UnrolledListNode* head = list->head;
+    memmove(&head->data[1], &head->data[0], head->count * sizeof(UNROLLEDLIST_TYPE));
+    head->data[0] = data;
+    head->count++;
+    list->size++;
+    return true;
+}
+
+/******************************************************************************
+* unrolledListPopBack
+*
+* parameters:
+*  - list : UnrolledList*
+*
+* returns: bool ; success status
+*
+* description: removes the last element, freeing the tail node if it empties
+*
+******************************************************************************/
+bool unrolledListPopBack(UnrolledList* list) {
+    if (list->tail == NULL) {
+        fprintf(stderr, "ERROR: list is empty.\n");
+        return false;
+    }
+
+    if (--list->tail->count == 0) __unrolledListUnlink(list, list->tail);
+    list->size--;
+    return true;
+}
+
+/******************************************************************************
+* unrolledListPopFront
+*
+* parameters:
+*  - list : UnrolledList*
+*
+* returns: bool ; success status
+*
+* description: removes the first element, freeing the head node if it empties
+*
+******************************************************************************/
+bool unrolledListPopFront(UnrolledList* list) {
+    if (list->head == NULL) {
+        fprintf(stderr, "ERROR: list is empty.\n");
+        return false;
+    }
+
+    UnrolledListNode* head = list->head;
+    if (--head->count == 0) {
+        __unrolledListUnlink(list, head);
+    }
+    else {
+        memmove(&head->data[0], &head->data[1], head->count * sizeof(UNROLLEDLIST_TYPE));
+    }
+    list->size--;
+    return true;
+}
+
+/******************************************************************************
+* unrolledListBegin
+*
+* parameters:
+*  - list : UnrolledList*
+*
+* returns: UnrolledListCursor ; the end cursor if the list is empty
+*
+* description: cursor at the first element
+*
+******************************************************************************/
+UnrolledListCursor unrolledListBegin(UnrolledList* list) {
+    UnrolledListCursor cursor = { list->head, 0 };
+    return cursor;
+}
+
+/******************************************************************************
+* unrolledListCursorValid / unrolledListCursorGet / unrolledListCursorNext
+*
+* parameters:
+*  - cursor : UnrolledListCursor*
+*
+* returns: bool / UNROLLEDLIST_TYPE* / bool
+*
+* description: whether the cursor is on an element, the element it is on, and
+*              step to the next element (false once the cursor reaches end)
+*
+******************************************************************************/
+bool unrolledListCursorValid(UnrolledListCursor* cursor) {
+    return cursor->node != NULL;
+}
+
+UNROLLEDLIST_TYPE* unrolledListCursorGet(UnrolledListCursor* cursor) {
+    if (cursor->node == NULL) {
+        fprintf(stderr, "Error: cursor is at end\n");
+        return NULL;
+    }
+
+    return &cursor->node->data[cursor->index];
+}
+
+bool unrolledListCursorNext(UnrolledListCursor* cursor) {
+    if (cursor->node == NULL) return false;
+
+    if (++cursor->index >= cursor->node->count) {
+        cursor->node = cursor->node->next;
+        cursor->index = 0;
+    }
+    return cursor->node != NULL;
+}
+
+/******************************************************************************
+* unrolledListInsert
+*
+* parameters:
+*  - list : UnrolledList*
+*  - cursor : UnrolledListCursor* ; from this list; the end cursor appends
+*  - data : UNROLLEDLIST_TYPE
+*
+* returns: bool ; success status
+*
+* description: inserts data before the cursor's element and leaves the cursor
+*              on the inserted element. A full node is split in half first,
+*              the upper half moving to a new node linked after it.
+*
+******************************************************************************/
+bool unrolledListInsert(UnrolledList* list, UnrolledListCursor* cursor, UNROLLEDLIST_TYPE data) {
+    if (list == NULL || cursor == NULL) {
+        fprintf(stderr, "ERROR: attempted to insert into NULL UnrolledList* or at NULL cursor.\n");
+        return false;
+    }
+
+    if (cursor->node == NULL) {
+        if (!unrolledListPushBack(list, data)) return false;
+        cursor->node = list->tail;
+        cursor->index = list->tail->count - 1;
+        return true;
+    }
+
+    UnrolledListNode* node = cursor->node;
+    unsigned int index = cursor->index;
+
+    if (node->count == UNROLLEDLIST_NODE_CAPACITY) {
+        UnrolledListNode* newNode = unrolledListNodeInit();
+        if (newNode == NULL) return false;
+
+        unsigned int keep = node->count / 2;
+        newNode->count = node->count - keep;
+        memcpy(newNode->data, &node->data[keep], newNode->count * sizeof(UNROLLEDLIST_TYPE));
+        node->count = keep;
+        __unrolledListLinkAfter(list, node, newNode);
+
+        if (index > keep) {
+            node = newNode;
+            index -= keep;
+        }
+    }
+
+    memmove(&node->data[index + 1], &node->data[index], (node->count - index) * sizeof(UNROLLEDLIST_TYPE));
+    node->data[index] = data;
+    node->count++;
+    list->size++;
+
+    cursor->node = node;
+    cursor->index = index;
+    return true;
+}
+
+/******************************************************************************
+* unrolledListToString
+*
+* parameters:
+*  - list : UnrolledList*
+*
+* returns: none
+*
+* description: prints every element; node boundaries are marked with |
+*
+******************************************************************************/
+void unrolledListToString(UnrolledList* list) {
+    printf("[ ");
+    for (UnrolledListNode* node = list->head; node != NULL; node = node->next) {
+        for (unsigned int i = 0; i < node->count; ++i) {
+            printf("%d", node->data[i]);
+            if (i + 1 < node->count) printf(", ");
+        }
+        if (node->next != NULL) printf(" | ");
+    }
+    printf(" ]\n");
+}
+
+#endif /* UNROLLEDLIST_H */
@@ -0,0 +1,88 @@
+#ifndef UNROLLEDLISTBENCH_H
+#define UNROLLEDLISTBENCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "UnrolledList.h"
+#include "LinkedList.h"
+#include "util.h"
+
+/******************************************************************************
+* UnrolledListBench.h
+*
+* UnrolledList vs. LinkedList (pooled nodes) at each size in
+* UNROLLEDLIST_BENCH_SIZES: time to build by push back, RSS growth per
+* element, and time for a full traversal summing every element. Each case
+* runs in a forked child so RSS measurements don't see each other's memory.
+*
+******************************************************************************/
+
+#define UNROLLEDLIST_BENCH_SIZES { 1000000UL, 100000000UL }
+
+static void __unrolledListBenchCase(bool unrolled, unsigned long count) {
+    double start, buildSeconds, traverseSeconds;
+    long rssBefore = benchRssKb(), rssAfter;
+    long long sum = 0;
+
+    if (unrolled) {
+        UnrolledList* list = unrolledListInit();
+        start = benchSeconds();
+        for (unsigned long i = 0; i < count; ++i) {
+            if (!unrolledListPushBack(list, (int)i)) return;
+        }
+        buildSeconds = benchSeconds() - start;
+        rssAfter = benchRssKb();
+
+        start = benchSeconds();
+        for (UnrolledListNode* node = list->head; node != NULL; node = node->next) {
+            for (unsigned int i = 0; i < node->count; ++i) sum += node->data[i];
+        }
+        traverseSeconds = benchSeconds() - start;
+        unrolledListDestroy(list);
+    }
+    else {
+        LinkedList* list = linkedListInit();
+        start = benchSeconds();
+        for (unsigned long i = 0; i < count; ++i) {
+            if (!linkedListPushBack(list, (int)i)) return;
+        }
+        buildSeconds = benchSeconds() - start;
+        rssAfter = benchRssKb();
+
+        start = benchSeconds();
+        for (ListNode* node = list->head; node != NULL; node = node->next) sum += node->data;
+        traverseSeconds = benchSeconds() - start;
+        linkedListDestroy(list);
+    }
+
+    printf("%-12s %10lu  build %7.3f s  traverse %7.3f s (%5.2f ns/elem)  RSS +%ld KB (%5.2f B/elem)  [sum %lld]\n",
+           unrolled ? "UnrolledList" : "LinkedList", count,
+           buildSeconds, traverseSeconds, traverseSeconds * 1e9 / count,
+           rssAfter - rssBefore, (rssAfter - rssBefore) * 1024.0 / count, sum);
+}
+
+void runUnrolledListBenchmarks() {
+    const unsigned long sizes[] = UNROLLEDLIST_BENCH_SIZES;
+
+    printf("\nUnrolledList benchmarks: %lu elements per node\n", (unsigned long)UNROLLEDLIST_NODE_CAPACITY);
+    printf("================================\n");
+    fflush(stdout);
+
+    for (unsigned long s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        for (int unrolled = 0; unrolled <= 1; ++unrolled) {
+            pid_t pid = fork();
+            if (pid == 0) {
+                __unrolledListBenchCase(unrolled, sizes[s]);
+                fflush(stdout);
+                _exit(0);
+            }
+            waitpid(pid, NULL, 0);
+        }
+    }
+}
+
+#endif /* UNROLLEDLISTBENCH_H */
@@ -0,0 +1,40 @@
+#include <stdio.h>
+
+#include "UnrolledList.h"
+#include "UnrolledListTest.h"
+#ifdef RUN_BENCHMARKS
+#include "UnrolledListBench.h"
+#endif
+
+int main() {
+    UnrolledList* list = unrolledListInit();
+    if (list == NULL) return 1;
+
+    for (int i = 0; i < 40; ++i) unrolledListPushBack(list, i);
+    unrolledListPushFront(list, -1);
+    unrolledListToString(list);
+
+    // Insert 100 before the element 10, splitting its full node
+    UnrolledListCursor cursor = unrolledListBegin(list);
+    while (unrolledListCursorValid(&cursor) && *unrolledListCursorGet(&cursor) != 10) {
+        unrolledListCursorNext(&cursor);
+    }
+    unrolledListInsert(list, &cursor, 100);
+    unrolledListToString(list);
+
+    printf("Element at index 30: %d\n", *unrolledListAt(list, 30));
+    printf("%lu elements in %lu nodes of up to %lu\n",
+           unrolledListSize(list), list->nodeCount, (unsigned long)UNROLLEDLIST_NODE_CAPACITY);
+
+    unrolledListPopFront(list);
+    unrolledListPopBack(list);
+    unrolledListToString(list);
+
+    unrolledListDestroy(list);
+
+    runUnrolledListTests();
+
+#ifdef RUN_BENCHMARKS
+    runUnrolledListBenchmarks();
+#endif
+}
\ No newline at end of file
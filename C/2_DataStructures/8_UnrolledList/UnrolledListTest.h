@@ -0,0 +1,214 @@
+#ifndef UNROLLEDLISTTEST_H
+#define UNROLLEDLISTTEST_H
+
+#include "UnrolledList.h"
+#include "TestsSummary.h"
+
+/* Testing functions **********************************************************/
+void testUnrolledListPushBack();
+void testUnrolledListPushFront();
+void testUnrolledListPop();
+void testUnrolledListAt();
+void testUnrolledListInsert();
+void testUnrolledListCursor();
+/* End testing functions ******************************************************/
+
+/* Test setup/teardown functions **********************************************/
+UnrolledList* SetUp() {
+    return unrolledListInit();
+}
+
+void TearDown(UnrolledList* list) {
+    unrolledListDestroy(list);
+}
+/* End test setup/teardown functions ******************************************/
+
+// These tests assume UNROLLEDLIST_TYPE is int
+void runUnrolledListTests() {
+    TestsSummaryPrintHeader("UnrolledList");
+
+    testUnrolledListPushBack();
+    testUnrolledListPushFront();
+    testUnrolledListPop();
+    testUnrolledListAt();
+    testUnrolledListInsert();
+    testUnrolledListCursor();
+
+    TestsSummaryPrintFooter("UnrolledList");
+}
+
+// Checks that list holds 0, 1, ..., size - 1 in order
+bool __unrolledListIsSequence(UnrolledList* list) {
+    int expected = 0;
+    for (UnrolledListCursor cursor = unrolledListBegin(list); unrolledListCursorValid(&cursor);
+         unrolledListCursorNext(&cursor)) {
+        if (*unrolledListCursorGet(&cursor) != expected++) return false;
+    }
+    return (unsigned long)expected == list->size;
+}
+
+void testUnrolledListPushBack() {
+    UnrolledList* list = SetUp();
+    int successes = 0, failures = 0;
+    const int count = UNROLLEDLIST_NODE_CAPACITY * 3 + 1;
+
+    for (int i = 0; i < count; ++i) unrolledListPushBack(list, i);
+
+    if (!__unrolledListIsSequence(list) || *unrolledListBack(list) != count - 1) {
+        printf("FAILED: testUnrolledListPushBack: elements out of order\n");
+        failures++;
+    }
+    else successes++;
+
+    // full nodes are not split by push back
+    if (list->nodeCount != 4) {
+        printf("FAILED: testUnrolledListPushBack: expected 4 nodes but got %lu\n", list->nodeCount);
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("UnrolledListPushBack", successes, failures);
+    TearDown(list);
+}
+
+void testUnrolledListPushFront() {
+    UnrolledList* list = SetUp();
+    int successes = 0, failures = 0;
+    const int count = UNROLLEDLIST_NODE_CAPACITY * 2 + 3;
+
+    for (int i = count - 1; i >= 0; --i) unrolledListPushFront(list, i);
+
+    if (!__unrolledListIsSequence(list) || *unrolledListFront(list) != 0) {
+        printf("FAILED: testUnrolledListPushFront: elements out of order\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("UnrolledListPushFront", successes, failures);
+    TearDown(list);
+}
+
+void testUnrolledListPop() {
+    UnrolledList* list = SetUp();
+    int successes = 0, failures = 0;
+    const int count = UNROLLEDLIST_NODE_CAPACITY * 2;
+
+    for (int i = 0; i < count; ++i) unrolledListPushBack(list, i);
+    for (int i = 0; i < count / 2; ++i) unrolledListPopFront(list);
+
+    if (*unrolledListFront(list) != count / 2 || list->nodeCount != 1) {
+        printf("FAILED: testUnrolledListPop: expected front %d in a single node\n", count / 2);
+        failures++;
+    }
+    else successes++;
+
+    for (int i = 0; i < count / 2; ++i) unrolledListPopBack(list);
+
+    if (!unrolledListEmpty(list) || list->head != NULL || list->tail != NULL || list->nodeCount != 0) {
+        printf("FAILED: testUnrolledListPop: expected empty list with no nodes\n");
+        failures++;
+    }
+    else successes++;
+
+    if (unrolledListPopFront(list) || unrolledListPopBack(list)) {
+        printf("FAILED: testUnrolledListPop: incorrectly allowed pop from empty list\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("UnrolledListPop", successes, failures);
+    TearDown(list);
+}
+
+void testUnrolledListAt() {
+    UnrolledList* list = SetUp();
+    int successes = 0, failures = 0;
+    const int count = UNROLLEDLIST_NODE_CAPACITY * 3;
+
+    for (int i = 0; i < count; ++i) unrolledListPushBack(list, i * 2);
+
+    int* element = unrolledListAt(list, UNROLLEDLIST_NODE_CAPACITY + 5);
+    if (element == NULL || *element != (int)(UNROLLEDLIST_NODE_CAPACITY + 5) * 2) {
+        printf("FAILED: testUnrolledListAt: wrong element in the second node\n");
+        failures++;
+    }
+    else successes++;
+
+    if (unrolledListAt(list, count) != NULL) {
+        printf("FAILED: testUnrolledListAt: incorrectly allowed index past the end\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("UnrolledListAt", successes, failures);
+    TearDown(list);
+}
+
+void testUnrolledListInsert() {
+    UnrolledList* list = SetUp();
+    int successes = 0, failures = 0;
+    const int count = UNROLLEDLIST_NODE_CAPACITY * 2;
+
+    // even numbers, then insert each odd number before its successor
+    for (int i = 0; i < count; i += 2) unrolledListPushBack(list, i);
+    UnrolledListCursor cursor = unrolledListBegin(list);
+    unrolledListCursorNext(&cursor);
+    for (int odd = 1; odd < count - 1; odd += 2) {
+        unrolledListInsert(list, &cursor, odd);
+        if (*unrolledListCursorGet(&cursor) != odd) break;
+        unrolledListCursorNext(&cursor);
+        unrolledListCursorNext(&cursor);
+    }
+
+    if (!__unrolledListIsSequence(list) || list->size != (unsigned long)count - 1) {
+        printf("FAILED: testUnrolledListInsert: elements out of order after inserts\n");
+        failures++;
+    }
+    else successes++;
+
+    // inserting at the end cursor appends
+    unrolledListInsert(list, &cursor, count - 1);
+    if (*unrolledListBack(list) != count - 1 || !__unrolledListIsSequence(list)) {
+        printf("FAILED: testUnrolledListInsert: insert at end did not append\n");
+        failures++;
+    }
+    else successes++;
+
+    // splitting keeps every node at least half full
+    bool halfFull = true;
+    for (UnrolledListNode* node = list->head; node != NULL; node = node->next) {
+        if (node->next != NULL && node->count < UNROLLEDLIST_NODE_CAPACITY / 2) halfFull = false;
+    }
+    if (!halfFull) {
+        printf("FAILED: testUnrolledListInsert: found a node less than half full after splits\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("UnrolledListInsert", successes, failures);
+    TearDown(list);
+}
+
+void testUnrolledListCursor() {
+    UnrolledList* list = SetUp();
+    int successes = 0, failures = 0;
+
+    UnrolledListCursor cursor = unrolledListBegin(list);
+    if (unrolledListCursorValid(&cursor) || unrolledListCursorNext(&cursor)) {
+        printf("FAILED: testUnrolledListCursor: expected end cursor on empty list\n");
+        failures++;
+    }
+    else successes++;
+
+    unrolledListInsert(list, &cursor, 42);
+    if (!unrolledListCursorValid(&cursor) || *unrolledListCursorGet(&cursor) != 42 || list->size != 1) {
+        printf("FAILED: testUnrolledListCursor: insert into empty list\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("UnrolledListCursor", successes, failures);
+    TearDown(list);
+}
+
+#endif /* UNROLLEDLISTTEST_H */
@@ -0,0 +1,608 @@
+#ifndef INDEXLIST_H
+#define INDEXLIST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/******************************************************************************
+* IndexList
+*
+* implementation: doubly-linked list whose nodes all live in one growable
+*                 array and link to each other by 32-bit index instead of by
+*                 pointer; compile-time "generic" with INDEXLIST_TYPE. With
+*                 int data a node is 12 bytes instead of ListNode's 24.
+*
+*                 Because links are indices, growing the array with realloc
+*                 moves nothing that matters, and the array can be written to
+*                 disk and read back as is (indexListSave / indexListLoad).
+*                 Element pointers returned by the accessors are only valid
+*                 until the next push, like Array's.
+*
+*                 Removed nodes go onto a free-index list chained through
+*                 next and are reused before the array grows. Slots
+*                 [0, used) have been handed out at least once.
+*
+* structures
+*  - IndexListNode: data plus prev/next indices (INDEXLIST_NIL for none)
+*  - IndexList: node array, capacity, high-water mark, head, tail, free list
+*               head and size
+*
+******************************************************************************/
+
+#define INDEXLIST_TYPE int32_t
+#define INDEXLIST_NIL UINT32_MAX
+#define INDEXLIST_INITIAL_CAPACITY 16
+
+// "ILST" little-endian, then a format version, for indexListSave/Load
+#define INDEXLIST_FILE_MAGIC 0x54534C49u
+#define INDEXLIST_FILE_VERSION 2u
+
+typedef struct IndexListNode {
+    INDEXLIST_TYPE data;
+    uint32_t prev;
+    uint32_t next;
+} IndexListNode;
+
+typedef struct IndexList {
+    IndexListNode* nodes;
+    uint32_t capacity;
+    uint32_t used;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t freeHead;
+    uint32_t size;
+} IndexList;
+
+/******************************************************************************
+* indexListInit
+*
+* parameters:
+*  - capacity : uint32_t ; initial node capacity, 0 for the default
+*
+* returns: IndexList*
+*
+* description: initializes an empty list with room for capacity nodes
+*
+******************************************************************************/
+IndexList* indexListInit(uint32_t capacity) {
+    IndexList* list = malloc(sizeof(IndexList));
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for IndexList.\n");
+        return NULL;
+    }
+
+    if (capacity == 0) capacity = INDEXLIST_INITIAL_CAPACITY;
+    list->nodes = malloc(capacity * sizeof(IndexListNode));
+    if (list->nodes == NULL) {
+        fprintf(stderr, "ERROR: failed to allocate memory for IndexList's nodes.\n");
+        free(list);
+        return NULL;
+    }
+
+    list->capacity = capacity;
+    list->used = 0;
+    list->head = INDEXLIST_NIL;
+    list->tail = INDEXLIST_NIL;
+    list->freeHead = INDEXLIST_NIL;
+    list->size = 0;
+
+    return list;
+}
+
+/******************************************************************************
+* indexListDestroy
+*
+* parameters:
+*  - list : IndexList*
+*
+* returns: none
+*
+* description: frees the heap memory associated with the IndexList*; one free
+*              for all of the nodes
+*
+******************************************************************************/
+void indexListDestroy(IndexList* list) {
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: attempted to destroy NULL IndexList.\n");
+        return;
+    }
+
+    free(list->nodes);
+    free(list);
+}
+
+/******************************************************************************
+* indexListSize / indexListEmpty
+*
+* parameters:
+*  - list : IndexList*
+*
+* returns: uint32_t / bool
+*
+* description: number of elements / whether there are none
+*
+******************************************************************************/
+uint32_t indexListSize(IndexList* list) {
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: attempted to access size of NULL IndexList*.\n");
+        return 0;
+    }
+
+    return list->size;
+}
+
+bool indexListEmpty(IndexList* list) {
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: attempted to access size of NULL IndexList*.\n");
+        return false;
+    }
+
+    return list->size == 0;
+}
+
+/******************************************************************************
+* indexListFront / indexListBack
+*
+* parameters:
+*  - list : IndexList*
+*
+* returns: INDEXLIST_TYPE* ; NULL if empty
+*
+* description: the first / last element
+*
+******************************************************************************/
+INDEXLIST_TYPE* indexListFront(IndexList* list) {
+    if (list->head == INDEXLIST_NIL) {
+        fprintf(stderr, "Error: list is empty\n");
+        return NULL;
+    }
+
+    return &list->nodes[list->head].data;
+}
+
+INDEXLIST_TYPE* indexListBack(IndexList* list) {
+    if (list->tail == INDEXLIST_NIL) {
+        fprintf(stderr, "Error: list is empty\n");
+        return NULL;
+    }
+
+    return &list->nodes[list->tail].data;
+}
+
+/******************************************************************************
+* indexListAt
+*
+* parameters:
+*  - list : IndexList*
+*  - index : uint32_t ; position in list order, not a node index
+*
+* returns: INDEXLIST_TYPE* ; NULL if out of bounds
+*
+* description: walks from head to the element at the given position
+*
+******************************************************************************/
+INDEXLIST_TYPE* indexListAt(IndexList* list, uint32_t index) {
+    if (index >= list->size) {
+        fprintf(stderr, "Error: index out of bounds\n");
+        return NULL;
+    }
+
+    uint32_t node = list->head;
+    for (uint32_t i = 0; i < index; ++i) {
+        node = list->nodes[node].next;
+    }
+
+    return &list->nodes[node].data;
+}
+
+/******************************************************************************
+* indexListAcquire
+*
+* parameters:
+*  - list : IndexList*
+*  - data : INDEXLIST_TYPE
+*
+* returns: uint32_t ; node index, INDEXLIST_NIL on failure
+*
+* description: takes a node off the free-index list, or the next unused
+*              slot, doubling the array when it is full. Links are indices,
+*              so the realloc can move the array freely.
+*
+******************************************************************************/
+uint32_t indexListAcquire(IndexList* list, INDEXLIST_TYPE data) {
+    uint32_t node;
+
+    if (list->freeHead != INDEXLIST_NIL) {
+        node = list->freeHead;
+        list->freeHead = list->nodes[node].next;
+    }
+    else {
+        if (list->used == list->capacity) {
+            // INDEXLIST_NIL itself is never a valid node index
+            if (list->capacity >= INDEXLIST_NIL / 2) {
+                fprintf(stderr, "ERROR: IndexList is at its maximum capacity.\n");
+                return INDEXLIST_NIL;
+            }
+            uint32_t newCapacity = list->capacity * 2;
+            IndexListNode* grown = realloc(list->nodes, newCapacity * sizeof(IndexListNode));
+            if (grown == NULL) {
+                fprintf(stderr, "ERROR: failed to grow IndexList's nodes.\n");
+                return INDEXLIST_NIL;
+            }
+            list->nodes = grown;
+            list->capacity = newCapacity;
+        }
+        node = list->used++;
+    }
+
+    list->nodes[node].data = data;
+    list->nodes[node].prev = INDEXLIST_NIL;
+    list->nodes[node].next = INDEXLIST_NIL;
+    return node;
+}
+
+/******************************************************************************
+* indexListRelease
+*
+* parameters:
+*  - list : IndexList*
+*  - node : uint32_t ; an unlinked node index
+*
+* returns: none
+*
+* description: pushes node onto the free-index list
+*
+******************************************************************************/
+void indexListRelease(IndexList* list, uint32_t node) {
+    list->nodes[node].next = list->freeHead;
+    list->freeHead = node;
+}
+
+/******************************************************************************
+* indexListPushBack
+*
+* parameters:
+*  - list : IndexList*
+*  - data : INDEXLIST_TYPE
+*
+* returns: bool ; success status
+*
+* description: adds a node containing data to the back of the list
+*
+******************************************************************************/
+bool indexListPushBack(IndexList* list, INDEXLIST_TYPE data) {
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: attempted to add element to NULL IndexList*.\n");
+        return false;
+    }
+
+    uint32_t node = indexListAcquire(list, data);
+    if (node == INDEXLIST_NIL) return false;
+
+    if (list->tail == INDEXLIST_NIL) {
+        list->head = list->tail = node;
+    }
+    else {
+        list->nodes[node].prev = list->tail;
+        list->nodes[list->tail].next = node;
+        list->tail = node;
+    }
+
+    list->size++;
+    return true;
+}
+
+/******************************************************************************
+* indexListPushFront
+*
+* parameters:
+*  - list : IndexList*
+*  - data : INDEXLIST_TYPE
+*
+* returns: bool ; success status
+*
+* description: adds a node containing data to the front of the list
+*
+******************************************************************************/
+bool indexListPushFront(IndexList* list, INDEXLIST_TYPE data) {
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: attempted to add element to NULL IndexList*.\n");
+        return false;
+    }
+
+    uint32_t node = indexListAcquire(list, data);
+    if (node == INDEXLIST_NIL) return false;
+
+    if (list->head == INDEXLIST_NIL) {
+        list->head = list->tail = node;
+    }
+    else {
+        list->nodes[node].next = list->head;
+        list->nodes[list->head].prev = node;
+        list->head = node;
+    }
+
+    list->size++;
+    return true;
+}
+
+/******************************************************************************
+* indexListPopBack
+*
+* parameters:
+*  - list : IndexList*
+*
+* returns: bool ; success status
+*
+* description: removes the node at the back of the list
+*
+******************************************************************************/
+bool indexListPopBack(IndexList* list) {
+    if (list->tail == INDEXLIST_NIL) {
+        fprintf(stderr, "ERROR: list is empty.\n");
+        return false;
+    }
+
+    uint32_t nodeToRemove = list->tail;
+    list->tail = list->nodes[nodeToRemove].prev;
+
+    if (list->tail != INDEXLIST_NIL) {
+        list->nodes[list->tail].next = INDEXLIST_NIL;
+    }
+    else {
+        list->head = INDEXLIST_NIL;
+    }
+
+    indexListRelease(list, nodeToRemove);
+    list->size--;
+    return true;
+}
+
+/******************************************************************************
+* indexListPopFront
+*
+* parameters:
+*  - list : IndexList*
+*
+* returns: bool ; success status
+*
+* description: removes the node at the front of the list
+*
+******************************************************************************/
+bool indexListPopFront(IndexList* list) {
+    if (list->head == INDEXLIST_NIL) {
+        fprintf(stderr, "ERROR: list is empty.\n");
+        return false;
+    }
+
+    uint32_t nodeToRemove = list->head;
+    list->head = list->nodes[nodeToRemove].next;
+
+    if (list->head != INDEXLIST_NIL) {
+        list->nodes[list->head].prev = INDEXLIST_NIL;
+    }
+    else {
+        list->tail = INDEXLIST_NIL;
+    }
+
+    indexListRelease(list, nodeToRemove);
+    list->size--;
+    return true;
+}
+
+/******************************************************************************
+* indexListClear
+*
+* parameters:
+*  - list : IndexList*
+*
+* returns: none
+*
+* description: forgets every node; the array keeps its capacity
+*
+******************************************************************************/
+void indexListClear(IndexList* list) {
+    if (list == NULL) {
+        fprintf(stderr, "ERROR: attempted to clear NULL IndexList*.\n");
+        return;
+    }
+
+    list->used = 0;
+    list->head = INDEXLIST_NIL;
+    list->tail = INDEXLIST_NIL;
+    list->freeHead = INDEXLIST_NIL;
+    list->size = 0;
+}
+
+/******************************************************************************
+* indexListToString
+*
+* parameters:
+*  - list : IndexList*
+*
+* returns: none
+*
+* description: prints every element in list order
+*
+******************************************************************************/
+void indexListToString(IndexList* list) {
+    printf("[ ");
+    for (uint32_t node = list->head; node != INDEXLIST_NIL; node = list->nodes[node].next) {
+        printf("%d", list->nodes[node].data);
+        if (list->nodes[node].next != INDEXLIST_NIL) {
+            printf(", ");
+        }
+    }
+    printf(" ]\n");
+}
+
+/* Serialization **************************************************************/
+// File layout: this header, then nodes[0, used) exactly as they are in memory
+typedef struct IndexListFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t nodeSize;   // sizeof(IndexListNode), catches a different INDEXLIST_TYPE
+    uint32_t used;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t freeHead;
+    uint32_t size;
+    uint32_t checksum;   // FNV-1a over this header (checksum 0) and the node bytes
+} IndexListFileHeader;
+
+// FNV-1a, unlike a plain byte sum, notices bytes that move, and it covers the
+// header too, so a changed head or size is caught as well
+static uint32_t __indexListChecksum(const IndexListFileHeader* header, const IndexListNode* nodes, uint32_t count) {
+    IndexListFileHeader unsummed = *header;
+    unsummed.checksum = 0;
+
+    uint32_t checksum = 2166136261u;
+    const unsigned char* bytes = (const unsigned char*)&unsummed;
+    for (size_t i = 0; i < sizeof(unsummed); ++i) checksum = (checksum ^ bytes[i]) * 16777619u;
+    bytes = (const unsigned char*)nodes;
+    for (size_t i = 0; i < (size_t)count * sizeof(IndexListNode); ++i) checksum = (checksum ^ bytes[i]) * 16777619u;
+    return checksum;
+}
+
+// Checks that every index is below used or INDEXLIST_NIL, that the list runs
+// from head to tail in size steps with matching prev links, and that the
+// free list holds exactly the other slots; a loaded list is walked blindly
+static bool __indexListIsConsistent(const IndexList* list) {
+    if ((list->head != INDEXLIST_NIL && list->head >= list->used)
+        || (list->tail != INDEXLIST_NIL && list->tail >= list->used)
+        || (list->freeHead != INDEXLIST_NIL && list->freeHead >= list->used)
+        || (list->head == INDEXLIST_NIL) != (list->size == 0)
+        || (list->tail == INDEXLIST_NIL) != (list->size == 0)) {
+        return false;
+    }
+
+    bool* seen = calloc(list->used ? list->used : 1, sizeof(bool));
+    if (seen == NULL) return false;
+
+    bool consistent = true;
+    uint32_t count = 0;
+    uint32_t prev = INDEXLIST_NIL;
+    uint32_t node = list->head;
+    while (consistent && node != INDEXLIST_NIL) {
+        consistent = node < list->used && !seen[node] && list->nodes[node].prev == prev && count < list->size;
+        if (consistent) {
+            seen[node] = true;
+            prev = node;
+            count++;
+            node = list->nodes[node].next;
+        }
+    }
+    consistent = consistent && count == list->size && prev == list->tail;
+
+    node = list->freeHead;
+    while (consistent && node != INDEXLIST_NIL) {
+        consistent = node < list->used && !seen[node];
+        if (consistent) {
+            seen[node] = true;
+            count++;
+            node = list->nodes[node].next;
+        }
+    }
+    consistent = consistent && count == list->used;
+
+    free(seen);
+    return consistent;
+}
+
+/******************************************************************************
+* indexListSave
+*
+* parameters:
+*  - list : IndexList*
+*  - path : const char*
+*
+* returns: bool ; success status
+*
+* description: writes the header and the used part of the node array with
+*              two fwrites; no pointers to fix up, free list included
+*
+******************************************************************************/
+bool indexListSave(IndexList* list, const char* path) {
+    if (list == NULL || path == NULL) {
+        fprintf(stderr, "ERROR: attempted to save NULL IndexList* or to NULL path.\n");
+        return false;
+    }
+
+    FILE* fp = fopen(path, "wb");
+    if (fp == NULL) {
+        perror("Error opening IndexList file for writing");
+        return false;
+    }
+
+    IndexListFileHeader header = {
+        INDEXLIST_FILE_MAGIC, INDEXLIST_FILE_VERSION, sizeof(IndexListNode),
+        list->used, list->head, list->tail, list->freeHead, list->size, 0
+    };
+    header.checksum = __indexListChecksum(&header, list->nodes, list->used);
+
+    bool success = fwrite(&header, sizeof(header), 1, fp) == 1
+                && fwrite(list->nodes, sizeof(IndexListNode), list->used, fp) == list->used;
+    if (!success) perror("Error writing IndexList file");
+
+    if (fclose(fp) != 0) success = false;
+    return success;
+}
+
+/******************************************************************************
+* indexListLoad
+*
+* parameters:
+*  - path : const char*
+*
+* returns: IndexList* ; NULL if the file is missing, of another format,
+*          corrupt, or holds an index outside the array
+*
+* description: reads a file written by indexListSave straight into a new
+*              node array
+*
+******************************************************************************/
+IndexList* indexListLoad(const char* path) {
+    FILE* fp = fopen(path, "rb");
+    if (fp == NULL) {
+        perror("Error opening IndexList file for reading");
+        return NULL;
+    }
+
+    IndexListFileHeader header;
+    if (fread(&header, sizeof(header), 1, fp) != 1
+        || header.magic != INDEXLIST_FILE_MAGIC
+        || header.version != INDEXLIST_FILE_VERSION
+        || header.nodeSize != sizeof(IndexListNode)
+        || header.size > header.used) {
+        fprintf(stderr, "ERROR: %s is not an IndexList file.\n", path);
+        fclose(fp);
+        return NULL;
+    }
+
+    IndexList* list = indexListInit(header.used);
+    if (list == NULL) {
+        fclose(fp);
+        return NULL;
+    }
+
+    list->used = header.used;
+    list->head = header.head;
+    list->tail = header.tail;
+    list->freeHead = header.freeHead;
+    list->size = header.size;
+    if (fread(list->nodes, sizeof(IndexListNode), header.used, fp) != header.used
+        || __indexListChecksum(&header, list->nodes, header.used) != header.checksum
+        || !__indexListIsConsistent(list)) {
+        fprintf(stderr, "ERROR: %s is truncated or corrupt.\n", path);
+        indexListDestroy(list);
+        fclose(fp);
+        return NULL;
+    }
+    fclose(fp);
+    return list;
+}
+/* End serialization **********************************************************/
+
+#endif /* INDEXLIST_H */
@@ -0,0 +1,44 @@
+#include <stdio.h>
+
+#include "IndexList.h"
+#include "IndexListTest.h"
+
+int main() {
+    IndexList* list = indexListInit(0);
+    if (list == NULL) return 1;
+
+    indexListPushBack(list, 10);
+    indexListPushBack(list, 20);
+    indexListPushBack(list, 30);
+    indexListPushFront(list, 5);
+
+    indexListToString(list);
+
+    int32_t* dataAtIndex = indexListAt(list, 2);
+    if (dataAtIndex != NULL) {
+        printf("Element at index 2: %d\n", *dataAtIndex);
+    }
+
+    indexListPopBack(list);
+    indexListPopFront(list);
+    indexListToString(list);
+
+    // Links are indices, so the node array goes to disk as is
+    if (indexListSave(list, "indexlist.bin")) {
+        IndexList* loaded = indexListLoad("indexlist.bin");
+        if (loaded != NULL) {
+            printf("Loaded from disk: ");
+            indexListToString(loaded);
+            indexListDestroy(loaded);
+        }
+        remove("indexlist.bin");
+    }
+
+    struct PointerNode { INDEXLIST_TYPE data; void* prev; void* next; };
+    printf("%zu bytes per node (with pointer links: %zu)\n",
+           sizeof(IndexListNode), sizeof(struct PointerNode));
+
+    indexListDestroy(list);
+
+    runIndexListTests();
+}
\ No newline at end of file
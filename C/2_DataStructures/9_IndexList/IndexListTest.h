@@ -0,0 +1,254 @@
+#ifndef INDEXLISTTEST_H
+#define INDEXLISTTEST_H
+
+#include <stddef.h>
+
+#include "IndexList.h"
+#include "TestsSummary.h"
+
+/* Testing functions **********************************************************/
+void testIndexListPushPop();
+void testIndexListFreeList();
+void testIndexListGrowth();
+void testIndexListSaveLoad();
+void testIndexListLoadCorrupt();
+/* End testing functions ******************************************************/
+
+/* Test setup/teardown functions **********************************************/
+IndexList* SetUp(uint32_t capacity) {
+    return indexListInit(capacity);
+}
+
+void TearDown(IndexList* list) {
+    indexListDestroy(list);
+}
+/* End test setup/teardown functions ******************************************/
+
+#define INDEXLIST_TEST_FILE "indexlist_test.bin"
+
+// These tests assume INDEXLIST_TYPE is int32_t
+void runIndexListTests() {
+    TestsSummaryPrintHeader("IndexList");
+
+    testIndexListPushPop();
+    testIndexListFreeList();
+    testIndexListGrowth();
+    testIndexListSaveLoad();
+    testIndexListLoadCorrupt();
+
+    remove(INDEXLIST_TEST_FILE);
+    TestsSummaryPrintFooter("IndexList");
+}
+
+// Checks that list holds first, first + 1, ..., first + size - 1 in order,
+// walking forward and backward
+bool __indexListIsSequence(IndexList* list, int32_t first) {
+    int32_t expected = first;
+    for (uint32_t node = list->head; node != INDEXLIST_NIL; node = list->nodes[node].next) {
+        if (list->nodes[node].data != expected++) return false;
+    }
+    if ((uint32_t)(expected - first) != list->size) return false;
+
+    for (uint32_t node = list->tail; node != INDEXLIST_NIL; node = list->nodes[node].prev) {
+        if (list->nodes[node].data != --expected) return false;
+    }
+    return expected == first;
+}
+
+void testIndexListPushPop() {
+    IndexList* list = SetUp(0);
+    int successes = 0, failures = 0;
+
+    indexListPushBack(list, 2);
+    indexListPushBack(list, 3);
+    indexListPushFront(list, 1);
+    indexListPushFront(list, 0);
+
+    if (!__indexListIsSequence(list, 0) || *indexListAt(list, 2) != 2) {
+        printf("FAILED: testIndexListPushPop: expected [ 0, 1, 2, 3 ]\n");
+        failures++;
+    }
+    else successes++;
+
+    indexListPopFront(list);
+    indexListPopBack(list);
+    if (!__indexListIsSequence(list, 1) || *indexListFront(list) != 1 || *indexListBack(list) != 2) {
+        printf("FAILED: testIndexListPushPop: expected [ 1, 2 ]\n");
+        failures++;
+    }
+    else successes++;
+
+    indexListPopFront(list);
+    indexListPopFront(list);
+    if (!indexListEmpty(list) || indexListPopBack(list) || indexListAt(list, 0) != NULL) {
+        printf("FAILED: testIndexListPushPop: expected empty list to reject pop and access\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("IndexListPushPop", successes, failures);
+    TearDown(list);
+}
+
+void testIndexListFreeList() {
+    IndexList* list = SetUp(8);
+    int successes = 0, failures = 0;
+
+    // steady push/pop churn reuses freed slots instead of growing
+    for (int32_t i = 0; i < 4; ++i) indexListPushBack(list, i);
+    for (int32_t i = 4; i < 10000; ++i) {
+        indexListPushBack(list, i);
+        indexListPopFront(list);
+    }
+
+    if (list->capacity != 8 || list->used != 5 || !__indexListIsSequence(list, 9996)) {
+        printf("FAILED: testIndexListFreeList: expected churn to stay within 5 slots, used %u of %u\n",
+               list->used, list->capacity);
+        failures++;
+    }
+    else successes++;
+
+    indexListClear(list);
+    indexListPushBack(list, 7);
+    if (list->used != 1 || list->size != 1 || *indexListFront(list) != 7) {
+        printf("FAILED: testIndexListFreeList: expected clear to reset the slots\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("IndexListFreeList", successes, failures);
+    TearDown(list);
+}
+
+void testIndexListGrowth() {
+    IndexList* list = SetUp(1);
+    int successes = 0, failures = 0;
+
+    // alternate ends so links cross many reallocs in both directions
+    for (int32_t i = 0; i < 5000; ++i) {
+        indexListPushBack(list, 5000 + i);
+        indexListPushFront(list, 4999 - i);
+    }
+
+    if (list->capacity < 10000 || !__indexListIsSequence(list, 0)) {
+        printf("FAILED: testIndexListGrowth: links broken after growing to %u\n", list->capacity);
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("IndexListGrowth", successes, failures);
+    TearDown(list);
+}
+
+void testIndexListSaveLoad() {
+    IndexList* list = SetUp(0);
+    int successes = 0, failures = 0;
+
+    for (int32_t i = 0; i < 100; ++i) indexListPushBack(list, i);
+    for (int32_t i = 0; i < 10; ++i) indexListPopFront(list);
+
+    if (!indexListSave(list, INDEXLIST_TEST_FILE)) {
+        printf("FAILED: testIndexListSaveLoad: save failed\n");
+        failures++;
+    }
+    else successes++;
+
+    IndexList* loaded = indexListLoad(INDEXLIST_TEST_FILE);
+    if (loaded == NULL || !__indexListIsSequence(loaded, 10)) {
+        printf("FAILED: testIndexListSaveLoad: loaded list differs from saved list\n");
+        failures++;
+    }
+    else successes++;
+
+    // the free list survives the round trip too
+    if (loaded != NULL) {
+        indexListPushBack(loaded, 100);
+        if (loaded->used != 100 || !__indexListIsSequence(loaded, 10)) {
+            printf("FAILED: testIndexListSaveLoad: loaded list did not reuse a freed slot\n");
+            failures++;
+        }
+        else successes++;
+        indexListDestroy(loaded);
+    }
+    else failures++;
+
+    TestsSummaryPrintResults("IndexListSaveLoad", successes, failures);
+    TearDown(list);
+}
+
+void testIndexListLoadCorrupt() {
+    IndexList* list = SetUp(0);
+    int successes = 0, failures = 0;
+
+    for (int32_t i = 0; i < 10; ++i) indexListPushBack(list, i);
+    indexListSave(list, INDEXLIST_TEST_FILE);
+
+    // flip one byte of node data
+    FILE* fp = fopen(INDEXLIST_TEST_FILE, "r+b");
+    if (fp != NULL) {
+        fseek(fp, (long)sizeof(IndexListFileHeader) + 4, SEEK_SET);
+        fputc(0x7F, fp);
+        fclose(fp);
+    }
+
+    if (indexListLoad(INDEXLIST_TEST_FILE) != NULL) {
+        printf("FAILED: testIndexListLoadCorrupt: loaded a file with a bad checksum\n");
+        failures++;
+    }
+    else successes++;
+
+    // a header field changed after saving, as the checksum now covers it
+    indexListSave(list, INDEXLIST_TEST_FILE);
+    fp = fopen(INDEXLIST_TEST_FILE, "r+b");
+    if (fp != NULL) {
+        uint32_t head = 100000;
+        fseek(fp, (long)offsetof(IndexListFileHeader, head), SEEK_SET);
+        fwrite(&head, sizeof(head), 1, fp);
+        fclose(fp);
+    }
+    if (indexListLoad(INDEXLIST_TEST_FILE) != NULL) {
+        printf("FAILED: testIndexListLoadCorrupt: loaded a file with a changed head\n");
+        failures++;
+    }
+    else successes++;
+
+    // bad links saved with a valid checksum: out of range, a broken prev, a
+    // cycle in the free list
+    indexListPopFront(list);
+    indexListPopFront(list);
+    uint32_t* links[] = { &list->head, &list->nodes[5].next, &list->nodes[7].prev, &list->nodes[0].next };
+    uint32_t values[] = { 100000, 100000, 2, 1 };
+    for (size_t i = 0; i < sizeof(links) / sizeof(links[0]); ++i) {
+        uint32_t saved = *links[i];
+        *links[i] = values[i];
+        indexListSave(list, INDEXLIST_TEST_FILE);
+        *links[i] = saved;
+        IndexList* loaded = indexListLoad(INDEXLIST_TEST_FILE);
+        if (loaded != NULL) {
+            printf("FAILED: testIndexListLoadCorrupt: loaded a file with bad link %zu\n", i);
+            indexListDestroy(loaded);
+            failures++;
+        }
+        else successes++;
+    }
+
+    indexListSave(list, INDEXLIST_TEST_FILE);
+    IndexList* loaded = indexListLoad(INDEXLIST_TEST_FILE);
+    if (loaded == NULL || !__indexListIsSequence(loaded, 2)) {
+        printf("FAILED: testIndexListLoadCorrupt: rejected a valid list with a free list\n");
+        failures++;
+    }
+    else successes++;
+    indexListDestroy(loaded);
+
+    if (indexListLoad("does_not_exist.bin") != NULL) {
+        printf("FAILED: testIndexListLoadCorrupt: loaded a missing file\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("IndexListLoadCorrupt", successes, failures);
+    TearDown(list);
+}
+
+#endif /* INDEXLISTTEST_H */
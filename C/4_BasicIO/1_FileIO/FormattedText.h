@@ -90,7 +90,7 @@ void parseServerInfo(FILE* file, ServerInfo* servers, int* serverIndex, char* fi
 {
     char line[FORMATTED_H_MAX_LINE_LENGTH];
     char prevLine[FORMATTED_H_MAX_LINE_LENGTH];
-    strncpy(line, firstLine, FORMATTED_H_MAX_LINE_LENGTH);
+    snprintf(line, FORMATTED_H_MAX_LINE_LENGTH, "%s", firstLine);
     bool isFirstLine = true;
 
     while (true)
@@ -100,8 +100,8 @@ void parseServerInfo(FILE* file, ServerInfo* servers, int* serverIndex, char* fi
         // New section, make sure prevLine has its contents
         if (!isFirstLine && (strncmp(line, "---", 3) == 0))
         {
-            strncpy(prevLine, line, FORMATTED_H_MAX_LINE_LENGTH);
-            strncpy(line, prevLine, FORMATTED_H_MAX_LINE_LENGTH);
+            snprintf(prevLine, FORMATTED_H_MAX_LINE_LENGTH, "%s", line);
+            snprintf(line, FORMATTED_H_MAX_LINE_LENGTH, "%s", prevLine);
             return;
         }
         if (strstr(line, "[ServerID]"))
@@ -146,12 +146,12 @@ void parseEventLogs(FILE* file, EventLog* events, int* eventIndex, char* firstLi
 {
     char line[FORMATTED_H_MAX_LINE_LENGTH];
     char prevLine[FORMATTED_H_MAX_LINE_LENGTH];
-    strncpy(line, firstLine, FORMATTED_H_MAX_LINE_LENGTH);
+    snprintf(line, FORMATTED_H_MAX_LINE_LENGTH, "%s", firstLine);
     bool isFirstLine = true;
 
     if (!isFirstLine && (strncmp(line, "---", 3) == 0)) {
-        strncpy(prevLine, line, FORMATTED_H_MAX_LINE_LENGTH);
-        strncpy(line, prevLine, FORMATTED_H_MAX_LINE_LENGTH);
+        snprintf(prevLine, FORMATTED_H_MAX_LINE_LENGTH, "%s", line);
+        snprintf(line, FORMATTED_H_MAX_LINE_LENGTH, "%s", prevLine);
         return;
     }
 
@@ -200,7 +200,7 @@ void parseEventLogs(FILE* file, EventLog* events, int* eventIndex, char* firstLi
 void parseErrorDetails(FILE* file, ErrorDetail* errors, int* errorIndex, char* firstLine)
 {
     char line[FORMATTED_H_MAX_LINE_LENGTH];
-    strncpy(line, firstLine, FORMATTED_H_MAX_LINE_LENGTH);
+    snprintf(line, FORMATTED_H_MAX_LINE_LENGTH, "%s", firstLine);
     bool isFirstLine = true;
 
     // Keep this logic in case we expand formatted.txt later
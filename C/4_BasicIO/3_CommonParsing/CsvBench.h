@@ -0,0 +1,364 @@
+#ifndef CSVBENCH_H
+#define CSVBENCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <stdatomic.h>
+
+#include "CsvParser.h"
+#include "CsvNumbers.h"
+#include "CsvTable.h"
+#include "CsvWriter.h"
+#include "util.h"
+
+/******************************************************************************
+* CsvBench.h
+*
+* Throughput of the CSV parsers over a generated file of CSV_BENCH_ROWS rows
+* shaped like __common/data.csv (names, ids, numbers, some quoted fields with
+* escaped quotes), batches, projection and filtering, typed loading, column
+* changes, writing, binary caches and number parsing, then parseCsvFileParallel scaling from 1
+* thread to one per CPU over CSV_BENCH_PARALLEL_MB of the same rows.
+*
+******************************************************************************/
+
+#define CSV_BENCH_ROWS 500000UL
+#define CSV_BENCH_PATH "/tmp/CsvBench.csv"
+#define CSV_BENCH_OUTPUT_PATH "/tmp/CsvBenchOutput.csv"
+#define CSV_BENCH_CACHE_PATH "/tmp/CsvBench.csv.cache"
+#ifndef CSV_BENCH_PARALLEL_MB
+#define CSV_BENCH_PARALLEL_MB 2048UL
+#endif
+
+// Touch every byte so the handlers cannot be optimized away
+static void __csvBenchRow(size_t rowIndex, const char** columns, size_t columnCount, void* userData)
+{
+    size_t* checksum = userData;
+    for (size_t i = 0; i < columnCount; ++i) *checksum += strlen(columns[i]);
+}
+
+static void __csvBenchFields(size_t rowIndex, const CsvField* fields, size_t fieldCount, void* userData)
+{
+    size_t* checksum = userData;
+    for (size_t i = 0; i < fieldCount; ++i) *checksum += fields[i].length;
+}
+
+static void __csvBenchFieldsShared(size_t rowIndex, const CsvField* fields, size_t fieldCount, void* userData)
+{
+    size_t length = 0;
+    for (size_t i = 0; i < fieldCount; ++i) length += fields[i].length;
+    atomic_fetch_add_explicit((atomic_size_t*)userData, length, memory_order_relaxed);
+}
+
+static void __csvBenchBatch(const CsvBatch* batch, void* userData)
+{
+    size_t* checksum = userData;
+    size_t fieldCount = batch->rowStarts[batch->rowCount];
+    *checksum += batch->fieldOffsets[fieldCount] - fieldCount;
+}
+
+// What every consumer of char* rows does today: convert the numeric columns
+static void __csvBenchConvertRow(size_t rowIndex, const char** columns, size_t columnCount, void* userData)
+{
+    if (rowIndex == 0 || columnCount < 8) return;
+    double* sum = userData;
+    *sum += atoi(columns[4]) + strtod(columns[5], NULL) + atoi(columns[7]);
+}
+
+// NULL-terminated char* rows, the layout addCsvColumn/dropCsvColumn work on
+typedef struct {
+    char*** rows;
+    size_t count;
+} CsvBenchRows;
+
+static void __csvBenchKeepRow(size_t rowIndex, const char** columns, size_t columnCount, void* userData)
+{
+    CsvBenchRows* rows = userData;
+    char** row = malloc((columnCount + 1) * sizeof(char*));
+    if (!row) return;
+    for (size_t i = 0; i < columnCount; ++i) row[i] = strdup(columns[i]);
+    row[columnCount] = NULL;
+    rows->rows[rows->count++] = row;
+}
+
+// Writes the benchmark file; returns its size in bytes
+static size_t __csvBenchWriteFile()
+{
+    FILE* file = fopen(CSV_BENCH_PATH, "w");
+    if (!file) return 0;
+
+    fprintf(file, "First Name,Last Name,ID,Sex,Age,BMI,Height,Weight,Notes\n");
+    unsigned long state = 11;
+    for (unsigned long i = 0; i < CSV_BENCH_ROWS; ++i)
+    {
+        state = state * 6364136223846793005UL + 1442695040888963407UL;
+        unsigned long r = state >> 33;
+        fprintf(file, "Name%lu,Surname%lu,MBPL%04luCD,%c,%lu,%lu.%lu,\"%lu'%lu\"\"\",%lu,%s\n",
+                r % 5000, (r >> 7) % 9000, r % 10000, (r & 1) ? 'M' : 'F', 18 + r % 70,
+                15 + r % 25, r % 10, 4 + r % 3, r % 12, 90 + r % 200,
+                (r % 4 == 0) ? "\"quoted, with delimiter\"" : "plain note");
+    }
+
+    size_t size = (size_t)ftell(file);
+    fclose(file);
+    return size;
+}
+
+void runCsvBenchmarks()
+{
+    size_t size = __csvBenchWriteFile();
+    if (size == 0) return;
+    double megabytes = (double)size / (1024.0 * 1024.0);
+
+    printf("\nCsvParser benchmarks: %lu rows, %.1f MB\n", CSV_BENCH_ROWS, megabytes);
+    printf("==============================================================\n");
+
+    CsvParserConfig config =
+    {
+        .delimiter = ',',
+        .quoteChar = '"',
+        .quotedFieldsAllowed = true,
+        .shouldTrimWhitespace = false
+    };
+
+    size_t checksum = 0;
+    config.rowHandler = __csvBenchRow;
+    config.userData = &checksum;
+    double start = benchSeconds();
+    parseCsvFile(CSV_BENCH_PATH, &config);
+    double elapsed = benchSeconds() - start;
+    printf("parseCsvFile (64KB blocks)     %8.3f s  %8.1f MB/s  (%zu)\n", elapsed, megabytes / elapsed, checksum);
+
+    checksum = 0;
+    start = benchSeconds();
+    parseCsvFileMapped(CSV_BENCH_PATH, &config);
+    elapsed = benchSeconds() - start;
+    printf("parseCsvFileMapped, rows       %8.3f s  %8.1f MB/s  (%zu)\n", elapsed, megabytes / elapsed, checksum);
+
+    checksum = 0;
+    config.batchHandler = __csvBenchBatch;
+    start = benchSeconds();
+    parseCsvFileMapped(CSV_BENCH_PATH, &config);
+    elapsed = benchSeconds() - start;
+    printf("parseCsvFileMapped, batches    %8.3f s  %8.1f MB/s  (%zu)\n", elapsed, megabytes / elapsed, checksum);
+    config.batchHandler = NULL;
+
+    const CsvScanMode modes[] = { CSV_SCAN_SCALAR, CSV_SCAN_SSE2, CSV_SCAN_AVX2 };
+    const char* modeNames[] = { "scalar", "sse2", "avx2" };
+    config.fieldHandler = __csvBenchFields;
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); ++m)
+    {
+        checksum = 0;
+        config.scanMode = modes[m];
+        start = benchSeconds();
+        parseCsvFileMapped(CSV_BENCH_PATH, &config);
+        elapsed = benchSeconds() - start;
+        printf("parseCsvFileMapped, fields %-6s %6.3f s  %8.1f MB/s  (%zu)\n", modeNames[m], elapsed,
+               megabytes / elapsed, checksum);
+    }
+
+    // only Age and BMI of patients over 60, vs every column of every row
+    const CsvPredicate over60 = { .column = 4, .op = CSV_OP_GT, .numeric = true, .number = 60 };
+    CsvParserConfig filterConfig = config;
+    filterConfig.fieldHandler = NULL;
+    filterConfig.rowHandler = __csvBenchRow;
+    filterConfig.projectionMask = (1ULL << 4) | (1ULL << 5);
+    filterConfig.predicates = &over60;
+    filterConfig.predicateCount = 1;
+    checksum = 0;
+    start = benchSeconds();
+    parseCsvFile(CSV_BENCH_PATH, &filterConfig);
+    elapsed = benchSeconds() - start;
+    printf("parseCsvFile, Age > 60, 2 cols %8.3f s  %8.1f MB/s  (%zu)\n", elapsed, megabytes / elapsed, checksum);
+
+    // typed columns vs char* rows converted by the consumer
+    double sum = 0;
+    CsvParserConfig rowConfig = config;
+    rowConfig.fieldHandler = NULL;
+    rowConfig.rowHandler = __csvBenchConvertRow;
+    rowConfig.userData = &sum;
+    start = benchSeconds();
+    parseCsvFile(CSV_BENCH_PATH, &rowConfig);
+    elapsed = benchSeconds() - start;
+    printf("parseCsvFile + atoi/strtod      %6.3f s  %8.1f MB/s  (%.1f)\n", elapsed, megabytes / elapsed, sum);
+
+    start = benchSeconds();
+    CsvTable* table = csvTableLoad(CSV_BENCH_PATH, &config, NULL, 0, true);
+    elapsed = benchSeconds() - start;
+    sum = 0;
+    for (size_t r = 0; table && r < table->rowCount; ++r)
+    {
+        sum += table->columns[4].values.int32s[r] + table->columns[5].values.doubles[r] + table->columns[7].values.int32s[r];
+    }
+    printf("csvTableLoad (inferred)         %6.3f s  %8.1f MB/s  (%.1f)\n", elapsed, megabytes / elapsed, sum);
+
+    // adding and dropping a column: columns vs char* rows
+    start = benchSeconds();
+    if (table && csvTableAddColumn(table, "Flag", CSV_COLUMN_INT32, "1") == CSV_SUCCESS)
+    {
+        csvTableDropColumn(table, 0);
+    }
+    elapsed = benchSeconds() - start;
+    printf("csvTableAddColumn + DropColumn  %9.6f s\n", elapsed);
+
+    // writing it back out: fprintf per field vs CsvWriter
+    FILE* output = fopen(CSV_BENCH_OUTPUT_PATH, "w");
+    start = benchSeconds();
+    for (size_t r = 0; table && output && r < table->rowCount; ++r)
+    {
+        for (size_t c = 0; c < table->columnCount; ++c)
+        {
+            const CsvColumn* column = &table->columns[c];
+            const char* separator = (c + 1 < table->columnCount) ? "," : "\n";
+            if (column->type == CSV_COLUMN_INT32) fprintf(output, "%d%s", column->values.int32s[r], separator);
+            else if (column->type == CSV_COLUMN_DOUBLE) fprintf(output, "%.17g%s", column->values.doubles[r], separator);
+            else fprintf(output, "\"%s\"%s", csvTableString(table, column->values.stringIds[r]), separator);
+        }
+    }
+    if (output) fclose(output);
+    elapsed = benchSeconds() - start;
+    printf("fprintf per field               %6.3f s  %8.1f MB/s\n", elapsed, megabytes / elapsed);
+
+    start = benchSeconds();
+    if (table) csvTableSave(table, CSV_BENCH_OUTPUT_PATH, &config, true);
+    elapsed = benchSeconds() - start;
+    printf("csvTableSave                    %6.3f s  %8.1f MB/s\n", elapsed, megabytes / elapsed);
+    csvTableDestroy(table);
+
+    // fields only, as a pipeline copying text columns would write them
+    const char* copied[] = { "Name1234", "Surname5678", "MBPL0042CD", "M", "5'2\"", "plain note" };
+    CsvWriter* writer = csvWriterOpen(CSV_BENCH_OUTPUT_PATH, &config);
+    start = benchSeconds();
+    for (size_t r = 0; writer && r < CSV_BENCH_ROWS * 4; ++r) csvWriterRow(writer, copied, 6);
+    size_t written = csvWriterByteCount(writer);
+    csvWriterClose(writer);
+    elapsed = benchSeconds() - start;
+    printf("csvWriterRow, text only         %6.3f s  %8.1f MB/s\n", elapsed, written / (1024.0 * 1024.0) / elapsed);
+    unlink(CSV_BENCH_OUTPUT_PATH);
+
+    // reloading through a binary cache: parse and write it, then map it
+    unlink(CSV_BENCH_CACHE_PATH);
+    start = benchSeconds();
+    table = csvTableLoadCached(CSV_BENCH_PATH, CSV_BENCH_CACHE_PATH, &config, NULL, 0, true);
+    elapsed = benchSeconds() - start;
+    printf("csvTableLoadCached, building    %6.3f s  %8.1f MB/s\n", elapsed, megabytes / elapsed);
+    csvTableDestroy(table);
+
+    start = benchSeconds();
+    table = csvTableLoadCached(CSV_BENCH_PATH, CSV_BENCH_CACHE_PATH, &config, NULL, 0, true);
+    elapsed = benchSeconds() - start;
+    printf("csvTableLoadCached, verified    %9.6f s  (%s)\n", elapsed, (table && table->mapping) ? "mapped" : "parsed");
+    csvTableDestroy(table);
+
+    start = benchSeconds();
+    table = csvTableOpenCache(CSV_BENCH_CACHE_PATH, CSV_BENCH_PATH, false);
+    elapsed = benchSeconds() - start;
+    printf("csvTableOpenCache, unverified   %9.6f s  (%zu rows)\n", elapsed, table ? table->rowCount : 0);
+    csvTableDestroy(table);
+    unlink(CSV_BENCH_CACHE_PATH);
+
+    CsvBenchRows kept = { malloc((CSV_BENCH_ROWS + 1) * sizeof(char**)), 0 };
+    rowConfig.rowHandler = __csvBenchKeepRow;
+    rowConfig.userData = &kept;
+    if (kept.rows && parseCsvFile(CSV_BENCH_PATH, &rowConfig))
+    {
+        start = benchSeconds();
+        addCsvColumn(kept.rows, kept.count, "1");
+        dropCsvColumn(kept.rows, kept.count, 0);
+        elapsed = benchSeconds() - start;
+        printf("addCsvColumn + dropCsvColumn    %9.6f s\n", elapsed);
+    }
+    for (size_t r = 0; kept.rows && r < kept.count; ++r)
+    {
+        for (size_t c = 0; kept.rows[r][c]; ++c) free(kept.rows[r][c]);
+        free(kept.rows[r]);
+    }
+    free(kept.rows);
+
+    // number parsing alone
+    const size_t numberCount = 2000000;
+    char (*numbers)[24] = malloc(numberCount * sizeof(*numbers));
+    unsigned long state = 13;
+    for (size_t i = 0; numbers && i < numberCount; ++i)
+    {
+        state = state * 6364136223846793005UL + 1442695040888963407UL;
+        snprintf(numbers[i], sizeof(numbers[i]), "%.*g", 3 + (int)(state % 15), (double)(state >> 11) / (1UL << (state % 60)));
+    }
+    double parsedSum = 0;
+    start = benchSeconds();
+    for (size_t i = 0; numbers && i < numberCount; ++i) parsedSum += strtod(numbers[i], NULL);
+    elapsed = benchSeconds() - start;
+    printf("strtod            %8.1f ns/number  (%g)\n", elapsed * 1e9 / numberCount, parsedSum);
+    parsedSum = 0;
+    start = benchSeconds();
+    for (size_t i = 0; numbers && i < numberCount; ++i)
+    {
+        double value = 0;
+        csvParseDouble(numbers[i], strlen(numbers[i]), &value);
+        parsedSum += value;
+    }
+    elapsed = benchSeconds() - start;
+    printf("csvParseDouble    %8.1f ns/number  (%g)\n", elapsed * 1e9 / numberCount, parsedSum);
+    free(numbers);
+
+    // grow the file to CSV_BENCH_PARALLEL_MB by repeating its rows
+    FILE* file = fopen(CSV_BENCH_PATH, "a");
+    char* rows = malloc(size);
+    FILE* source = fopen(CSV_BENCH_PATH, "r");
+    if (!file || !rows || !source || fread(rows, 1, size, source) != size)
+    {
+        fprintf(stderr, "CsvBench: unable to grow %s\n", CSV_BENCH_PATH);
+        if (file) fclose(file);
+        if (source) fclose(source);
+        free(rows);
+        unlink(CSV_BENCH_PATH);
+        return;
+    }
+    fclose(source);
+    const char* body = (const char*)memchr(rows, '\n', size) + 1;  // without the header
+    size_t bodySize = size - (body - rows);
+    size_t total = size;
+    while (total + bodySize <= CSV_BENCH_PARALLEL_MB * 1024 * 1024)
+    {
+        fwrite(body, 1, bodySize, file);
+        total += bodySize;
+    }
+    fclose(file);
+    free(rows);
+    megabytes = (double)total / (1024.0 * 1024.0);
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t maxThreads = (cpus > 4) ? (size_t)cpus : 4;
+    printf("\nparseCsvFileParallel: %.0f MB, %ld CPUs\n", megabytes, cpus);
+    printf("==============================================================\n");
+    config.scanMode = CSV_SCAN_AUTO;
+    parseCsvFileMapped(CSV_BENCH_PATH, &config);  // warm the page cache
+
+    const CsvDeliveryOrder orders[] = { CSV_DELIVER_ORDERED, CSV_DELIVER_UNORDERED };
+    double baseline = 0;
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        for (size_t o = 0; o < 2; ++o)
+        {
+            // unordered handlers run concurrently; give each call its own counter
+            atomic_size_t shared;
+            atomic_init(&shared, 0);
+            checksum = 0;
+            config.fieldHandler = (orders[o] == CSV_DELIVER_ORDERED) ? __csvBenchFields : __csvBenchFieldsShared;
+            config.userData = (orders[o] == CSV_DELIVER_ORDERED) ? (void*)&checksum : (void*)&shared;
+            start = benchSeconds();
+            parseCsvFileParallel(CSV_BENCH_PATH, &config, threads, orders[o]);
+            elapsed = benchSeconds() - start;
+            if (threads == 1 && o == 0) baseline = elapsed;
+            printf("%2zu threads %-9s %8.3f s  %8.1f MB/s  x%.2f  (%zu)\n", threads,
+                   (orders[o] == CSV_DELIVER_ORDERED) ? "ordered" : "unordered", elapsed, megabytes / elapsed,
+                   baseline / elapsed, (orders[o] == CSV_DELIVER_ORDERED) ? checksum : atomic_load(&shared));
+        }
+    }
+
+    unlink(CSV_BENCH_PATH);
+}
+
+#endif /* CSVBENCH_H */
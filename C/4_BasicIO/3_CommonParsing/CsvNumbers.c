@@ -0,0 +1,315 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "CsvNumbers.h"
+#include "CsvPow5Table.h"
+
+// Significant digits that fit a uint64_t without overflow
+#define CSV_MAX_DIGITS 19
+
+// Exactly representable powers of ten for Clinger's fast path
+static const double __csvExactPowersOfTen[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+__extension__ typedef unsigned __int128 CsvUint128;
+
+// "00" to "99", for formatting two digits at a time
+static const char __csvDigitPairs[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// Parse an int32, rejecting overflow as soon as it happens
+bool csvParseInt32(const char* text, size_t length, int32_t* out)
+{
+    size_t i = 0;
+    bool negative = false;
+    if (length > 0 && (text[0] == '-' || text[0] == '+'))
+    {
+        negative = (text[0] == '-');
+        i = 1;
+    }
+    if (i == length) return false;
+
+    uint64_t value = 0;
+    for (; i < length; ++i)
+    {
+        unsigned digit = (unsigned char)text[i] - '0';
+        if (digit > 9) return false;
+        value = value * 10 + digit;
+        if (value > (uint64_t)INT32_MAX + 1) return false;
+    }
+    if (!negative && value > INT32_MAX) return false;
+
+    *out = negative ? (int32_t)(-(int64_t)value) : (int32_t)value;
+    return true;
+}
+
+// Internal helper: strtod on a NUL-terminated copy of the slice
+static bool __csvParseDoubleSlow(const char* text, size_t length, double* out)
+{
+    char local[64];
+    char* copy = (length < sizeof(local)) ? local : malloc(length + 1);
+    if (!copy) return false;
+    memcpy(copy, text, length);
+    copy[length] = '\0';
+
+    char* end;
+    *out = strtod(copy, &end);
+    bool parsed = (end == copy + length);
+    if (copy != local) free(copy);
+    return parsed;
+}
+
+// Internal helper: Eisel-Lemire. Computes the double nearest w * 10^q from
+// a 128-bit approximation of 5^q; false when the approximation cannot decide
+// the rounding, which the caller leaves to strtod. w must be non-zero.
+static bool __csvEiselLemire(uint64_t w, int64_t q, uint64_t* bits)
+{
+    if (q < CSV_POW5_MIN)
+    {
+        *bits = 0;
+        return true;
+    }
+    if (q > CSV_POW5_MAX)
+    {
+        *bits = 0x7FFULL << 52;
+        return true;
+    }
+
+    int leadingZeros = __builtin_clzll(w);
+    w <<= leadingZeros;
+
+    // w * 5^q, high bits first; the second half of the table only matters
+    // when the low bits of the first product could carry into the mantissa
+    size_t index = 2 * (size_t)(q - CSV_POW5_MIN);
+    CsvUint128 product = (CsvUint128)w * __csvPow5Table[index];
+    uint64_t high = (uint64_t)(product >> 64), low = (uint64_t)product;
+    const uint64_t precisionMask = 0xFFFFFFFFFFFFFFFFULL >> 55;
+    if ((high & precisionMask) == precisionMask)
+    {
+        CsvUint128 second = (CsvUint128)w * __csvPow5Table[index + 1];
+        uint64_t secondHigh = (uint64_t)(second >> 64);
+        low += secondHigh;
+        if (secondHigh > low) high++;
+        if (low == 0xFFFFFFFFFFFFFFFFULL && (q < -27 || q > 55)) return false;
+    }
+
+    int upperBit = (int)(high >> 63);
+    int shift = upperBit + 64 - 52 - 3;
+    uint64_t mantissa = high >> shift;
+    // floor(log2(10^q)) + 63, then the binary exponent with the double bias
+    int64_t power2 = ((((152170 + 65536) * q) >> 16) + 63) + upperBit - leadingZeros + 1023;
+
+    if (power2 <= 0)
+    {
+        // subnormal, or zero
+        if (-power2 + 1 >= 64)
+        {
+            *bits = 0;
+            return true;
+        }
+        mantissa >>= -power2 + 1;
+        mantissa += (mantissa & 1);
+        mantissa >>= 1;
+        power2 = (mantissa < (1ULL << 52)) ? 0 : 1;
+        *bits = mantissa | ((uint64_t)power2 << 52);
+        return true;
+    }
+
+    // exactly halfway between two doubles: round to even
+    if (low <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << shift) == high)
+    {
+        mantissa &= ~1ULL;
+    }
+    mantissa += (mantissa & 1);
+    mantissa >>= 1;
+    if (mantissa >= (2ULL << 52))
+    {
+        mantissa = 1ULL << 52;
+        power2++;
+    }
+    mantissa &= ~(1ULL << 52);
+    if (power2 >= 0x7FF)
+    {
+        power2 = 0x7FF;
+        mantissa = 0;
+    }
+
+    *bits = mantissa | ((uint64_t)power2 << 52);
+    return true;
+}
+
+// Parse a double: decimal significand w and exponent q, then w * 10^q
+bool csvParseDouble(const char* text, size_t length, double* out)
+{
+    const char* p = text;
+    const char* end = text + length;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+        negative = (*p == '-');
+        p++;
+    }
+
+    // digits overflow w past 19 of them; those numbers go to strtod below
+    uint64_t w = 0;
+    const char* integerStart = p;
+    while (p < end && (unsigned)(*p - '0') <= 9) w = w * 10 + (uint64_t)(*p++ - '0');
+    size_t digitCount = p - integerStart;
+    int64_t q = 0;
+    if (p < end && *p == '.')
+    {
+        const char* fractionStart = ++p;
+        while (p < end && (unsigned)(*p - '0') <= 9) w = w * 10 + (uint64_t)(*p++ - '0');
+        q = -(int64_t)(p - fractionStart);
+        digitCount += p - fractionStart;
+    }
+    if (digitCount == 0) return false;
+
+    if (p < end && (*p == 'e' || *p == 'E'))
+    {
+        p++;
+        bool negativeExponent = false;
+        if (p < end && (*p == '-' || *p == '+'))
+        {
+            negativeExponent = (*p == '-');
+            p++;
+        }
+        if (p == end) return false;
+        int64_t exponent = 0;
+        while (p < end && (unsigned)(*p - '0') <= 9)
+        {
+            if (exponent < 100000) exponent = exponent * 10 + (*p - '0');
+            p++;
+        }
+        q += negativeExponent ? -exponent : exponent;
+    }
+    if (p != end) return false;
+
+    if (digitCount > CSV_MAX_DIGITS)
+    {
+        // leading zeros are not significant
+        size_t significant = digitCount;
+        for (const char* z = integerStart; z < end && (*z == '0' || *z == '.'); ++z) significant -= (*z == '0');
+        if (significant > CSV_MAX_DIGITS) return __csvParseDoubleSlow(text, length, out);
+    }
+
+    if (w == 0)
+    {
+        *out = negative ? -0.0 : 0.0;
+        return true;
+    }
+
+    // Clinger: w and 10^|q| are exact doubles, so one rounding is correct
+    if (q >= -22 && q <= 22 && w <= (1ULL << 53))
+    {
+        double value = (double)w;
+        value = (q < 0) ? value / __csvExactPowersOfTen[-q] : value * __csvExactPowersOfTen[q];
+        *out = negative ? -value : value;
+        return true;
+    }
+
+    uint64_t bits;
+    if (!__csvEiselLemire(w, q, &bits)) return __csvParseDoubleSlow(text, length, out);
+    if (negative) bits |= 1ULL << 63;
+    memcpy(out, &bits, sizeof(double));
+    return true;
+}
+
+// Internal helper: decimal digits of value at out, returns their count
+static size_t __csvFormatUint64(uint64_t value, char* out)
+{
+    char digits[20];
+    size_t at = sizeof(digits);
+    while (value >= 100)
+    {
+        memcpy(digits + (at -= 2), __csvDigitPairs + (value % 100) * 2, 2);
+        value /= 100;
+    }
+    if (value >= 10) memcpy(digits + (at -= 2), __csvDigitPairs + value * 2, 2);
+    else digits[--at] = (char)('0' + value);
+
+    memcpy(out, digits + at, sizeof(digits) - at);
+    return sizeof(digits) - at;
+}
+
+// Format an int64, two digits per division
+size_t csvFormatInt64(int64_t value, char* out)
+{
+    if (value >= 0) return __csvFormatUint64((uint64_t)value, out);
+    out[0] = '-';
+    return 1 + __csvFormatUint64(-(uint64_t)value, out + 1);
+}
+
+// Format a double: fixed notation if few decimals read back exactly, else %g
+size_t csvFormatDouble(double value, char* out)
+{
+    if (isnan(value)) return 0;
+    size_t length = 0;
+    if (signbit(value)) out[length++] = '-';
+    double magnitude = fabs(value);
+    if (isinf(magnitude))
+    {
+        memcpy(out + length, "inf", 3);
+        return length + 3;
+    }
+
+    // digits / 10^decimals is one correctly rounded division, exactly what a
+    // parser computes for that string; the first match is the shortest
+    const double limit = 9007199254740992.0;  // 2^53
+    for (int decimals = 0; decimals <= 17 && magnitude * __csvExactPowersOfTen[decimals] < limit; ++decimals)
+    {
+        uint64_t digits = (uint64_t)(magnitude * __csvExactPowersOfTen[decimals] + 0.5);
+        if ((double)digits / __csvExactPowersOfTen[decimals] != magnitude) continue;
+
+        char text[20];
+        size_t count = __csvFormatUint64(digits, text);
+        if (decimals == 0)
+        {
+            memcpy(out + length, text, count);
+            return length + count;
+        }
+        // 0.00ddd when there are fewer digits than decimals
+        if (count <= (size_t)decimals)
+        {
+            out[length++] = '0';
+            out[length++] = '.';
+            memset(out + length, '0', decimals - count);
+            length += decimals - count;
+            memcpy(out + length, text, count);
+            return length + count;
+        }
+        memcpy(out + length, text, count - decimals);
+        length += count - decimals;
+        out[length++] = '.';
+        memcpy(out + length, text + count - decimals, decimals);
+        return length + decimals;
+    }
+
+    // integers past 2^53 print exactly; below 1e17 that beats the exponent form
+    if (magnitude < 1e17 && magnitude == floor(magnitude))
+    {
+        return length + __csvFormatUint64((uint64_t)magnitude, out + length);
+    }
+
+    for (int precision = 15; precision <= 17; ++precision)
+    {
+        char text[CSV_NUMBER_TEXT_MAX];
+        int count = snprintf(text, sizeof(text), "%.*g", precision, magnitude);
+        double parsed;
+        if (precision == 17 || (csvParseDouble(text, (size_t)count, &parsed) && parsed == magnitude))
+        {
+            memcpy(out + length, text, count);
+            return length + count;
+        }
+    }
+    return length;
+}
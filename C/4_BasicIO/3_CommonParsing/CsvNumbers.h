@@ -0,0 +1,34 @@
+#ifndef CSVNUMBERS_H
+#define CSVNUMBERS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Number parsing straight from field slices (not NUL-terminated). Both
+// parsers accept the whole slice or nothing: no surrounding whitespace, no
+// trailing characters.
+
+// Optional sign and decimal digits; false on anything else or overflow
+bool csvParseInt32(const char* text, size_t length, int32_t* out);
+
+// Optional sign, digits with an optional '.', optional e/E exponent. The
+// result is the correctly rounded double, bit for bit what strtod returns:
+// Clinger's fast path for small exponents, Eisel-Lemire otherwise, and
+// strtod itself for more than 19 significant digits.
+bool csvParseDouble(const char* text, size_t length, double* out);
+
+// Number formatting for CsvWriter: out needs CSV_NUMBER_TEXT_MAX bytes and is
+// not NUL-terminated; both return the length written.
+#define CSV_NUMBER_TEXT_MAX 32
+
+size_t csvFormatInt64(int64_t value, char* out);
+
+// A short decimal that reads back as exactly value: the fewest decimals in
+// fixed notation when that works below 2^53, whole numbers below 1e17 as
+// integers, else the first of %.15g, %.16g and %.17g that round-trips. NaN
+// is empty; infinities are "inf"/"-inf", which strtod reads but
+// csvParseDouble does not.
+size_t csvFormatDouble(double value, char* out);
+
+#endif /* CSVNUMBERS_H */
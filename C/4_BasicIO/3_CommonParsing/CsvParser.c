@@ -2,8 +2,32 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
 #include "CsvParser.h"
+#include "CsvNumbers.h"
+
+// Bytes indexed per pass of the structural scanner
+#define CSV_SCAN_WINDOW (64 * 1024)
+
+// Bytes read per block by parseCsvStream / parseCsvFile
+#define CSV_STREAM_BLOCK (64 * 1024)
+
+// Chunk size bounds for parseCsvFileParallel, and how many chunks past the
+// last delivered one may be parsed ahead in ordered mode (per thread)
+#define CSV_PARALLEL_MIN_CHUNK (64 * 1024)
+#define CSV_PARALLEL_MAX_CHUNK (4 * 1024 * 1024)
+#define CSV_PARALLEL_AHEAD 2
 
 // Map error code to a message
 const char* csvErrorMessage(CsvErrorCode code) 
@@ -14,6 +38,10 @@ const char* csvErrorMessage(CsvErrorCode code)
         case CSV_ERR_MEMORY_ALLOCATION: return "Memory allocation failed";
         case CSV_ERR_UNBALANCED_QUOTES: return "Unbalanced quotes in field";
         case CSV_ERR_COLUMN_INDEX_OUT_OF_RANGE: return "Column index out of range";
+        case CSV_ERR_FILE_OPEN: return "Unable to open file";
+        case CSV_ERR_FILE_MAP: return "Unable to map file into memory";
+        case CSV_ERR_FILE_WRITE: return "Unable to write file";
+        case CSV_ERR_CORRUPT_CACHE: return "Corrupt cache file";
         default: return "Unknown error";
     }
 }
@@ -57,38 +85,1116 @@ static void __normalizeEscapedQuotes(char *field, char quoteChar)
 }
 
 
-// Parse a CSV file line by line
-bool parseCsvFile(const char* filePath, const CsvParserConfig* config)
+// Rows collected for batchHandler: unescaped text, field offsets into it and
+// row starts into those, all reused across batches
+typedef struct {
+    char* text;
+    size_t length;
+    size_t capacity;
+    size_t* offsets;
+    size_t fieldCount;
+    size_t offsetCapacity;
+    size_t* rowStarts;         // batchSize + 1 entries
+    size_t* rowIndices;
+    size_t rowCount;
+} CsvBatchBuffer;
+
+// Fields of parsed records, reused across records. Unbuffered, it holds the
+// record being assembled; buffered, whole records stay back to back and
+// recordSizes delimits them until they are delivered.
+typedef struct {
+    CsvField* fields;
+    size_t count;
+    size_t capacity;
+    size_t recordStart;        // first field of the record being assembled
+    bool buffered;
+    uint32_t* recordSizes;
+    size_t recordCount;
+    size_t recordCapacity;
+    char* text;                // NUL-terminated copies for rowHandler
+    size_t textCapacity;
+    const char** columns;
+    size_t columnCapacity;
+    CsvField* projected;       // fields kept by the projection mask
+    size_t projectedCapacity;
+    CsvBatchBuffer batch;
+} CsvRecord;
+
+static void __csvRecordFree(CsvRecord* record)
+{
+    free(record->batch.text);
+    free(record->batch.offsets);
+    free(record->batch.rowStarts);
+    free(record->batch.rowIndices);
+    free(record->fields);
+    free(record->recordSizes);
+    free(record->text);
+    free(record->columns);
+    free(record->projected);
+}
+
+// Internal helper: append the field [start, end) to the record, trimming a
+// trailing '\r' if it ends the record, then whitespace and enclosing quotes
+static bool __csvRecordAddField(CsvRecord* record, const char* start, const char* end, bool endsRecord,
+                                const CsvParserConfig* config)
+{
+    if (record->count == record->capacity)
+    {
+        size_t capacity = record->capacity ? record->capacity * 2 : 16;
+        CsvField* grown = realloc(record->fields, capacity * sizeof(CsvField));
+        if (!grown)
+        {
+            fprintf(stderr, "%s: growing record fields\n", csvErrorMessage(CSV_ERR_MEMORY_ALLOCATION));
+            return false;
+        }
+        record->fields = grown;
+        record->capacity = capacity;
+    }
+
+    if (endsRecord && end > start && end[-1] == '\r') end--;
+    if (config->shouldTrimWhitespace)
+    {
+        while (start < end && isspace((unsigned char)*start)) start++;
+        while (end > start && isspace((unsigned char)end[-1])) end--;
+    }
+
+    CsvField* field = &record->fields[record->count++];
+    field->hasEscapedQuotes = false;
+    field->quoted = false;
+    if (config->quotedFieldsAllowed)
+    {
+        if (end - start >= 2 && *start == config->quoteChar && end[-1] == config->quoteChar)
+        {
+            field->quoted = true;
+            start++;
+            end--;
+            field->hasEscapedQuotes = memchr(start, config->quoteChar, end - start) != NULL;
+        }
+    }
+    field->data = start;
+    field->length = end - start;
+    return true;
+}
+
+// Internal helper: room for length bytes of text in scratch
+static bool __csvRecordReserveText(CsvRecord* scratch, size_t length)
+{
+    if (length <= scratch->textCapacity) return true;
+
+    char* grown = realloc(scratch->text, length * 2);
+    if (!grown)
+    {
+        fprintf(stderr, "%s: growing record text\n", csvErrorMessage(CSV_ERR_MEMORY_ALLOCATION));
+        return false;
+    }
+    scratch->text = grown;
+    scratch->textCapacity = length * 2;
+    return true;
+}
+
+// Internal helper: does the record pass the predicate
+static bool __csvPredicateMatches(const CsvPredicate* predicate, CsvRecord* scratch, const CsvField* fields,
+                                  size_t count, const CsvParserConfig* config)
+{
+    if (predicate->column >= count) return false;
+    const CsvField* field = &fields[predicate->column];
+
+    int comparison;
+    if (predicate->numeric)
+    {
+        double value;
+        if (field->hasEscapedQuotes || !csvParseDouble(field->data, field->length, &value)) return false;
+        comparison = (value > predicate->number) - (value < predicate->number);
+    }
+    else
+    {
+        const char* text = field->data;
+        size_t length = field->length;
+        if (field->hasEscapedQuotes)
+        {
+            if (!__csvRecordReserveText(scratch, length + 1)) return false;
+            length = csvFieldCopy(field, config->quoteChar, scratch->text);
+            text = scratch->text;
+        }
+        size_t expectedLength = strlen(predicate->text);
+        comparison = memcmp(text, predicate->text, (length < expectedLength) ? length : expectedLength);
+        if (comparison == 0) comparison = (length > expectedLength) - (length < expectedLength);
+    }
+
+    switch (predicate->op)
+    {
+        case CSV_OP_EQ: return comparison == 0;
+        case CSV_OP_NE: return comparison != 0;
+        case CSV_OP_LT: return comparison < 0;
+        case CSV_OP_LE: return comparison <= 0;
+        case CSV_OP_GT: return comparison > 0;
+        case CSV_OP_GE: return comparison >= 0;
+        default: return false;
+    }
+}
+
+// Internal helper: hand the rows collected in batch to batchHandler
+static void __csvBatchFlush(CsvBatchBuffer* batch, const CsvParserConfig* config)
+{
+    if (batch->rowCount == 0) return;
+
+    batch->offsets[batch->fieldCount] = batch->length;
+    batch->rowStarts[batch->rowCount] = batch->fieldCount;
+    CsvBatch view =
+    {
+        .rowCount = batch->rowCount,
+        .rowIndices = batch->rowIndices,
+        .rowStarts = batch->rowStarts,
+        .fieldOffsets = batch->offsets,
+        .data = batch->text
+    };
+    config->batchHandler(&view, config->userData);
+    batch->length = batch->fieldCount = batch->rowCount = 0;
+}
+
+// Internal helper: copy a row into batch, handing the batch over once full
+static bool __csvBatchAppend(CsvBatchBuffer* batch, const CsvField* fields, size_t count, size_t rowIndex,
+                             const CsvParserConfig* config)
+{
+    size_t batchSize = config->batchSize ? config->batchSize : CSV_DEFAULT_BATCH_ROWS;
+    if (!batch->rowStarts)
+    {
+        batch->rowStarts = malloc((batchSize + 1) * sizeof(size_t));
+        batch->rowIndices = malloc(batchSize * sizeof(size_t));
+        if (!batch->rowStarts || !batch->rowIndices)
+        {
+            fprintf(stderr, "%s: allocating row batch\n", csvErrorMessage(CSV_ERR_MEMORY_ALLOCATION));
+            return false;
+        }
+    }
+
+    size_t textLength = batch->length;
+    for (size_t i = 0; i < count; ++i) textLength += fields[i].length + 1;
+    if (textLength > batch->capacity)
+    {
+        char* grown = realloc(batch->text, textLength * 2);
+        if (!grown)
+        {
+            fprintf(stderr, "%s: growing row batch\n", csvErrorMessage(CSV_ERR_MEMORY_ALLOCATION));
+            return false;
+        }
+        batch->text = grown;
+        batch->capacity = textLength * 2;
+    }
+    // one more offset than fields, closing the last one
+    if (batch->fieldCount + count + 1 > batch->offsetCapacity)
+    {
+        size_t capacity = (batch->fieldCount + count + 1) * 2;
+        size_t* grown = realloc(batch->offsets, capacity * sizeof(size_t));
+        if (!grown)
+        {
+            fprintf(stderr, "%s: growing row batch\n", csvErrorMessage(CSV_ERR_MEMORY_ALLOCATION));
+            return false;
+        }
+        batch->offsets = grown;
+        batch->offsetCapacity = capacity;
+    }
+
+    batch->rowStarts[batch->rowCount] = batch->fieldCount;
+    batch->rowIndices[batch->rowCount++] = rowIndex;
+    for (size_t i = 0; i < count; ++i)
+    {
+        batch->offsets[batch->fieldCount++] = batch->length;
+        batch->length += csvFieldCopy(&fields[i], config->quoteChar, batch->text + batch->length) + 1;
+    }
+
+    if (batch->rowCount == batchSize) __csvBatchFlush(batch, config);
+    return true;
+}
+
+// Internal helper: hand a record's fields to fieldHandler, add them to the
+// scratch batch for batchHandler, or copy them into scratch's NUL-terminated
+// columns for rowHandler. Rows failing a predicate stop here, and only
+// projected fields go further.
+static bool __csvDeliverFields(CsvRecord* scratch, const CsvField* fields, size_t count, size_t rowIndex,
+                               const CsvParserConfig* config)
+{
+    for (size_t p = 0; p < config->predicateCount; ++p)
+    {
+        if (!__csvPredicateMatches(&config->predicates[p], scratch, fields, count, config)) return true;
+    }
+
+    if (config->projectionMask)
+    {
+        if (count > scratch->projectedCapacity)
+        {
+            CsvField* grown = realloc(scratch->projected, count * 2 * sizeof(CsvField));
+            if (!grown)
+            {
+                fprintf(stderr, "%s: growing projected fields\n", csvErrorMessage(CSV_ERR_MEMORY_ALLOCATION));
+                return false;
+            }
+            scratch->projected = grown;
+            scratch->projectedCapacity = count * 2;
+        }
+        size_t kept = 0;
+        for (size_t i = 0; i < count && i < 64; ++i)
+        {
+            if (config->projectionMask & (1ULL << i)) scratch->projected[kept++] = fields[i];
+        }
+        fields = scratch->projected;
+        count = kept;
+    }
+
+    if (config->fieldHandler)
+    {
+        config->fieldHandler(rowIndex, fields, count, config->userData);
+        return true;
+    }
+    if (config->batchHandler) return __csvBatchAppend(&scratch->batch, fields, count, rowIndex, config);
+
+    size_t textLength = 0;
+    for (size_t i = 0; i < count; ++i) textLength += fields[i].length + 1;
+    if (!__csvRecordReserveText(scratch, textLength)) return false;
+    if (count > scratch->columnCapacity)
+    {
+        const char** grown = realloc(scratch->columns, count * 2 * sizeof(char*));
+        if (!grown)
+        {
+            fprintf(stderr, "%s: growing record columns\n", csvErrorMessage(CSV_ERR_MEMORY_ALLOCATION));
+            return false;
+        }
+        scratch->columns = grown;
+        scratch->columnCapacity = count * 2;
+    }
+
+    char* out = scratch->text;
+    for (size_t i = 0; i < count; ++i)
+    {
+        scratch->columns[i] = out;
+        out += csvFieldCopy(&fields[i], config->quoteChar, out) + 1;
+    }
+    config->rowHandler(rowIndex, scratch->columns, count, config->userData);
+    return true;
+}
+
+// Internal helper: the current record is complete; deliver it, or keep it
+// for later if the record buffers
+static bool __csvRecordEnd(CsvRecord* record, size_t rowIndex, const CsvParserConfig* config)
+{
+    if (!record->buffered)
+    {
+        bool delivered = __csvDeliverFields(record, record->fields, record->count, rowIndex, config);
+        record->count = 0;
+        return delivered;
+    }
+
+    if (record->recordCount == record->recordCapacity)
+    {
+        size_t capacity = record->recordCapacity ? record->recordCapacity * 2 : 256;
+        uint32_t* grown = realloc(record->recordSizes, capacity * sizeof(uint32_t));
+        if (!grown)
+        {
+            fprintf(stderr, "%s: growing record buffer\n", csvErrorMessage(CSV_ERR_MEMORY_ALLOCATION));
+            return false;
+        }
+        record->recordSizes = grown;
+        record->recordCapacity = capacity;
+    }
+    record->recordSizes[record->recordCount++] = (uint32_t)(record->count - record->recordStart);
+    record->recordStart = record->count;
+    return true;
+}
+
+// Internal helper: config is non-NULL, has somewhere to deliver rows, and
+// every predicate it lists exists and has text if it compares text
+static bool __csvConfigIsUsable(const CsvParserConfig* config)
+{
+    if (!config || !(config->fieldHandler || config->batchHandler || config->rowHandler)) return false;
+    if (config->predicateCount > 0 && !config->predicates) return false;
+    for (size_t p = 0; p < config->predicateCount; ++p)
+    {
+        if (!config->predicates[p].numeric && !config->predicates[p].text) return false;
+    }
+    return true;
+}
+
+// Internal helper: positions of the delimiters and newlines in
+// data[0, length) that are outside quotes; *inQuotes carries the quote state
+// from one window to the next. A quote anywhere toggles the state, so an
+// escaped quote ("") toggles it twice.
+static size_t __csvIndexScalar(const char* data, size_t length, const CsvParserConfig* config,
+                               bool* inQuotes, uint32_t* positions)
+{
+    size_t count = 0;
+    bool quoted = *inQuotes;
+    char quoteChar = config->quotedFieldsAllowed ? config->quoteChar : '\0';
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        char c = data[i];
+        if (c == quoteChar && quoteChar != '\0') quoted = !quoted;
+        else if (!quoted && (c == config->delimiter || c == '\n')) positions[count++] = (uint32_t)i;
+    }
+
+    *inQuotes = quoted;
+    return count;
+}
+
+// Structural scanner signature; see __csvIndexScalar
+typedef size_t (*CsvIndexer)(const char* data, size_t length, const CsvParserConfig* config,
+                             bool* inQuotes, uint32_t* positions);
+
+#if defined(__x86_64__)
+// Internal helper: append the set bits of mask as positions base + bit
+static inline size_t __csvFlattenBits(uint64_t mask, uint32_t base, uint32_t* positions, size_t count)
+{
+    while (mask)
+    {
+        positions[count++] = base + (uint32_t)__builtin_ctzll(mask);
+        mask &= mask - 1;
+    }
+    return count;
+}
+
+// Internal helper: scan the bytes after the last full 64-byte block
+static inline size_t __csvIndexTail(const char* data, size_t length, size_t offset, const CsvParserConfig* config,
+                                    bool* inQuotes, uint32_t* positions, size_t count)
+{
+    size_t tail = __csvIndexScalar(data + offset, length - offset, config, inQuotes, positions + count);
+    for (size_t i = count; i < count + tail; ++i) positions[i] += (uint32_t)offset;
+    return count + tail;
+}
+
+// Internal helper: prefix XOR without carry-less multiply; bit i becomes the
+// XOR of bits 0..i, i.e. set for every byte after an odd number of quotes
+static inline uint64_t __csvPrefixXor(uint64_t bits)
+{
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+// SSE2 scanner: 64-byte blocks as four 16-byte compares per character class
+static size_t __csvIndexSse2(const char* data, size_t length, const CsvParserConfig* config,
+                             bool* inQuotes, uint32_t* positions)
+{
+    const __m128i delimiter = _mm_set1_epi8(config->delimiter);
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i quote = _mm_set1_epi8(config->quoteChar);
+    bool quotes = config->quotedFieldsAllowed;
+    uint64_t carry = *inQuotes ? ~0ULL : 0;
+    size_t count = 0, i = 0;
+
+    for (; i + 64 <= length; i += 64)
+    {
+        uint64_t structural = 0, quoteBits = 0;
+        for (int lane = 0; lane < 4; ++lane)
+        {
+            __m128i bytes = _mm_loadu_si128((const __m128i*)(const void*)(data + i + lane * 16));
+            uint64_t split = (uint32_t)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(bytes, delimiter),
+                                                                      _mm_cmpeq_epi8(bytes, newline)));
+            structural |= split << (lane * 16);
+            if (quotes) quoteBits |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, quote)) << (lane * 16);
+        }
+
+        uint64_t inside = __csvPrefixXor(quoteBits) ^ carry;
+        carry = (uint64_t)((int64_t)inside >> 63);
+        count = __csvFlattenBits(structural & ~inside, (uint32_t)i, positions, count);
+    }
+
+    *inQuotes = carry != 0;
+    return __csvIndexTail(data, length, i, config, inQuotes, positions, count);
+}
+
+// AVX2 scanner: 64-byte blocks as two 32-byte compares per character class;
+// the in-quote mask is the carry-less product of the quote bits and all ones
+__attribute__((target("avx2,pclmul")))
+static size_t __csvIndexAvx2(const char* data, size_t length, const CsvParserConfig* config,
+                             bool* inQuotes, uint32_t* positions)
+{
+    const __m256i delimiter = _mm256_set1_epi8(config->delimiter);
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i quote = _mm256_set1_epi8(config->quoteChar);
+    bool quotes = config->quotedFieldsAllowed;
+    uint64_t carry = *inQuotes ? ~0ULL : 0;
+    size_t count = 0, i = 0;
+
+    for (; i + 64 <= length; i += 64)
+    {
+        __m256i low = _mm256_loadu_si256((const __m256i*)(const void*)(data + i));
+        __m256i high = _mm256_loadu_si256((const __m256i*)(const void*)(data + i + 32));
+        uint64_t structural = (uint32_t)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(low, delimiter),
+                                                                             _mm256_cmpeq_epi8(low, newline)))
+            | (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(high, delimiter),
+                                                                       _mm256_cmpeq_epi8(high, newline))) << 32;
+
+        uint64_t inside = carry;
+        if (quotes)
+        {
+            uint64_t quoteBits = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, quote))
+                | (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, quote)) << 32;
+            if (quoteBits)
+            {
+                __m128i product = _mm_clmulepi64_si128(_mm_set_epi64x(0, (long long)quoteBits), _mm_set1_epi8(-1), 0);
+                inside ^= (uint64_t)_mm_cvtsi128_si64(product);
+            }
+        }
+        carry = (uint64_t)((int64_t)inside >> 63);
+        count = __csvFlattenBits(structural & ~inside, (uint32_t)i, positions, count);
+    }
+
+    *inQuotes = carry != 0;
+    return __csvIndexTail(data, length, i, config, inQuotes, positions, count);
+}
+#endif
+
+// Internal helper: pick the scanner for config->scanMode and this CPU
+static CsvIndexer __csvSelectIndexer(const CsvParserConfig* config)
+{
+#if defined(__x86_64__)
+    if (config->scanMode == CSV_SCAN_SCALAR) return __csvIndexScalar;
+    if (config->scanMode == CSV_SCAN_SSE2) return __csvIndexSse2;
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("pclmul")) return __csvIndexAvx2;
+    return __csvIndexSse2;
+#else
+    return __csvIndexScalar;
+#endif
+}
+
+// Copy a field, collapsing escaped quotes
+size_t csvFieldCopy(const CsvField* field, char quoteChar, char* out)
+{
+    if (!field->hasEscapedQuotes)
+    {
+        memcpy(out, field->data, field->length);
+        out[field->length] = '\0';
+        return field->length;
+    }
+
+    size_t written = 0;
+    for (size_t i = 0; i < field->length; ++i)
+    {
+        out[written++] = field->data[i];
+        if (field->data[i] == quoteChar && i + 1 < field->length && field->data[i + 1] == quoteChar) i++;
+    }
+    out[written] = '\0';
+    return written;
+}
+
+// Internal helper: parse the records starting in the byte range owned by
+// [begin, end): the record at 0 if begin is 0, and those just after a
+// newline p outside quotes with begin <= p < end. Records owned by the range
+// may run past end. inQuotes is the quote state at begin and *rowIndex the
+// index of the first owned record; on return it is one past the last.
+static CsvErrorCode __csvParseRange(const char* data, size_t size, size_t begin, size_t end, bool inQuotes,
+                                    size_t* rowIndex, const CsvParserConfig* config, CsvIndexer index,
+                                    uint32_t* positions, CsvRecord* record)
+{
+    bool inRecord = (begin == 0);
+    const char* fieldStart = data;
+
+    // index a window, then cut fields at its structural positions; a record
+    // may continue into the next window since the whole file is mapped
+    for (size_t window = begin; window < size; window += CSV_SCAN_WINDOW)
+    {
+        size_t length = (size - window < CSV_SCAN_WINDOW) ? size - window : CSV_SCAN_WINDOW;
+        size_t count = index(data + window, length, config, &inQuotes, positions);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            size_t at = window + positions[i];
+            bool endsRecord = (data[at] == '\n');
+            if (inRecord)
+            {
+                if (!__csvRecordAddField(record, fieldStart, data + at, endsRecord, config)) return CSV_ERR_MEMORY_ALLOCATION;
+                if (endsRecord && !__csvRecordEnd(record, (*rowIndex)++, config)) return CSV_ERR_MEMORY_ALLOCATION;
+            }
+            if (endsRecord)
+            {
+                if (at >= end) return CSV_SUCCESS;
+                inRecord = (at + 1 < size);
+            }
+            fieldStart = data + at + 1;
+        }
+    }
+
+    if (inQuotes) return CSV_ERR_UNBALANCED_QUOTES;
+    // last record without a trailing newline
+    if (inRecord)
+    {
+        if (!__csvRecordAddField(record, fieldStart, data + size, true, config)
+            || !__csvRecordEnd(record, (*rowIndex)++, config)) return CSV_ERR_MEMORY_ALLOCATION;
+    }
+    return CSV_SUCCESS;
+}
+
+// Internal helper: map a whole file read-only; *data is NULL for an empty file
+static CsvErrorCode __csvMapFile(const char* filePath, const char** data, size_t* size)
+{
+    *data = NULL;
+    *size = 0;
+
+    int fd = open(filePath, O_RDONLY);
+    if (fd < 0)
+    {
+        fprintf(stderr, "%s: %s\n", csvErrorMessage(CSV_ERR_FILE_OPEN), filePath);
+        return CSV_ERR_FILE_OPEN;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        fprintf(stderr, "%s: %s\n", csvErrorMessage(CSV_ERR_FILE_OPEN), filePath);
+        close(fd);
+        return CSV_ERR_FILE_OPEN;
+    }
+    if (info.st_size == 0)
+    {
+        close(fd);
+        return CSV_SUCCESS;
+    }
+
+    void* mapped = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+    {
+        fprintf(stderr, "%s: %s\n", csvErrorMessage(CSV_ERR_FILE_MAP), filePath);
+        return CSV_ERR_FILE_MAP;
+    }
+    madvise(mapped, (size_t)info.st_size, MADV_SEQUENTIAL);
+
+    *data = mapped;
+    *size = (size_t)info.st_size;
+    return CSV_SUCCESS;
+}
+
+// Parse a memory-mapped CSV file without copying fields
+CsvErrorCode parseCsvFileMapped(const char* filePath, const CsvParserConfig* config)
 {
-    if (!filePath || !config || !config->rowHandler) return false;
+    if (!filePath || !__csvConfigIsUsable(config))
+    {
+        fprintf(stderr, "%s: file path, config, handler or predicates\n", csvErrorMessage(CSV_ERR_NULL_INPUT));
+        return CSV_ERR_NULL_INPUT;
+    }
 
-    FILE* file = fopen(filePath, "r");
-    if (!file) return false;
+    const char* data;
+    size_t size;
+    CsvErrorCode result = __csvMapFile(filePath, &data, &size);
+    if (result != CSV_SUCCESS || size == 0) return result;
 
-    char* line = NULL;
-    size_t len = 0;
+    uint32_t* positions = malloc(CSV_SCAN_WINDOW * sizeof(uint32_t));
+    CsvRecord record = { 0 };
     size_t rowIndex = 0;
+    result = positions ? __csvParseRange(data, size, 0, size, false, &rowIndex, config, __csvSelectIndexer(config),
+                                         positions, &record)
+                       : CSV_ERR_MEMORY_ALLOCATION;
+    if (result == CSV_SUCCESS && config->batchHandler) __csvBatchFlush(&record.batch, config);
 
-    while (getline(&line, &len, file) != -1)
+    if (result == CSV_ERR_UNBALANCED_QUOTES)
+    {
+        fprintf(stderr, "%s: row %zu of %s\n", csvErrorMessage(result), rowIndex, filePath);
+    }
+    else if (result == CSV_ERR_MEMORY_ALLOCATION)
     {
-        char** columns = NULL;
-        size_t columnCount = 0;
+        fprintf(stderr, "%s: parsing %s\n", csvErrorMessage(result), filePath);
+    }
+    __csvRecordFree(&record);
+    free(positions);
+    munmap((void*)data, size);
+    return result;
+}
+
+// A slice of the file for parseCsvFileParallel
+typedef struct {
+    size_t begin;
+    size_t end;
+    bool oddQuotes;            // pre-pass: parity of the quotes in the slice
+    size_t newlines;           // pre-pass: all newlines in the slice
+    size_t newlinesOutside;    // pre-pass: newlines outside quotes, entering unquoted
+    bool inQuotes;             // quote state at begin
+    size_t firstRow;           // index of the first record the slice owns
+    bool done;                 // ordered mode: records are in its buffer
+} CsvChunk;
 
-        if (parseCsvLine(line, config, &columns, &columnCount))
+// State shared by the workers of parseCsvFileParallel
+typedef struct {
+    const char* data;
+    size_t size;
+    const CsvParserConfig* config;
+    CsvIndexer index;
+    CsvChunk* chunks;
+    size_t chunkCount;
+    bool ordered;
+    CsvRecord* buffers;        // ordered mode: chunk k buffers in buffers[k % ahead]
+    atomic_size_t nextChunk;
+    atomic_int result;
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    size_t delivered;          // ordered mode: chunks handed to the caller
+    size_t ahead;
+} CsvParallelJob;
+
+// Internal helper: pre-pass over the job's chunks; the quote parity and the
+// newline counts are enough to tell every chunk its entry state and first row
+static void* __csvParallelCount(void* argument)
+{
+    CsvParallelJob* job = argument;
+    uint32_t* positions = malloc(CSV_SCAN_WINDOW * sizeof(uint32_t));
+    if (!positions)
+    {
+        atomic_store(&job->result, CSV_ERR_MEMORY_ALLOCATION);
+        return NULL;
+    }
+
+    size_t k;
+    while ((k = atomic_fetch_add(&job->nextChunk, 1)) < job->chunkCount)
+    {
+        CsvChunk* chunk = &job->chunks[k];
+        bool inQuotes = false;
+        for (size_t window = chunk->begin; window < chunk->end; window += CSV_SCAN_WINDOW)
         {
-            config->rowHandler(rowIndex++, (const char**)columns, columnCount, config->userData);
-            freeCsvColumns(columns, columnCount);
+            size_t length = (chunk->end - window < CSV_SCAN_WINDOW) ? chunk->end - window : CSV_SCAN_WINDOW;
+            size_t count = job->index(job->data + window, length, job->config, &inQuotes, positions);
+            for (size_t i = 0; i < count; ++i) chunk->newlinesOutside += (job->data[window + positions[i]] == '\n');
         }
-        else
+        chunk->oddQuotes = inQuotes;
+
+        const char* at = job->data + chunk->begin;
+        const char* stop = job->data + chunk->end;
+        while ((at = memchr(at, '\n', stop - at)) != NULL)
+        {
+            chunk->newlines++;
+            at++;
+        }
+    }
+
+    free(positions);
+    return NULL;
+}
+
+// Internal helper: parse claimed chunks; unordered, records go straight to the
+// handler, ordered, they are buffered for the calling thread to deliver
+static void* __csvParallelParse(void* argument)
+{
+    CsvParallelJob* job = argument;
+    uint32_t* positions = malloc(CSV_SCAN_WINDOW * sizeof(uint32_t));
+    CsvRecord record = { 0 };
+    if (!positions) atomic_store(&job->result, CSV_ERR_MEMORY_ALLOCATION);
+
+    size_t k;
+    while ((k = atomic_fetch_add(&job->nextChunk, 1)) < job->chunkCount)
+    {
+        CsvChunk* chunk = &job->chunks[k];
+        if (job->ordered)
+        {
+            pthread_mutex_lock(&job->lock);
+            while (k >= job->delivered + job->ahead) pthread_cond_wait(&job->changed, &job->lock);
+            pthread_mutex_unlock(&job->lock);
+        }
+
+        if (atomic_load(&job->result) == CSV_SUCCESS)
+        {
+            CsvRecord* target = job->ordered ? &job->buffers[k % job->ahead] : &record;
+            target->buffered = job->ordered;
+            size_t rowIndex = chunk->firstRow;
+            CsvErrorCode result = __csvParseRange(job->data, job->size, chunk->begin, chunk->end, chunk->inQuotes,
+                                                  &rowIndex, job->config, job->index, positions, target);
+            if (result != CSV_SUCCESS) atomic_store(&job->result, result);
+        }
+
+        if (job->ordered)
+        {
+            pthread_mutex_lock(&job->lock);
+            chunk->done = true;
+            pthread_cond_broadcast(&job->changed);
+            pthread_mutex_unlock(&job->lock);
+        }
+    }
+
+    if (atomic_load(&job->result) == CSV_SUCCESS && job->config->batchHandler)
+    {
+        __csvBatchFlush(&record.batch, job->config);
+    }
+    __csvRecordFree(&record);
+    free(positions);
+    return NULL;
+}
+
+// Internal helper: run worker on threadCount threads (the calling thread
+// delivers in ordered mode, so it never runs a worker itself)
+static bool __csvParallelRun(CsvParallelJob* job, size_t threadCount, void* (*worker)(void*), bool deliver)
+{
+    pthread_t* threads = malloc(threadCount * sizeof(pthread_t));
+    if (!threads) return false;
+
+    atomic_store(&job->nextChunk, 0);
+    size_t started = 0;
+    while (started < threadCount && pthread_create(&threads[started], NULL, worker, job) == 0) started++;
+    if (started == 0 && !deliver) worker(job);
+    else if (started == 0)
+    {
+        free(threads);
+        return false;
+    }
+
+    if (deliver)
+    {
+        CsvRecord scratch = { 0 };
+        for (size_t k = 0; k < job->chunkCount; ++k)
+        {
+            CsvChunk* chunk = &job->chunks[k];
+            pthread_mutex_lock(&job->lock);
+            while (!chunk->done) pthread_cond_wait(&job->changed, &job->lock);
+            pthread_mutex_unlock(&job->lock);
+
+            // the buffer is reused, not freed, by chunk k + ahead
+            CsvRecord* buffer = &job->buffers[k % job->ahead];
+            size_t rowIndex = chunk->firstRow;
+            const CsvField* fields = buffer->fields;
+            for (size_t r = 0; r < buffer->recordCount && atomic_load(&job->result) == CSV_SUCCESS; ++r)
+            {
+                if (!__csvDeliverFields(&scratch, fields, buffer->recordSizes[r], rowIndex++, job->config))
+                {
+                    atomic_store(&job->result, CSV_ERR_MEMORY_ALLOCATION);
+                }
+                fields += buffer->recordSizes[r];
+            }
+            buffer->count = buffer->recordStart = buffer->recordCount = 0;
+
+            pthread_mutex_lock(&job->lock);
+            job->delivered = k + 1;
+            pthread_cond_broadcast(&job->changed);
+            pthread_mutex_unlock(&job->lock);
+        }
+        if (atomic_load(&job->result) == CSV_SUCCESS && job->config->batchHandler)
+        {
+            __csvBatchFlush(&scratch.batch, job->config);
+        }
+        __csvRecordFree(&scratch);
+    }
+
+    for (size_t i = 0; i < started; ++i) pthread_join(threads[i], NULL);
+    free(threads);
+    return true;
+}
+
+// Parse a memory-mapped CSV file on several threads
+CsvErrorCode parseCsvFileParallel(const char* filePath, const CsvParserConfig* config, size_t threadCount,
+                                  CsvDeliveryOrder order)
+{
+    if (!filePath || !__csvConfigIsUsable(config))
+    {
+        fprintf(stderr, "%s: file path, config, handler or predicates\n", csvErrorMessage(CSV_ERR_NULL_INPUT));
+        return CSV_ERR_NULL_INPUT;
+    }
+    if (threadCount == 0)
+    {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threadCount = (online > 0) ? (size_t)online : 1;
+    }
+
+    const char* data;
+    size_t size;
+    CsvErrorCode result = __csvMapFile(filePath, &data, &size);
+    if (result != CSV_SUCCESS || size == 0) return result;
+
+    // a few chunks per thread so that uneven chunks still balance
+    size_t chunkSize = size / (threadCount * 4);
+    if (chunkSize < CSV_PARALLEL_MIN_CHUNK) chunkSize = CSV_PARALLEL_MIN_CHUNK;
+    if (chunkSize > CSV_PARALLEL_MAX_CHUNK) chunkSize = CSV_PARALLEL_MAX_CHUNK;
+
+    CsvParallelJob job =
+    {
+        .data = data,
+        .size = size,
+        .config = config,
+        .index = __csvSelectIndexer(config),
+        .chunkCount = (size + chunkSize - 1) / chunkSize,
+        .ordered = (order == CSV_DELIVER_ORDERED),
+        .ahead = threadCount * CSV_PARALLEL_AHEAD
+    };
+    atomic_init(&job.result, CSV_SUCCESS);
+    job.chunks = calloc(job.chunkCount, sizeof(CsvChunk));
+    job.buffers = calloc(job.ahead, sizeof(CsvRecord));
+    if (!job.chunks || !job.buffers)
+    {
+        free(job.chunks);
+        free(job.buffers);
+        fprintf(stderr, "%s: parsing %s\n", csvErrorMessage(CSV_ERR_MEMORY_ALLOCATION), filePath);
+        munmap((void*)data, size);
+        return CSV_ERR_MEMORY_ALLOCATION;
+    }
+    for (size_t k = 0; k < job.chunkCount; ++k)
+    {
+        job.chunks[k].begin = k * chunkSize;
+        job.chunks[k].end = (k + 1 == job.chunkCount) ? size : (k + 1) * chunkSize;
+    }
+    pthread_mutex_init(&job.lock, NULL);
+    pthread_cond_init(&job.changed, NULL);
+
+    if (!__csvParallelRun(&job, threadCount, __csvParallelCount, false)) atomic_store(&job.result, CSV_ERR_MEMORY_ALLOCATION);
+
+    // entry states and first rows from the pre-pass; the record at 0 is row 0
+    bool inQuotes = false;
+    size_t rows = 1;
+    for (size_t k = 0; k < job.chunkCount; ++k)
+    {
+        CsvChunk* chunk = &job.chunks[k];
+        chunk->inQuotes = inQuotes;
+        chunk->firstRow = (k == 0) ? 0 : rows;
+        rows += inQuotes ? chunk->newlines - chunk->newlinesOutside : chunk->newlinesOutside;
+        inQuotes ^= chunk->oddQuotes;
+    }
+    if (atomic_load(&job.result) == CSV_SUCCESS && inQuotes) atomic_store(&job.result, CSV_ERR_UNBALANCED_QUOTES);
+
+    if (atomic_load(&job.result) == CSV_SUCCESS
+        && !__csvParallelRun(&job, threadCount, __csvParallelParse, job.ordered))
+    {
+        atomic_store(&job.result, CSV_ERR_MEMORY_ALLOCATION);
+    }
+
+    result = atomic_load(&job.result);
+    if (result != CSV_SUCCESS) fprintf(stderr, "%s: parsing %s\n", csvErrorMessage(result), filePath);
+    for (size_t i = 0; i < job.ahead; ++i) __csvRecordFree(&job.buffers[i]);
+    free(job.buffers);
+    free(job.chunks);
+    pthread_mutex_destroy(&job.lock);
+    pthread_cond_destroy(&job.changed);
+    munmap((void*)data, size);
+    return result;
+}
+
+// Resumable parser state; see csvStreamCreate
+struct CsvStreamParser {
+    CsvParserConfig config;
+    CsvIndexer index;
+    uint32_t* positions;
+    CsvRecord record;
+    char* carry;               // the record still open at the end of the last block
+    size_t carryLength;
+    size_t carryCapacity;
+    bool inQuotes;             // quote state at the end of carry
+    size_t rowIndex;
+    CsvErrorCode result;
+};
+
+// Internal helper: deliver the complete records of data, which starts at a
+// record start outside quotes. Returns where the trailing open record starts
+// (length if there is none) and its quote state in *inQuotes; with final,
+// that record is delivered too unless it is still quoted.
+static size_t __csvStreamRecords(CsvStreamParser* parser, const char* data, size_t length, bool final, bool* inQuotes)
+{
+    const CsvParserConfig* config = &parser->config;
+    size_t recordStart = 0;
+    const char* fieldStart = data;
+    bool quoted = false;
+    parser->record.count = 0;
+
+    for (size_t window = 0; window < length; window += CSV_SCAN_WINDOW)
+    {
+        size_t windowLength = (length - window < CSV_SCAN_WINDOW) ? length - window : CSV_SCAN_WINDOW;
+        size_t count = parser->index(data + window, windowLength, config, &quoted, parser->positions);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            size_t at = window + parser->positions[i];
+            bool endsRecord = (data[at] == '\n');
+            if (!__csvRecordAddField(&parser->record, fieldStart, data + at, endsRecord, config)
+                || (endsRecord && !__csvRecordEnd(&parser->record, parser->rowIndex++, config)))
+            {
+                parser->result = CSV_ERR_MEMORY_ALLOCATION;
+                return length;
+            }
+            if (endsRecord) recordStart = at + 1;
+            fieldStart = data + at + 1;
+        }
+    }
+
+    *inQuotes = quoted;
+    if (!final || recordStart == length) return recordStart;
+    if (quoted)
+    {
+        parser->result = CSV_ERR_UNBALANCED_QUOTES;
+        return length;
+    }
+    if (!__csvRecordAddField(&parser->record, fieldStart, data + length, true, config)
+        || !__csvRecordEnd(&parser->record, parser->rowIndex++, config)) parser->result = CSV_ERR_MEMORY_ALLOCATION;
+    return length;
+}
+
+// Internal helper: append data to the carried record
+static bool __csvStreamCarry(CsvStreamParser* parser, const char* data, size_t length)
+{
+    if (parser->carryLength + length > parser->carryCapacity)
+    {
+        size_t capacity = (parser->carryLength + length) * 2;
+        char* grown = realloc(parser->carry, capacity);
+        if (!grown)
         {
-            fprintf(stderr, "Failed to parse line %zu in CSV file", columnCount);
+            fprintf(stderr, "%s: growing carried record\n", csvErrorMessage(CSV_ERR_MEMORY_ALLOCATION));
+            parser->result = CSV_ERR_MEMORY_ALLOCATION;
             return false;
         }
+        parser->carry = grown;
+        parser->carryCapacity = capacity;
+    }
+    memcpy(parser->carry + parser->carryLength, data, length);
+    parser->carryLength += length;
+    return true;
+}
+
+// Create a streaming parser
+CsvStreamParser* csvStreamCreate(const CsvParserConfig* config)
+{
+    if (!__csvConfigIsUsable(config))
+    {
+        fprintf(stderr, "%s: config, handler or predicates\n", csvErrorMessage(CSV_ERR_NULL_INPUT));
+        return NULL;
+    }
+
+    CsvStreamParser* parser = calloc(1, sizeof(CsvStreamParser));
+    if (parser) parser->positions = malloc(CSV_SCAN_WINDOW * sizeof(uint32_t));
+    if (!parser || !parser->positions)
+    {
+        fprintf(stderr, "%s: creating stream parser\n", csvErrorMessage(CSV_ERR_MEMORY_ALLOCATION));
+        free(parser);
+        return NULL;
+    }
+
+    parser->config = *config;
+    parser->index = __csvSelectIndexer(config);
+    parser->result = CSV_SUCCESS;
+    return parser;
+}
+
+// Feed the next block of input
+CsvErrorCode csvStreamFeed(CsvStreamParser* parser, const char* data, size_t length)
+{
+    if (!parser || (!data && length > 0)) return CSV_ERR_NULL_INPUT;
+    if (parser->result != CSV_SUCCESS) return parser->result;
+
+    // close the carried record first: it ends at the first newline that is
+    // outside quotes given the carried state
+    size_t consumed = 0;
+    if (parser->carryLength > 0)
+    {
+        size_t recordEnd = length;
+        for (size_t window = 0; window < length && recordEnd == length; window += CSV_SCAN_WINDOW)
+        {
+            size_t windowLength = (length - window < CSV_SCAN_WINDOW) ? length - window : CSV_SCAN_WINDOW;
+            size_t count = parser->index(data + window, windowLength, &parser->config, &parser->inQuotes,
+                                         parser->positions);
+            for (size_t i = 0; i < count && recordEnd == length; ++i)
+            {
+                if (data[window + parser->positions[i]] == '\n') recordEnd = window + parser->positions[i];
+            }
+        }
+
+        if (recordEnd == length) return __csvStreamCarry(parser, data, length) ? CSV_SUCCESS : parser->result;
+
+        consumed = recordEnd + 1;
+        if (!__csvStreamCarry(parser, data, consumed)) return parser->result;
+        bool inQuotes;
+        __csvStreamRecords(parser, parser->carry, parser->carryLength, false, &inQuotes);
+        parser->carryLength = 0;
+        if (parser->result != CSV_SUCCESS) return parser->result;
+    }
+
+    // whole records straight from the block, then carry the open one
+    size_t open = consumed + __csvStreamRecords(parser, data + consumed, length - consumed, false, &parser->inQuotes);
+    if (parser->result == CSV_SUCCESS && open < length) __csvStreamCarry(parser, data + open, length - open);
+    return parser->result;
+}
+
+// Deliver the last record, if the input did not end with a newline, and the
+// last batch
+CsvErrorCode csvStreamFinish(CsvStreamParser* parser)
+{
+    if (!parser) return CSV_ERR_NULL_INPUT;
+    if (parser->result != CSV_SUCCESS) return parser->result;
+
+    if (parser->carryLength > 0)
+    {
+        bool inQuotes;
+        __csvStreamRecords(parser, parser->carry, parser->carryLength, true, &inQuotes);
+        parser->carryLength = 0;
+    }
+    if (parser->result == CSV_SUCCESS && parser->config.batchHandler)
+    {
+        __csvBatchFlush(&parser->record.batch, &parser->config);
+    }
+    return parser->result;
+}
+
+// Records parsed so far
+size_t csvStreamRowCount(const CsvStreamParser* parser)
+{
+    return parser ? parser->rowIndex : 0;
+}
+
+// Free a streaming parser
+void csvStreamDestroy(CsvStreamParser* parser)
+{
+    if (!parser) return;
+    __csvRecordFree(&parser->record);
+    free(parser->positions);
+    free(parser->carry);
+    free(parser);
+}
+
+// Parse everything readable from stream, CSV_STREAM_BLOCK bytes at a time
+CsvErrorCode parseCsvStream(FILE* stream, const CsvParserConfig* config)
+{
+    // checked here so that a parser that could not be created means out of memory
+    if (!stream || !__csvConfigIsUsable(config))
+    {
+        fprintf(stderr, "%s: stream, config, handler or predicates\n", csvErrorMessage(CSV_ERR_NULL_INPUT));
+        return CSV_ERR_NULL_INPUT;
+    }
+
+    CsvStreamParser* parser = csvStreamCreate(config);
+    char* block = malloc(CSV_STREAM_BLOCK);
+    if (!parser || !block)
+    {
+        if (parser) fprintf(stderr, "%s: stream block\n", csvErrorMessage(CSV_ERR_MEMORY_ALLOCATION));
+        csvStreamDestroy(parser);
+        free(block);
+        return CSV_ERR_MEMORY_ALLOCATION;
     }
 
-    free(line);
+    CsvErrorCode result = CSV_SUCCESS;
+    size_t length;
+    while (result == CSV_SUCCESS && (length = fread(block, 1, CSV_STREAM_BLOCK, stream)) > 0)
+    {
+        result = csvStreamFeed(parser, block, length);
+    }
+    if (result == CSV_SUCCESS) result = csvStreamFinish(parser);
+    if (result != CSV_SUCCESS)
+    {
+        fprintf(stderr, "%s: row %zu\n", csvErrorMessage(result), csvStreamRowCount(parser));
+    }
+
+    csvStreamDestroy(parser);
+    free(block);
+    return result;
+}
+
+// Parse a CSV file block by block
+bool parseCsvFile(const char* filePath, const CsvParserConfig* config)
+{
+    if (!filePath || !__csvConfigIsUsable(config)) return false;
+
+    FILE* file = fopen(filePath, "rb");
+    if (!file)
+    {
+        fprintf(stderr, "%s: %s\n", csvErrorMessage(CSV_ERR_FILE_OPEN), filePath);
+        return false;
+    }
+
+    CsvErrorCode result = parseCsvStream(file, config);
     fclose(file);
-    return true;
+    return result == CSV_SUCCESS;
 }
 
 // Internal helper to split a line into columns
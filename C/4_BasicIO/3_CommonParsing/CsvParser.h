@@ -1,15 +1,21 @@
 #ifndef CSVPARSER_H
 #define CSVPARSER_H
 
+#include <stdio.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 typedef enum {
     CSV_SUCCESS = 1,
     CSV_ERR_NULL_INPUT,
     CSV_ERR_MEMORY_ALLOCATION,
     CSV_ERR_UNBALANCED_QUOTES,
-    CSV_ERR_COLUMN_INDEX_OUT_OF_RANGE
+    CSV_ERR_COLUMN_INDEX_OUT_OF_RANGE,
+    CSV_ERR_FILE_OPEN,
+    CSV_ERR_FILE_MAP,
+    CSV_ERR_FILE_WRITE,
+    CSV_ERR_CORRUPT_CACHE
 } CsvErrorCode;
 
 // Map error codes to messages
@@ -18,6 +24,67 @@ const char* csvErrorMessage(CsvErrorCode code);
 // Callback for handling parsed rows
 typedef void (*CsvRowHandler)(size_t rowIndex, const char** columns, size_t columnCount, void* userData);
 
+// A field as a slice of the input; not NUL-terminated. Enclosing quotes are
+// already stripped, escaped quotes ("") are not - see csvFieldCopy.
+typedef struct {
+    const char* data;
+    size_t length;
+    bool hasEscapedQuotes;     // contains quoteChar, so needs unescaping
+    bool quoted;               // was enclosed in quotes; tells "" apart from nothing
+} CsvField;
+
+// Callback for zero-copy parsing; the slices are only valid during the call
+typedef void (*CsvFieldHandler)(size_t rowIndex, const CsvField* fields, size_t fieldCount, void* userData);
+
+// Rows per CsvBatch when batchSize is 0
+#define CSV_DEFAULT_BATCH_ROWS 4096
+
+// A block of rows for batchHandler. Field f is the NUL-terminated, unescaped
+// text at data + fieldOffsets[f], fieldOffsets[f + 1] - fieldOffsets[f] - 1
+// bytes long. Row r is fields rowStarts[r] to rowStarts[r + 1] - 1, and row
+// rowIndices[r] of the input. The arrays are reused by the next batch. A
+// batch goes out when full and at the end of a successful parse; unordered
+// parseCsvFileParallel fills one per worker thread.
+typedef struct {
+    size_t rowCount;
+    const size_t* rowIndices;  // rowCount entries
+    const size_t* rowStarts;   // rowCount + 1 entries
+    const size_t* fieldOffsets; // rowStarts[rowCount] + 1 entries
+    const char* data;
+} CsvBatch;
+
+// Callback for batched rows; the batch is only valid during the call
+typedef void (*CsvBatchHandler)(const CsvBatch* batch, void* userData);
+
+// How structural characters are located
+typedef enum {
+    CSV_SCAN_AUTO = 0,         // widest SIMD the CPU supports
+    CSV_SCAN_SCALAR,           // one byte at a time
+    CSV_SCAN_SSE2,             // 64-byte blocks, 16 bytes per compare
+    CSV_SCAN_AVX2              // 64-byte blocks, 32 bytes per compare; SSE2 if unsupported
+} CsvScanMode;
+
+// Comparison of a CsvPredicate
+typedef enum {
+    CSV_OP_EQ,
+    CSV_OP_NE,
+    CSV_OP_LT,
+    CSV_OP_LE,
+    CSV_OP_GT,
+    CSV_OP_GE
+} CsvCompareOp;
+
+// A row filter on one column, e.g. Age > 60 or Sex == "F". Numeric
+// predicates parse the field as a double; text ones compare bytes. Fields
+// that are missing, or do not parse for a numeric predicate, never match.
+typedef struct {
+    size_t column;
+    CsvCompareOp op;
+    bool numeric;
+    double number;             // numeric predicates
+    const char* text;          // text predicates, NUL-terminated; required
+} CsvPredicate;
+
 // Configuration structure for the CSV parser
 typedef struct {
     char delimiter;            // Delimiter character (e.g., ',')
@@ -25,19 +92,70 @@ typedef struct {
     bool quotedFieldsAllowed;  // Whether quoted fields are allowed
     bool shouldTrimWhitespace; // Whether to trim leading/trailing whitespace
     CsvRowHandler rowHandler;  // Callback for processing rows
+    CsvFieldHandler fieldHandler; // Callback for field slices, used over the other handlers if set
+    CsvBatchHandler batchHandler; // Callback for blocks of rows, used over rowHandler if set
+    size_t batchSize;          // Rows per batch; 0 for CSV_DEFAULT_BATCH_ROWS
     void* userData;            // User-defined data for callback
+    CsvScanMode scanMode;      // Structural scanner
+    uint64_t projectionMask;   // Columns to deliver (bit i for column i < 64), in file order; 0 for all
+    const CsvPredicate* predicates; // Only rows matching all of them are delivered; rowIndex stays the file's
+    size_t predicateCount;
 } CsvParserConfig;
 
-// Main parsing function
+// Main parsing function; reads the file in fixed-size blocks through a
+// CsvStreamParser, so quoted fields may span lines
 bool parseCsvFile(const char* filePath, const CsvParserConfig* config);
 
+// Resumable parser for input that arrives in pieces (pipes, sockets, ...).
+// Whole records in a block are delivered as slices of it; a record cut by
+// the end of a block is carried over, so memory is one block plus the
+// longest record. Row handlers run during csvStreamFeed/csvStreamFinish.
+typedef struct CsvStreamParser CsvStreamParser;
+
+CsvStreamParser* csvStreamCreate(const CsvParserConfig* config);
+// The block only needs to stay valid during the call
+CsvErrorCode csvStreamFeed(CsvStreamParser* parser, const char* data, size_t length);
+// End of input: delivers a last record that has no trailing newline, then
+// the rows still waiting for batchHandler
+CsvErrorCode csvStreamFinish(CsvStreamParser* parser);
+// Records parsed so far, delivered or filtered out
+size_t csvStreamRowCount(const CsvStreamParser* parser);
+void csvStreamDestroy(CsvStreamParser* parser);
+
+// Feed everything readable from stream to a CsvStreamParser
+CsvErrorCode parseCsvStream(FILE* stream, const CsvParserConfig* config);
+
+// Zero-copy parsing: mmaps the file and hands slices of it to fieldHandler
+// (or NUL-terminated copies to batchHandler or rowHandler). Quoted fields may
+// span lines.
+CsvErrorCode parseCsvFileMapped(const char* filePath, const CsvParserConfig* config);
+
+// Row delivery for parseCsvFileParallel
+typedef enum {
+    CSV_DELIVER_ORDERED = 0,   // from the calling thread, in row order
+    CSV_DELIVER_UNORDERED      // from the worker threads, concurrently; the handler must be thread-safe
+} CsvDeliveryOrder;
+
+// parseCsvFileMapped on threadCount threads (0: one per CPU). The file is cut
+// into chunks whose quote state and first row index come from a parallel
+// pre-pass, so rowIndex is the same as in a sequential parse. Unbalanced
+// quotes are reported before any row is delivered.
+CsvErrorCode parseCsvFileParallel(const char* filePath, const CsvParserConfig* config, size_t threadCount,
+                                  CsvDeliveryOrder order);
+
+// Copy a field into out (room for field->length + 1), unescaping "" if needed
+// and NUL-terminating; returns the copied length
+size_t csvFieldCopy(const CsvField* field, char quoteChar, char* out);
+
 // Utility function to split a single CSV line into columns
 bool parseCsvLine(const char* line, const CsvParserConfig* config, char*** columns, size_t* columnCount);
 
 // Utility function to free allocated columns
 void freeCsvColumns(char** columns, size_t columnCount);
 
-// Add/drop a column by index
+// Add/drop a column by index, on NULL-terminated rows: O(rows x columns),
+// every row is touched. CsvTable's csvTableAddColumn/csvTableDropColumn
+// change the schema without touching the rows.
 CsvErrorCode addCsvColumn(char*** rows, size_t rowCount, const char* defaultValue);
 CsvErrorCode dropCsvColumn(char*** rows, size_t rowCount, size_t columnIndex);
 
@@ -0,0 +1,1573 @@
+#ifndef CSVPARSERTEST_H
+#define CSVPARSERTEST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <sys/stat.h>
+
+#include <math.h>
+
+#include "CsvParser.h"
+#include "CsvNumbers.h"
+#include "CsvTable.h"
+#include "CsvWriter.h"
+#include "TestsSummary.h"
+
+/* Testing functions **********************************************************/
+void testCsvMappedFields();
+void testCsvMappedQuoting();
+void testCsvMappedEdges();
+void testCsvMappedWindows();
+void testCsvScanModes();
+void testCsvParallel();
+void testCsvStream();
+void testCsvNumbers();
+void testCsvTableLoad();
+void testCsvTableColumns();
+void testCsvProjection();
+void testCsvBatches();
+void testCsvWriter();
+void testCsvTableCache();
+/* End testing functions ******************************************************/
+
+/* Test setup/teardown functions **********************************************/
+// Every record flattened as "a|b|c\n" after unescaping
+typedef struct
+{
+    char* text;
+    size_t length;
+    size_t capacity;
+    size_t rows;
+    size_t lastRowIndex;
+} CsvTestOutput;
+
+// Default config collecting into output; tests override fields as needed
+CsvParserConfig SetUp(CsvTestOutput* output)
+{
+    memset(output, 0, sizeof(CsvTestOutput));
+    CsvParserConfig config =
+    {
+        .delimiter = ',',
+        .quoteChar = '"',
+        .quotedFieldsAllowed = true,
+        .shouldTrimWhitespace = false,
+        .userData = output
+    };
+    return config;
+}
+
+void TearDown(CsvTestOutput* output, const char* path)
+{
+    free(output->text);
+    if (path) unlink(path);
+}
+/* End test setup/teardown functions ******************************************/
+
+void runCsvParserTests()
+{
+    TestsSummaryPrintHeader("CsvParser");
+
+    testCsvMappedFields();
+    testCsvMappedQuoting();
+    testCsvMappedEdges();
+    testCsvMappedWindows();
+    testCsvScanModes();
+    testCsvParallel();
+    testCsvStream();
+    testCsvNumbers();
+    testCsvTableLoad();
+    testCsvTableColumns();
+    testCsvProjection();
+    testCsvBatches();
+    testCsvWriter();
+    testCsvTableCache();
+
+    TestsSummaryPrintFooter("CsvParser");
+}
+
+static void __csvTestAppend(CsvTestOutput* output, const char* text, size_t length)
+{
+    if (output->length + length + 1 > output->capacity)
+    {
+        output->capacity = (output->length + length + 1) * 2;
+        output->text = realloc(output->text, output->capacity);
+    }
+    memcpy(output->text + output->length, text, length);
+    output->length += length;
+    output->text[output->length] = '\0';
+}
+
+static void __csvTestCollectRow(size_t rowIndex, const char** columns, size_t columnCount, void* userData)
+{
+    CsvTestOutput* output = userData;
+    for (size_t i = 0; i < columnCount; ++i)
+    {
+        __csvTestAppend(output, columns[i], strlen(columns[i]));
+        __csvTestAppend(output, (i < columnCount - 1) ? "|" : "\n", 1);
+    }
+    output->rows++;
+    output->lastRowIndex = rowIndex;
+}
+
+static void __csvTestCollectFields(size_t rowIndex, const CsvField* fields, size_t fieldCount, void* userData)
+{
+    CsvTestOutput* output = userData;
+    for (size_t i = 0; i < fieldCount; ++i)
+    {
+        char* buffer = malloc(fields[i].length + 1);
+        size_t length = csvFieldCopy(&fields[i], '"', buffer);
+        __csvTestAppend(output, buffer, length);
+        __csvTestAppend(output, (i < fieldCount - 1) ? "|" : "\n", 1);
+        free(buffer);
+    }
+    output->rows++;
+    output->lastRowIndex = rowIndex;
+}
+
+// Writes contents to a fresh temporary file, whose name is stored in path
+static void __csvTestWriteFile(char* path, const char* contents, size_t length)
+{
+    strcpy(path, "/tmp/CsvParserTestXXXXXX");
+    int fd = mkstemp(path);
+    FILE* file = fdopen(fd, "wb");
+    fwrite(contents, 1, length, file);
+    fclose(file);
+}
+
+// Reads a file into a CsvTestOutput
+static void __csvTestReadFile(const char* path, CsvTestOutput* output)
+{
+    SetUp(output);
+    FILE* file = fopen(path, "rb");
+    char block[4096];
+    size_t length;
+    while (file && (length = fread(block, 1, sizeof(block), file)) > 0) __csvTestAppend(output, block, length);
+    if (file) fclose(file);
+}
+
+// Parses contents with both handlers; true if both produce expected
+static bool __csvTestMapped(const char* contents, bool trim, const char* expected)
+{
+    char path[32];
+    __csvTestWriteFile(path, contents, strlen(contents));
+
+    CsvTestOutput fieldOutput, rowOutput;
+    CsvParserConfig config = SetUp(&fieldOutput);
+    config.shouldTrimWhitespace = trim;
+    config.fieldHandler = __csvTestCollectFields;
+    CsvErrorCode fieldResult = parseCsvFileMapped(path, &config);
+
+    config = SetUp(&rowOutput);
+    config.shouldTrimWhitespace = trim;
+    config.rowHandler = __csvTestCollectRow;
+    CsvErrorCode rowResult = parseCsvFileMapped(path, &config);
+
+    bool passed = fieldResult == CSV_SUCCESS && rowResult == CSV_SUCCESS
+        && strcmp(fieldOutput.text ? fieldOutput.text : "", expected) == 0
+        && strcmp(rowOutput.text ? rowOutput.text : "", expected) == 0;
+    if (!passed)
+    {
+        printf("FAILED: parseCsvFileMapped: expected \"%s\", got \"%s\" / \"%s\"\n", expected,
+               fieldOutput.text ? fieldOutput.text : "", rowOutput.text ? rowOutput.text : "");
+    }
+
+    TearDown(&fieldOutput, NULL);
+    TearDown(&rowOutput, path);
+    return passed;
+}
+
+void testCsvMappedFields()
+{
+    int successes = 0, failures = 0;
+
+    if (__csvTestMapped("a,b,c\n1,2,3\n", false, "a|b|c\n1|2|3\n")) successes++;
+    else failures++;
+
+    if (__csvTestMapped("a,,c\n,\n", false, "a||c\n|\n")) successes++;
+    else failures++;
+
+    if (__csvTestMapped("  a , b\t,c  \n", true, "a|b|c\n")) successes++;
+    else failures++;
+
+    if (__csvTestMapped("  a , b\n", false, "  a | b\n")) successes++;
+    else failures++;
+
+    TestsSummaryPrintResults("CsvMappedFields", successes, failures);
+}
+
+void testCsvMappedQuoting()
+{
+    int successes = 0, failures = 0;
+
+    if (__csvTestMapped("\"a,b\",c\n", false, "a,b|c\n")) successes++;
+    else failures++;
+
+    if (__csvTestMapped("\"5'2\"\"\",x\n", false, "5'2\"|x\n")) successes++;
+    else failures++;
+
+    if (__csvTestMapped("\"line\nbreak\",2\n3,4\n", false, "line\nbreak|2\n3|4\n")) successes++;
+    else failures++;
+
+    if (__csvTestMapped(" \"a\" ,b\n", true, "a|b\n")) successes++;
+    else failures++;
+
+    if (__csvTestMapped("\"\",\"\"\"\"\n", false, "|\"\n")) successes++;
+    else failures++;
+
+    TestsSummaryPrintResults("CsvMappedQuoting", successes, failures);
+}
+
+void testCsvMappedEdges()
+{
+    int successes = 0, failures = 0;
+
+    // CRLF line endings and a missing final newline
+    if (__csvTestMapped("a,b\r\nc,d\r\n", false, "a|b\nc|d\n")) successes++;
+    else failures++;
+
+    if (__csvTestMapped("a,b\nc,d", false, "a|b\nc|d\n")) successes++;
+    else failures++;
+
+    if (__csvTestMapped("", false, "")) successes++;
+    else failures++;
+
+    if (__csvTestMapped("a,b\n\nc\n", false, "a|b\n\nc\n")) successes++;
+    else failures++;
+
+    char path[32];
+    CsvTestOutput output;
+    CsvParserConfig config = SetUp(&output);
+    config.fieldHandler = __csvTestCollectFields;
+
+    __csvTestWriteFile(path, "a,\"b\nc\n", 7);
+    fprintf(stderr, "(expected error) ");
+    if (parseCsvFileMapped(path, &config) != CSV_ERR_UNBALANCED_QUOTES)
+    {
+        printf("FAILED: testCsvMappedEdges: unbalanced quotes not reported\n");
+        failures++;
+    }
+    else successes++;
+    TearDown(&output, path);
+
+    config = SetUp(&output);
+    config.fieldHandler = __csvTestCollectFields;
+    fprintf(stderr, "(expected error) ");
+    if (parseCsvFileMapped("/nonexistent/file.csv", &config) != CSV_ERR_FILE_OPEN)
+    {
+        printf("FAILED: testCsvMappedEdges: missing file not reported\n");
+        failures++;
+    }
+    else successes++;
+    TearDown(&output, NULL);
+
+    TestsSummaryPrintResults("CsvMappedEdges", successes, failures);
+}
+
+// Records, including quoted newlines, that straddle the 64KB scan windows
+void testCsvMappedWindows()
+{
+    int successes = 0, failures = 0;
+    const size_t rowCount = 20000;
+
+    CsvTestOutput source;
+    SetUp(&source);
+    CsvTestOutput expected;
+    SetUp(&expected);
+    char line[64], flat[64];
+    for (size_t i = 0; i < rowCount; ++i)
+    {
+        int length = (i % 3 == 0) ? snprintf(line, sizeof(line), "%zu,\"q,\"\"%zu\"\"\nx\",z\n", i, i * 7)
+                                  : snprintf(line, sizeof(line), "%zu,plain%zu,z\n", i, i * 7);
+        __csvTestAppend(&source, line, length);
+        length = (i % 3 == 0) ? snprintf(flat, sizeof(flat), "%zu|q,\"%zu\"\nx|z\n", i, i * 7)
+                              : snprintf(flat, sizeof(flat), "%zu|plain%zu|z\n", i, i * 7);
+        __csvTestAppend(&expected, flat, length);
+    }
+
+    if (__csvTestMapped(source.text, false, expected.text)) successes++;
+    else failures++;
+
+    char path[32];
+    __csvTestWriteFile(path, source.text, source.length);
+    CsvTestOutput output;
+    CsvParserConfig config = SetUp(&output);
+    config.fieldHandler = __csvTestCollectFields;
+    if (parseCsvFileMapped(path, &config) != CSV_SUCCESS || output.rows != rowCount
+        || output.lastRowIndex != rowCount - 1)
+    {
+        printf("FAILED: testCsvMappedWindows: %zu rows, last index %zu\n", output.rows, output.lastRowIndex);
+        failures++;
+    }
+    else successes++;
+
+    TearDown(&output, path);
+    TearDown(&source, NULL);
+    TearDown(&expected, NULL);
+    TestsSummaryPrintResults("CsvMappedWindows", successes, failures);
+}
+
+// Every scanner yields the same records on random quote/delimiter soup
+void testCsvScanModes()
+{
+    int successes = 0, failures = 0;
+    const char alphabet[] = "ab,,\"\"\n\r ";
+    const CsvScanMode modes[] = { CSV_SCAN_SSE2, CSV_SCAN_AVX2, CSV_SCAN_AUTO };
+    unsigned long state = 5;
+
+    for (int round = 0; round < 200; ++round)
+    {
+        CsvTestOutput source;
+        SetUp(&source);
+        state = state * 6364136223846793005UL + 1442695040888963407UL;
+        size_t length = (state >> 33) % ((round % 10 == 0) ? 200000 : 300);
+        size_t quoteCount = 0;
+        for (size_t i = 0; i < length; ++i)
+        {
+            state = state * 6364136223846793005UL + 1442695040888963407UL;
+            char c = alphabet[(state >> 33) % (sizeof(alphabet) - 1)];
+            quoteCount += (c == '"');
+            __csvTestAppend(&source, &c, 1);
+        }
+        if (quoteCount % 2) __csvTestAppend(&source, "\"", 1);
+
+        char path[32];
+        __csvTestWriteFile(path, source.text ? source.text : "", source.length);
+        CsvTestOutput expected;
+        CsvParserConfig config = SetUp(&expected);
+        config.fieldHandler = __csvTestCollectFields;
+        config.scanMode = CSV_SCAN_SCALAR;
+        parseCsvFileMapped(path, &config);
+
+        for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); ++m)
+        {
+            CsvTestOutput output;
+            config = SetUp(&output);
+            config.fieldHandler = __csvTestCollectFields;
+            config.scanMode = modes[m];
+            parseCsvFileMapped(path, &config);
+
+            if (output.rows != expected.rows || output.length != expected.length
+                || (output.length && memcmp(output.text, expected.text, output.length) != 0))
+            {
+                printf("FAILED: testCsvScanModes: mode %d differs from scalar on %zu bytes\n", (int)modes[m], length);
+                failures++;
+            }
+            else successes++;
+            TearDown(&output, NULL);
+        }
+
+        TearDown(&expected, path);
+        TearDown(&source, NULL);
+    }
+
+    TestsSummaryPrintResults("CsvScanModes", successes, failures);
+}
+
+// Unordered delivery: every row flattened into its own slot
+typedef struct
+{
+    char** rows;
+    size_t rowCount;
+    atomic_size_t delivered;
+} CsvTestSlots;
+
+static void __csvTestCollectSlot(size_t rowIndex, const CsvField* fields, size_t fieldCount, void* userData)
+{
+    CsvTestSlots* slots = userData;
+    atomic_fetch_add(&slots->delivered, 1);
+    if (rowIndex >= slots->rowCount || slots->rows[rowIndex]) return;
+
+    CsvTestOutput row;
+    SetUp(&row);
+    __csvTestCollectFields(rowIndex, fields, fieldCount, &row);
+    slots->rows[rowIndex] = row.text;
+}
+
+// Parallel parses of contents, ordered and unordered, match the sequential one
+static bool __csvTestParallel(const char* contents, size_t length, size_t threadCount)
+{
+    char path[32];
+    __csvTestWriteFile(path, contents, length);
+
+    CsvTestOutput expected, ordered;
+    CsvParserConfig config = SetUp(&expected);
+    config.fieldHandler = __csvTestCollectFields;
+    CsvErrorCode expectedResult = parseCsvFileMapped(path, &config);
+
+    config = SetUp(&ordered);
+    config.fieldHandler = __csvTestCollectFields;
+    bool passed = parseCsvFileParallel(path, &config, threadCount, CSV_DELIVER_ORDERED) == expectedResult
+        && ordered.rows == expected.rows && ordered.length == expected.length
+        && (expected.length == 0 || memcmp(ordered.text, expected.text, expected.length) == 0);
+
+    CsvTestSlots slots = { calloc(expected.rows + 1, sizeof(char*)), expected.rows };
+    atomic_init(&slots.delivered, 0);
+    config.fieldHandler = __csvTestCollectSlot;
+    config.userData = &slots;
+    passed = passed && parseCsvFileParallel(path, &config, threadCount, CSV_DELIVER_UNORDERED) == expectedResult
+        && atomic_load(&slots.delivered) == expected.rows;
+
+    CsvTestOutput unordered;
+    SetUp(&unordered);
+    for (size_t i = 0; i < expected.rows; ++i)
+    {
+        if (slots.rows[i]) __csvTestAppend(&unordered, slots.rows[i], strlen(slots.rows[i]));
+        free(slots.rows[i]);
+    }
+    free(slots.rows);
+    passed = passed && unordered.length == expected.length
+        && (expected.length == 0 || memcmp(unordered.text, expected.text, expected.length) == 0);
+
+    if (!passed) printf("FAILED: testCsvParallel: %zu bytes on %zu threads\n", length, threadCount);
+    TearDown(&unordered, NULL);
+    TearDown(&ordered, NULL);
+    TearDown(&expected, path);
+    return passed;
+}
+
+// Chunks are at least 64KB, so about 1MB of records with quoted newlines puts
+// quoted fields across chunk boundaries
+void testCsvParallel()
+{
+    int successes = 0, failures = 0;
+
+    CsvTestOutput source;
+    SetUp(&source);
+    char line[96];
+    for (size_t i = 0; i < 40000; ++i)
+    {
+        int length = (i % 5 == 0) ? snprintf(line, sizeof(line), "%zu,\"multi\nline, \"\"%zu\"\"\",z\n", i, i)
+                                  : snprintf(line, sizeof(line), "%zu,plain,z\n", i);
+        __csvTestAppend(&source, line, length);
+    }
+    // one record far longer than a chunk
+    __csvTestAppend(&source, "long,\"", 6);
+    for (size_t i = 0; i < 20000; ++i) __csvTestAppend(&source, "abc\n,\"\"xyz", 10);
+    __csvTestAppend(&source, "\"\nlast,row", 10);
+
+    const size_t threads[] = { 1, 3, 8 };
+    for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); ++t)
+    {
+        if (__csvTestParallel(source.text, source.length, threads[t])) successes++;
+        else failures++;
+    }
+
+    if (__csvTestParallel("a,b\nc,d\n", 8, 4)) successes++;
+    else failures++;
+
+    if (__csvTestParallel("", 0, 2)) successes++;
+    else failures++;
+
+    char path[32];
+    CsvTestOutput output;
+    CsvParserConfig config = SetUp(&output);
+    config.fieldHandler = __csvTestCollectFields;
+    source.text[source.length - 10] = 'x';  // drop the closing quote of the long record
+    __csvTestWriteFile(path, source.text, source.length);
+    fprintf(stderr, "(expected error) ");
+    if (parseCsvFileParallel(path, &config, 4, CSV_DELIVER_ORDERED) != CSV_ERR_UNBALANCED_QUOTES || output.rows != 0)
+    {
+        printf("FAILED: testCsvParallel: unbalanced quotes not reported before delivery\n");
+        failures++;
+    }
+    else successes++;
+    TearDown(&output, path);
+
+    TearDown(&source, NULL);
+    TestsSummaryPrintResults("CsvParallel", successes, failures);
+}
+
+// Feeds contents in blocks of blockSize; true if the rows match expected
+static bool __csvTestStream(const char* contents, size_t length, size_t blockSize, const char* expected)
+{
+    CsvTestOutput output;
+    CsvParserConfig config = SetUp(&output);
+    config.fieldHandler = __csvTestCollectFields;
+    CsvStreamParser* parser = csvStreamCreate(&config);
+
+    CsvErrorCode result = CSV_SUCCESS;
+    for (size_t offset = 0; offset < length && result == CSV_SUCCESS; offset += blockSize)
+    {
+        // copy so that nothing can point into the caller's buffer after the call
+        size_t size = (length - offset < blockSize) ? length - offset : blockSize;
+        char* block = malloc(size);
+        memcpy(block, contents + offset, size);
+        result = csvStreamFeed(parser, block, size);
+        memset(block, '#', size);
+        free(block);
+    }
+    if (result == CSV_SUCCESS) result = csvStreamFinish(parser);
+
+    bool passed = result == CSV_SUCCESS && output.length == strlen(expected)
+        && memcmp(output.text ? output.text : "", expected, output.length) == 0
+        && csvStreamRowCount(parser) == output.rows;
+    if (!passed) printf("FAILED: testCsvStream: %zu bytes in blocks of %zu\n", length, blockSize);
+
+    csvStreamDestroy(parser);
+    TearDown(&output, NULL);
+    return passed;
+}
+
+void testCsvStream()
+{
+    int successes = 0, failures = 0;
+    const char* contents = "a,\"b\nc\",d\r\n\"\"\"q\"\"\",,\n\nlast,\"x,y\"";
+    const char* expected = "a|b\nc|d\n\"q\"||\n\nlast|x,y\n";
+
+    // every block size from one byte up, so every cut position is covered
+    for (size_t blockSize = 1; blockSize <= strlen(contents) + 1; ++blockSize)
+    {
+        if (__csvTestStream(contents, strlen(contents), blockSize, expected)) successes++;
+        else failures++;
+    }
+
+    // records far longer than a block, and blocks that end on a newline
+    CsvTestOutput source, flat;
+    SetUp(&source);
+    SetUp(&flat);
+    for (size_t i = 0; i < 3000; ++i)
+    {
+        char line[64];
+        int length = snprintf(line, sizeof(line), "%zu,\"%s\n%zu\"\n", i, (i % 100 == 0) ? "" : "v", i);
+        __csvTestAppend(&source, line, length);
+        length = snprintf(line, sizeof(line), "%zu|%s\n%zu\n", i, (i % 100 == 0) ? "" : "v", i);
+        __csvTestAppend(&flat, line, length);
+    }
+    __csvTestAppend(&source, "big,\"", 5);
+    __csvTestAppend(&flat, "big|", 4);
+    for (size_t i = 0; i < 50000; ++i)
+    {
+        __csvTestAppend(&source, "0123456789\n", 11);
+        __csvTestAppend(&flat, "0123456789\n", 11);
+    }
+    __csvTestAppend(&source, "\"\n", 2);
+    __csvTestAppend(&flat, "\n", 1);
+
+    const size_t blockSizes[] = { 13, 4096, 65536, 1 << 20 };
+    for (size_t b = 0; b < sizeof(blockSizes) / sizeof(blockSizes[0]); ++b)
+    {
+        if (__csvTestStream(source.text, source.length, blockSizes[b], flat.text)) successes++;
+        else failures++;
+    }
+
+    // parseCsvFile goes through the stream parser: embedded newlines, no leak
+    char path[32];
+    __csvTestWriteFile(path, source.text, source.length);
+    CsvTestOutput output;
+    CsvParserConfig config = SetUp(&output);
+    config.rowHandler = __csvTestCollectRow;
+    if (!parseCsvFile(path, &config) || output.length != flat.length || memcmp(output.text, flat.text, flat.length) != 0)
+    {
+        printf("FAILED: testCsvStream: parseCsvFile with embedded newlines\n");
+        failures++;
+    }
+    else successes++;
+    TearDown(&output, path);
+
+    // any FILE*: a pipe
+    int fds[2];
+    if (pipe(fds) == 0)
+    {
+        ssize_t written = write(fds[1], contents, strlen(contents));
+        close(fds[1]);
+        FILE* stream = fdopen(fds[0], "r");
+        config = SetUp(&output);
+        config.fieldHandler = __csvTestCollectFields;
+        if (written < 0 || parseCsvStream(stream, &config) != CSV_SUCCESS || strcmp(output.text, expected) != 0)
+        {
+            printf("FAILED: testCsvStream: parseCsvStream from a pipe\n");
+            failures++;
+        }
+        else successes++;
+        fclose(stream);
+        TearDown(&output, NULL);
+    }
+
+    // a config without a handler is a null input, not a failed allocation
+    config = SetUp(&output);
+    fprintf(stderr, "(expected error) ");
+    if (parseCsvStream(stdin, &config) != CSV_ERR_NULL_INPUT)
+    {
+        printf("FAILED: testCsvStream: parseCsvStream without a handler\n");
+        failures++;
+    }
+    else successes++;
+
+    config = SetUp(&output);
+    config.fieldHandler = __csvTestCollectFields;
+    CsvStreamParser* parser = csvStreamCreate(&config);
+    csvStreamFeed(parser, "a,\"b\n", 5);
+    if (csvStreamFinish(parser) != CSV_ERR_UNBALANCED_QUOTES || output.rows != 0)
+    {
+        printf("FAILED: testCsvStream: unbalanced quotes at end of input\n");
+        failures++;
+    }
+    else successes++;
+    csvStreamDestroy(parser);
+    TearDown(&output, NULL);
+
+    TearDown(&source, NULL);
+    TearDown(&flat, NULL);
+    TestsSummaryPrintResults("CsvStream", successes, failures);
+}
+
+// csvParseDouble must agree bit for bit with strtod
+static bool __csvTestDouble(const char* text)
+{
+    double expected = strtod(text, NULL), parsed;
+    return csvParseDouble(text, strlen(text), &parsed) && memcmp(&parsed, &expected, sizeof(double)) == 0;
+}
+
+void testCsvNumbers()
+{
+    int successes = 0, failures = 0;
+
+    const char* ints[] = { "0", "-0", "+17", "2147483647", "-2147483648", "0000000000042" };
+    const int32_t intValues[] = { 0, 0, 17, INT32_MAX, INT32_MIN, 42 };
+    for (size_t i = 0; i < sizeof(ints) / sizeof(ints[0]); ++i)
+    {
+        int32_t value;
+        if (!csvParseInt32(ints[i], strlen(ints[i]), &value) || value != intValues[i])
+        {
+            printf("FAILED: testCsvNumbers: int32 \"%s\"\n", ints[i]);
+            failures++;
+        }
+        else successes++;
+    }
+    const char* badInts[] = { "", "-", "+", "2147483648", "-2147483649", "12a", "1.0", " 1", "99999999999999999999" };
+    for (size_t i = 0; i < sizeof(badInts) / sizeof(badInts[0]); ++i)
+    {
+        int32_t value;
+        if (csvParseInt32(badInts[i], strlen(badInts[i]), &value))
+        {
+            printf("FAILED: testCsvNumbers: int32 \"%s\" accepted\n", badInts[i]);
+            failures++;
+        }
+        else successes++;
+    }
+
+    // boundaries of every path: Clinger, Eisel-Lemire, subnormals, overflow,
+    // round-to-even ties and the strtod fallback for long inputs
+    const char* doubles[] = {
+        "0", "-0", "26.1", "142.7", "-3.25e-2", ".5", "5.", "1e22", "1e23", "9007199254740993",
+        "1.7976931348623157e308", "1.7976931348623159e308", "1e309", "2.2250738585072014e-308",
+        "2.2250738585072011e-308", "4.9406564584124654e-324", "2.4703282292062327e-324",
+        "2.4703282292062328e-324", "1e-400", "9007199254740993e-3", "7.2057594037927933e16",
+        "123456789012345678901234567890", "0.00000000000000000000000000000000001234",
+        "3.141592653589793238462643383279502884197", "1448997445238699", "8.988465674311579e307"
+    };
+    for (size_t i = 0; i < sizeof(doubles) / sizeof(doubles[0]); ++i)
+    {
+        if (__csvTestDouble(doubles[i])) successes++;
+        else
+        {
+            printf("FAILED: testCsvNumbers: double \"%s\"\n", doubles[i]);
+            failures++;
+        }
+    }
+
+    // random bit patterns and random decimal strings
+    unsigned long state = 3, mismatches = 0;
+    char text[64];
+    for (int i = 0; i < 200000; ++i)
+    {
+        state = state * 6364136223846793005UL + 1442695040888963407UL;
+        uint64_t bits = state ^ (state >> 29) * 0x9E3779B97F4A7C15ULL;
+        double value;
+        memcpy(&value, &bits, sizeof(double));
+        if (i % 2 == 0 && isfinite(value)) snprintf(text, sizeof(text), "%.*g", 1 + (int)(state % 17), value);
+        else snprintf(text, sizeof(text), "%lu.%lue%d", (state >> 20) % 100000, (state >> 40) % 1000,
+                      (int)((state >> 8) % 700) - 350);
+        if (!__csvTestDouble(text))
+        {
+            if (mismatches++ < 5) printf("FAILED: testCsvNumbers: double \"%s\"\n", text);
+        }
+    }
+    if (mismatches) failures++;
+    else successes++;
+
+    const char* badDoubles[] = { "", "-", ".", "e5", "1e", "1e+", "1.2.3", "1,5", "nan", "inf", "0x10", " 1" };
+    for (size_t i = 0; i < sizeof(badDoubles) / sizeof(badDoubles[0]); ++i)
+    {
+        double value;
+        if (csvParseDouble(badDoubles[i], strlen(badDoubles[i]), &value))
+        {
+            printf("FAILED: testCsvNumbers: double \"%s\" accepted\n", badDoubles[i]);
+            failures++;
+        }
+        else successes++;
+    }
+
+    TestsSummaryPrintResults("CsvNumbers", successes, failures);
+}
+
+void testCsvTableLoad()
+{
+    int successes = 0, failures = 0;
+    CsvTestOutput unused;
+    CsvParserConfig config = SetUp(&unused);
+
+    // inferred from data.csv: ints, doubles and strings (Height is 5'2")
+    CsvTable* table = csvTableLoad("../../../__common/data.csv", &config, NULL, 0, true);
+    const CsvColumnType expectedTypes[] = {
+        CSV_COLUMN_STRING, CSV_COLUMN_STRING, CSV_COLUMN_STRING, CSV_COLUMN_STRING, CSV_COLUMN_INT32,
+        CSV_COLUMN_DOUBLE, CSV_COLUMN_STRING, CSV_COLUMN_DOUBLE, CSV_COLUMN_INT32, CSV_COLUMN_INT32
+    };
+    bool typesMatch = table && table->columnCount == 10 && table->rowCount == 100;
+    for (size_t c = 0; typesMatch && c < 10; ++c) typesMatch = (table->columns[c].type == expectedTypes[c]);
+    if (!typesMatch)
+    {
+        printf("FAILED: testCsvTableLoad: inferred schema of data.csv\n");
+        failures++;
+    }
+    else successes++;
+
+    if (typesMatch)
+    {
+        long age = csvTableColumnIndex(table, "Age"), bmi = csvTableColumnIndex(table, "BMI");
+        long height = csvTableColumnIndex(table, "Height"), sex = csvTableColumnIndex(table, "Sex");
+        const char* firstHeight = csvTableString(table, table->columns[height].values.stringIds[0]);
+        if (table->columns[age].values.int32s[0] != 46 || table->columns[bmi].values.doubles[0] != 26.1
+            || strcmp(firstHeight, "5'2\"") != 0 || csvTableColumnIndex(table, "Systolic BP") != 8
+            || table->columns[sex].values.stringIds[0] != csvTableFindString(table, "M", 1)
+            || ((uintptr_t)table->columns[bmi].values.doubles % CSV_TABLE_ALIGNMENT) != 0)
+        {
+            printf("FAILED: testCsvTableLoad: values of data.csv row 1\n");
+            failures++;
+        }
+        else successes++;
+    }
+    csvTableDestroy(table);
+
+    // explicit schema, nulls, invalid values, short rows, blank lines
+    char path[32];
+    const char* contents = "1,2.5,a\n,,\nx,1e3,\"b\"\"c\"\n7\n\n-4,-0.5,a\n";
+    __csvTestWriteFile(path, contents, strlen(contents));
+    const CsvColumnType types[] = { CSV_COLUMN_INT32, CSV_COLUMN_DOUBLE, CSV_COLUMN_STRING };
+    table = csvTableLoad(path, &config, types, 3, false);
+    if (!table || table->rowCount != 5 || table->columns[0].invalidCount != 1
+        || table->columns[0].values.int32s[1] != CSV_NULL_INT32 || table->columns[0].values.int32s[2] != CSV_NULL_INT32
+        || table->columns[0].values.int32s[4] != -4 || !isnan(table->columns[1].values.doubles[3])
+        || table->columns[1].values.doubles[2] != 1000.0 || table->strings.count != 2
+        || strcmp(csvTableString(table, table->columns[2].values.stringIds[2]), "b\"c") != 0
+        || table->columns[2].values.stringIds[0] != table->columns[2].values.stringIds[4]
+        || table->columns[2].values.stringIds[3] != CSV_NULL_STRING || strcmp(table->columns[1].name, "column1") != 0)
+    {
+        printf("FAILED: testCsvTableLoad: explicit schema\n");
+        failures++;
+    }
+    else successes++;
+    csvTableDestroy(table);
+    TearDown(&unused, path);
+
+    // blank lines are null values of a single column, and skipped otherwise
+    contents = "v\n1\n\n\"\"\n3\n";
+    __csvTestWriteFile(path, contents, strlen(contents));
+    table = csvTableLoad(path, &config, NULL, 0, true);
+    bool nulls = table && table->rowCount == 4 && table->columns[0].values.int32s[1] == CSV_NULL_INT32
+        && table->columns[0].values.int32s[2] == CSV_NULL_INT32 && table->columns[0].values.int32s[3] == 3;
+    csvTableDestroy(table);
+    TearDown(&unused, path);
+    contents = "a,b\n1,2\n\n\"\"\n3,4\n";
+    __csvTestWriteFile(path, contents, strlen(contents));
+    table = csvTableLoad(path, &config, NULL, 0, true);
+    nulls = nulls && table && table->rowCount == 3 && table->columns[0].values.int32s[1] == CSV_NULL_INT32
+        && table->columns[1].values.int32s[2] == 4;
+    if (!nulls)
+    {
+        printf("FAILED: testCsvTableLoad: blank lines and null rows\n");
+        failures++;
+    }
+    else successes++;
+    csvTableDestroy(table);
+    TearDown(&unused, path);
+
+    // INT32_MIN is the null sentinel, so it is a double, or invalid as an int
+    contents = "a,b\n-2147483648,x\n";
+    __csvTestWriteFile(path, contents, strlen(contents));
+    table = csvTableLoad(path, &config, NULL, 0, true);
+    bool kept = table && table->columns[0].type == CSV_COLUMN_DOUBLE
+        && csvTableSave(table, path, &config, true) == CSV_SUCCESS;
+    csvTableDestroy(table);
+    CsvTestOutput saved;
+    __csvTestReadFile(path, &saved);
+    kept = kept && saved.text && strcmp(saved.text, contents) == 0;
+    TearDown(&saved, NULL);
+    const CsvColumnType intTypes[] = { CSV_COLUMN_INT32, CSV_COLUMN_STRING };
+    table = csvTableLoad(path, &config, intTypes, 2, true);
+    kept = kept && table && table->columns[0].invalidCount == 1
+        && csvTableAddColumn(table, "c", CSV_COLUMN_INT32, "-2147483648") == CSV_SUCCESS
+        && table->columns[2].invalidCount == 1;
+    if (!kept)
+    {
+        printf("FAILED: testCsvTableLoad: INT32_MIN round trip\n");
+        failures++;
+    }
+    else successes++;
+    csvTableDestroy(table);
+    TearDown(&unused, path);
+
+    TestsSummaryPrintResults("CsvTableLoad", successes, failures);
+}
+
+// Schema changes leave the other columns' buffers where they were
+void testCsvTableColumns()
+{
+    int successes = 0, failures = 0;
+    CsvTestOutput unused;
+    CsvParserConfig config = SetUp(&unused);
+
+    char path[32];
+    const char* contents = "id,name,score\n1,a,2.5\n2,b,\n3,a,-1\n";
+    __csvTestWriteFile(path, contents, strlen(contents));
+    CsvTable* table = csvTableLoad(path, &config, NULL, 0, true);
+    if (!table || table->columnCount != 3 || table->rowCount != 3)
+    {
+        printf("FAILED: testCsvTableColumns: loading\n");
+        TestsSummaryPrintResults("CsvTableColumns", successes, failures + 1);
+        csvTableDestroy(table);
+        TearDown(&unused, path);
+        return;
+    }
+    const double* scores = table->columns[2].values.doubles;
+
+    // 20 columns grow the descriptors past their initial capacity
+    bool added = true;
+    char name[32];
+    for (int c = 0; c < 20; ++c)
+    {
+        snprintf(name, sizeof(name), "extra%d", c);
+        added = added && csvTableAddColumn(table, name, CSV_COLUMN_INT32, "7") == CSV_SUCCESS;
+    }
+    added = added && csvTableAddColumn(table, "tag", CSV_COLUMN_STRING, "new") == CSV_SUCCESS
+        && csvTableAddColumn(table, "ratio", CSV_COLUMN_DOUBLE, NULL) == CSV_SUCCESS
+        && csvTableAddColumn(table, "bad", CSV_COLUMN_INT32, "x") == CSV_SUCCESS;
+    long tag = csvTableColumnIndex(table, "tag"), ratio = csvTableColumnIndex(table, "ratio");
+    long bad = csvTableColumnIndex(table, "bad");
+    CsvTableRow row = csvTableRowAt(table, 2);
+    if (!added || table->columnCount != 26 || table->columns[2].values.doubles != scores
+        || csvTableRowInt32(row, csvTableColumnIndex(table, "extra19")) != 7
+        || strcmp(csvTableRowString(row, tag), "new") != 0
+        || !isnan(csvTableRowDouble(row, ratio)) || csvTableRowInt32(row, bad) != CSV_NULL_INT32
+        || table->columns[bad].invalidCount != 3
+        || ((uintptr_t)table->columns[ratio].values.doubles % CSV_TABLE_ALIGNMENT) != 0)
+    {
+        printf("FAILED: testCsvTableColumns: adding columns\n");
+        failures++;
+    }
+    else successes++;
+
+    if (csvTableDropColumn(table, 1) != CSV_SUCCESS || table->columnCount != 25
+        || table->columns[1].values.doubles != scores
+        || csvTableColumnIndex(table, "name") != -1 || csvTableColumnIndex(table, "tag") != tag - 1
+        || csvTableRowDouble(row, 1) != -1.0 || csvTableRowInt32(row, 0) != 3 || csvTableRowString(row, 0) != NULL
+        || !isnan(csvTableRowDouble(csvTableRowAt(table, 1), 1))
+        || csvTableRowInt32(csvTableRowAt(table, 3), 0) != CSV_NULL_INT32
+        || csvTableDropColumn(table, 25) != CSV_ERR_COLUMN_INDEX_OUT_OF_RANGE)
+    {
+        printf("FAILED: testCsvTableColumns: dropping a column\n");
+        failures++;
+    }
+    else successes++;
+
+    // all of them, then one back
+    while (table->columnCount > 0) csvTableDropColumn(table, table->columnCount - 1);
+    if (csvTableAddColumn(table, "only", CSV_COLUMN_DOUBLE, "0.5") != CSV_SUCCESS || table->columnCount != 1
+        || csvTableRowDouble(csvTableRowAt(table, 0), 0) != 0.5 || csvTableRowDouble(csvTableRowAt(table, 2), 0) != 0.5)
+    {
+        printf("FAILED: testCsvTableColumns: dropping every column\n");
+        failures++;
+    }
+    else successes++;
+
+    csvTableDestroy(table);
+    TearDown(&unused, path);
+    TestsSummaryPrintResults("CsvTableColumns", successes, failures);
+}
+
+void testCsvWriter()
+{
+    int successes = 0, failures = 0;
+    CsvTestOutput output;
+    CsvParserConfig config = SetUp(&output);
+
+    // quotes only where the field needs them
+    char path[32];
+    __csvTestWriteFile(path, "", 0);
+    CsvWriter* writer = csvWriterOpen(path, &config);
+    const char* fields[] = { "plain", "a,b", "say \"hi\"", " padded", "", "line\nbreak", "cr\r", "exactly sixteen!" };
+    csvWriterRow(writer, fields, sizeof(fields) / sizeof(fields[0]));
+    csvWriterInt64(writer, INT64_MIN);
+    csvWriterInt64(writer, 0);
+    csvWriterInt64(writer, 1234567890123);
+    csvWriterDouble(writer, 26.1);
+    csvWriterDouble(writer, -0.05);
+    csvWriterDouble(writer, 1e20);
+    csvWriterDouble(writer, -0.0);
+    csvWriterDouble(writer, NAN);
+    csvWriterDouble(writer, 0.1 + 0.2);
+    csvWriterEndRow(writer);
+    csvWriterEndRow(writer);
+    csvWriterDouble(writer, NAN);
+    csvWriterEndRow(writer);
+    size_t byteCount = csvWriterByteCount(writer);
+    CsvErrorCode result = csvWriterClose(writer);
+
+    const char* expected = "plain,\"a,b\",\"say \"\"hi\"\"\",\" padded\",,\"line\nbreak\",\"cr\r\",exactly sixteen!\n"
+                           "-9223372036854775808,0,1234567890123,26.1,-0.05,1e+20,-0,,0.30000000000000004\n\n\"\"\n";
+    CsvTestOutput written;
+    __csvTestReadFile(path, &written);
+    if (result != CSV_SUCCESS || byteCount != strlen(expected) || strcmp(written.text, expected) != 0)
+    {
+        printf("FAILED: testCsvWriter: wrote \"%s\"\n", written.text ? written.text : "");
+        failures++;
+    }
+    else successes++;
+    TearDown(&written, NULL);
+
+    // and reads back as written
+    config.fieldHandler = __csvTestCollectFields;
+    if (parseCsvFileMapped(path, &config) != CSV_SUCCESS || output.rows != 4
+        || strncmp(output.text, "plain|a,b|say \"hi\"| padded||line\nbreak|cr\r|exactly sixteen!\n", 57) != 0)
+    {
+        printf("FAILED: testCsvWriter: reading back \"%s\"\n", output.text ? output.text : "");
+        failures++;
+    }
+    else successes++;
+    TearDown(&output, path);
+
+    // a special byte at every position of every block size of the scan
+    int devNull = open("/dev/null", O_WRONLY);
+    writer = csvWriterCreate(devNull, &config);
+    const char specials[] = { ',', '"', '\n', '\r', 'a' };
+    char field[40];
+    bool scanned = true;
+    for (size_t length = 1; length <= sizeof(field); ++length)
+    {
+        for (size_t at = 1; at + 1 < length; ++at)
+        {
+            for (size_t k = 0; k < sizeof(specials); ++k)
+            {
+                memset(field, 'a', length);
+                field[at] = specials[k];
+                size_t before = csvWriterByteCount(writer);
+                csvWriterField(writer, field, length);
+                csvWriterEndRow(writer);
+                size_t expectedLength = length + 1 + (specials[k] == 'a' ? 0 : 2) + (specials[k] == '"');
+                scanned = scanned && csvWriterByteCount(writer) - before == expectedLength;
+            }
+        }
+    }
+    if (csvWriterClose(writer) != CSV_SUCCESS || !scanned)
+    {
+        printf("FAILED: testCsvWriter: quoting decision\n");
+        failures++;
+    }
+    else successes++;
+    close(devNull);
+
+    // shortest doubles that parse back bit for bit
+    unsigned long state = 17, mismatches = 0;
+    for (int i = 0; i < 200000; ++i)
+    {
+        state = state * 6364136223846793005UL + 1442695040888963407UL;
+        uint64_t bits = state ^ (state >> 29) * 0x9E3779B97F4A7C15ULL;
+        double value;
+        memcpy(&value, &bits, sizeof(double));
+        if (i % 2) value = (double)(state >> 40) / pow(10, (double)(state % 8));
+        if (!isfinite(value)) continue;
+
+        char text[CSV_NUMBER_TEXT_MAX + 1], shortest[32];
+        size_t length = csvFormatDouble(value, text);
+        double parsed;
+        int digits = snprintf(shortest, sizeof(shortest), "%.17g", value);
+        if (!csvParseDouble(text, length, &parsed) || memcmp(&parsed, &value, sizeof(double)) != 0
+            || length > (size_t)digits)
+        {
+            text[length] = '\0';
+            if (mismatches++ < 5) printf("FAILED: testCsvWriter: %.17g formatted as \"%s\"\n", value, text);
+        }
+    }
+    if (mismatches) failures++;
+    else successes++;
+
+    // megabytes of rows across every buffer, with fields written in place
+    CsvTestOutput flat;
+    SetUp(&flat);
+    char* big = malloc(CSV_WRITER_DIRECT * 2);
+    memset(big, 'x', CSV_WRITER_DIRECT * 2);
+    big[CSV_WRITER_DIRECT] = '"';
+    __csvTestWriteFile(path, "", 0);
+    config = SetUp(&output);
+    writer = csvWriterOpen(path, &config);
+    char line[96];
+    for (size_t i = 0; i < 120000; ++i)
+    {
+        int length = snprintf(line, sizeof(line), "row %zu, \"%zu\"", i, i * 3);
+        csvWriterInt64(writer, (int64_t)i);
+        csvWriterField(writer, line, length);
+        csvWriterDouble(writer, i / 8.0);
+        csvWriterEndRow(writer);
+        length = snprintf(line, sizeof(line), "%zu|row %zu, \"%zu\"|%.17g\n", i, i, i * 3, i / 8.0);
+        __csvTestAppend(&flat, line, length);
+
+        if (i % 40000 == 0)
+        {
+            // both large fields, one needing quotes and one going straight out
+            size_t quoted = CSV_WRITER_DIRECT * 2, direct = CSV_WRITER_DIRECT;
+            csvWriterField(writer, big, (i == 0) ? quoted : direct);
+            csvWriterEndRow(writer);
+            __csvTestAppend(&flat, big, (i == 0) ? quoted : direct);
+            __csvTestAppend(&flat, "\n", 1);
+        }
+    }
+    result = csvWriterClose(writer);
+    config.rowHandler = __csvTestCollectRow;
+    if (result != CSV_SUCCESS || !parseCsvFile(path, &config) || output.length != flat.length
+        || memcmp(output.text, flat.text, flat.length) != 0)
+    {
+        printf("FAILED: testCsvWriter: %zu bytes of rows did not read back\n", flat.length);
+        failures++;
+    }
+    else successes++;
+    free(big);
+    TearDown(&flat, NULL);
+    TearDown(&output, path);
+
+    // a table saved and loaded again is the same table
+    config = SetUp(&output);
+    CsvTable* table = csvTableLoad("../../../__common/data.csv", &config, NULL, 0, true);
+    __csvTestWriteFile(path, "", 0);
+    CsvTable* reloaded = (table && csvTableSave(table, path, &config, true) == CSV_SUCCESS)
+        ? csvTableLoad(path, &config, NULL, 0, true) : NULL;
+    bool same = reloaded && reloaded->rowCount == table->rowCount && reloaded->columnCount == table->columnCount;
+    for (size_t c = 0; same && c < table->columnCount; ++c)
+    {
+        const CsvColumn* a = &table->columns[c];
+        const CsvColumn* b = &reloaded->columns[c];
+        same = a->type == b->type && strcmp(a->name, b->name) == 0;
+        for (size_t r = 0; same && r < table->rowCount; ++r)
+        {
+            switch (a->type)
+            {
+                case CSV_COLUMN_INT32: same = a->values.int32s[r] == b->values.int32s[r]; break;
+                case CSV_COLUMN_DOUBLE:
+                    same = memcmp(&a->values.doubles[r], &b->values.doubles[r], sizeof(double)) == 0;
+                    break;
+                case CSV_COLUMN_STRING:
+                    same = strcmp(csvTableString(table, a->values.stringIds[r]),
+                                  csvTableString(reloaded, b->values.stringIds[r])) == 0;
+                    break;
+            }
+        }
+    }
+    if (!same)
+    {
+        printf("FAILED: testCsvWriter: data.csv saved and reloaded\n");
+        failures++;
+    }
+    else successes++;
+    csvTableDestroy(table);
+    csvTableDestroy(reloaded);
+    TearDown(&output, path);
+
+    // write errors stick
+    __csvTestWriteFile(path, "", 0);
+    int fd = open(path, O_RDONLY);
+    writer = csvWriterCreate(fd, &config);
+    csvWriterField(writer, "a", 1);
+    fprintf(stderr, "(expected error) ");
+    if (csvWriterFlush(writer) != CSV_ERR_FILE_WRITE || csvWriterInt64(writer, 1) != CSV_ERR_FILE_WRITE
+        || csvWriterClose(writer) != CSV_ERR_FILE_WRITE)
+    {
+        printf("FAILED: testCsvWriter: write error not reported\n");
+        failures++;
+    }
+    else successes++;
+    close(fd);
+    unlink(path);
+
+    // single-column null rows survive csvTableSave and csvTableLoad
+    const CsvColumnType types[] = { CSV_COLUMN_INT32, CSV_COLUMN_DOUBLE, CSV_COLUMN_STRING };
+    bool roundTrip = true;
+    for (size_t t = 0; t < 3; ++t)
+    {
+        config = SetUp(&output);
+        __csvTestWriteFile(path, "w\n\"\"\n\"\"\n", 7);
+        CsvTable* table = csvTableLoad(path, &config, &types[t], 1, true);
+        roundTrip = roundTrip && table && table->rowCount == 2
+            && csvTableSave(table, path, &config, true) == CSV_SUCCESS;
+        csvTableDestroy(table);
+        __csvTestReadFile(path, &output);
+        table = csvTableLoad(path, &config, &types[t], 1, true);
+        roundTrip = roundTrip && table && table->rowCount == 2 && strcmp(output.text, "w\n\"\"\n\"\"\n") == 0
+            && csvTableRowString(csvTableRowAt(table, 1), 0) == NULL
+            && csvTableRowInt32(csvTableRowAt(table, 1), 0) == CSV_NULL_INT32
+            && isnan(csvTableRowDouble(csvTableRowAt(table, 1), 0));
+        csvTableDestroy(table);
+        TearDown(&output, path);
+    }
+    if (!roundTrip)
+    {
+        printf("FAILED: testCsvWriter: null rows of one column\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("CsvWriter", successes, failures);
+}
+
+// Projected and filtered parses of contents through every entry point; true
+// if all of them produce expected
+static bool __csvTestProjected(const char* contents, uint64_t mask, const CsvPredicate* predicates,
+                               size_t predicateCount, const char* expected)
+{
+    char path[32];
+    __csvTestWriteFile(path, contents, strlen(contents));
+    bool passed = true;
+
+    for (int entry = 0; entry < 4; ++entry)
+    {
+        CsvTestOutput output;
+        CsvParserConfig config = SetUp(&output);
+        config.projectionMask = mask;
+        config.predicates = predicates;
+        config.predicateCount = predicateCount;
+        bool parsed;
+        switch (entry)
+        {
+            case 0:
+                config.fieldHandler = __csvTestCollectFields;
+                parsed = parseCsvFileMapped(path, &config) == CSV_SUCCESS;
+                break;
+            case 1:
+                config.rowHandler = __csvTestCollectRow;
+                parsed = parseCsvFileMapped(path, &config) == CSV_SUCCESS;
+                break;
+            case 2:
+                config.fieldHandler = __csvTestCollectFields;
+                parsed = parseCsvFileParallel(path, &config, 3, CSV_DELIVER_ORDERED) == CSV_SUCCESS;
+                break;
+            default:
+                config.rowHandler = __csvTestCollectRow;
+                parsed = parseCsvFile(path, &config);
+                break;
+        }
+        if (!parsed || strcmp(output.text ? output.text : "", expected) != 0)
+        {
+            printf("FAILED: testCsvProjection: entry point %d: expected \"%s\", got \"%s\"\n", entry, expected,
+                   output.text ? output.text : "");
+            passed = false;
+        }
+        TearDown(&output, NULL);
+    }
+
+    unlink(path);
+    return passed;
+}
+
+static void __csvTestCountAbove60(size_t rowIndex, const CsvField* fields, size_t fieldCount, void* userData)
+{
+    double age;
+    if (fieldCount == 1 && csvParseDouble(fields[0].data, fields[0].length, &age) && age > 60) (*(size_t*)userData)++;
+}
+
+void testCsvProjection()
+{
+    int successes = 0, failures = 0;
+    const char* contents = "id,name,score\n1,\"a\"\"x\",10.5\n2,b,3\n3,\"c,d\",7e1\n4,b\n";
+
+    if (__csvTestProjected(contents, 0x5, NULL, 0, "id|score\n1|10.5\n2|3\n3|7e1\n4\n")) successes++;
+    else failures++;
+
+    // the header and the short row have no number to compare
+    const CsvPredicate above5 = { .column = 2, .op = CSV_OP_GT, .numeric = true, .number = 5 };
+    if (__csvTestProjected(contents, 0x3, &above5, 1, "1|a\"x\n3|c,d\n")) successes++;
+    else failures++;
+
+    const CsvPredicate escaped = { .column = 1, .op = CSV_OP_EQ, .text = "a\"x" };
+    if (__csvTestProjected(contents, 0, &escaped, 1, "1|a\"x|10.5\n")) successes++;
+    else failures++;
+
+    const CsvPredicate both[] = {
+        { .column = 1, .op = CSV_OP_GE, .text = "b" },
+        { .column = 2, .op = CSV_OP_LE, .numeric = true, .number = 3 }
+    };
+    if (__csvTestProjected(contents, 0, both, 2, "2|b|3\n")) successes++;
+    else failures++;
+
+    const CsvPredicate notB = { .column = 1, .op = CSV_OP_NE, .text = "b" };
+    if (__csvTestProjected(contents, 0x1, &notB, 1, "id\n1\n3\n")) successes++;
+    else failures++;
+
+    // data.csv: 34 patients over 60, with only the Age column delivered
+    CsvTestOutput unused;
+    CsvParserConfig config = SetUp(&unused);
+    size_t count = 0;
+    const CsvPredicate over60 = { .column = 4, .op = CSV_OP_GT, .numeric = true, .number = 60 };
+    config.fieldHandler = __csvTestCountAbove60;
+    config.userData = &count;
+    config.projectionMask = 1ULL << 4;
+    config.predicates = &over60;
+    config.predicateCount = 1;
+    if (parseCsvFileMapped("../../../__common/data.csv", &config) != CSV_SUCCESS || count != 34)
+    {
+        printf("FAILED: testCsvProjection: data.csv Age > 60 gave %zu rows\n", count);
+        failures++;
+    }
+    else successes++;
+    TearDown(&unused, NULL);
+
+    // predicates that cannot be evaluated are rejected up front
+    const CsvPredicate noText = { .column = 3, .op = CSV_OP_EQ };
+    config.predicates = &noText;
+    fprintf(stderr, "(expected error) ");
+    CsvErrorCode withoutText = parseCsvFileMapped("../../../__common/data.csv", &config);
+    config.predicates = NULL;
+    fprintf(stderr, "(expected error) ");
+    if (withoutText != CSV_ERR_NULL_INPUT
+        || parseCsvFileParallel("../../../__common/data.csv", &config, 2, CSV_DELIVER_ORDERED) != CSV_ERR_NULL_INPUT)
+    {
+        printf("FAILED: testCsvProjection: NULL predicate text or predicates accepted\n");
+        failures++;
+    }
+    else successes++;
+
+    TestsSummaryPrintResults("CsvProjection", successes, failures);
+}
+
+// Batches flattened like __csvTestCollectFields, with their shape checked
+typedef struct
+{
+    CsvTestOutput output;
+    size_t batchSize;
+    size_t batches;
+    size_t expectedRow;        // rows arrive in order, except unordered parallel
+    bool ordered;
+    bool valid;
+    atomic_size_t rows;
+} CsvTestBatches;
+
+static void __csvTestCollectBatch(const CsvBatch* batch, void* userData)
+{
+    CsvTestBatches* collected = userData;
+    atomic_fetch_add(&collected->rows, batch->rowCount);
+    if (!collected->ordered) return;
+
+    collected->batches++;
+    if (batch->rowCount == 0 || batch->rowCount > collected->batchSize || batch->rowStarts[0] != 0)
+    {
+        collected->valid = false;
+    }
+    for (size_t r = 0; r < batch->rowCount; ++r)
+    {
+        if (batch->rowIndices[r] < collected->expectedRow) collected->valid = false;
+        collected->expectedRow = batch->rowIndices[r] + 1;
+        for (size_t f = batch->rowStarts[r]; f < batch->rowStarts[r + 1]; ++f)
+        {
+            const char* field = batch->data + batch->fieldOffsets[f];
+            if (strlen(field) != batch->fieldOffsets[f + 1] - batch->fieldOffsets[f] - 1) collected->valid = false;
+            __csvTestAppend(&collected->output, field, strlen(field));
+            __csvTestAppend(&collected->output, (f + 1 < batch->rowStarts[r + 1]) ? "|" : "\n", 1);
+        }
+        collected->output.rows++;
+        collected->output.lastRowIndex = batch->rowIndices[r];
+    }
+}
+
+// Batched parses of contents through every entry point match the per-row one
+static bool __csvTestBatched(const char* contents, size_t length, size_t batchSize, uint64_t mask)
+{
+    char path[32];
+    __csvTestWriteFile(path, contents, length);
+
+    CsvTestOutput expected;
+    CsvParserConfig config = SetUp(&expected);
+    config.fieldHandler = __csvTestCollectFields;
+    config.projectionMask = mask;
+    parseCsvFileMapped(path, &config);
+    bool passed = true;
+
+    for (int entry = 0; entry < 4; ++entry)
+    {
+        CsvTestBatches collected = { .batchSize = batchSize ? batchSize : CSV_DEFAULT_BATCH_ROWS, .valid = true };
+        atomic_init(&collected.rows, 0);
+        config = SetUp(&collected.output);
+        config.batchHandler = __csvTestCollectBatch;
+        config.batchSize = batchSize;
+        config.projectionMask = mask;
+        config.userData = &collected;
+        collected.ordered = (entry != 3);
+        CsvErrorCode result;
+        switch (entry)
+        {
+            case 0: result = parseCsvFileMapped(path, &config); break;
+            case 1: result = parseCsvFile(path, &config) ? CSV_SUCCESS : CSV_ERR_FILE_OPEN; break;
+            case 2: result = parseCsvFileParallel(path, &config, 3, CSV_DELIVER_ORDERED); break;
+            default: result = parseCsvFileParallel(path, &config, 3, CSV_DELIVER_UNORDERED); break;
+        }
+
+        size_t expectedBatches = (expected.rows + collected.batchSize - 1) / collected.batchSize;
+        bool matches = result == CSV_SUCCESS && atomic_load(&collected.rows) == expected.rows
+            && (!collected.ordered || (collected.valid && collected.batches == expectedBatches
+                && collected.output.length == expected.length
+                && memcmp(collected.output.text ? collected.output.text : "", expected.text ? expected.text : "",
+                          expected.length) == 0));
+        if (!matches)
+        {
+            printf("FAILED: testCsvBatches: entry point %d, %zu bytes in batches of %zu\n", entry, length, batchSize);
+            passed = false;
+        }
+        TearDown(&collected.output, NULL);
+    }
+
+    TearDown(&expected, path);
+    return passed;
+}
+
+void testCsvBatches()
+{
+    int successes = 0, failures = 0;
+    const char* contents = "a,\"b\nc\",d\r\n\"\"\"q\"\"\",,\n\nlast,\"x,y\"";
+
+    const size_t batchSizes[] = { 1, 2, 0 };
+    for (size_t b = 0; b < sizeof(batchSizes) / sizeof(batchSizes[0]); ++b)
+    {
+        if (__csvTestBatched(contents, strlen(contents), batchSizes[b], 0)) successes++;
+        else failures++;
+    }
+
+    // many full batches across chunks and blocks, some projected away
+    CsvTestOutput source;
+    SetUp(&source);
+    char line[64];
+    for (size_t i = 0; i < 30000; ++i)
+    {
+        int length = snprintf(line, sizeof(line), "%zu,\"v\"\"%zu\",%s\n", i, i % 7, (i % 11 == 0) ? "" : "w");
+        __csvTestAppend(&source, line, length);
+    }
+    if (__csvTestBatched(source.text, source.length, 0, 0)) successes++;
+    else failures++;
+
+    if (__csvTestBatched(source.text, source.length, 1000, 0x6)) successes++;
+    else failures++;
+
+    // filtered rows keep their row numbers
+    char path[32];
+    __csvTestWriteFile(path, contents, strlen(contents));
+    CsvTestBatches collected = { .batchSize = 2, .valid = true, .ordered = true };
+    atomic_init(&collected.rows, 0);
+    CsvParserConfig config = SetUp(&collected.output);
+    const CsvPredicate notEmpty = { .column = 0, .op = CSV_OP_NE, .text = "" };
+    config.batchHandler = __csvTestCollectBatch;
+    config.batchSize = 2;
+    config.userData = &collected;
+    config.predicates = &notEmpty;
+    config.predicateCount = 1;
+    if (parseCsvFileMapped(path, &config) != CSV_SUCCESS || collected.output.rows != 3
+        || collected.output.lastRowIndex != 3 || collected.batches != 2)
+    {
+        printf("FAILED: testCsvBatches: predicate with batches\n");
+        failures++;
+    }
+    else successes++;
+    TearDown(&collected.output, path);
+
+    TearDown(&source, NULL);
+    TestsSummaryPrintResults("CsvBatches", successes, failures);
+}
+
+// Same schema, values and strings
+static bool __csvTestSameTable(const CsvTable* a, const CsvTable* b)
+{
+    if (!a || !b || a->rowCount != b->rowCount || a->columnCount != b->columnCount) return false;
+    for (size_t c = 0; c < a->columnCount; ++c)
+    {
+        const CsvColumn* x = &a->columns[c];
+        const CsvColumn* y = &b->columns[c];
+        if (x->type != y->type || x->invalidCount != y->invalidCount || strcmp(x->name, y->name) != 0) return false;
+        for (size_t r = 0; r < a->rowCount; ++r)
+        {
+            CsvTableRow rowA = csvTableRowAt(a, r), rowB = csvTableRowAt(b, r);
+            const char* textA = csvTableRowString(rowA, c);
+            const char* textB = csvTableRowString(rowB, c);
+            double realA = csvTableRowDouble(rowA, c), realB = csvTableRowDouble(rowB, c);
+            if (csvTableRowInt32(rowA, c) != csvTableRowInt32(rowB, c)
+                || memcmp(&realA, &realB, sizeof(double)) != 0
+                || ((textA || textB) && (!textA || !textB || strcmp(textA, textB) != 0))) return false;
+        }
+    }
+    return true;
+}
+
+void testCsvTableCache()
+{
+    int successes = 0, failures = 0;
+    CsvTestOutput source;
+    CsvParserConfig config = SetUp(&source);
+
+    // a copy of data.csv, so that it can be changed
+    char path[32], cachePath[48];
+    __csvTestReadFile("../../../__common/data.csv", &source);
+    __csvTestWriteFile(path, source.text, source.length);
+    snprintf(cachePath, sizeof(cachePath), "%s.cache", path);
+    CsvTable* parsed = csvTableLoad(path, &config, NULL, 0, true);
+
+    // built on the first load, mapped on the next
+    CsvTable* built = csvTableLoadCached(path, cachePath, &config, NULL, 0, true);
+    CsvTable* cached = csvTableLoadCached(path, cachePath, &config, NULL, 0, true);
+    if (!built || built->mapping || !cached || !cached->mapping || !__csvTestSameTable(parsed, built)
+        || !__csvTestSameTable(parsed, cached)
+        || csvTableFindString(cached, "F", 1) != csvTableFindString(parsed, "F", 1)
+        || csvTableFindString(cached, "F", 1) == CSV_NULL_STRING
+        || ((uintptr_t)cached->columns[5].values.doubles % CSV_TABLE_ALIGNMENT) != 0)
+    {
+        printf("FAILED: testCsvTableCache: reloading data.csv\n");
+        failures++;
+    }
+    else successes++;
+    csvTableDestroy(built);
+
+    // a flipped value fails verification, and only verification
+    size_t valueOffset = (size_t)((char*)cached->columns[4].values.int32s - (char*)cached->mapping);
+    csvTableDestroy(cached);
+    int fd = open(cachePath, O_RDWR);
+    char byte;
+    bool flipped = fd >= 0 && pread(fd, &byte, 1, (off_t)valueOffset) == 1;
+    byte ^= 0x10;
+    flipped = flipped && pwrite(fd, &byte, 1, (off_t)valueOffset) == 1;
+    if (fd >= 0) close(fd);
+    fprintf(stderr, "(expected error) ");
+    CsvTable* verified = csvTableOpenCache(cachePath, path, true);
+    CsvTable* trusted = csvTableOpenCache(cachePath, path, false);
+    if (!flipped || verified || !trusted || trusted->columns[4].values.int32s[0] == parsed->columns[4].values.int32s[0])
+    {
+        printf("FAILED: testCsvTableCache: corrupted column\n");
+        failures++;
+    }
+    else successes++;
+    csvTableDestroy(verified);
+    csvTableDestroy(trusted);
+
+    // which makes the next load parse again
+    fprintf(stderr, "(expected error) ");
+    built = csvTableLoadCached(path, cachePath, &config, NULL, 0, true);
+    cached = csvTableOpenCache(cachePath, path, true);
+    if (!built || built->mapping || !cached || !__csvTestSameTable(parsed, cached))
+    {
+        printf("FAILED: testCsvTableCache: rebuilding a corrupt cache\n");
+        failures++;
+    }
+    else successes++;
+    csvTableDestroy(built);
+
+    // schema changes on a mapped table leave the mapping alone
+    CsvTableRow row = csvTableRowAt(cached, 99);
+    const char* id = csvTableRowString(row, 2);
+    bool changed = csvTableAddColumn(cached, "tag", CSV_COLUMN_STRING, "cached") == CSV_SUCCESS
+        && csvTableAddColumn(cached, "F", CSV_COLUMN_STRING, "F") == CSV_SUCCESS
+        && csvTableDropColumn(cached, 0) == CSV_SUCCESS && csvTableDropColumn(cached, 3) == CSV_SUCCESS;
+    cached->columns[6].values.int32s[0] = -1;
+    if (!changed || cached->columnCount != 10 || strcmp(csvTableRowString(row, 8), "cached") != 0
+        || csvTableRowString(row, 1) == NULL || strcmp(csvTableRowString(row, 1), id) != 0
+        || csvTableFindString(cached, "F", 1) != cached->columns[9].values.stringIds[0]
+        || csvTableRowInt32(csvTableRowAt(cached, 0), 6) != -1)
+    {
+        printf("FAILED: testCsvTableCache: changing a mapped table\n");
+        failures++;
+    }
+    else successes++;
+    csvTableDestroy(cached);
+
+    // the source growing, a new mtime, or other types make it stale
+    FILE* file = fopen(path, "ab");
+    fputs("Zed,Zed,ZZZ,M,35,30.5,\"5'9\"\"\",180.2,120,70\n", file);
+    fclose(file);
+    CsvTable* grown = csvTableLoadCached(path, cachePath, &config, NULL, 0, true);
+    cached = csvTableOpenCache(cachePath, path, true);
+    bool stale = grown && !grown->mapping && grown->rowCount == 101 && cached && cached->rowCount == 101;
+    csvTableDestroy(grown);
+    csvTableDestroy(cached);
+
+    struct timespec times[2] = { { 0, UTIME_OMIT }, { 1000000000, 5 } };
+    stale = stale && utimensat(AT_FDCWD, path, times, 0) == 0 && !csvTableOpenCache(cachePath, path, false);
+    // without a source there is nothing to be stale against
+    cached = csvTableOpenCache(cachePath, NULL, false);
+    stale = stale && cached;
+    csvTableDestroy(cached);
+
+    CsvColumnType strings[10];
+    for (size_t c = 0; c < 10; ++c) strings[c] = CSV_COLUMN_STRING;
+    csvTableDestroy(csvTableLoadCached(path, cachePath, &config, NULL, 0, true));
+    CsvTable* retyped = csvTableLoadCached(path, cachePath, &config, strings, 10, true);
+    stale = stale && retyped && !retyped->mapping && retyped->columns[4].type == CSV_COLUMN_STRING;
+    csvTableDestroy(retyped);
+    if (!stale)
+    {
+        printf("FAILED: testCsvTableCache: stale caches\n");
+        failures++;
+    }
+    else successes++;
+
+    // out-of-range strings and ids, and a changed header, are caught even
+    // without the column checksums
+    cached = csvTableOpenCache(cachePath, NULL, false);
+    const char* mapping = cached ? cached->mapping : NULL;
+    off_t patches[] = {
+        cached ? (char*)cached->columns[0].values.stringIds - mapping : 0,  // an id
+        cached ? (char*)&cached->strings.offsets[1] - mapping : 0,          // a string offset
+        cached ? cached->strings.data + cached->strings.length - 1 - mapping : 0, // the last NUL
+        128                                                                // the delimiter, after 16 bytes
+    };                                                                     // and 14 64-bit header fields
+    csvTableDestroy(cached);
+    const uint32_t bad = 0x7FFFFFFF;
+    bool caught = mapping != NULL;
+    fd = open(cachePath, O_RDWR);
+    for (size_t p = 0; caught && p < sizeof(patches) / sizeof(patches[0]); ++p)
+    {
+        uint32_t original;
+        size_t length = (p >= 2) ? 1 : sizeof(bad);
+        caught = pread(fd, &original, length, patches[p]) == (ssize_t)length
+            && pwrite(fd, (p >= 2) ? (const void*)"x" : (const void*)&bad, length, patches[p]) == (ssize_t)length;
+        fprintf(stderr, "(expected error) ");
+        cached = csvTableOpenCache(cachePath, NULL, false);
+        caught = caught && !cached && pwrite(fd, &original, length, patches[p]) == (ssize_t)length;
+        csvTableDestroy(cached);
+    }
+    if (fd >= 0) close(fd);
+    cached = csvTableOpenCache(cachePath, NULL, true);
+    if (!caught || !cached)
+    {
+        printf("FAILED: testCsvTableCache: strings out of range or header changed\n");
+        failures++;
+    }
+    else successes++;
+    csvTableDestroy(cached);
+    unlink(cachePath);
+    TearDown(&source, path);
+
+    // no rows, no strings
+    __csvTestWriteFile(path, "a,b\n", 4);
+    snprintf(cachePath, sizeof(cachePath), "%s.cache", path);
+    csvTableDestroy(csvTableLoadCached(path, cachePath, &config, NULL, 0, true));
+    cached = csvTableOpenCache(cachePath, path, true);
+    if (!cached || cached->rowCount != 0 || cached->columnCount != 2 || csvTableColumnIndex(cached, "b") != 1
+        || csvTableAddColumn(cached, "c", CSV_COLUMN_STRING, "x") != CSV_SUCCESS)
+    {
+        printf("FAILED: testCsvTableCache: empty table\n");
+        failures++;
+    }
+    else successes++;
+    csvTableDestroy(cached);
+    unlink(cachePath);
+    unlink(path);
+
+    csvTableDestroy(parsed);
+    TestsSummaryPrintResults("CsvTableCache", successes, failures);
+}
+
+#endif /* CSVPARSERTEST_H */
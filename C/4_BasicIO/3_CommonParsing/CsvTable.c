@@ -0,0 +1,1095 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "CsvTable.h"
+#include "CsvNumbers.h"
+#include "CsvWriter.h"
+
+// Bytes read per block while sampling for csvTableInferTypes
+#define CSV_TABLE_SAMPLE_BLOCK (64 * 1024)
+
+// Size in bytes of one value of the given type
+static size_t __csvColumnValueSize(CsvColumnType type)
+{
+    return (type == CSV_COLUMN_DOUBLE) ? sizeof(double) : sizeof(uint32_t);
+}
+
+// Internal helper: aligned buffer for count values of the given type
+static void* __csvColumnAllocate(CsvColumnType type, size_t count)
+{
+    size_t bytes = count * __csvColumnValueSize(type);
+    bytes = (bytes + CSV_TABLE_ALIGNMENT - 1) / CSV_TABLE_ALIGNMENT * CSV_TABLE_ALIGNMENT;
+    return aligned_alloc(CSV_TABLE_ALIGNMENT, bytes ? bytes : CSV_TABLE_ALIGNMENT);
+}
+
+// Internal helper: does pointer point into the table's cache mapping
+static bool __csvTableIsMapped(const CsvTable* table, const void* pointer)
+{
+    const char* at = pointer;
+    const char* mapping = table->mapping;
+    return mapping && at >= mapping && at < mapping + table->mappingSize;
+}
+
+// Internal helper: copy a string pool read from a cache to the heap, so that
+// it can grow
+static bool __csvTableOwnStrings(CsvTable* table)
+{
+    CsvStringPool* pool = &table->strings;
+    if (!__csvTableIsMapped(table, pool->data) && !__csvTableIsMapped(table, pool->offsets)) return true;
+
+    char* data = malloc(pool->length ? pool->length : 1);
+    size_t* offsets = malloc((pool->count ? pool->count : 1) * sizeof(size_t));
+    if (!data || !offsets)
+    {
+        free(data);
+        free(offsets);
+        return false;
+    }
+    memcpy(data, pool->data, pool->length);
+    memcpy(offsets, pool->offsets, pool->count * sizeof(size_t));
+    pool->data = data;
+    pool->capacity = pool->length;
+    pool->offsets = offsets;
+    pool->offsetCapacity = pool->count;
+    return true;
+}
+
+// Internal helper: csvParseInt32 for INT32 columns, where INT32_MIN is taken
+// as CSV_NULL_INT32 and so does not fit
+static bool __csvTableParseInt32(const char* text, size_t length, int32_t* out)
+{
+    return csvParseInt32(text, length, out) && *out != CSV_NULL_INT32;
+}
+
+// Internal helper: FNV-1a, for the string pool
+static uint64_t __csvHashString(const char* text, size_t length)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; ++i) hash = (hash ^ (unsigned char)text[i]) * 1099511628211ULL;
+    return hash;
+}
+
+// Internal helper: length of the string with the given id
+static size_t __csvStringPoolLength(const CsvStringPool* pool, uint32_t id)
+{
+    size_t end = (id + 1 < pool->count) ? pool->offsets[id + 1] : pool->length;
+    return end - pool->offsets[id] - 1;
+}
+
+// Internal helper: the slot holding text, or the empty slot where it belongs
+static size_t __csvStringPoolSlot(const CsvStringPool* pool, const char* text, size_t length)
+{
+    size_t mask = pool->slotCount - 1;
+    size_t slot = (size_t)__csvHashString(text, length) & mask;
+    while (pool->slots[slot] != 0)
+    {
+        uint32_t id = pool->slots[slot] - 1;
+        if (__csvStringPoolLength(pool, id) == length && memcmp(pool->data + pool->offsets[id], text, length) == 0)
+        {
+            return slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+// Internal helper: rebuild the hash slots with room for slotCount
+static bool __csvStringPoolRehash(CsvStringPool* pool, size_t slotCount)
+{
+    uint32_t* slots = calloc(slotCount, sizeof(uint32_t));
+    if (!slots) return false;
+
+    free(pool->slots);
+    pool->slots = slots;
+    pool->slotCount = slotCount;
+    for (uint32_t id = 0; id < pool->count; ++id)
+    {
+        const char* text = pool->data + pool->offsets[id];
+        pool->slots[__csvStringPoolSlot(pool, text, __csvStringPoolLength(pool, id))] = id + 1;
+    }
+    return true;
+}
+
+// Internal helper: id of text, adding it to the pool if it is new
+static bool __csvStringPoolIntern(CsvStringPool* pool, const char* text, size_t length, uint32_t* id)
+{
+    // keep the load under one half
+    if ((pool->count + 1) * 2 > pool->slotCount
+        && !__csvStringPoolRehash(pool, pool->slotCount ? pool->slotCount * 2 : 1024)) return false;
+
+    size_t slot = __csvStringPoolSlot(pool, text, length);
+    if (pool->slots[slot] != 0)
+    {
+        *id = pool->slots[slot] - 1;
+        return true;
+    }
+    if (pool->count == CSV_NULL_STRING - 1) return false;
+
+    if (pool->length + length + 1 > pool->capacity)
+    {
+        size_t capacity = (pool->length + length + 1) * 2;
+        char* grown = realloc(pool->data, capacity);
+        if (!grown) return false;
+        pool->data = grown;
+        pool->capacity = capacity;
+    }
+    if (pool->count == pool->offsetCapacity)
+    {
+        uint32_t capacity = pool->offsetCapacity ? pool->offsetCapacity * 2 : 256;
+        size_t* grown = realloc(pool->offsets, capacity * sizeof(size_t));
+        if (!grown) return false;
+        pool->offsets = grown;
+        pool->offsetCapacity = capacity;
+    }
+
+    memcpy(pool->data + pool->length, text, length);
+    pool->data[pool->length + length] = '\0';
+    pool->offsets[pool->count] = pool->length;
+    pool->length += length + 1;
+    pool->slots[slot] = pool->count + 1;
+    *id = pool->count++;
+    return true;
+}
+
+// Per-column type evidence gathered while sampling
+typedef struct {
+    bool hasHeader;
+    size_t maxColumns;
+    size_t columnCount;
+    bool* seen;                // any non-empty value
+    bool* notInt32;
+    bool* notDouble;
+} CsvTypeSample;
+
+// Internal helper: narrow the candidate types with one sampled row
+static void __csvTableSampleRow(size_t rowIndex, const CsvField* fields, size_t fieldCount, void* userData)
+{
+    CsvTypeSample* sample = userData;
+    if (rowIndex >= CSV_TABLE_SAMPLE_ROWS + (sample->hasHeader ? 1 : 0)) return;
+    if (fieldCount > sample->maxColumns) fieldCount = sample->maxColumns;
+    if (fieldCount > sample->columnCount) sample->columnCount = fieldCount;
+    if (rowIndex == 0 && sample->hasHeader) return;
+
+    for (size_t c = 0; c < fieldCount; ++c)
+    {
+        const CsvField* field = &fields[c];
+        if (field->length == 0) continue;
+
+        int32_t integer;
+        double real;
+        sample->seen[c] = true;
+        if (field->hasEscapedQuotes)
+        {
+            sample->notInt32[c] = sample->notDouble[c] = true;
+            continue;
+        }
+        if (!sample->notInt32[c] && !__csvTableParseInt32(field->data, field->length, &integer))
+        {
+            sample->notInt32[c] = true;
+        }
+        if (!sample->notDouble[c] && !csvParseDouble(field->data, field->length, &real)) sample->notDouble[c] = true;
+    }
+}
+
+// Infer column types from a sample of rows
+CsvErrorCode csvTableInferTypes(const char* filePath, const CsvParserConfig* config, bool hasHeader,
+                                CsvColumnType* types, size_t maxColumns, size_t* columnCount)
+{
+    if (!filePath || !config || !types || !columnCount)
+    {
+        fprintf(stderr, "%s: file path, config, types or column count\n", csvErrorMessage(CSV_ERR_NULL_INPUT));
+        return CSV_ERR_NULL_INPUT;
+    }
+
+    FILE* file = fopen(filePath, "rb");
+    if (!file)
+    {
+        fprintf(stderr, "%s: %s\n", csvErrorMessage(CSV_ERR_FILE_OPEN), filePath);
+        return CSV_ERR_FILE_OPEN;
+    }
+
+    CsvTypeSample sample =
+    {
+        hasHeader, maxColumns, 0, calloc(maxColumns, sizeof(bool)), calloc(maxColumns, sizeof(bool)),
+        calloc(maxColumns, sizeof(bool))
+    };
+    CsvParserConfig sampleConfig = *config;
+    sampleConfig.rowHandler = NULL;
+    sampleConfig.fieldHandler = __csvTableSampleRow;
+    sampleConfig.userData = &sample;
+    sampleConfig.projectionMask = 0;
+    sampleConfig.predicates = NULL;
+    sampleConfig.predicateCount = 0;
+    CsvStreamParser* parser = csvStreamCreate(&sampleConfig);
+    char* block = malloc(CSV_TABLE_SAMPLE_BLOCK);
+
+    CsvErrorCode result = (sample.seen && sample.notInt32 && sample.notDouble && parser && block) ? CSV_SUCCESS : CSV_ERR_MEMORY_ALLOCATION;
+    size_t length;
+    while (result == CSV_SUCCESS && csvStreamRowCount(parser) < CSV_TABLE_SAMPLE_ROWS + (hasHeader ? 1 : 0)
+           && (length = fread(block, 1, CSV_TABLE_SAMPLE_BLOCK, file)) > 0)
+    {
+        result = csvStreamFeed(parser, block, length);
+    }
+    if (result == CSV_SUCCESS && feof(file)) result = csvStreamFinish(parser);
+
+    if (result == CSV_SUCCESS)
+    {
+        for (size_t c = 0; c < sample.columnCount; ++c)
+        {
+            // columns without a single value stay strings
+            types[c] = !sample.seen[c] ? CSV_COLUMN_STRING
+                : !sample.notInt32[c] ? CSV_COLUMN_INT32
+                : !sample.notDouble[c] ? CSV_COLUMN_DOUBLE : CSV_COLUMN_STRING;
+        }
+        *columnCount = sample.columnCount;
+    }
+    else fprintf(stderr, "%s: sampling %s\n", csvErrorMessage(result), filePath);
+
+    csvStreamDestroy(parser);
+    free(block);
+    free(sample.seen);
+    free(sample.notInt32);
+    free(sample.notDouble);
+    fclose(file);
+    return result;
+}
+
+// State of csvTableLoad while rows stream in
+typedef struct {
+    CsvTable* table;
+    bool hasHeader;
+    char quoteChar;
+    char* scratch;             // unescaped copies of fields
+    size_t scratchCapacity;
+    bool failed;
+} CsvTableLoader;
+
+// Internal helper: make room for rowCount rows in every column
+static bool __csvTableReserve(CsvTable* table, size_t rowCount)
+{
+    if (rowCount <= table->rowCapacity) return true;
+
+    size_t capacity = table->rowCapacity ? table->rowCapacity * 2 : 1024;
+    while (capacity < rowCount) capacity *= 2;
+    for (size_t c = 0; c < table->columnCount; ++c)
+    {
+        CsvColumn* column = &table->columns[c];
+        void* grown = __csvColumnAllocate(column->type, capacity);
+        if (!grown) return false;
+        if (table->rowCount > 0) memcpy(grown, column->values.int32s, table->rowCount * __csvColumnValueSize(column->type));
+        free(column->values.int32s);
+        column->values.int32s = grown;
+    }
+    table->rowCapacity = capacity;
+    return true;
+}
+
+// Internal helper: the field's text with escaped quotes collapsed
+static const char* __csvTableFieldText(CsvTableLoader* loader, const CsvField* field, size_t* length)
+{
+    *length = field->length;
+    if (!field->hasEscapedQuotes) return field->data;
+
+    if (field->length + 1 > loader->scratchCapacity)
+    {
+        char* grown = realloc(loader->scratch, (field->length + 1) * 2);
+        if (!grown) return NULL;
+        loader->scratch = grown;
+        loader->scratchCapacity = (field->length + 1) * 2;
+    }
+    *length = csvFieldCopy(field, loader->quoteChar, loader->scratch);
+    return loader->scratch;
+}
+
+// Internal helper: convert one row into the columns
+static void __csvTableAppendRow(size_t rowIndex, const CsvField* fields, size_t fieldCount, void* userData)
+{
+    CsvTableLoader* loader = userData;
+    CsvTable* table = loader->table;
+    if (loader->failed) return;
+
+    if (rowIndex == 0 && loader->hasHeader)
+    {
+        for (size_t c = 0; c < table->columnCount && c < fieldCount; ++c)
+        {
+            size_t length;
+            const char* text = __csvTableFieldText(loader, &fields[c], &length);
+            char* name = text ? malloc(length + 1) : NULL;
+            if (!name)
+            {
+                loader->failed = true;
+                return;
+            }
+            memcpy(name, text, length);
+            name[length] = '\0';
+            free(table->columns[c].name);
+            table->columns[c].name = name;
+        }
+        return;
+    }
+    // a blank line is not a row of a wider table; with one column it is a null value
+    if (table->columnCount > 1 && fieldCount == 1 && fields[0].length == 0 && !fields[0].quoted) return;
+
+    if (!__csvTableReserve(table, table->rowCount + 1))
+    {
+        loader->failed = true;
+        return;
+    }
+
+    size_t row = table->rowCount++;
+    for (size_t c = 0; c < table->columnCount; ++c)
+    {
+        CsvColumn* column = &table->columns[c];
+        const CsvField* field = (c < fieldCount) ? &fields[c] : NULL;
+        bool present = field && field->length > 0;
+
+        switch (column->type)
+        {
+            case CSV_COLUMN_INT32:
+            {
+                int32_t value = CSV_NULL_INT32;
+                if (present && (field->hasEscapedQuotes || !__csvTableParseInt32(field->data, field->length, &value)))
+                {
+                    value = CSV_NULL_INT32;
+                    column->invalidCount++;
+                }
+                column->values.int32s[row] = value;
+                break;
+            }
+            case CSV_COLUMN_DOUBLE:
+            {
+                double value = NAN;
+                if (present && (field->hasEscapedQuotes || !csvParseDouble(field->data, field->length, &value)))
+                {
+                    value = NAN;
+                    column->invalidCount++;
+                }
+                column->values.doubles[row] = value;
+                break;
+            }
+            case CSV_COLUMN_STRING:
+            {
+                uint32_t id = CSV_NULL_STRING;
+                size_t length;
+                const char* text = present ? __csvTableFieldText(loader, field, &length) : NULL;
+                if (present && (!text || !__csvStringPoolIntern(&table->strings, text, length, &id)))
+                {
+                    loader->failed = true;
+                    return;
+                }
+                column->values.stringIds[row] = id;
+                break;
+            }
+        }
+    }
+}
+
+// Load a CSV file into typed columns
+CsvTable* csvTableLoad(const char* filePath, const CsvParserConfig* config, const CsvColumnType* types,
+                       size_t columnCount, bool hasHeader)
+{
+    if (!filePath || !config)
+    {
+        fprintf(stderr, "%s: file path or config\n", csvErrorMessage(CSV_ERR_NULL_INPUT));
+        return NULL;
+    }
+
+    CsvColumnType* inferred = NULL;
+    if (!types)
+    {
+        // a schema wider than 4096 columns has to be given explicitly
+        inferred = malloc(4096 * sizeof(CsvColumnType));
+        if (!inferred || csvTableInferTypes(filePath, config, hasHeader, inferred, 4096, &columnCount) != CSV_SUCCESS)
+        {
+            free(inferred);
+            return NULL;
+        }
+        types = inferred;
+    }
+
+    CsvTable* table = calloc(1, sizeof(CsvTable));
+    if (table) table->columns = calloc(columnCount ? columnCount : 1, sizeof(CsvColumn));
+    if (!table || !table->columns)
+    {
+        fprintf(stderr, "%s: creating table\n", csvErrorMessage(CSV_ERR_MEMORY_ALLOCATION));
+        free(table);
+        free(inferred);
+        return NULL;
+    }
+    table->columnCount = columnCount;
+    table->columnCapacity = columnCount ? columnCount : 1;
+
+    bool failed = false;
+    for (size_t c = 0; c < columnCount; ++c)
+    {
+        table->columns[c].type = types[c];
+        table->columns[c].name = malloc(32);
+        if (table->columns[c].name) snprintf(table->columns[c].name, 32, "column%zu", c);
+        else failed = true;
+    }
+    free(inferred);
+
+    CsvTableLoader loader = { table, hasHeader, config->quoteChar, NULL, 0, failed };
+    CsvParserConfig loadConfig = *config;
+    loadConfig.rowHandler = NULL;
+    loadConfig.fieldHandler = __csvTableAppendRow;
+    loadConfig.userData = &loader;
+    loadConfig.projectionMask = 0;
+    loadConfig.predicates = NULL;
+    loadConfig.predicateCount = 0;
+
+    CsvErrorCode result = failed ? CSV_ERR_MEMORY_ALLOCATION : parseCsvFileMapped(filePath, &loadConfig);
+    free(loader.scratch);
+    if (result != CSV_SUCCESS || loader.failed)
+    {
+        if (loader.failed) fprintf(stderr, "%s: loading %s\n", csvErrorMessage(CSV_ERR_MEMORY_ALLOCATION), filePath);
+        csvTableDestroy(table);
+        return NULL;
+    }
+    return table;
+}
+
+// Free a table, its columns and its strings
+void csvTableDestroy(CsvTable* table)
+{
+    if (!table) return;
+
+    for (size_t c = 0; c < table->columnCount; ++c)
+    {
+        free(table->columns[c].name);
+        if (!__csvTableIsMapped(table, table->columns[c].values.int32s)) free(table->columns[c].values.int32s);
+    }
+    free(table->columns);
+    if (!__csvTableIsMapped(table, table->strings.data)) free(table->strings.data);
+    if (!__csvTableIsMapped(table, table->strings.offsets)) free(table->strings.offsets);
+    free(table->strings.slots);
+    if (table->mapping) munmap(table->mapping, table->mappingSize);
+    free(table);
+}
+
+// Add a column filled with one value
+CsvErrorCode csvTableAddColumn(CsvTable* table, const char* name, CsvColumnType type, const char* defaultValue)
+{
+    if (!table || !name)
+    {
+        fprintf(stderr, "%s: table or column name\n", csvErrorMessage(CSV_ERR_NULL_INPUT));
+        return CSV_ERR_NULL_INPUT;
+    }
+
+    if (table->columnCount == table->columnCapacity)
+    {
+        size_t capacity = table->columnCapacity ? table->columnCapacity * 2 : 8;
+        CsvColumn* grown = realloc(table->columns, capacity * sizeof(CsvColumn));
+        if (!grown)
+        {
+            fprintf(stderr, "%s: adding column %s\n", csvErrorMessage(CSV_ERR_MEMORY_ALLOCATION), name);
+            return CSV_ERR_MEMORY_ALLOCATION;
+        }
+        table->columns = grown;
+        table->columnCapacity = capacity;
+    }
+
+    CsvColumn column = { .type = type };
+    size_t length = defaultValue ? strlen(defaultValue) : 0;
+    int32_t integer = CSV_NULL_INT32;
+    double real = NAN;
+    uint32_t id = CSV_NULL_STRING;
+    bool parsed = true;
+    if (length > 0)
+    {
+        switch (type)
+        {
+            case CSV_COLUMN_INT32: parsed = __csvTableParseInt32(defaultValue, length, &integer); break;
+            case CSV_COLUMN_DOUBLE: parsed = csvParseDouble(defaultValue, length, &real); break;
+            case CSV_COLUMN_STRING:
+                if (!__csvTableOwnStrings(table) || !__csvStringPoolIntern(&table->strings, defaultValue, length, &id))
+                {
+                    fprintf(stderr, "%s: adding column %s\n", csvErrorMessage(CSV_ERR_MEMORY_ALLOCATION), name);
+                    return CSV_ERR_MEMORY_ALLOCATION;
+                }
+                break;
+        }
+        if (!parsed)
+        {
+            integer = CSV_NULL_INT32;
+            real = NAN;
+            column.invalidCount = table->rowCount;
+        }
+    }
+
+    column.name = strdup(name);
+    column.values.int32s = __csvColumnAllocate(type, table->rowCapacity);
+    if (!column.name || !column.values.int32s)
+    {
+        free(column.name);
+        free(column.values.int32s);
+        fprintf(stderr, "%s: adding column %s\n", csvErrorMessage(CSV_ERR_MEMORY_ALLOCATION), name);
+        return CSV_ERR_MEMORY_ALLOCATION;
+    }
+    for (size_t r = 0; r < table->rowCount; ++r)
+    {
+        switch (type)
+        {
+            case CSV_COLUMN_INT32: column.values.int32s[r] = integer; break;
+            case CSV_COLUMN_DOUBLE: column.values.doubles[r] = real; break;
+            case CSV_COLUMN_STRING: column.values.stringIds[r] = id; break;
+        }
+    }
+
+    table->columns[table->columnCount++] = column;
+    return CSV_SUCCESS;
+}
+
+// Drop a column by index
+CsvErrorCode csvTableDropColumn(CsvTable* table, size_t columnIndex)
+{
+    if (!table) return CSV_ERR_NULL_INPUT;
+    if (columnIndex >= table->columnCount) return CSV_ERR_COLUMN_INDEX_OUT_OF_RANGE;
+
+    free(table->columns[columnIndex].name);
+    if (!__csvTableIsMapped(table, table->columns[columnIndex].values.int32s))
+    {
+        free(table->columns[columnIndex].values.int32s);
+    }
+    memmove(&table->columns[columnIndex], &table->columns[columnIndex + 1],
+            (table->columnCount - columnIndex - 1) * sizeof(CsvColumn));
+    table->columnCount--;
+    return CSV_SUCCESS;
+}
+
+// Write a table out as CSV
+CsvErrorCode csvTableSave(const CsvTable* table, const char* filePath, const CsvParserConfig* config,
+                          bool withHeader)
+{
+    if (!table || !filePath || !config)
+    {
+        fprintf(stderr, "%s: table, file path or config\n", csvErrorMessage(CSV_ERR_NULL_INPUT));
+        return CSV_ERR_NULL_INPUT;
+    }
+
+    CsvWriter* writer = csvWriterOpen(filePath, config);
+    if (!writer) return CSV_ERR_FILE_OPEN;
+
+    if (withHeader)
+    {
+        for (size_t c = 0; c < table->columnCount; ++c)
+        {
+            const char* name = table->columns[c].name ? table->columns[c].name : "";
+            csvWriterField(writer, name, strlen(name));
+        }
+        csvWriterEndRow(writer);
+    }
+
+    CsvErrorCode result = CSV_SUCCESS;
+    for (size_t r = 0; r < table->rowCount && result == CSV_SUCCESS; ++r)
+    {
+        for (size_t c = 0; c < table->columnCount; ++c)
+        {
+            const CsvColumn* column = &table->columns[c];
+            switch (column->type)
+            {
+                case CSV_COLUMN_INT32:
+                    if (column->values.int32s[r] == CSV_NULL_INT32) csvWriterField(writer, "", 0);
+                    else csvWriterInt64(writer, column->values.int32s[r]);
+                    break;
+                case CSV_COLUMN_DOUBLE:
+                    csvWriterDouble(writer, column->values.doubles[r]);
+                    break;
+                case CSV_COLUMN_STRING:
+                {
+                    uint32_t id = column->values.stringIds[r];
+                    if (id == CSV_NULL_STRING) csvWriterField(writer, "", 0);
+                    else csvWriterField(writer, csvTableString(table, id), __csvStringPoolLength(&table->strings, id));
+                    break;
+                }
+            }
+        }
+        result = csvWriterEndRow(writer);
+    }
+
+    CsvErrorCode closed = csvWriterClose(writer);
+    return (result == CSV_SUCCESS) ? closed : result;
+}
+
+// Identifies a cache file, and its byte order
+#define CSV_CACHE_MAGIC "CSVCACHE"
+#define CSV_CACHE_BYTE_ORDER 0x01020304u
+
+// Header at the start of a cache file; the column directory follows it
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t columnCount;
+    uint64_t rowCount;
+    uint64_t sourceSize;
+    int64_t sourceSeconds;     // source mtime
+    int64_t sourceNanoseconds;
+    uint64_t namesOffset;      // column names, NUL-terminated, back to back
+    uint64_t namesBytes;
+    uint64_t stringCount;
+    uint64_t stringBytes;
+    uint64_t stringDataOffset;
+    uint64_t stringOffsetsOffset; // stringCount offsets into the string data
+    uint64_t stringChecksum;   // string data, then string offsets
+    uint64_t directoryChecksum; // directory, then names
+    uint64_t headerChecksum;   // this header block, with this field 0
+    char delimiter;
+    char quoteChar;
+    uint8_t quotedFieldsAllowed;
+    uint8_t shouldTrimWhitespace;
+    uint8_t hasHeader;
+} CsvCacheHeader;
+
+// One column in the directory
+typedef struct {
+    uint32_t type;
+    uint32_t nameLength;
+    uint64_t nameOffset;       // into the names block
+    uint64_t valuesOffset;     // rowCount values of the type
+    uint64_t invalidCount;
+    uint64_t checksum;
+} CsvCacheColumn;
+
+#define CSV_CACHE_HEADER_SIZE 192
+_Static_assert(sizeof(CsvCacheHeader) <= CSV_CACHE_HEADER_SIZE, "cache header outgrew its block");
+_Static_assert(sizeof(size_t) == sizeof(uint64_t), "string offsets are cached as they are in memory");
+
+// Internal helper: length rounded up to a whole number of blocks; never 0,
+// so every block starts inside the file
+static uint64_t __csvCacheAlign(uint64_t length)
+{
+    return length ? (length + CSV_TABLE_ALIGNMENT - 1) / CSV_TABLE_ALIGNMENT * CSV_TABLE_ALIGNMENT
+                  : CSV_TABLE_ALIGNMENT;
+}
+
+// Internal helper: Fletcher-style checksum over 64-bit words (the last one
+// zero-padded). The plain sum, as in BinaryIO.h, misses reordered words;
+// the sum of running sums catches them.
+static uint64_t __csvCacheChecksum(const void* data, size_t length, uint64_t seed)
+{
+    const char* bytes = data;
+    uint64_t a = seed;
+    uint64_t b = seed >> 32;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, bytes + i, sizeof word);
+        a += word;
+        b += a;
+    }
+    if (i < length)
+    {
+        uint64_t word = 0;
+        memcpy(&word, bytes + i, length - i);
+        a += word;
+        b += a;
+    }
+    return a ^ (b << 32 | b >> 32);
+}
+
+// Internal helper: checksum of a header block, taken with headerChecksum 0 so
+// that the format flags and the source stamp are covered too
+static uint64_t __csvCacheHeaderChecksum(const char* block)
+{
+    char copy[CSV_CACHE_HEADER_SIZE];
+    memcpy(copy, block, CSV_CACHE_HEADER_SIZE);
+    memset(copy + offsetof(CsvCacheHeader, headerChecksum), 0, sizeof(uint64_t));
+    return __csvCacheChecksum(copy, CSV_CACHE_HEADER_SIZE, 0);
+}
+
+// Internal helper: write length bytes, then zeros up to the next block
+static bool __csvCacheWriteBlock(FILE* file, const void* data, size_t length)
+{
+    static const char zeros[CSV_TABLE_ALIGNMENT];
+    size_t padding = __csvCacheAlign(length) - length;
+    return (length == 0 || fwrite(data, 1, length, file) == length)
+        && (padding == 0 || fwrite(zeros, 1, padding, file) == padding);
+}
+
+// Internal helper: write a cache stamped with the source's size and mtime
+static CsvErrorCode __csvTableWriteCache(const CsvTable* table, const char* cachePath, const struct stat* source,
+                                         const CsvParserConfig* config, bool hasHeader)
+{
+    size_t columnCount = table->columnCount;
+    const CsvStringPool* strings = &table->strings;
+    CsvCacheHeader header =
+    {
+        .magic = CSV_CACHE_MAGIC, .version = CSV_CACHE_VERSION, .byteOrder = CSV_CACHE_BYTE_ORDER,
+        .columnCount = columnCount, .rowCount = table->rowCount, .sourceSize = (uint64_t)source->st_size,
+        .sourceSeconds = source->st_mtim.tv_sec, .sourceNanoseconds = source->st_mtim.tv_nsec,
+        .stringCount = strings->count, .stringBytes = strings->length,
+        .delimiter = config->delimiter, .quoteChar = config->quoteChar,
+        .quotedFieldsAllowed = config->quotedFieldsAllowed, .shouldTrimWhitespace = config->shouldTrimWhitespace,
+        .hasHeader = hasHeader
+    };
+    CsvCacheColumn* directory = calloc(columnCount ? columnCount : 1, sizeof(CsvCacheColumn));
+    size_t tmpLength = strlen(cachePath) + sizeof ".tmp";
+    char* tmpPath = malloc(tmpLength);
+    if (!directory || !tmpPath)
+    {
+        free(directory);
+        free(tmpPath);
+        fprintf(stderr, "%s: writing %s\n", csvErrorMessage(CSV_ERR_MEMORY_ALLOCATION), cachePath);
+        return CSV_ERR_MEMORY_ALLOCATION;
+    }
+    snprintf(tmpPath, tmpLength, "%s.tmp", cachePath);
+
+    // lay the blocks out: directory, names, string data, string offsets, columns
+    uint64_t offset = CSV_CACHE_HEADER_SIZE + __csvCacheAlign(columnCount * sizeof(CsvCacheColumn));
+    header.namesOffset = offset;
+    for (size_t c = 0; c < columnCount; ++c)
+    {
+        const CsvColumn* column = &table->columns[c];
+        directory[c].type = column->type;
+        directory[c].nameLength = column->name ? strlen(column->name) : 0;
+        directory[c].nameOffset = header.namesBytes;
+        directory[c].invalidCount = column->invalidCount;
+        header.namesBytes += directory[c].nameLength + 1;
+    }
+    offset += __csvCacheAlign(header.namesBytes);
+    header.stringDataOffset = offset;
+    offset += __csvCacheAlign(header.stringBytes);
+    header.stringOffsetsOffset = offset;
+    offset += __csvCacheAlign(header.stringCount * sizeof(uint64_t));
+    for (size_t c = 0; c < columnCount; ++c)
+    {
+        const CsvColumn* column = &table->columns[c];
+        size_t bytes = table->rowCount * __csvColumnValueSize(column->type);
+        directory[c].valuesOffset = offset;
+        directory[c].checksum = __csvCacheChecksum(column->values.int32s, bytes, 0);
+        offset += __csvCacheAlign(bytes);
+    }
+    header.stringChecksum = __csvCacheChecksum(strings->data, strings->length, 0);
+    header.stringChecksum = __csvCacheChecksum(strings->offsets, strings->count * sizeof(uint64_t),
+                                               header.stringChecksum);
+
+    CsvErrorCode result = CSV_ERR_FILE_WRITE;
+    FILE* file = fopen(tmpPath, "wb");
+    if (file)
+    {
+        // names are checksummed as they are written
+        header.directoryChecksum = __csvCacheChecksum(directory, columnCount * sizeof(CsvCacheColumn), 0);
+        char headerBlock[CSV_CACHE_HEADER_SIZE] = { 0 };
+        bool written = __csvCacheWriteBlock(file, headerBlock, CSV_CACHE_HEADER_SIZE)
+                    && __csvCacheWriteBlock(file, directory, columnCount * sizeof(CsvCacheColumn));
+        char* names = malloc(header.namesBytes ? header.namesBytes : 1);
+        if (names)
+        {
+            for (size_t c = 0; c < columnCount; ++c)
+            {
+                if (directory[c].nameLength) memcpy(names + directory[c].nameOffset, table->columns[c].name,
+                                                    directory[c].nameLength);
+                names[directory[c].nameOffset + directory[c].nameLength] = '\0';
+            }
+            header.directoryChecksum = __csvCacheChecksum(names, header.namesBytes, header.directoryChecksum);
+            written = written && __csvCacheWriteBlock(file, names, header.namesBytes);
+            free(names);
+        }
+        else written = false;
+
+        written = written && __csvCacheWriteBlock(file, strings->data, strings->length)
+                          && __csvCacheWriteBlock(file, strings->offsets, strings->count * sizeof(uint64_t));
+        for (size_t c = 0; c < columnCount && written; ++c)
+        {
+            const CsvColumn* column = &table->columns[c];
+            written = __csvCacheWriteBlock(file, column->values.int32s,
+                                           table->rowCount * __csvColumnValueSize(column->type));
+        }
+
+        // the header goes in last, so a file cut short has no valid magic
+        memcpy(headerBlock, &header, sizeof header);
+        uint64_t headerChecksum = __csvCacheHeaderChecksum(headerBlock);
+        memcpy(headerBlock + offsetof(CsvCacheHeader, headerChecksum), &headerChecksum, sizeof headerChecksum);
+        written = written && fseek(file, 0, SEEK_SET) == 0
+                          && fwrite(headerBlock, 1, CSV_CACHE_HEADER_SIZE, file) == CSV_CACHE_HEADER_SIZE;
+        if (fclose(file) == 0 && written && rename(tmpPath, cachePath) == 0) result = CSV_SUCCESS;
+        else remove(tmpPath);
+    }
+    if (result != CSV_SUCCESS) fprintf(stderr, "%s: %s\n", csvErrorMessage(result), cachePath);
+
+    free(directory);
+    free(tmpPath);
+    return result;
+}
+
+// Write a table's binary cache
+CsvErrorCode csvTableSaveCache(const CsvTable* table, const char* cachePath, const char* sourcePath,
+                               const CsvParserConfig* config, bool hasHeader)
+{
+    if (!table || !cachePath || !sourcePath || !config)
+    {
+        fprintf(stderr, "%s: table, cache path, source path or config\n", csvErrorMessage(CSV_ERR_NULL_INPUT));
+        return CSV_ERR_NULL_INPUT;
+    }
+
+    struct stat source;
+    if (stat(sourcePath, &source) != 0)
+    {
+        fprintf(stderr, "%s: %s\n", csvErrorMessage(CSV_ERR_FILE_OPEN), sourcePath);
+        return CSV_ERR_FILE_OPEN;
+    }
+    return __csvTableWriteCache(table, cachePath, &source, config, hasHeader);
+}
+
+// Internal helper: does [offset, offset + length) lie within a file of size bytes
+static bool __csvCacheInBounds(uint64_t offset, uint64_t length, uint64_t size)
+{
+    return offset % CSV_TABLE_ALIGNMENT == 0 && offset <= size && length <= size - offset;
+}
+
+// Internal helper: map a cache and build a table over it; NULL if it is
+// missing, stale (source is not NULL and differs) or corrupt
+static CsvTable* __csvTableMapCache(const char* cachePath, const struct stat* source, bool verifyChecksums)
+{
+    int fd = open(cachePath, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat cache;
+    void* mapping = MAP_FAILED;
+    if (fstat(fd, &cache) == 0 && cache.st_size >= CSV_CACHE_HEADER_SIZE)
+    {
+        mapping = mmap(NULL, (size_t)cache.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        fprintf(stderr, "%s: %s\n", csvErrorMessage(CSV_ERR_CORRUPT_CACHE), cachePath);
+        return NULL;
+    }
+
+    uint64_t size = (uint64_t)cache.st_size;
+    char* base = mapping;
+    const CsvCacheHeader* header = mapping;
+    const CsvCacheColumn* directory = (const void*)(base + CSV_CACHE_HEADER_SIZE);
+    bool valid = memcmp(header->magic, CSV_CACHE_MAGIC, sizeof header->magic) == 0
+              && header->version == CSV_CACHE_VERSION && header->byteOrder == CSV_CACHE_BYTE_ORDER
+              && __csvCacheHeaderChecksum(base) == header->headerChecksum
+              && header->columnCount <= (size - CSV_CACHE_HEADER_SIZE) / sizeof(CsvCacheColumn)
+              && __csvCacheInBounds(header->namesOffset, header->namesBytes, size)
+              && header->stringCount < CSV_NULL_STRING
+              && __csvCacheInBounds(header->stringDataOffset, header->stringBytes, size)
+              && header->stringCount <= size / sizeof(uint64_t)
+              && __csvCacheInBounds(header->stringOffsetsOffset, header->stringCount * sizeof(uint64_t), size)
+              && (header->stringCount == 0 || header->stringBytes > 0);
+    for (uint64_t c = 0; valid && c < header->columnCount; ++c)
+    {
+        size_t valueSize = __csvColumnValueSize(directory[c].type);
+        valid = directory[c].type <= CSV_COLUMN_STRING
+             && directory[c].nameOffset < header->namesBytes
+             && directory[c].nameLength < header->namesBytes - directory[c].nameOffset
+             && header->rowCount <= size / valueSize
+             && __csvCacheInBounds(directory[c].valuesOffset, header->rowCount * valueSize, size)
+             && base[header->namesOffset + directory[c].nameOffset + directory[c].nameLength] == '\0';
+    }
+
+    // whatever the checksums say, every string read later has to lie within
+    // the string data and end in a NUL
+    const uint64_t* stringOffsets = valid ? (const void*)(base + header->stringOffsetsOffset) : NULL;
+    valid = valid && (header->stringCount == 0 || base[header->stringDataOffset + header->stringBytes - 1] == '\0');
+    for (uint64_t i = 0; valid && i < header->stringCount; ++i)
+    {
+        valid = stringOffsets[i] < header->stringBytes && (i == 0 || stringOffsets[i] > stringOffsets[i - 1]);
+    }
+    for (uint64_t c = 0; valid && c < header->columnCount; ++c)
+    {
+        if (directory[c].type != CSV_COLUMN_STRING) continue;
+        const uint32_t* ids = (const void*)(base + directory[c].valuesOffset);
+        for (uint64_t r = 0; valid && r < header->rowCount; ++r)
+        {
+            valid = ids[r] < header->stringCount || ids[r] == CSV_NULL_STRING;
+        }
+    }
+
+    if (valid && verifyChecksums)
+    {
+        uint64_t checksum = __csvCacheChecksum(directory, header->columnCount * sizeof(CsvCacheColumn), 0);
+        valid = __csvCacheChecksum(base + header->namesOffset, header->namesBytes, checksum)
+                == header->directoryChecksum;
+        checksum = __csvCacheChecksum(base + header->stringDataOffset, header->stringBytes, 0);
+        valid = valid && __csvCacheChecksum(base + header->stringOffsetsOffset,
+                                            header->stringCount * sizeof(uint64_t), checksum)
+                         == header->stringChecksum;
+        for (uint64_t c = 0; valid && c < header->columnCount; ++c)
+        {
+            size_t bytes = header->rowCount * __csvColumnValueSize(directory[c].type);
+            valid = __csvCacheChecksum(base + directory[c].valuesOffset, bytes, 0) == directory[c].checksum;
+        }
+    }
+    if (!valid)
+    {
+        fprintf(stderr, "%s: %s\n", csvErrorMessage(CSV_ERR_CORRUPT_CACHE), cachePath);
+        munmap(mapping, size);
+        return NULL;
+    }
+    if (source && (header->sourceSize != (uint64_t)source->st_size || header->sourceSeconds != source->st_mtim.tv_sec
+                   || header->sourceNanoseconds != source->st_mtim.tv_nsec))
+    {
+        munmap(mapping, size);
+        return NULL;
+    }
+
+    CsvTable* table = calloc(1, sizeof(CsvTable));
+    if (table) table->columns = calloc(header->columnCount ? header->columnCount : 1, sizeof(CsvColumn));
+    if (!table || !table->columns)
+    {
+        fprintf(stderr, "%s: opening %s\n", csvErrorMessage(CSV_ERR_MEMORY_ALLOCATION), cachePath);
+        free(table);
+        munmap(mapping, size);
+        return NULL;
+    }
+    table->mapping = mapping;
+    table->mappingSize = size;
+    table->rowCount = table->rowCapacity = header->rowCount;
+    table->columnCount = header->columnCount;
+    table->columnCapacity = header->columnCount ? header->columnCount : 1;
+
+    // names are copied so that columns can be renamed and dropped as usual
+    bool failed = false;
+    for (size_t c = 0; c < table->columnCount; ++c)
+    {
+        CsvColumn* column = &table->columns[c];
+        column->type = directory[c].type;
+        column->invalidCount = directory[c].invalidCount;
+        column->values.int32s = (void*)(base + directory[c].valuesOffset);
+        column->name = malloc(directory[c].nameLength + 1);
+        if (column->name) memcpy(column->name, base + header->namesOffset + directory[c].nameOffset,
+                                 directory[c].nameLength + 1);
+        else failed = true;
+    }
+
+    CsvStringPool* strings = &table->strings;
+    strings->data = base + header->stringDataOffset;
+    strings->length = strings->capacity = header->stringBytes;
+    strings->offsets = (void*)(base + header->stringOffsetsOffset);
+    strings->count = strings->offsetCapacity = header->stringCount;
+    size_t slotCount = 1024;
+    while ((strings->count + 1) * 2 > slotCount) slotCount *= 2;
+    if (failed || !__csvStringPoolRehash(strings, slotCount))
+    {
+        fprintf(stderr, "%s: opening %s\n", csvErrorMessage(CSV_ERR_MEMORY_ALLOCATION), cachePath);
+        csvTableDestroy(table);
+        return NULL;
+    }
+    return table;
+}
+
+// Open a binary cache
+CsvTable* csvTableOpenCache(const char* cachePath, const char* sourcePath, bool verifyChecksums)
+{
+    if (!cachePath)
+    {
+        fprintf(stderr, "%s: cache path\n", csvErrorMessage(CSV_ERR_NULL_INPUT));
+        return NULL;
+    }
+
+    struct stat source;
+    if (sourcePath && stat(sourcePath, &source) != 0) return NULL;
+    return __csvTableMapCache(cachePath, sourcePath ? &source : NULL, verifyChecksums);
+}
+
+// Load a CSV file through its binary cache
+CsvTable* csvTableLoadCached(const char* filePath, const char* cachePath, const CsvParserConfig* config,
+                             const CsvColumnType* types, size_t columnCount, bool hasHeader)
+{
+    if (!filePath || !cachePath || !config)
+    {
+        fprintf(stderr, "%s: file path, cache path or config\n", csvErrorMessage(CSV_ERR_NULL_INPUT));
+        return NULL;
+    }
+
+    // stamped before parsing, so a change made during the parse makes the cache stale
+    struct stat source;
+    if (stat(filePath, &source) != 0)
+    {
+        fprintf(stderr, "%s: %s\n", csvErrorMessage(CSV_ERR_FILE_OPEN), filePath);
+        return NULL;
+    }
+
+    CsvTable* table = __csvTableMapCache(cachePath, &source, true);
+    if (table)
+    {
+        const CsvCacheHeader* header = table->mapping;
+        bool matches = header->delimiter == config->delimiter && header->quoteChar == config->quoteChar
+                    && header->quotedFieldsAllowed == config->quotedFieldsAllowed
+                    && header->shouldTrimWhitespace == config->shouldTrimWhitespace
+                    && header->hasHeader == hasHeader && (!types || table->columnCount == columnCount);
+        for (size_t c = 0; matches && types && c < columnCount; ++c) matches = table->columns[c].type == types[c];
+        if (matches) return table;
+        csvTableDestroy(table);
+    }
+
+    table = csvTableLoad(filePath, config, types, columnCount, hasHeader);
+    // a table that could not be cached is still returned
+    if (table) __csvTableWriteCache(table, cachePath, &source, config, hasHeader);
+    return table;
+}
+
+// Find a column by name
+long csvTableColumnIndex(const CsvTable* table, const char* name)
+{
+    if (!table || !name) return -1;
+    for (size_t c = 0; c < table->columnCount; ++c)
+    {
+        if (table->columns[c].name && strcmp(table->columns[c].name, name) == 0) return (long)c;
+    }
+    return -1;
+}
+
+// Look up an interned string
+const char* csvTableString(const CsvTable* table, uint32_t id)
+{
+    if (!table || id >= table->strings.count) return NULL;
+    return table->strings.data + table->strings.offsets[id];
+}
+
+// Id of an interned string, without adding it
+uint32_t csvTableFindString(const CsvTable* table, const char* text, size_t length)
+{
+    if (!table || !text || table->strings.slotCount == 0) return CSV_NULL_STRING;
+    size_t slot = __csvStringPoolSlot(&table->strings, text, length);
+    return table->strings.slots[slot] ? table->strings.slots[slot] - 1 : CSV_NULL_STRING;
+}
+
+// A view of one row
+CsvTableRow csvTableRowAt(const CsvTable* table, size_t row)
+{
+    CsvTableRow view = { table, row };
+    return view;
+}
+
+// Internal helper: the column behind a row view, if it has the given type
+static const CsvColumn* __csvTableRowColumn(CsvTableRow row, size_t column, CsvColumnType type)
+{
+    if (!row.table || row.row >= row.table->rowCount || column >= row.table->columnCount) return NULL;
+    const CsvColumn* found = &row.table->columns[column];
+    return (found->type == type) ? found : NULL;
+}
+
+// Read an int32 through a row view
+int32_t csvTableRowInt32(CsvTableRow row, size_t column)
+{
+    const CsvColumn* found = __csvTableRowColumn(row, column, CSV_COLUMN_INT32);
+    return found ? found->values.int32s[row.row] : CSV_NULL_INT32;
+}
+
+// Read a double through a row view
+double csvTableRowDouble(CsvTableRow row, size_t column)
+{
+    const CsvColumn* found = __csvTableRowColumn(row, column, CSV_COLUMN_DOUBLE);
+    return found ? found->values.doubles[row.row] : NAN;
+}
+
+// Read a string through a row view
+const char* csvTableRowString(CsvTableRow row, size_t column)
+{
+    const CsvColumn* found = __csvTableRowColumn(row, column, CSV_COLUMN_STRING);
+    return found ? csvTableString(row.table, found->values.stringIds[row.row]) : NULL;
+}
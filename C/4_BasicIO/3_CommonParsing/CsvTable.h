@@ -0,0 +1,149 @@
+#ifndef CSVTABLE_H
+#define CSVTABLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "CsvParser.h"
+
+// Column value types of a CsvTable
+typedef enum {
+    CSV_COLUMN_INT32,
+    CSV_COLUMN_DOUBLE,
+    CSV_COLUMN_STRING          // ids into the table's string pool
+} CsvColumnType;
+
+// Null values: empty fields, missing fields, and values that do not parse
+// as the column type. Double columns use NaN. INT32_MIN itself does not fit
+// an INT32 column: such a column is inferred as DOUBLE, and with an explicit
+// INT32 type the value counts as invalid.
+#define CSV_NULL_INT32 INT32_MIN
+#define CSV_NULL_STRING UINT32_MAX
+
+// Column buffers are aligned for vector loads
+#define CSV_TABLE_ALIGNMENT 64
+
+// Rows read to infer a schema
+#define CSV_TABLE_SAMPLE_ROWS 1000
+
+// One typed column; values holds rowCount entries of the column type
+typedef struct {
+    char* name;
+    CsvColumnType type;
+    union {
+        int32_t* int32s;
+        double* doubles;
+        uint32_t* stringIds;
+    } values;
+    size_t invalidCount;       // non-empty fields that did not parse, stored as null
+} CsvColumn;
+
+// Interned strings: each distinct string is stored once and named by an id
+typedef struct {
+    char* data;                // NUL-terminated strings back to back
+    size_t length;
+    size_t capacity;
+    size_t* offsets;           // offsets[id] into data
+    uint32_t count;
+    uint32_t offsetCapacity;
+    uint32_t* slots;           // open addressing; id + 1, 0 for empty
+    size_t slotCount;
+} CsvStringPool;
+
+// A CSV file loaded into contiguous typed columns
+typedef struct {
+    size_t rowCount;
+    size_t rowCapacity;
+    size_t columnCount;
+    size_t columnCapacity;
+    CsvColumn* columns;
+    CsvStringPool strings;
+    void* mapping;             // cache file the values and strings live in, or NULL
+    size_t mappingSize;
+} CsvTable;
+
+// A row of a table, read through its columns; valid until the table changes
+typedef struct {
+    const CsvTable* table;
+    size_t row;
+} CsvTableRow;
+
+// Infer column types from the first CSV_TABLE_SAMPLE_ROWS rows: INT32 if
+// every value parses as one, else DOUBLE if every value does, else STRING.
+// types needs room for maxColumns; *columnCount is the widest row sampled.
+CsvErrorCode csvTableInferTypes(const char* filePath, const CsvParserConfig* config, bool hasHeader,
+                                CsvColumnType* types, size_t maxColumns, size_t* columnCount);
+
+// Load a file into a table with the given column types, or inferred ones if
+// types is NULL. Only the format fields of config are used (delimiter,
+// quoting, trimming, scan mode), not its handlers, projection or predicates.
+// With hasHeader, the first row names the columns; otherwise they are named
+// column0, column1, ... Blank lines are skipped, except in a one-column table,
+// where they are null values like "".
+CsvTable* csvTableLoad(const char* filePath, const CsvParserConfig* config, const CsvColumnType* types,
+                       size_t columnCount, bool hasHeader);
+
+void csvTableDestroy(CsvTable* table);
+
+// Append a column holding defaultValue, parsed as type, in every row. NULL or
+// "" gives null values, as does a value that does not parse (counted in
+// invalidCount). One buffer is allocated; no other column is touched.
+CsvErrorCode csvTableAddColumn(CsvTable* table, const char* name, CsvColumnType type, const char* defaultValue);
+
+// Remove a column: its buffer is freed and the columns after it move down
+// one index, without touching their values
+CsvErrorCode csvTableDropColumn(CsvTable* table, size_t columnIndex);
+
+// Write the table as CSV through a CsvWriter, names first if withHeader;
+// null values are empty fields. Only the delimiter and quoteChar of config
+// are used.
+CsvErrorCode csvTableSave(const CsvTable* table, const char* filePath, const CsvParserConfig* config,
+                          bool withHeader);
+
+// Binary columnar cache of a loaded table: a checksummed header, then each
+// block (column directory, names, strings, one block per column) 64-byte
+// aligned with its own checksum. It records the source file's size and mtime, and is stale
+// once either changes. Values are in the byte order of the machine.
+#define CSV_CACHE_VERSION 2
+
+// Write table to cachePath as the cache of sourcePath, loaded with config and
+// hasHeader. The file is written beside cachePath and renamed into place.
+CsvErrorCode csvTableSaveCache(const CsvTable* table, const char* cachePath, const char* sourcePath,
+                               const CsvParserConfig* config, bool hasHeader);
+
+// Map a cache file; the columns and strings are read straight from the
+// mapping (copy-on-write, so values may be modified). NULL if the file is
+// missing, stale or corrupt; only corruption is reported. With a NULL
+// sourcePath freshness is not checked. Without verifyChecksums the layout,
+// names, strings and string ids are still checked to lie within the file,
+// but the values are trusted.
+CsvTable* csvTableOpenCache(const char* cachePath, const char* sourcePath, bool verifyChecksums);
+
+// csvTableOpenCache (verified) if cachePath is a fresh cache of filePath with
+// the same format and types, else csvTableLoad and then csvTableSaveCache
+CsvTable* csvTableLoadCached(const char* filePath, const char* cachePath, const CsvParserConfig* config,
+                             const CsvColumnType* types, size_t columnCount, bool hasHeader);
+
+// Index of the column called name, or -1
+long csvTableColumnIndex(const CsvTable* table, const char* name);
+
+// The string with the given id, or NULL for CSV_NULL_STRING
+const char* csvTableString(const CsvTable* table, uint32_t id);
+
+// Id of a string already in the table, or CSV_NULL_STRING if it is not
+uint32_t csvTableFindString(const CsvTable* table, const char* text, size_t length);
+
+// View of row; the accessors below read one of its values
+CsvTableRow csvTableRowAt(const CsvTable* table, size_t row);
+
+// Value of an INT32 column, or CSV_NULL_INT32 for any other column
+int32_t csvTableRowInt32(CsvTableRow row, size_t column);
+
+// Value of a DOUBLE column, or NaN for any other column
+double csvTableRowDouble(CsvTableRow row, size_t column);
+
+// Value of a STRING column, or NULL for null values and any other column
+const char* csvTableRowString(CsvTableRow row, size_t column);
+
+#endif /* CSVTABLE_H */
@@ -0,0 +1,386 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include "CsvWriter.h"
+#include "CsvNumbers.h"
+
+// Writer state; see csvWriterCreate
+struct CsvWriter {
+    int fd;
+    bool ownsFd;
+    char delimiter;
+    char quoteChar;
+    char* memory;              // the buffers, back to back
+    size_t lengths[CSV_WRITER_BUFFERS];
+    size_t current;            // buffer being filled
+    size_t fieldsInRow;
+    size_t byteCount;
+    size_t rowStart;           // byteCount when the current row began
+    CsvErrorCode result;
+    bool special[256];         // bytes that force quotes anywhere in a field
+    bool space[256];           // bytes that force quotes at either end (isspace)
+};
+
+// Internal helper: writev the buffers, then extra; handles short writes
+static bool __csvWriterWrite(CsvWriter* writer, const char* extra, size_t extraLength)
+{
+    struct iovec parts[CSV_WRITER_BUFFERS + 1];
+    int count = 0;
+    for (size_t i = 0; i <= writer->current; ++i)
+    {
+        if (writer->lengths[i] == 0) continue;
+        parts[count].iov_base = writer->memory + i * CSV_WRITER_BUFFER;
+        parts[count++].iov_len = writer->lengths[i];
+        writer->lengths[i] = 0;
+    }
+    if (extraLength > 0)
+    {
+        parts[count].iov_base = (void*)extra;
+        parts[count++].iov_len = extraLength;
+    }
+    writer->current = 0;
+
+    struct iovec* next = parts;
+    while (count > 0)
+    {
+        ssize_t written = writev(writer->fd, next, count);
+        if (written < 0 && errno == EINTR) continue;
+        if (written < 0)
+        {
+            fprintf(stderr, "%s: %s\n", csvErrorMessage(CSV_ERR_FILE_WRITE), strerror(errno));
+            writer->result = CSV_ERR_FILE_WRITE;
+            return false;
+        }
+        while (count > 0 && (size_t)written >= next->iov_len)
+        {
+            written -= next->iov_len;
+            next++;
+            count--;
+        }
+        if (count > 0)
+        {
+            next->iov_base = (char*)next->iov_base + written;
+            next->iov_len -= written;
+        }
+    }
+    return true;
+}
+
+// Internal helper: room for length contiguous bytes (at most one buffer) at
+// the end of the current buffer, moving on to the next one if needed
+static char* __csvWriterReserve(CsvWriter* writer, size_t length)
+{
+    if (writer->lengths[writer->current] + length > CSV_WRITER_BUFFER)
+    {
+        if (writer->current + 1 < CSV_WRITER_BUFFERS) writer->current++;
+        else if (!__csvWriterWrite(writer, NULL, 0)) return NULL;
+    }
+    return writer->memory + writer->current * CSV_WRITER_BUFFER + writer->lengths[writer->current];
+}
+
+// Internal helper: copy bytes into the buffers, across as many as it takes
+static bool __csvWriterAppend(CsvWriter* writer, const char* data, size_t length)
+{
+    writer->byteCount += length;
+    while (length > 0)
+    {
+        size_t room = CSV_WRITER_BUFFER - writer->lengths[writer->current];
+        if (room == 0)
+        {
+            if (!__csvWriterReserve(writer, 1)) return false;
+            continue;
+        }
+        size_t copied = (length < room) ? length : room;
+        memcpy(writer->memory + writer->current * CSV_WRITER_BUFFER + writer->lengths[writer->current], data, copied);
+        writer->lengths[writer->current] += copied;
+        data += copied;
+        length -= copied;
+    }
+    return true;
+}
+
+// Internal helper: the delimiter before every field but the first of a row
+static bool __csvWriterSeparate(CsvWriter* writer)
+{
+    return writer->fieldsInRow++ == 0 || __csvWriterAppend(writer, &writer->delimiter, 1);
+}
+
+// Internal helper: non-zero if any byte of word is in pattern's bytes
+static inline uint64_t __csvWriterHasByte(uint64_t word, uint64_t pattern)
+{
+    uint64_t x = word ^ pattern;
+    return (x - 0x0101010101010101ULL) & ~x & 0x8080808080808080ULL;
+}
+
+// Internal helper: does the field need quotes to read back as itself. Blocks
+// are compared whole, the last one overlapping the one before it.
+static bool __csvWriterNeedsQuotes(const CsvWriter* writer, const char* text, size_t length)
+{
+    if (length == 0) return false;
+    if (writer->space[(unsigned char)text[0]] || writer->space[(unsigned char)text[length - 1]]) return true;
+
+#if defined(__x86_64__)
+    if (length >= 16)
+    {
+        const __m128i delimiter = _mm_set1_epi8(writer->delimiter);
+        const __m128i quote = _mm_set1_epi8(writer->quoteChar);
+        const __m128i newline = _mm_set1_epi8('\n');
+        const __m128i carriageReturn = _mm_set1_epi8('\r');
+        for (size_t i = 0; i < length; i += 16)
+        {
+            if (i + 16 > length) i = length - 16;
+            __m128i bytes = _mm_loadu_si128((const __m128i*)(const void*)(text + i));
+            __m128i fieldBytes = _mm_or_si128(_mm_cmpeq_epi8(bytes, delimiter), _mm_cmpeq_epi8(bytes, quote));
+            __m128i lineBytes = _mm_or_si128(_mm_cmpeq_epi8(bytes, newline), _mm_cmpeq_epi8(bytes, carriageReturn));
+            if (_mm_movemask_epi8(_mm_or_si128(fieldBytes, lineBytes))) return true;
+        }
+        return false;
+    }
+#endif
+    if (length >= 8)
+    {
+        const uint64_t ones = 0x0101010101010101ULL;
+        const uint64_t delimiter = ones * (unsigned char)writer->delimiter;
+        const uint64_t quote = ones * (unsigned char)writer->quoteChar;
+        for (size_t i = 0; i < length; i += 8)
+        {
+            if (i + 8 > length) i = length - 8;
+            uint64_t word;
+            memcpy(&word, text + i, sizeof(word));
+            if (__csvWriterHasByte(word, delimiter) | __csvWriterHasByte(word, quote)
+                | __csvWriterHasByte(word, ones * '\n') | __csvWriterHasByte(word, ones * '\r')) return true;
+        }
+        return false;
+    }
+
+    bool found = false;
+    for (size_t i = 0; i < length; ++i) found |= writer->special[(unsigned char)text[i]];
+    return found;
+}
+
+// Internal helper: room for a formatted number at the end of the buffers
+static char* __csvWriterNumberSpace(CsvWriter* writer)
+{
+    if (writer->result != CSV_SUCCESS || !__csvWriterSeparate(writer)) return NULL;
+    return __csvWriterReserve(writer, CSV_NUMBER_TEXT_MAX);
+}
+
+// Internal helper: count the length bytes formatted at __csvWriterNumberSpace
+static CsvErrorCode __csvWriterNumberWritten(CsvWriter* writer, size_t length)
+{
+    writer->lengths[writer->current] += length;
+    writer->byteCount += length;
+    return CSV_SUCCESS;
+}
+
+// Create a writer on an open file descriptor
+CsvWriter* csvWriterCreate(int fd, const CsvParserConfig* config)
+{
+    if (fd < 0 || !config)
+    {
+        fprintf(stderr, "%s: file descriptor or config\n", csvErrorMessage(CSV_ERR_NULL_INPUT));
+        return NULL;
+    }
+
+    CsvWriter* writer = calloc(1, sizeof(CsvWriter));
+    if (writer) writer->memory = malloc((size_t)CSV_WRITER_BUFFERS * CSV_WRITER_BUFFER);
+    if (!writer || !writer->memory)
+    {
+        fprintf(stderr, "%s: creating writer\n", csvErrorMessage(CSV_ERR_MEMORY_ALLOCATION));
+        free(writer);
+        return NULL;
+    }
+
+    writer->fd = fd;
+    writer->delimiter = config->delimiter;
+    writer->quoteChar = config->quoteChar;
+    writer->result = CSV_SUCCESS;
+    writer->special[(unsigned char)config->delimiter] = true;
+    writer->special[(unsigned char)config->quoteChar] = true;
+    writer->special['\n'] = writer->special['\r'] = true;
+    for (int c = 0; c < 256; ++c) writer->space[c] = isspace(c) != 0;
+    return writer;
+}
+
+// Create a writer on a new file
+CsvWriter* csvWriterOpen(const char* filePath, const CsvParserConfig* config)
+{
+    if (!filePath || !config)
+    {
+        fprintf(stderr, "%s: file path or config\n", csvErrorMessage(CSV_ERR_NULL_INPUT));
+        return NULL;
+    }
+
+    int fd = open(filePath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        fprintf(stderr, "%s: %s\n", csvErrorMessage(CSV_ERR_FILE_OPEN), filePath);
+        return NULL;
+    }
+
+    CsvWriter* writer = csvWriterCreate(fd, config);
+    if (!writer) close(fd);
+    else writer->ownsFd = true;
+    return writer;
+}
+
+// Internal helper: write a quoted field into out, doubling its quotes;
+// returns the length written, at most 2 * length + 2
+static size_t __csvWriterEscape(const CsvWriter* writer, const char* text, size_t length, char* out)
+{
+    const char* end = text + length;
+    const char* quote;
+    char* start = out;
+    *out++ = writer->quoteChar;
+    while ((quote = memchr(text, writer->quoteChar, end - text)) != NULL)
+    {
+        memcpy(out, text, quote - text + 1);
+        out += quote - text + 1;
+        *out++ = writer->quoteChar;
+        text = quote + 1;
+    }
+    memcpy(out, text, end - text);
+    out += end - text;
+    *out++ = writer->quoteChar;
+    return out - start;
+}
+
+// Write a field, quoted and escaped only if needed
+CsvErrorCode csvWriterField(CsvWriter* writer, const char* text, size_t length)
+{
+    if (!writer || (!text && length > 0)) return CSV_ERR_NULL_INPUT;
+    if (writer->result != CSV_SUCCESS) return writer->result;
+
+    bool quoted = __csvWriterNeedsQuotes(writer, text, length);
+    if (length < CSV_WRITER_DIRECT)
+    {
+        // delimiter, quotes and doubled quotes included, in one reservation
+        char* out = __csvWriterReserve(writer, quoted ? 2 * length + 3 : length + 1);
+        if (!out) return writer->result;
+        char* start = out;
+        if (writer->fieldsInRow++ > 0) *out++ = writer->delimiter;
+        if (quoted) out += __csvWriterEscape(writer, text, length, out);
+        else
+        {
+            memcpy(out, text, length);
+            out += length;
+        }
+        writer->lengths[writer->current] += out - start;
+        writer->byteCount += out - start;
+        return CSV_SUCCESS;
+    }
+
+    if (!__csvWriterSeparate(writer)) return writer->result;
+    if (!quoted)
+    {
+        if (__csvWriterWrite(writer, text, length)) writer->byteCount += length;
+        return writer->result;
+    }
+
+    // too long to reserve at once: copy up to and including each quote, then
+    // add another
+    const char* end = text + length;
+    const char* quote;
+    if (!__csvWriterAppend(writer, &writer->quoteChar, 1)) return writer->result;
+    while ((quote = memchr(text, writer->quoteChar, end - text)) != NULL)
+    {
+        if (!__csvWriterAppend(writer, text, quote - text + 1)
+            || !__csvWriterAppend(writer, &writer->quoteChar, 1)) return writer->result;
+        text = quote + 1;
+    }
+    if (__csvWriterAppend(writer, text, end - text)) __csvWriterAppend(writer, &writer->quoteChar, 1);
+    return writer->result;
+}
+
+// Write an integer field
+CsvErrorCode csvWriterInt64(CsvWriter* writer, int64_t value)
+{
+    if (!writer) return CSV_ERR_NULL_INPUT;
+    char* out = __csvWriterNumberSpace(writer);
+    return out ? __csvWriterNumberWritten(writer, csvFormatInt64(value, out)) : writer->result;
+}
+
+// Write a floating-point field
+CsvErrorCode csvWriterDouble(CsvWriter* writer, double value)
+{
+    if (!writer) return CSV_ERR_NULL_INPUT;
+    char* out = __csvWriterNumberSpace(writer);
+    return out ? __csvWriterNumberWritten(writer, csvFormatDouble(value, out)) : writer->result;
+}
+
+// End the current row
+CsvErrorCode csvWriterEndRow(CsvWriter* writer)
+{
+    if (!writer) return CSV_ERR_NULL_INPUT;
+    if (writer->result != CSV_SUCCESS) return writer->result;
+
+    // one empty field is written as "", since an empty line reads back as no row
+    size_t length = (writer->fieldsInRow == 1 && writer->byteCount == writer->rowStart) ? 3 : 1;
+    writer->fieldsInRow = 0;
+    char* out = __csvWriterReserve(writer, length);
+    if (!out) return writer->result;
+    if (length == 3)
+    {
+        *out++ = writer->quoteChar;
+        *out++ = writer->quoteChar;
+    }
+    *out = '\n';
+    writer->lengths[writer->current] += length;
+    writer->byteCount += length;
+    writer->rowStart = writer->byteCount;
+    return CSV_SUCCESS;
+}
+
+// Write a row of NUL-terminated columns
+CsvErrorCode csvWriterRow(CsvWriter* writer, const char** columns, size_t columnCount)
+{
+    if (!writer || (!columns && columnCount > 0)) return CSV_ERR_NULL_INPUT;
+    for (size_t i = 0; i < columnCount; ++i)
+    {
+        if (csvWriterField(writer, columns[i] ? columns[i] : "", columns[i] ? strlen(columns[i]) : 0) != CSV_SUCCESS)
+        {
+            return writer->result;
+        }
+    }
+    return csvWriterEndRow(writer);
+}
+
+// Write the buffered output
+CsvErrorCode csvWriterFlush(CsvWriter* writer)
+{
+    if (!writer) return CSV_ERR_NULL_INPUT;
+    if (writer->result == CSV_SUCCESS) __csvWriterWrite(writer, NULL, 0);
+    return writer->result;
+}
+
+// Bytes accepted so far
+size_t csvWriterByteCount(const CsvWriter* writer)
+{
+    return writer ? writer->byteCount : 0;
+}
+
+// Flush and free a writer
+CsvErrorCode csvWriterClose(CsvWriter* writer)
+{
+    if (!writer) return CSV_ERR_NULL_INPUT;
+
+    CsvErrorCode result = csvWriterFlush(writer);
+    if (writer->ownsFd && close(writer->fd) != 0 && result == CSV_SUCCESS)
+    {
+        fprintf(stderr, "%s: %s\n", csvErrorMessage(CSV_ERR_FILE_WRITE), strerror(errno));
+        result = CSV_ERR_FILE_WRITE;
+    }
+    free(writer->memory);
+    free(writer);
+    return result;
+}
@@ -0,0 +1,54 @@
+#ifndef CSVWRITER_H
+#define CSVWRITER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "CsvParser.h"
+
+// Output is built in CSV_WRITER_BUFFERS buffers of CSV_WRITER_BUFFER bytes,
+// all handed to one writev once they are full
+#define CSV_WRITER_BUFFER (1024 * 1024)
+#define CSV_WRITER_BUFFERS 4
+
+// Fields at least this long and needing no quotes are written from the
+// caller's memory instead of being copied
+#define CSV_WRITER_DIRECT (64 * 1024)
+
+// Buffered CSV output to a file descriptor. Only the delimiter and quoteChar
+// of the config are used. A field is quoted only when it has to be: it holds
+// the delimiter, a quote or a line break, or starts or ends with whitespace
+// (which a trimming reader would drop). Rows end with '\n'. Errors are
+// sticky: after one, every call returns it.
+typedef struct CsvWriter CsvWriter;
+
+CsvWriter* csvWriterCreate(int fd, const CsvParserConfig* config);
+// Creates or truncates filePath; the writer closes it
+CsvWriter* csvWriterOpen(const char* filePath, const CsvParserConfig* config);
+
+// Append a field to the current row
+CsvErrorCode csvWriterField(CsvWriter* writer, const char* text, size_t length);
+CsvErrorCode csvWriterInt64(CsvWriter* writer, int64_t value);
+// The shortest decimal that parses back to value; NaN is an empty field
+CsvErrorCode csvWriterDouble(CsvWriter* writer, double value);
+
+// End the current row. A row with no fields is an empty line; a row of one
+// empty field is written as a quoted empty field, so that it reads back as a
+// row rather than a blank line.
+CsvErrorCode csvWriterEndRow(CsvWriter* writer);
+
+// Write a whole row of NUL-terminated columns
+CsvErrorCode csvWriterRow(CsvWriter* writer, const char** columns, size_t columnCount);
+
+// Write everything buffered so far
+CsvErrorCode csvWriterFlush(CsvWriter* writer);
+
+// Bytes accepted so far, written or still buffered
+size_t csvWriterByteCount(const CsvWriter* writer);
+
+// Flush, close the file if the writer opened it, and free the writer;
+// returns the first error of its lifetime
+CsvErrorCode csvWriterClose(CsvWriter* writer);
+
+#endif /* CSVWRITER_H */
@@ -7,8 +7,14 @@ JSON parsing / navigation
 #include <stdio.h>
 
 #include "CsvParser.h"
+#include "CsvTable.h"
 #include "XmlParser.h"
 #include "JsonParser.h"
+#include "CsvParserTest.h"
+
+#ifdef RUN_BENCHMARKS
+#include "CsvBench.h"
+#endif
 
 void csvPrintRow(size_t rowIndex, const char** columns, size_t columnCount, void* userData)
 {
@@ -19,6 +25,15 @@ void csvPrintRow(size_t rowIndex, const char** columns, size_t columnCount, void
     }
 }
 
+void csvPrintFields(size_t rowIndex, const CsvField* fields, size_t fieldCount, void* userData)
+{
+    printf("Row %zu: ", rowIndex);
+    for (size_t i = 0; i < fieldCount; ++i)
+    {
+        printf("%.*s  %s", (int)fields[i].length, fields[i].data, (i < fieldCount - 1) ? ", " : "\n");
+    }
+}
+
 int main()
 {
     CsvParserConfig cfg = 
@@ -32,5 +47,42 @@ int main()
     };
 
     parseCsvFile("../../../__common/data.csv", &cfg);
-    
+
+    // same file, mapped, fields printed straight from the mapping
+    cfg.fieldHandler = csvPrintFields;
+    parseCsvFileMapped("../../../__common/data.csv", &cfg);
+
+    // typed columns: mean BMI of the patients over 60
+    CsvTable* table = csvTableLoad("../../../__common/data.csv", &cfg, NULL, 0, true);
+    long age = table ? csvTableColumnIndex(table, "Age") : -1;
+    long bmi = table ? csvTableColumnIndex(table, "BMI") : -1;
+    if (age < 0 || bmi < 0 || table->columns[age].type != CSV_COLUMN_INT32
+        || table->columns[bmi].type != CSV_COLUMN_DOUBLE)
+    {
+        fprintf(stderr, "data.csv has no INT32 Age and DOUBLE BMI columns\n");
+    }
+    else
+    {
+        const int32_t* ages = table->columns[age].values.int32s;
+        const double* bmis = table->columns[bmi].values.doubles;
+        double bmiSum = 0;
+        size_t count = 0;
+        for (size_t r = 0; r < table->rowCount; ++r)
+        {
+            if (ages[r] > 60)
+            {
+                bmiSum += bmis[r];
+                count++;
+            }
+        }
+        printf("\n%zu of %zu patients are over 60, mean BMI %.2f\n", count, table->rowCount, count ? bmiSum / count : 0.0);
+    }
+    csvTableDestroy(table);
+
+    runCsvParserTests();
+
+#ifdef RUN_BENCHMARKS
+    runCsvBenchmarks();
+#endif
+
 }
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include <stdbool.h>
 #include <limits.h>
 #include <string.h>
+#include <time.h>
+#include <unistd.h>
 
 /*******************************************************************************\
 * util                                                                         *
@@ -95,6 +97,44 @@ bool dateIsValid(int year, int month, int day)
     return isValid;
 }
 
+/******************************************************************************
+* timestampToEpoch
+*
+* parameters: 
+*  - timestamp : const char* ; "YYYY-MM-DD HH:MM:SS", as in __common/formatted.txt
+*  - epoch : long long* ; out, seconds since 1970-01-01 00:00:00
+*   
+* returns: bool ; false if timestamp is malformed or not a valid date/time
+* 
+* description: reads the first 19 characters (anything after, e.g. a '\r', is
+* ignored) and treats them as UTC, so unlike mktime the result doesn't depend
+* on the local time zone. Days are counted with the civil-from-days algorithm
+* (shift the year to start in March so the leap day comes last).
+* 
+******************************************************************************/
+bool timestampToEpoch(const char* timestamp, long long* epoch)
+{
+    int year, month, day, hour, minute, second, length = 0;
+
+    if (sscanf(timestamp, "%4d-%2d-%2d %2d:%2d:%2d%n", &year, &month, &day, &hour, &minute, &second, &length) != 6
+        || length != 19)
+        return false;
+
+    if (!dateIsValid(year, month, day) || hour > 23 || minute > 59 || second > 59 
+        || hour < 0 || minute < 0 || second < 0)
+        return false;
+
+    long long shiftedYear = (month <= 2) ? year - 1 : year;
+    long long era = shiftedYear / 400;
+    long long yearOfEra = shiftedYear - era * 400;
+    long long dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    long long dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    long long days = era * 146097 + dayOfEra - 719468;
+
+    *epoch = days * 86400 + hour * 3600 + minute * 60 + second;
+    return true;
+}
+
 /******************************************************************************
 * charlenUtf8
 *
@@ -143,4 +183,43 @@ void printBinary(BINARY_WIDTH_TYPE n)
     }
 }
 
+/******************************************************************************
+* benchSeconds
+*
+* parameters: none
+*   
+* returns: double ; seconds on the monotonic clock
+* 
+* description: a timer for benchmarks; only differences between two calls
+* mean anything
+* 
+******************************************************************************/
+double benchSeconds()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/******************************************************************************
+* benchRssKb
+*
+* parameters: none
+*   
+* returns: long ; resident set size in KB, -1 if it cannot be read
+* 
+* description: memory actually in use by the process, from /proc/self/statm
+* (Linux only)
+* 
+******************************************************************************/
+long benchRssKb()
+{
+    long pages = 0, resident = 0;
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (statm == NULL) return -1;
+    if (fscanf(statm, "%ld %ld", &pages, &resident) != 2) resident = -1;
+    fclose(statm);
+    return (resident < 0) ? -1 : resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
 #endif /* UTIL_H */
\ No newline at end of file